@@ -2047,6 +2047,35 @@ cdp_tx_send(ol_txrx_soc_handle soc, uint8_t vdev_id, qdf_nbuf_t nbuf)
 	soc->ops->cmn_drv_ops->tx_send(soc, vdev_id, nbuf);
 }
 
+/**
+ * cdp_tx_send_list() - enqueue a chain of frames for transmission
+ * @soc: soc opaque handle
+ * @vdev_id: id of VAP device
+ * @nbuf_list: chain of nbufs linked through qdf_nbuf_next()
+ *
+ * This API is used to enqueue a burst of frames for the same VAP so that
+ * the datapath can update the TCL ring once for the whole burst
+ *
+ * Return: NULL on success, chain of nbufs that could not be sent
+ */
+static inline qdf_nbuf_t
+cdp_tx_send_list(ol_txrx_soc_handle soc, uint8_t vdev_id,
+		 qdf_nbuf_t nbuf_list)
+{
+	if (!soc || !soc->ops) {
+		QDF_TRACE(QDF_MODULE_ID_CDP, QDF_TRACE_LEVEL_DEBUG,
+			  "%s: Invalid Instance:", __func__);
+		QDF_BUG(0);
+		return nbuf_list;
+	}
+
+	if (!soc->ops->cmn_drv_ops ||
+	    !soc->ops->cmn_drv_ops->tx_send_list)
+		return nbuf_list;
+
+	return soc->ops->cmn_drv_ops->tx_send_list(soc, vdev_id, nbuf_list);
+}
+
 /**
  * cdp_set_pdev_pcp_tid_map() - set pdev pcp-tid-map
  * @soc: opaque soc handle
@@ -227,6 +227,9 @@ enum {
  *  mointor status and monitor destination ring
  * @status_ppdu_drop: Number of ppdu dropped from monitor status ring
  * @dest_ppdu_drop: Number of ppdu dropped from monitor destination ring
+ * @restitch_frag_mpdu: MPDUs restitched with MSDU payloads as page fragments
+ * @restitch_frag_fallback: MPDUs restitched by copy as an MSDU could not be
+ *  attached as a page fragment
  */
 struct cdp_pdev_mon_stats {
 #ifndef REMOVE_MON_DBG_STATS
@@ -254,5 +257,7 @@ struct cdp_pdev_mon_stats {
 	uint32_t ppdu_id_match;
 	uint32_t status_ppdu_drop;
 	uint32_t dest_ppdu_drop;
+	uint32_t restitch_frag_mpdu;
+	uint32_t restitch_frag_fallback;
 };
 #endif
@@ -1672,6 +1672,9 @@ struct cdp_cfr_rcc_stats {
  * @tx_ppdu_proc: stats counter for tx ppdu processed
  * @ack_ba_comes_twice: stats counter for ack_ba_comes twice
  * @ppdu_drop: stats counter for ppdu_desc drop once threshold reached
+ * @ppdu_info_reuse: ppdu_info served from the pre-allocated slab
+ * @ppdu_info_heap_alloc: ppdu_info allocated from the heap
+ * @ppdu_desc_reuse: ppdu desc nbuf reused from a dropped ppdu
  */
 struct cdp_pdev_stats {
 	struct {
@@ -1738,6 +1741,9 @@ struct cdp_pdev_stats {
 	uint64_t tx_ppdu_proc;
 	uint64_t ack_ba_comes_twice;
 	uint64_t ppdu_drop;
+	uint64_t ppdu_info_reuse;
+	uint64_t ppdu_info_heap_alloc;
+	uint64_t ppdu_desc_reuse;
 };
 
 enum cdp_soc_param_t {
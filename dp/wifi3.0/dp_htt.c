@@ -3389,6 +3389,268 @@ dp_ppdu_desc_user_stats_update(struct dp_pdev *pdev,
 	}
 }
 
+#ifndef WLAN_TX_PKT_CAPTURE_ENH
+/**
+ * dp_ppdu_info_hash_bucket(): Get the hash bucket of a ppdu_id
+ * @pdev: DP pdev handle
+ * @ppdu_id: PPDU unique identifier
+ *
+ * return: pointer to the head of the bucket
+ */
+static inline
+struct ppdu_info **dp_ppdu_info_hash_bucket(struct dp_pdev *pdev,
+					    uint32_t ppdu_id)
+{
+	return &pdev->ppdu_info_hash[ppdu_id & (DP_PPDU_INFO_HASH_SIZE - 1)];
+}
+
+/**
+ * dp_ppdu_info_find(): Find the pending ppdu_info of a ppdu_id
+ * @pdev: DP pdev handle
+ * @ppdu_id: PPDU unique identifier
+ *
+ * return: ppdu_info if found, NULL otherwise
+ */
+static inline
+struct ppdu_info *dp_ppdu_info_find(struct dp_pdev *pdev, uint32_t ppdu_id)
+{
+	struct ppdu_info *ppdu_info = *dp_ppdu_info_hash_bucket(pdev, ppdu_id);
+
+	while (ppdu_info && ppdu_info->ppdu_id != ppdu_id)
+		ppdu_info = ppdu_info->hash_next;
+
+	return ppdu_info;
+}
+
+/**
+ * dp_ppdu_info_hash_add(): Index a ppdu_info by its ppdu_id
+ * @pdev: DP pdev handle
+ * @ppdu_info: per PPDU TLV descriptor
+ *
+ * return: void
+ */
+static inline
+void dp_ppdu_info_hash_add(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+	struct ppdu_info **bucket = dp_ppdu_info_hash_bucket(pdev,
+							      ppdu_info->ppdu_id);
+
+	ppdu_info->hash_next = *bucket;
+	*bucket = ppdu_info;
+}
+
+/**
+ * dp_ppdu_info_hash_del(): Remove a ppdu_info from the ppdu_id index
+ * @pdev: DP pdev handle
+ * @ppdu_info: per PPDU TLV descriptor
+ *
+ * return: void
+ */
+static inline
+void dp_ppdu_info_hash_del(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+	struct ppdu_info **prev = dp_ppdu_info_hash_bucket(pdev,
+							    ppdu_info->ppdu_id);
+
+	while (*prev && *prev != ppdu_info)
+		prev = &(*prev)->hash_next;
+
+	if (*prev)
+		*prev = ppdu_info->hash_next;
+
+	ppdu_info->hash_next = NULL;
+}
+
+/**
+ * dp_ppdu_info_alloc(): Allocate a zeroed ppdu_info, from the slab if
+ *			 an entry is free
+ * @pdev: DP pdev handle
+ *
+ * return: ppdu_info on success, NULL otherwise
+ */
+static inline struct ppdu_info *dp_ppdu_info_alloc(struct dp_pdev *pdev)
+{
+	struct ppdu_info *ppdu_info = pdev->ppdu_info_freelist;
+
+	if (qdf_likely(ppdu_info)) {
+		pdev->ppdu_info_freelist = ppdu_info->hash_next;
+		qdf_mem_zero(ppdu_info, sizeof(*ppdu_info));
+		pdev->stats.ppdu_info_reuse++;
+		return ppdu_info;
+	}
+
+	pdev->stats.ppdu_info_heap_alloc++;
+	return qdf_mem_malloc(sizeof(*ppdu_info));
+}
+
+/**
+ * dp_ppdu_info_free(): Release a ppdu_info to the slab or to the heap
+ * @pdev: DP pdev handle
+ * @ppdu_info: per PPDU TLV descriptor
+ *
+ * return: void
+ */
+static inline
+void dp_ppdu_info_free(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+	if (pdev->ppdu_info_slab && ppdu_info >= pdev->ppdu_info_slab &&
+	    ppdu_info < pdev->ppdu_info_slab + DP_PPDU_INFO_SLAB_SIZE) {
+		ppdu_info->hash_next = pdev->ppdu_info_freelist;
+		pdev->ppdu_info_freelist = ppdu_info;
+		return;
+	}
+
+	qdf_mem_free(ppdu_info);
+}
+
+void dp_htt_ppdu_info_pool_attach(struct dp_pdev *pdev)
+{
+	uint32_t i;
+
+	qdf_mem_zero(pdev->ppdu_info_hash, sizeof(pdev->ppdu_info_hash));
+	pdev->ppdu_info_freelist = NULL;
+	pdev->ppdu_info_slab = qdf_mem_malloc(DP_PPDU_INFO_SLAB_SIZE *
+					      sizeof(struct ppdu_info));
+	if (!pdev->ppdu_info_slab) {
+		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_WARN,
+			  "ppdu_info slab alloc fail, using heap");
+		return;
+	}
+
+	for (i = 0; i < DP_PPDU_INFO_SLAB_SIZE; i++)
+		dp_ppdu_info_free(pdev, &pdev->ppdu_info_slab[i]);
+}
+#else
+static inline
+struct ppdu_info *dp_ppdu_info_find(struct dp_pdev *pdev, uint32_t ppdu_id)
+{
+	struct ppdu_info *ppdu_info;
+
+	TAILQ_FOREACH(ppdu_info, &pdev->ppdu_info_list, ppdu_info_list_elem) {
+		if (ppdu_info->ppdu_id == ppdu_id)
+			break;
+	}
+
+	return ppdu_info;
+}
+
+static inline
+void dp_ppdu_info_hash_add(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+}
+
+static inline
+void dp_ppdu_info_hash_del(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+}
+
+/*
+ * ppdu_info entries are handed over to and released by the tx capture
+ * module, hence they are always allocated from the heap
+ */
+static inline struct ppdu_info *dp_ppdu_info_alloc(struct dp_pdev *pdev)
+{
+	pdev->stats.ppdu_info_heap_alloc++;
+	return qdf_mem_malloc(sizeof(struct ppdu_info));
+}
+
+static inline
+void dp_ppdu_info_free(struct dp_pdev *pdev, struct ppdu_info *ppdu_info)
+{
+	qdf_mem_free(ppdu_info);
+}
+
+void dp_htt_ppdu_info_pool_attach(struct dp_pdev *pdev)
+{
+}
+#endif /* WLAN_TX_PKT_CAPTURE_ENH */
+
+/**
+ * dp_ppdu_desc_nbuf_alloc(): Get a zeroed ppdu descriptor nbuf, reusing
+ *			      the nbuf of a dropped ppdu if one is cached
+ * @pdev: DP pdev handle
+ *
+ * return: nbuf holding a struct cdp_tx_completion_ppdu, NULL on failure
+ */
+static qdf_nbuf_t dp_ppdu_desc_nbuf_alloc(struct dp_pdev *pdev)
+{
+	qdf_nbuf_t nbuf;
+
+	if (pdev->ppdu_desc_nbuf_cache_cnt) {
+		nbuf = pdev->ppdu_desc_nbuf_cache[
+				--pdev->ppdu_desc_nbuf_cache_cnt];
+		qdf_mem_zero(qdf_nbuf_data(nbuf),
+			     sizeof(struct cdp_tx_completion_ppdu));
+		pdev->stats.ppdu_desc_reuse++;
+		return nbuf;
+	}
+
+	nbuf = qdf_nbuf_alloc(pdev->soc->osdev,
+			      sizeof(struct cdp_tx_completion_ppdu), 0, 4,
+			      TRUE);
+	if (!nbuf)
+		return NULL;
+
+	qdf_mem_zero(qdf_nbuf_data(nbuf),
+		     sizeof(struct cdp_tx_completion_ppdu));
+
+	if (!qdf_nbuf_put_tail(nbuf, sizeof(struct cdp_tx_completion_ppdu))) {
+		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_ERROR,
+			  "No tailroom for HTT PPDU");
+		qdf_nbuf_free(nbuf);
+		return NULL;
+	}
+
+	return nbuf;
+}
+
+/**
+ * dp_ppdu_desc_nbuf_free(): Release a ppdu descriptor nbuf which was not
+ *			     delivered to the upper layer
+ * @pdev: DP pdev handle
+ * @nbuf: ppdu descriptor nbuf
+ *
+ * return: void
+ */
+static void dp_ppdu_desc_nbuf_free(struct dp_pdev *pdev, qdf_nbuf_t nbuf)
+{
+	if (pdev->ppdu_desc_nbuf_cache_cnt < DP_PPDU_DESC_NBUF_CACHE_SIZE) {
+		pdev->ppdu_desc_nbuf_cache[
+			pdev->ppdu_desc_nbuf_cache_cnt++] = nbuf;
+		return;
+	}
+
+	qdf_nbuf_free(nbuf);
+}
+
+void dp_htt_ppdu_info_pool_detach(struct dp_pdev *pdev)
+{
+	struct ppdu_info *ppdu_info, *ppdu_info_next;
+
+	TAILQ_FOREACH_SAFE(ppdu_info, &pdev->ppdu_info_list,
+			   ppdu_info_list_elem, ppdu_info_next) {
+		TAILQ_REMOVE(&pdev->ppdu_info_list, ppdu_info,
+			     ppdu_info_list_elem);
+		dp_ppdu_info_hash_del(pdev, ppdu_info);
+		qdf_assert_always(ppdu_info->nbuf);
+		qdf_nbuf_free(ppdu_info->nbuf);
+		dp_ppdu_info_free(pdev, ppdu_info);
+	}
+	pdev->list_depth = 0;
+
+	while (pdev->ppdu_desc_nbuf_cache_cnt)
+		qdf_nbuf_free(pdev->ppdu_desc_nbuf_cache[
+				--pdev->ppdu_desc_nbuf_cache_cnt]);
+
+#ifndef WLAN_TX_PKT_CAPTURE_ENH
+	pdev->ppdu_info_freelist = NULL;
+	if (pdev->ppdu_info_slab) {
+		qdf_mem_free(pdev->ppdu_info_slab);
+		pdev->ppdu_info_slab = NULL;
+	}
+#endif
+}
+
 #ifndef WLAN_TX_PKT_CAPTURE_ENH
 
 /**
@@ -3415,9 +3677,10 @@ void dp_ppdu_desc_deliver(struct dp_pdev *pdev,
 	 * Remove from the list
 	 */
 	TAILQ_REMOVE(&pdev->ppdu_info_list, ppdu_info, ppdu_info_list_elem);
+	dp_ppdu_info_hash_del(pdev, ppdu_info);
 	nbuf = ppdu_info->nbuf;
 	pdev->list_depth--;
-	qdf_mem_free(ppdu_info);
+	dp_ppdu_info_free(pdev, ppdu_info);
 
 	qdf_assert_always(nbuf);
 
@@ -3442,7 +3705,7 @@ void dp_ppdu_desc_deliver(struct dp_pdev *pdev,
 					pdev->soc, nbuf, HTT_INVALID_PEER,
 					WDI_NO_VAL, pdev->pdev_id);
 		} else
-			qdf_nbuf_free(nbuf);
+			dp_ppdu_desc_nbuf_free(pdev, nbuf);
 	}
 	return;
 }
@@ -3468,12 +3731,7 @@ struct ppdu_info *dp_get_ppdu_desc(struct dp_pdev *pdev, uint32_t ppdu_id,
 	/*
 	 * Find ppdu_id node exists or not
 	 */
-	TAILQ_FOREACH(ppdu_info, &pdev->ppdu_info_list, ppdu_info_list_elem) {
-
-		if (ppdu_info && (ppdu_info->ppdu_id == ppdu_id)) {
-			break;
-		}
-	}
+	ppdu_info = dp_ppdu_info_find(pdev, ppdu_id);
 
 	if (ppdu_info) {
 		if (ppdu_info->tlv_bitmap & (1 << tlv_type)) {
@@ -3518,42 +3776,29 @@ struct ppdu_info *dp_get_ppdu_desc(struct dp_pdev *pdev, uint32_t ppdu_id,
 		TAILQ_REMOVE(&pdev->ppdu_info_list,
 			     ppdu_info, ppdu_info_list_elem);
 		pdev->list_depth--;
+		dp_ppdu_info_hash_del(pdev, ppdu_info);
 		pdev->stats.ppdu_drop++;
-		qdf_nbuf_free(ppdu_info->nbuf);
+		dp_ppdu_desc_nbuf_free(pdev, ppdu_info->nbuf);
 		ppdu_info->nbuf = NULL;
-		qdf_mem_free(ppdu_info);
+		dp_ppdu_info_free(pdev, ppdu_info);
 	}
 
 	/*
 	 * Allocate new ppdu_info node
 	 */
-	ppdu_info = qdf_mem_malloc(sizeof(struct ppdu_info));
+	ppdu_info = dp_ppdu_info_alloc(pdev);
 	if (!ppdu_info)
 		return NULL;
 
-	ppdu_info->nbuf = qdf_nbuf_alloc(pdev->soc->osdev,
-			sizeof(struct cdp_tx_completion_ppdu), 0, 4,
-			TRUE);
+	ppdu_info->nbuf = dp_ppdu_desc_nbuf_alloc(pdev);
 	if (!ppdu_info->nbuf) {
-		qdf_mem_free(ppdu_info);
+		dp_ppdu_info_free(pdev, ppdu_info);
 		return NULL;
 	}
 
 	ppdu_info->ppdu_desc =
 		(struct cdp_tx_completion_ppdu *)qdf_nbuf_data(ppdu_info->nbuf);
-	qdf_mem_zero(qdf_nbuf_data(ppdu_info->nbuf),
-			sizeof(struct cdp_tx_completion_ppdu));
-
-	if (qdf_nbuf_put_tail(ppdu_info->nbuf,
-			sizeof(struct cdp_tx_completion_ppdu)) == NULL) {
-		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_ERROR,
-				"No tailroom for HTT PPDU");
-		qdf_nbuf_free(ppdu_info->nbuf);
-		ppdu_info->nbuf = NULL;
-		ppdu_info->last_user = 0;
-		qdf_mem_free(ppdu_info);
-		return NULL;
-	}
+	ppdu_info->ppdu_id = ppdu_id;
 
 	/**
 	 * No lock is needed because all PPDU TLVs are processed in
@@ -3561,6 +3806,7 @@ struct ppdu_info *dp_get_ppdu_desc(struct dp_pdev *pdev, uint32_t ppdu_id,
 	 */
 	TAILQ_INSERT_TAIL(&pdev->ppdu_info_list, ppdu_info,
 			ppdu_info_list_elem);
+	dp_ppdu_info_hash_add(pdev, ppdu_info);
 	pdev->list_depth++;
 	return ppdu_info;
 }
@@ -3780,6 +4026,14 @@ static struct ppdu_info *dp_htt_process_tlv(struct dp_pdev *pdev,
 
 	return NULL;
 }
+#else
+void dp_htt_ppdu_info_pool_attach(struct dp_pdev *pdev)
+{
+}
+
+void dp_htt_ppdu_info_pool_detach(struct dp_pdev *pdev)
+{
+}
 #endif /* FEATURE_PERPKT_INFO */
 
 /**
@@ -95,6 +95,8 @@ void htt_htc_pkt_pool_free(struct htt_soc *soc);
 
 #define HTT_FRAMECTRL_DATATYPE 0x08
 #define HTT_PPDU_DESC_MAX_DEPTH 16
+/* list depth is trimmed to HTT_PPDU_DESC_MAX_DEPTH before an insertion */
+#define DP_PPDU_INFO_SLAB_SIZE (HTT_PPDU_DESC_MAX_DEPTH + 1)
 #define DP_SCAN_PEER_ID 0xFFFF
 
 #define HTT_RX_DELBA_WIN_SIZE_M    0x0000FC00
@@ -444,6 +446,26 @@ void
 dp_ppdu_desc_user_stats_update(struct dp_pdev *pdev,
 			       struct ppdu_info *ppdu_info);
 
+/**
+ * dp_htt_ppdu_info_pool_attach(): Allocate the ppdu_info slab of a pdev
+ * @pdev: DP pdev handle
+ *
+ * A failure to allocate the slab is not fatal, ppdu_info entries are then
+ * allocated from the heap.
+ *
+ * return: void
+ */
+void dp_htt_ppdu_info_pool_attach(struct dp_pdev *pdev);
+
+/**
+ * dp_htt_ppdu_info_pool_detach(): Free the pending PPDU descriptors and
+ *				   the ppdu_info slab of a pdev
+ * @pdev: DP pdev handle
+ *
+ * return: void
+ */
+void dp_htt_ppdu_info_pool_detach(struct dp_pdev *pdev);
+
 /**
  * dp_htt_rx_flow_fst_setup(): Send HTT Rx FST setup message to FW
  * @pdev: DP pdev handle
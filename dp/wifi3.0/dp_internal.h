@@ -243,6 +243,137 @@ while (0)
 #define DP_STATS_AGGR_PKT(_handle_a, _handle_b, _field)
 #endif
 
+/*
+ * Hot datapath counters are written to per-CPU vdev and peer shards and
+ * folded into vdev->stats/peer->stats only when stats are requested, see
+ * dp_vdev_stats_shard_sync() and dp_peer_stats_shard_sync(). The fold
+ * takes the soc wide stats_shard_lock, so it must not be called per packet
+ * or per PPDU: the per-packet WDI_EVENT_UPDATE_DP_STATS updates publish
+ * peer->stats with the sharded counters as of the last stats request.
+ */
+#ifdef QCA_DP_PCPU_STATS
+/**
+ * dp_stats_shard_cpu_get() - Pin the caller to the current CPU for a shard
+ *			      update
+ *
+ * Bottom halves stay disabled until dp_stats_shard_cpu_put(), so nothing
+ * else can write the shard of the returned CPU in between.
+ *
+ * Return: shard index of the current CPU, -1 if the CPU has no shard
+ */
+static inline int dp_stats_shard_cpu_get(void)
+{
+	int cpu;
+
+	qdf_local_bh_disable();
+	cpu = qdf_get_cpu();
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU))
+		return -1;
+
+	return cpu;
+}
+
+/**
+ * dp_stats_shard_cpu_put() - Release the CPU taken by dp_stats_shard_cpu_get()
+ *
+ * Return: None
+ */
+static inline void dp_stats_shard_cpu_put(void)
+{
+	qdf_local_bh_enable();
+}
+
+#define DP_VDEV_SHARD_STATS_INC_PKT(_vdev, _field, _count, _bytes) \
+{ \
+	int _cpu = dp_stats_shard_cpu_get(); \
+	if (qdf_likely(_cpu >= 0)) { \
+		_vdev->stats_shard[_cpu].cur._field.num += _count; \
+		_vdev->stats_shard[_cpu].cur._field.bytes += _bytes; \
+	} else { \
+		DP_STATS_INC_PKT(_vdev, tx_i._field, _count, _bytes); \
+	} \
+	dp_stats_shard_cpu_put(); \
+}
+
+#define DP_PEER_RX_SHARD_STATS_RCVD(_peer, _ring, _bytes) \
+{ \
+	int _cpu = dp_stats_shard_cpu_get(); \
+	if (qdf_likely(_cpu >= 0)) { \
+		_peer->rx_shard[_cpu].cur.rcvd_reo[_ring].num += 1; \
+		_peer->rx_shard[_cpu].cur.rcvd_reo[_ring].bytes += _bytes; \
+	} else { \
+		DP_STATS_INC_PKT(_peer, rx.rcvd_reo[_ring], 1, _bytes); \
+	} \
+	dp_stats_shard_cpu_put(); \
+}
+
+#define DP_PEER_RX_SHARD_STATS_INCC(_peer, _field, _delta, _cond) \
+{ \
+	if (_cond) { \
+		int _cpu = dp_stats_shard_cpu_get(); \
+		if (qdf_likely(_cpu >= 0)) \
+			_peer->rx_shard[_cpu].cur._field += _delta; \
+		else \
+			DP_STATS_INC(_peer, rx._field, _delta); \
+		dp_stats_shard_cpu_put(); \
+	} \
+}
+
+#define DP_PEER_RX_SHARD_STATS_INC_PKT(_peer, _field, _count, _bytes) \
+{ \
+	int _cpu = dp_stats_shard_cpu_get(); \
+	if (qdf_likely(_cpu >= 0)) { \
+		_peer->rx_shard[_cpu].cur._field.num += _count; \
+		_peer->rx_shard[_cpu].cur._field.bytes += _bytes; \
+	} else { \
+		DP_STATS_INC_PKT(_peer, rx._field, _count, _bytes); \
+	} \
+	dp_stats_shard_cpu_put(); \
+}
+
+#define DP_PEER_TX_SHARD_STATS_INCC(_peer, _field, _delta, _cond) \
+{ \
+	if (_cond) { \
+		int _cpu = dp_stats_shard_cpu_get(); \
+		if (qdf_likely(_cpu >= 0)) \
+			_peer->tx_shard[_cpu].cur._field += _delta; \
+		else \
+			DP_STATS_INC(_peer, tx._field, _delta); \
+		dp_stats_shard_cpu_put(); \
+	} \
+}
+
+#define DP_PEER_TX_SHARD_STATS_INC_PKT(_peer, _field, _count, _bytes) \
+{ \
+	int _cpu = dp_stats_shard_cpu_get(); \
+	if (qdf_likely(_cpu >= 0)) { \
+		_peer->tx_shard[_cpu].cur._field.num += _count; \
+		_peer->tx_shard[_cpu].cur._field.bytes += _bytes; \
+	} else { \
+		DP_STATS_INC_PKT(_peer, tx._field, _count, _bytes); \
+	} \
+	dp_stats_shard_cpu_put(); \
+}
+#else
+#define DP_VDEV_SHARD_STATS_INC_PKT(_vdev, _field, _count, _bytes) \
+	DP_STATS_INC_PKT(_vdev, tx_i._field, _count, _bytes)
+
+#define DP_PEER_RX_SHARD_STATS_RCVD(_peer, _ring, _bytes) \
+	DP_STATS_INC_PKT(_peer, rx.rcvd_reo[_ring], 1, _bytes)
+
+#define DP_PEER_RX_SHARD_STATS_INCC(_peer, _field, _delta, _cond) \
+	DP_STATS_INCC(_peer, rx._field, _delta, _cond)
+
+#define DP_PEER_RX_SHARD_STATS_INC_PKT(_peer, _field, _count, _bytes) \
+	DP_STATS_INC_PKT(_peer, rx._field, _count, _bytes)
+
+#define DP_PEER_TX_SHARD_STATS_INCC(_peer, _field, _delta, _cond) \
+	DP_STATS_INCC(_peer, tx._field, _delta, _cond)
+
+#define DP_PEER_TX_SHARD_STATS_INC_PKT(_peer, _field, _count, _bytes) \
+	DP_STATS_INC_PKT(_peer, tx._field, _count, _bytes)
+#endif
+
 #ifdef ENABLE_DP_HIST_STATS
 #define DP_HIST_INIT() \
 	uint32_t num_of_packets[MAX_PDEV_CNT] = {0};
@@ -1147,6 +1278,34 @@ extern void dp_reo_cmdlist_destroy(struct dp_soc *soc);
  */
 uint32_t dp_reo_status_ring_handler(struct dp_intr *int_ctx,
 				    struct dp_soc *soc);
+#ifdef QCA_DP_PCPU_STATS
+/**
+ * dp_vdev_stats_shard_sync() - Fold per-CPU vdev stats shards into
+ *				vdev->stats
+ * @vdev: DP vdev handle
+ *
+ * Return: None
+ */
+void dp_vdev_stats_shard_sync(struct dp_vdev *vdev);
+
+/**
+ * dp_peer_stats_shard_sync() - Fold per-CPU peer stats shards into
+ *				peer->stats
+ * @peer: DP peer handle
+ *
+ * Return: None
+ */
+void dp_peer_stats_shard_sync(struct dp_peer *peer);
+#else
+static inline void dp_vdev_stats_shard_sync(struct dp_vdev *vdev)
+{
+}
+
+static inline void dp_peer_stats_shard_sync(struct dp_peer *peer)
+{
+}
+#endif
+
 void dp_aggregate_vdev_stats(struct dp_vdev *vdev,
 			     struct cdp_vdev_stats *vdev_stats);
 void dp_rx_tid_stats_cb(struct dp_soc *soc, void *cb_ctxt,
@@ -113,10 +113,14 @@ static QDF_STATUS __dp_ipa_handle_buf_smmu_mapping(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 }
 
-QDF_STATUS dp_ipa_handle_rx_buf_smmu_mapping(struct dp_soc *soc,
-					     qdf_nbuf_t nbuf,
-					     uint32_t size,
-					     bool create)
+/**
+ * dp_ipa_rx_buf_smmu_mapping_needed() - Check if Rx buffers need IPA SMMU
+ *					  map/unmap
+ * @soc: data path soc handle
+ *
+ * Return: true if Rx buffer IPA SMMU mappings must be maintained
+ */
+static bool dp_ipa_rx_buf_smmu_mapping_needed(struct dp_soc *soc)
 {
 	struct dp_pdev *pdev;
 	int i;
@@ -124,19 +128,71 @@ QDF_STATUS dp_ipa_handle_rx_buf_smmu_mapping(struct dp_soc *soc,
 	for (i = 0; i < soc->pdev_count; i++) {
 		pdev = soc->pdev_list[i];
 		if (pdev && pdev->monitor_configured)
-			return QDF_STATUS_SUCCESS;
+			return false;
 	}
 
 	if (!wlan_cfg_is_ipa_enabled(soc->wlan_cfg_ctx) ||
 	    !qdf_mem_smmu_s1_enabled(soc->osdev))
-		return QDF_STATUS_SUCCESS;
+		return false;
 
 	if (!qdf_atomic_read(&soc->ipa_pipes_enabled))
+		return false;
+
+	return true;
+}
+
+QDF_STATUS dp_ipa_handle_rx_buf_smmu_mapping(struct dp_soc *soc,
+					     qdf_nbuf_t nbuf,
+					     uint32_t size,
+					     bool create)
+{
+	if (!dp_ipa_rx_buf_smmu_mapping_needed(soc))
 		return QDF_STATUS_SUCCESS;
 
 	return __dp_ipa_handle_buf_smmu_mapping(soc, nbuf, size, create);
 }
 
+/* Rx buffers passed to IPA per SMMU map/unmap call */
+#define DP_IPA_SMMU_MAP_BATCH 16
+
+QDF_STATUS dp_ipa_handle_rx_buf_list_smmu_mapping(struct dp_soc *soc,
+						  qdf_nbuf_t nbuf_list,
+						  uint32_t size,
+						  bool create)
+{
+	qdf_mem_info_t mem_map_table[DP_IPA_SMMU_MAP_BATCH];
+	qdf_nbuf_t nbuf;
+	uint32_t num = 0;
+
+	if (!dp_ipa_rx_buf_smmu_mapping_needed(soc))
+		return QDF_STATUS_SUCCESS;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = qdf_nbuf_next(nbuf)) {
+		qdf_mem_zero(&mem_map_table[num], sizeof(mem_map_table[0]));
+		qdf_update_mem_map_table(soc->osdev, &mem_map_table[num],
+					 qdf_nbuf_get_frag_paddr(nbuf, 0),
+					 size);
+		if (++num < DP_IPA_SMMU_MAP_BATCH)
+			continue;
+
+		if (create)
+			qdf_ipa_wdi_create_smmu_mapping(num, mem_map_table);
+		else
+			qdf_ipa_wdi_release_smmu_mapping(num, mem_map_table);
+		num = 0;
+	}
+
+	if (!num)
+		return QDF_STATUS_SUCCESS;
+
+	if (create)
+		qdf_ipa_wdi_create_smmu_mapping(num, mem_map_table);
+	else
+		qdf_ipa_wdi_release_smmu_mapping(num, mem_map_table);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 #ifdef RX_DESC_MULTI_PAGE_ALLOC
 static QDF_STATUS dp_ipa_handle_rx_buf_pool_smmu_mapping(struct dp_soc *soc,
 							 struct dp_pdev *pdev,
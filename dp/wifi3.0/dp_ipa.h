@@ -242,6 +242,24 @@ QDF_STATUS dp_ipa_handle_rx_buf_smmu_mapping(struct dp_soc *soc,
 					     uint32_t size,
 					     bool create);
 
+/**
+ * dp_ipa_handle_rx_buf_list_smmu_mapping() - Create or release IPA SMMU
+ *					       mappings of a list of Rx buffers
+ * @soc: data path soc handle
+ * @nbuf_list: nbufs linked through qdf_nbuf_next()
+ * @size: mapped size of each buffer
+ * @create: true to create the mappings, false to release them
+ *
+ * The IPA enable/monitor checks are done once and buffers are handed to
+ * IPA in batches instead of one call per buffer.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_ipa_handle_rx_buf_list_smmu_mapping(struct dp_soc *soc,
+						  qdf_nbuf_t nbuf_list,
+						  uint32_t size,
+						  bool create);
+
 bool dp_reo_remap_config(struct dp_soc *soc, uint32_t *remap1,
 			 uint32_t *remap2);
 bool dp_ipa_is_mdm_platform(void);
@@ -274,6 +292,15 @@ static inline QDF_STATUS dp_ipa_handle_rx_buf_smmu_mapping(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 }
 
+static inline QDF_STATUS
+dp_ipa_handle_rx_buf_list_smmu_mapping(struct dp_soc *soc,
+				       qdf_nbuf_t nbuf_list,
+				       uint32_t size,
+				       bool create)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
 static inline qdf_nbuf_t dp_ipa_handle_rx_reo_reinject(struct dp_soc *soc,
 						       qdf_nbuf_t nbuf)
 {
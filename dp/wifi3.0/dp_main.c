@@ -88,6 +88,19 @@ cdp_dump_flow_pool_info(struct cdp_soc_t *soc)
 #define DEINIT_RX_HW_STATS_LOCK(_soc) /* no op */
 #endif
 
+#ifdef QCA_DP_PCPU_STATS
+#define INIT_STATS_SHARD_LOCK(_soc) \
+	qdf_spinlock_create(&(_soc)->stats_shard_lock)
+#define DEINIT_STATS_SHARD_LOCK(_soc) \
+	qdf_spinlock_destroy(&(_soc)->stats_shard_lock)
+#define DP_STATS_SHARDS_INIT(_handle, _shards) \
+	qdf_mem_zero((_handle)->_shards, sizeof((_handle)->_shards))
+#else
+#define INIT_STATS_SHARD_LOCK(_soc)  /* no op */
+#define DEINIT_STATS_SHARD_LOCK(_soc) /* no op */
+#define DP_STATS_SHARDS_INIT(_handle, _shards) /* no op */
+#endif
+
 #ifdef DP_PEER_EXTENDED_API
 #define SET_PEER_REF_CNT_ONE(_peer) \
 	qdf_atomic_set(&(_peer)->ref_cnt, 1)
@@ -1220,9 +1233,11 @@ void dp_print_ast_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("	Entries Mismatch ERR  = %d",
 		       soc->stats.ast.ast_mismatch);
 
+	qdf_spin_lock_bh(&soc->ast_lock);
+	dp_print_ast_hash_stats(soc);
+
 	DP_PRINT_STATS("AST Table:");
 
-	qdf_spin_lock_bh(&soc->ast_lock);
 	for (i = 0; i < MAX_PDEV_CNT && soc->pdev_list[i]; i++) {
 		pdev = soc->pdev_list[i];
 		qdf_spin_lock_bh(&pdev->vdev_list_lock);
@@ -1277,6 +1292,11 @@ static void dp_print_peer_table(struct dp_vdev *vdev)
 {
 	struct dp_peer *peer = NULL;
 
+	DP_PRINT_STATS("Peer find lock acquired = %u contended = %u lockless del race = %u",
+		       vdev->pdev->soc->stats.peer_find.lock_acquired,
+		       vdev->pdev->soc->stats.peer_find.lock_contended,
+		       qdf_atomic_read(&vdev->pdev->soc->stats.peer_find.
+				       rcu_del_race));
 	DP_PRINT_STATS("Dumping Peer Table  Stats:");
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (!peer) {
@@ -1697,6 +1717,207 @@ budget_done:
 	return total_budget - budget;
 }
 
+#ifdef DP_INTR_ADAPTIVE_MODERATION
+/* Polls per moderation decision window */
+#define DP_INTR_MOD_WINDOW_POLLS 64
+/* Average gap between polls above which traffic is treated as idle */
+#define DP_INTR_MOD_IDLE_GAP_US 10000
+
+/**
+ * dp_intr_mod_init() - Reset adaptive interrupt moderation state
+ * @int_ctx: DP interrupt context
+ *
+ * Rings start with the static thresholds from wlan_cfg, the first
+ * decision window programs the selected profile. The first window starts
+ * when the interrupt context is attached.
+ *
+ * Return: None
+ */
+static void dp_intr_mod_init(struct dp_intr *int_ctx)
+{
+	qdf_mem_zero(&int_ctx->intr_mod, sizeof(int_ctx->intr_mod));
+	int_ctx->intr_mod.window_start_us =
+		qdf_log_timestamp_to_usecs(qdf_get_log_timestamp());
+}
+
+/**
+ * dp_intr_mod_profile_get() - Get thresholds of a moderation profile
+ * @soc: DP soc handle
+ * @profile: profile index
+ * @timer_us: timer threshold in us
+ * @batch_cnt: batch counter threshold in entries
+ *
+ * Return: None
+ */
+static void dp_intr_mod_profile_get(struct dp_soc *soc, uint8_t profile,
+				    uint32_t *timer_us, uint32_t *batch_cnt)
+{
+	struct wlan_cfg_dp_soc_ctxt *cfg = soc->wlan_cfg_ctx;
+	uint32_t tmin = wlan_cfg_get_intr_mod_timer_min(cfg);
+	uint32_t tmax = wlan_cfg_get_intr_mod_timer_max(cfg);
+	uint32_t bmin = wlan_cfg_get_intr_mod_batch_min(cfg);
+	uint32_t bmax = wlan_cfg_get_intr_mod_batch_max(cfg);
+
+	if (tmax < tmin)
+		tmax = tmin;
+	if (bmax < bmin)
+		bmax = bmin;
+
+	*timer_us = tmin + ((tmax - tmin) * profile) /
+			   (DP_INTR_MOD_NUM_PROFILES - 1);
+	*batch_cnt = bmin + ((bmax - bmin) * profile) /
+			    (DP_INTR_MOD_NUM_PROFILES - 1);
+}
+
+/**
+ * dp_intr_mod_apply() - Program a moderation profile to the rings of an
+ *			 interrupt context
+ * @int_ctx: DP interrupt context
+ * @profile: profile index
+ *
+ * Only the Tx completion and REO destination rings are moderated. The
+ * threshold registers are written from the poll context, so the update is
+ * skipped while the target is runtime suspended and retried at the end of
+ * the next decision window.
+ *
+ * Return: true if the profile was programmed
+ */
+static bool dp_intr_mod_apply(struct dp_intr *int_ctx, uint8_t profile)
+{
+	struct dp_soc *soc = int_ctx->soc;
+	uint32_t timer_us, batch_cnt;
+	int ring;
+
+	if (hif_pm_runtime_get(soc->hif_handle, RTPM_ID_DP_INTR_MOD))
+		return false;
+
+	dp_intr_mod_profile_get(soc, profile, &timer_us, &batch_cnt);
+
+	for (ring = 0; ring < MAX_TCL_DATA_RINGS; ring++) {
+		if (!(int_ctx->tx_ring_mask & (1 << ring)) ||
+		    !soc->tx_comp_ring[ring].hal_srng)
+			continue;
+		hal_srng_dst_set_intr_thres(soc->hal_soc,
+					    soc->tx_comp_ring[ring].hal_srng,
+					    timer_us, batch_cnt);
+	}
+
+	for (ring = 0; ring < soc->num_reo_dest_rings; ring++) {
+		if (!(int_ctx->rx_ring_mask & (1 << ring)) ||
+		    !soc->reo_dest_ring[ring].hal_srng)
+			continue;
+		hal_srng_dst_set_intr_thres(soc->hal_soc,
+					    soc->reo_dest_ring[ring].hal_srng,
+					    timer_us, batch_cnt);
+	}
+
+	hif_pm_runtime_put(soc->hif_handle, RTPM_ID_DP_INTR_MOD);
+
+	return true;
+}
+
+/**
+ * dp_intr_mod_update() - Account a poll and retune moderation
+ * @int_ctx: DP interrupt context
+ * @work_done: entries processed in this poll
+ *
+ * At the end of each window of DP_INTR_MOD_WINDOW_POLLS polls the profile
+ * is stepped up when polls average more than twice the batch threshold,
+ * stepped down when they average less than half of it, and dropped to the
+ * lowest latency profile when polls are further apart than
+ * DP_INTR_MOD_IDLE_GAP_US.
+ *
+ * Return: None
+ */
+static void dp_intr_mod_update(struct dp_intr *int_ctx, uint32_t work_done)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+	struct dp_soc *soc = int_ctx->soc;
+	struct dp_intr_mod_record *record;
+	uint32_t timer_us, batch_cnt;
+	uint32_t avg_work, avg_gap_us;
+	uint8_t profile;
+	uint64_t now;
+
+	if (!wlan_cfg_is_intr_mod_enabled(soc->wlan_cfg_ctx) ||
+	    !(int_ctx->tx_ring_mask || int_ctx->rx_ring_mask))
+		return;
+
+	mod->polls++;
+	mod->work += work_done;
+	if (mod->polls < DP_INTR_MOD_WINDOW_POLLS)
+		return;
+
+	now = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp());
+	avg_work = mod->work / mod->polls;
+	avg_gap_us = (uint32_t)((now - mod->window_start_us) / mod->polls);
+	mod->window_start_us = now;
+	mod->polls = 0;
+	mod->work = 0;
+
+	profile = mod->profile;
+	dp_intr_mod_profile_get(soc, profile, &timer_us, &batch_cnt);
+	if (avg_gap_us > DP_INTR_MOD_IDLE_GAP_US)
+		profile = 0;
+	else if (avg_work > 2 * batch_cnt &&
+		 profile < DP_INTR_MOD_NUM_PROFILES - 1)
+		profile++;
+	else if (2 * avg_work < batch_cnt && profile)
+		profile--;
+
+	if ((mod->applied && profile == mod->profile) ||
+	    !dp_intr_mod_apply(int_ctx, profile)) {
+		mod->profile_windows[mod->profile]++;
+		return;
+	}
+
+	mod->profile_windows[profile]++;
+	mod->profile = profile;
+	mod->applied = true;
+	mod->changes++;
+
+	record = &mod->hist[mod->hist_idx];
+	record->ts_us = now;
+	record->avg_work = avg_work;
+	record->avg_gap_us = avg_gap_us;
+	record->profile = profile;
+	mod->hist_idx = (mod->hist_idx + 1) % DP_INTR_MOD_HIST_SIZE;
+}
+#else
+static inline void dp_intr_mod_init(struct dp_intr *int_ctx)
+{
+}
+
+static inline void dp_intr_mod_update(struct dp_intr *int_ctx,
+				      uint32_t work_done)
+{
+}
+#endif
+
+#ifdef HIF_EXEC_BUSY_POLL
+/**
+ * dp_soc_intr_napi_id_init() - Cache the NAPI instance of an interrupt
+ *				context
+ * @soc: DP SOC handle
+ * @int_ctx: interrupt context registered with HIF
+ *
+ * Socket busy polling drives dp_service_srngs() for the context through
+ * the NAPI id marked on Rx frames, with the kernel's busy poll budget.
+ *
+ * Return: None
+ */
+static void dp_soc_intr_napi_id_init(struct dp_soc *soc,
+				     struct dp_intr *int_ctx)
+{
+	int_ctx->napi = hif_get_ext_group_napi(soc->hif_handle, int_ctx);
+}
+#else
+static inline void dp_soc_intr_napi_id_init(struct dp_soc *soc,
+					    struct dp_intr *int_ctx)
+{
+}
+#endif
+
 /*
  * dp_service_srngs() - Top level interrupt handler for DP Ring interrupts
  * @dp_ctx: DP SOC handle
@@ -1828,6 +2049,7 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	intr_stats->num_masks++;
 
 budget_done:
+	dp_intr_mod_update(int_ctx, dp_budget - budget);
 	return dp_budget - budget;
 }
 
@@ -2193,6 +2415,7 @@ static QDF_STATUS dp_soc_interrupt_attach(struct cdp_soc_t *txrx_soc)
 			 host2rxdma_mon_ring_mask;
 
 		soc->intr_ctx[i].soc = soc;
+		dp_intr_mod_init(&soc->intr_ctx[i]);
 
 		num_irq = 0;
 
@@ -2211,6 +2434,7 @@ static QDF_STATUS dp_soc_interrupt_attach(struct cdp_soc_t *txrx_soc)
 			return QDF_STATUS_E_FAILURE;
 		}
 		soc->intr_ctx[i].lro_ctx = qdf_lro_init();
+		dp_soc_intr_napi_id_init(soc, &soc->intr_ctx[i]);
 	}
 
 	hif_configure_ext_group_interrupts(soc->hif_handle);
@@ -3614,15 +3838,16 @@ void  dp_iterate_update_peer_list(struct cdp_pdev *pdev_hdl)
 	struct dp_vdev *vdev = NULL;
 	struct dp_peer *peer = NULL;
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	qdf_spin_lock_bh(&pdev->vdev_list_lock);
 	DP_PDEV_ITERATE_VDEV_LIST(pdev, vdev) {
 		DP_VDEV_ITERATE_PEER_LIST(vdev, peer) {
+			dp_peer_stats_shard_sync(peer);
 			dp_cal_client_update_peer_stats(&peer->stats);
 		}
 	}
 	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 }
 #else
 void  dp_iterate_update_peer_list(struct cdp_pdev *pdev_hdl)
@@ -3646,6 +3871,8 @@ static QDF_STATUS dp_htt_ppdu_stats_attach(struct dp_pdev *pdev)
 		return QDF_STATUS_E_NOMEM;
 	}
 
+	dp_htt_ppdu_info_pool_attach(pdev);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -3797,16 +4024,7 @@ static void dp_neighbour_peers_detach(struct dp_pdev *pdev)
 */
 static void dp_htt_ppdu_stats_detach(struct dp_pdev *pdev)
 {
-	struct ppdu_info *ppdu_info, *ppdu_info_next;
-
-	TAILQ_FOREACH_SAFE(ppdu_info, &pdev->ppdu_info_list,
-			ppdu_info_list_elem, ppdu_info_next) {
-		if (!ppdu_info)
-			break;
-		qdf_assert_always(ppdu_info->nbuf);
-		qdf_nbuf_free(ppdu_info->nbuf);
-		qdf_mem_free(ppdu_info);
-	}
+	dp_htt_ppdu_info_pool_detach(pdev);
 
 	if (pdev->ppdu_tlv_buf)
 		qdf_mem_free(pdev->ppdu_tlv_buf);
@@ -4056,6 +4274,7 @@ static void dp_soc_deinit(void *txrx_soc)
 	dp_reo_desc_freelist_destroy(soc);
 
 	DEINIT_RX_HW_STATS_LOCK(soc);
+	DEINIT_STATS_SHARD_LOCK(soc);
 
 	qdf_spinlock_destroy(&soc->ast_lock);
 	qdf_spinlock_destroy(&soc->peer_ref_mutex);
@@ -4082,6 +4301,9 @@ static void dp_soc_deinit(void *txrx_soc)
 	/* Free wbm sg list and reset flags in down path */
 	dp_rx_wbm_sg_list_deinit(soc);
 
+	/* Unmap and free nbufs parked for Rx replenish */
+	dp_rx_nbuf_recycle_pool_deinit(soc);
+
 	wlan_minidump_remove(soc);
 }
 
@@ -4734,6 +4956,7 @@ static QDF_STATUS dp_vdev_attach_wifi3(struct cdp_soc_t *cdp_soc,
 
 	dp_info("Created vdev %pK (%pM)", vdev, vdev->mac_addr.raw);
 	DP_STATS_INIT(vdev);
+	DP_STATS_SHARDS_INIT(vdev, stats_shard);
 
 	if (wlan_op_mode_sta == vdev->opmode)
 		dp_peer_create_wifi3((struct cdp_soc_t *)soc, vdev_id,
@@ -4837,7 +5060,7 @@ static void dp_vdev_flush_peers(struct cdp_vdev *vdev_handle, bool unmap_only)
 		}
 	}
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (!unmap_only && n < soc->max_peers)
 			peer_array[n++] = peer;
@@ -4846,7 +5069,7 @@ static void dp_vdev_flush_peers(struct cdp_vdev *vdev_handle, bool unmap_only)
 			if (j < soc->max_peers)
 				peer_ids[j++] = peer->peer_id;
 	}
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	/*
 	 * If peer id is invalid, need to flush the peer if
@@ -4947,7 +5170,7 @@ static QDF_STATUS dp_vdev_detach_wifi3(struct cdp_soc_t *cdp_soc,
 	 * Use peer_ref_mutex while accessing peer_list, in case
 	 * a peer is in the process of being removed from the list.
 	 */
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	/* check that the vdev has no peers allocated */
 	if (!TAILQ_EMPTY(&vdev->peer_list)) {
 		/* debug print - will be removed later */
@@ -4962,10 +5185,10 @@ static QDF_STATUS dp_vdev_detach_wifi3(struct cdp_soc_t *cdp_soc,
 		vdev->delete.pending = 1;
 		vdev->delete.callback = callback;
 		vdev->delete.context = cb_context;
-		qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock(soc);
 		return QDF_STATUS_E_FAILURE;
 	}
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	if (wlan_op_mode_monitor == vdev->opmode)
 		goto free_vdev;
@@ -5181,6 +5404,8 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		dp_peer_rx_bufq_resources_init(peer);
 
 		DP_STATS_INIT(peer);
+		DP_STATS_SHARDS_INIT(peer, rx_shard);
+		DP_STATS_SHARDS_INIT(peer, tx_shard);
 		DP_STATS_UPD(peer, rx.avg_rssi, INVALID_RSSI);
 
 		/*
@@ -5223,6 +5448,9 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	/* store provided params */
 	peer->vdev = vdev;
+#ifdef DP_PEER_LOOKUP_RCU
+	peer->vdev_id = vdev->vdev_id;
+#endif
 
 	if ((vdev->opmode == wlan_op_mode_sta) &&
 	    !qdf_mem_cmp(peer_mac_addr, &vdev->mac_addr.raw[0],
@@ -5243,7 +5471,7 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	/* reset the ast index to flowid table */
 	dp_peer_reset_flowq_map(peer);
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 
 	qdf_atomic_init(&peer->ref_cnt);
 
@@ -5256,7 +5484,7 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	else
 		TAILQ_INSERT_TAIL(&vdev->peer_list, peer, peer_list_elem);
 
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	/* TODO: See if hash based search is required */
 	dp_peer_find_hash_add(soc, peer);
@@ -5290,6 +5518,8 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	peer->valid = 1;
 	dp_local_peer_id_alloc(pdev, peer);
 	DP_STATS_INIT(peer);
+	DP_STATS_SHARDS_INIT(peer, rx_shard);
+	DP_STATS_SHARDS_INIT(peer, tx_shard);
 	DP_STATS_UPD(peer, rx.avg_rssi, INVALID_RSSI);
 
 	qdf_mem_copy(peer_cookie.mac_addr, peer->mac_addr.raw,
@@ -5838,9 +6068,9 @@ dp_peer_authorize(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 			  "%s: Peer is NULL!\n", __func__);
 		status = QDF_STATUS_E_FAILURE;
 	} else {
-		qdf_spin_lock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_lock(soc);
 		peer->authorize = authorize ? 1 : 0;
-		qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock(soc);
 	}
 
 	if (peer)
@@ -5878,6 +6108,38 @@ static void dp_vdev_reset_peer(struct dp_vdev *vdev,
 	}
 }
 
+#ifdef DP_PEER_LOOKUP_RCU
+/*
+ * dp_peer_mem_free_rcu() - free dp peer memory after RCU grace period
+ * @head: rcu head embedded in the peer
+ *
+ * Return: None
+ */
+static void dp_peer_mem_free_rcu(qdf_rcu_head_t *head)
+{
+	qdf_mem_free(qdf_container_of(head, struct dp_peer, rcu));
+}
+
+/*
+ * dp_peer_mem_free() - free dp peer memory
+ * @peer: datapath peer handle
+ *
+ * Lockless lookups of the peer hash and peer id map may still be looking
+ * at the peer, so the memory is freed once they are all done.
+ *
+ * Return: None
+ */
+static inline void dp_peer_mem_free(struct dp_peer *peer)
+{
+	qdf_call_rcu(&peer->rcu, dp_peer_mem_free_rcu);
+}
+#else
+static inline void dp_peer_mem_free(struct dp_peer *peer)
+{
+	qdf_mem_free(peer);
+}
+#endif /* DP_PEER_LOOKUP_RCU */
+
 /*
  * dp_peer_release_mem() - free dp peer handle memory
  * @soc: dataptah soc handle
@@ -5906,7 +6168,7 @@ static void dp_peer_release_mem(struct dp_soc *soc,
 	 */
 	DP_AST_ASSERT(TAILQ_EMPTY(&peer->ast_entry_list));
 
-	qdf_mem_free(peer);
+	dp_peer_mem_free(peer);
 }
 
 /**
@@ -5984,7 +6246,7 @@ void dp_peer_unref_delete(struct dp_peer *peer)
 	 * vdev's list of peers is empty, to make sure that list is not modified
 	 * concurrently with the empty check.
 	 */
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	if (qdf_atomic_dec_and_test(&peer->ref_cnt)) {
 		peer_id = peer->peer_id;
 		vdev_id = vdev->vdev_id;
@@ -6059,7 +6321,7 @@ void dp_peer_unref_delete(struct dp_peer *peer)
 		 * Now that there are no references to the peer, we can
 		 * release the peer reference lock.
 		 */
-		qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock(soc);
 
 		wlan_minidump_remove(peer);
 		/*
@@ -6077,7 +6339,7 @@ void dp_peer_unref_delete(struct dp_peer *peer)
 			dp_delete_pending_vdev(pdev, vdev, vdev_id);
 
 	} else {
-		qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock(soc);
 	}
 }
 
@@ -6763,6 +7025,74 @@ void dp_rx_bar_stats_cb(struct dp_soc *soc, void *cb_ctxt,
 
 }
 
+#ifdef QCA_DP_PCPU_STATS
+/*
+ * Each shard is written only by its own CPU with bottom halves disabled,
+ * and only read here. The delta since the previous sync is added to the
+ * aggregated stats, so shards never have to be reset from outside their
+ * CPU.
+ */
+#define DP_STATS_SHARD_FOLD(_dst, _shard, _field) \
+{ \
+	(_dst)._field += (_shard)->cur._field - (_shard)->synced._field; \
+	(_shard)->synced._field = (_shard)->cur._field; \
+}
+
+#define DP_STATS_SHARD_FOLD_PKT(_dst, _shard, _field) \
+{ \
+	DP_STATS_SHARD_FOLD(_dst, _shard, _field.num); \
+	DP_STATS_SHARD_FOLD(_dst, _shard, _field.bytes); \
+}
+
+void dp_vdev_stats_shard_sync(struct dp_vdev *vdev)
+{
+	struct dp_soc *soc = vdev->pdev->soc;
+	struct dp_vdev_stats_shard *shard;
+	int cpu;
+
+	qdf_spin_lock_bh(&soc->stats_shard_lock);
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		shard = &vdev->stats_shard[cpu];
+		DP_STATS_SHARD_FOLD_PKT(vdev->stats.tx_i, shard, rcvd);
+		DP_STATS_SHARD_FOLD_PKT(vdev->stats.tx_i, shard, processed);
+	}
+	qdf_spin_unlock_bh(&soc->stats_shard_lock);
+}
+
+void dp_peer_stats_shard_sync(struct dp_peer *peer)
+{
+	struct dp_soc *soc = peer->vdev->pdev->soc;
+	struct dp_peer_rx_stats_shard *rx_shard;
+	struct dp_peer_tx_stats_shard *tx_shard;
+	uint8_t ring;
+	int cpu;
+
+	qdf_spin_lock_bh(&soc->stats_shard_lock);
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		rx_shard = &peer->rx_shard[cpu];
+		for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+			DP_STATS_SHARD_FOLD_PKT(peer->stats.rx, rx_shard,
+						rcvd_reo[ring]);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.rx, rx_shard, to_stack);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.rx, rx_shard, multicast);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.rx, rx_shard, bcast);
+		DP_STATS_SHARD_FOLD(peer->stats.rx, rx_shard, non_amsdu_cnt);
+		DP_STATS_SHARD_FOLD(peer->stats.rx, rx_shard, amsdu_cnt);
+		DP_STATS_SHARD_FOLD(peer->stats.rx, rx_shard, rx_retries);
+
+		tx_shard = &peer->tx_shard[cpu];
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.tx, tx_shard, comp_pkt);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.tx, tx_shard, ucast);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.tx, tx_shard, mcast);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.tx, tx_shard, bcast);
+		DP_STATS_SHARD_FOLD_PKT(peer->stats.tx, tx_shard, tx_success);
+		DP_STATS_SHARD_FOLD(peer->stats.tx, tx_shard, non_amsdu_cnt);
+		DP_STATS_SHARD_FOLD(peer->stats.tx, tx_shard, amsdu_cnt);
+	}
+	qdf_spin_unlock_bh(&soc->stats_shard_lock);
+}
+#endif
+
 /**
  * dp_aggregate_vdev_stats(): Consolidate stats at VDEV level
  * @vdev: DP VDEV handle
@@ -6780,10 +7110,13 @@ void dp_aggregate_vdev_stats(struct dp_vdev *vdev,
 
 	soc = vdev->pdev->soc;
 
+	dp_vdev_stats_shard_sync(vdev);
 	qdf_mem_copy(vdev_stats, &vdev->stats, sizeof(vdev->stats));
 
-	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem)
+	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
+		dp_peer_stats_shard_sync(peer);
 		dp_update_vdev_stats(vdev_stats, peer);
+	}
 
 #if defined(FEATURE_PERPKT_INFO) && WDI_EVENT_ENABLE
 	dp_wdi_event_handler(WDI_EVENT_UPDATE_DP_STATS, vdev->pdev->soc,
@@ -6813,7 +7146,7 @@ void dp_aggregate_pdev_stats(struct dp_pdev *pdev)
 		DP_UPDATE_STATS(pdev, pdev->invalid_peer);
 
 	soc = pdev->soc;
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	qdf_spin_lock_bh(&pdev->vdev_list_lock);
 	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
 
@@ -6822,7 +7155,7 @@ void dp_aggregate_pdev_stats(struct dp_pdev *pdev)
 		dp_update_pdev_ingress_stats(pdev, vdev);
 	}
 	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 	qdf_mem_free(vdev_stats);
 
 #if defined(FEATURE_PERPKT_INFO) && WDI_EVENT_ENABLE
@@ -6863,9 +7196,9 @@ static QDF_STATUS dp_vdev_getstats(struct cdp_vdev *vdev_handle,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	dp_aggregate_vdev_stats(vdev, vdev_stats);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	stats->tx_packets = vdev_stats->tx_i.rcvd.num;
 	stats->tx_bytes = vdev_stats->tx_i.rcvd.bytes;
@@ -7036,6 +7369,8 @@ dp_txrx_host_stats_clr(struct dp_vdev *vdev)
 
 	DP_STATS_CLR(vdev->pdev);
 	DP_STATS_CLR(vdev->pdev->soc);
+	/* Consume pending shard deltas so they do not reappear */
+	dp_vdev_stats_shard_sync(vdev);
 	DP_STATS_CLR(vdev);
 
 	hif_clear_napi_stats(vdev->pdev->soc->hif_handle);
@@ -7043,6 +7378,7 @@ dp_txrx_host_stats_clr(struct dp_vdev *vdev)
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (!peer)
 			return QDF_STATUS_E_FAILURE;
+		dp_peer_stats_shard_sync(peer);
 		DP_STATS_CLR(peer);
 
 #if defined(FEATURE_PERPKT_INFO) && WDI_EVENT_ENABLE
@@ -7090,6 +7426,7 @@ dp_get_host_peer_stats(struct cdp_soc_t *soc, uint8_t *mac_addr)
 		goto fail;
 	}
 
+	dp_peer_stats_shard_sync(peer);
 	dp_print_peer_stats(peer);
 	dp_peer_rxtid_stats(peer, dp_rx_tid_stats_cb, NULL);
 fail:
@@ -8249,9 +8586,11 @@ dp_txrx_get_peer_stats(struct cdp_soc_t *soc, uint8_t vdev_id,
 
 	if (!peer || peer->delete_in_progress) {
 		status = QDF_STATUS_E_FAILURE;
-	} else
+	} else {
+		dp_peer_stats_shard_sync(peer);
 		qdf_mem_copy(peer_stats, &peer->stats,
 			     sizeof(struct cdp_peer_stats));
+	}
 
 	if (peer)
 		dp_peer_unref_delete(peer);
@@ -8281,6 +8620,7 @@ dp_txrx_get_peer_stats_param(struct cdp_soc_t *soc, uint8_t vdev_id,
 			  "Invalid Peer for Mac %pM", peer_mac);
 		ret = QDF_STATUS_E_FAILURE;
 	} else if (type < cdp_peer_stats_max) {
+		dp_peer_stats_shard_sync(peer);
 		switch (type) {
 		case cdp_peer_tx_ucast:
 			buf->tx_ucast = peer->stats.tx.ucast;
@@ -8362,6 +8702,7 @@ dp_txrx_reset_peer_stats(struct cdp_soc_t *soc, uint8_t vdev_id,
 		goto fail;
 	}
 
+	dp_peer_stats_shard_sync(peer);
 	qdf_mem_zero(&peer->stats, sizeof(peer->stats));
 
 fail:
@@ -8396,10 +8737,11 @@ static int dp_txrx_get_vdev_stats(struct cdp_soc_t *soc, uint8_t vdev_id,
 	vdev_stats = (struct cdp_vdev_stats *)buf;
 
 	if (is_aggregate) {
-		qdf_spin_lock_bh(&((struct dp_soc *)soc)->peer_ref_mutex);
+		dp_peer_ref_mutex_lock((struct dp_soc *)soc);
 		dp_aggregate_vdev_stats(vdev, buf);
-		qdf_spin_unlock_bh(&((struct dp_soc *)soc)->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock((struct dp_soc *)soc);
 	} else {
+		dp_vdev_stats_shard_sync(vdev);
 		qdf_mem_copy(vdev_stats, &vdev->stats, sizeof(vdev->stats));
 	}
 
@@ -9397,7 +9739,7 @@ static QDF_STATUS dp_flush_rate_stats_req(struct cdp_soc_t *soc_hdl,
 	if (!pdev)
 		return QDF_STATUS_E_FAILURE;
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	qdf_spin_lock_bh(&pdev->vdev_list_lock);
 	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
 		TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
@@ -9410,7 +9752,7 @@ static QDF_STATUS dp_flush_rate_stats_req(struct cdp_soc_t *soc_hdl,
 		}
 	}
 	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -9710,6 +10052,7 @@ static struct cdp_cmn_ops dp_ops_cmn = {
 	.txrx_set_ba_aging_timeout = dp_set_ba_aging_timeout,
 	.txrx_get_ba_aging_timeout = dp_get_ba_aging_timeout,
 	.tx_send = dp_tx_send,
+	.tx_send_list = dp_tx_send_list,
 	.txrx_peer_reset_ast = dp_wds_reset_ast_wifi3,
 	.txrx_peer_reset_ast_table = dp_wds_reset_ast_table_wifi3,
 	.txrx_peer_flush_ast_table = dp_wds_flush_ast_table_wifi3,
@@ -9965,9 +10308,9 @@ static uint32_t dp_tx_get_success_ack_stats(struct cdp_soc_t *soc_hdl,
 		return 0;
 	}
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	dp_aggregate_vdev_stats(vdev, vdev_stats);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	tx_success = vdev_stats->tx.tx_success.num;
 	qdf_mem_free(vdev_stats);
@@ -10804,7 +11147,10 @@ void *dp_soc_init(struct dp_soc *soc, HTC_HANDLE htc_handle,
 	}
 
 	/* setup the global rx defrag waitlist */
-	TAILQ_INIT(&soc->rx.defrag.waitlist);
+	for (i = 0; i < DP_RX_DEFRAG_WHEEL_SLOTS; i++)
+		TAILQ_INIT(&soc->rx.defrag.waitlist[i]);
+	soc->rx.defrag.waitlist_len = 0;
+	soc->rx.defrag.wheel_tick = 0;
 	soc->rx.defrag.timeout_ms =
 		wlan_cfg_get_rx_defrag_min_timeout(soc->wlan_cfg_ctx);
 	soc->rx.defrag.next_flush_ms = 0;
@@ -10829,6 +11175,7 @@ void *dp_soc_init(struct dp_soc *soc, HTC_HANDLE htc_handle,
 
 	qdf_spinlock_create(&soc->peer_ref_mutex);
 	qdf_spinlock_create(&soc->ast_lock);
+	INIT_STATS_SHARD_LOCK(soc);
 
 	qdf_spinlock_create(&soc->reo_desc_freelist_lock);
 	qdf_list_create(&soc->reo_desc_freelist, REO_DESC_FREELIST_SIZE);
@@ -11501,7 +11848,7 @@ uint16_t dp_get_peer_mac_list(ol_txrx_soc_handle soc, uint8_t vdev_id,
 	if (!vdev)
 		return new_mac_cnt;
 
-	qdf_spin_lock_bh(&dp_soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(dp_soc);
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (peer->bss_peer)
 			continue;
@@ -11510,7 +11857,7 @@ uint16_t dp_get_peer_mac_list(ol_txrx_soc_handle soc, uint8_t vdev_id,
 			new_mac_cnt++;
 		}
 	}
-	qdf_spin_unlock_bh(&dp_soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(dp_soc);
 	return new_mac_cnt;
 }
 
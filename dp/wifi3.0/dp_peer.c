@@ -214,12 +214,74 @@ static inline unsigned dp_peer_find_hash_index(struct dp_soc *soc,
 }
 
 
+#ifdef DP_PEER_LOOKUP_RCU
+/**
+ * dp_peer_hash_bin_insert_tail() - Add a peer at the tail of a hash bin
+ * @bin: hash bin
+ * @peer: peer to add
+ *
+ * Same as TAILQ_INSERT_TAIL, except the peer is only linked into the bin
+ * once its own list pointers are set, so a concurrent lockless walk of
+ * the bin always sees a consistent list.
+ *
+ * Return: None
+ */
+static inline void
+dp_peer_hash_bin_insert_tail(struct dp_peer_hash_bin *bin,
+			     struct dp_peer *peer)
+{
+	peer->hash_list_elem.tqe_next = NULL;
+	peer->hash_list_elem.tqe_prev = bin->tqh_last;
+	qdf_rcu_assign_pointer(*bin->tqh_last, peer);
+	bin->tqh_last = &peer->hash_list_elem.tqe_next;
+}
+
+/**
+ * dp_peer_hash_bin_remove() - Unlink a peer from a hash bin
+ * @bin: hash bin
+ * @peer: peer to remove
+ *
+ * Unlike TAILQ_REMOVE, the next pointer of the removed peer is left
+ * intact, so a lockless reader currently on this peer can continue its
+ * walk of the bin. The peer memory is only freed after a grace period.
+ *
+ * Return: None
+ */
+static inline void
+dp_peer_hash_bin_remove(struct dp_peer_hash_bin *bin,
+			struct dp_peer *peer)
+{
+	struct dp_peer *next = peer->hash_list_elem.tqe_next;
+
+	if (next)
+		next->hash_list_elem.tqe_prev = peer->hash_list_elem.tqe_prev;
+	else
+		bin->tqh_last = peer->hash_list_elem.tqe_prev;
+
+	*peer->hash_list_elem.tqe_prev = next;
+}
+#else
+static inline void
+dp_peer_hash_bin_insert_tail(struct dp_peer_hash_bin *bin,
+			     struct dp_peer *peer)
+{
+	TAILQ_INSERT_TAIL(bin, peer, hash_list_elem);
+}
+
+static inline void
+dp_peer_hash_bin_remove(struct dp_peer_hash_bin *bin,
+			struct dp_peer *peer)
+{
+	TAILQ_REMOVE(bin, peer, hash_list_elem);
+}
+#endif /* DP_PEER_LOOKUP_RCU */
+
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 {
 	unsigned index;
 
 	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	/*
 	 * It is important to add the new peer at the tail of the peer list
 	 * with the bin index.  Together with having the hash_find function
@@ -227,45 +289,87 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 	 * the same MAC address are stored, the one added first will be
 	 * found first.
 	 */
-	TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer, hash_list_elem);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_hash_bin_insert_tail(&soc->peer_hash.bins[index], peer);
+	dp_peer_ref_mutex_unlock(soc);
 }
 
 #ifdef FEATURE_AST
+/* Initial AST hash size is the full size shifted down by this much */
+#define DP_AST_HASH_INIT_SHIFT 3
+/* Grow the AST hash once the average chain exceeds this length */
+#define DP_AST_HASH_GROW_LOAD 2
+/* Old buckets migrated per add/remove while a rehash is in progress */
+#define DP_AST_HASH_REHASH_STEP 4
+
+#define DP_AST_HASH_LOCK(_soc, _hash) \
+	(&(_soc)->ast_hash.lock[(_hash) & (DP_AST_HASH_LOCK_GROUPS - 1)])
+
+/*
+ * dp_peer_ast_hash_table_alloc() - Allocate an AST hash bucket array
+ * @idx_bits: log2 of the number of buckets
+ *
+ * Return: hash table or NULL on allocation failure
+ */
+static struct dp_ast_hash_table *dp_peer_ast_hash_table_alloc(
+		unsigned int idx_bits)
+{
+	struct dp_ast_hash_table *table;
+	unsigned int i, hash_elems = 1 << idx_bits;
+
+	table = qdf_mem_malloc(sizeof(*table) +
+			       hash_elems * sizeof(table->bins[0]));
+	if (!table)
+		return NULL;
+
+	table->mask = hash_elems - 1;
+	table->idx_bits = idx_bits;
+	for (i = 0; i < hash_elems; i++)
+		TAILQ_INIT(&table->bins[i]);
+
+	return table;
+}
+
 /*
  * dp_peer_ast_hash_attach() - Allocate and initialize AST Hash Table
  * @soc: SoC handle
  *
+ * The table starts at 1/2^DP_AST_HASH_INIT_SHIFT of the size needed for
+ * max_ast_idx entries and grows on demand, so that small deployments do
+ * not pay for the worst case WDS table.
+ *
  * Return: None
  */
 static int dp_peer_ast_hash_attach(struct dp_soc *soc)
 {
-	int i, hash_elems, log2;
+	int i, hash_elems, log2, max_log2, min_log2;
 	unsigned int max_ast_idx = wlan_cfg_get_max_ast_idx(soc->wlan_cfg_ctx);
 
 	hash_elems = ((max_ast_idx * DP_AST_HASH_LOAD_MULT) >>
 		DP_AST_HASH_LOAD_SHIFT);
 
-	log2 = dp_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
-
-	soc->ast_hash.mask = hash_elems - 1;
-	soc->ast_hash.idx_bits = log2;
+	max_log2 = dp_log2_ceil(hash_elems);
+	min_log2 = dp_log2_ceil(DP_AST_HASH_LOCK_GROUPS);
+	log2 = max_log2 - DP_AST_HASH_INIT_SHIFT;
+	if (log2 < min_log2)
+		log2 = min_log2;
+	if (max_log2 < log2)
+		max_log2 = log2;
 
 	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
-		  "ast hash_elems: %d, max_ast_idx: %d",
-		  hash_elems, max_ast_idx);
+		  "ast hash_elems: %d (max %d), max_ast_idx: %d",
+		  1 << log2, 1 << max_log2, max_ast_idx);
 
-	/* allocate an array of TAILQ peer object lists */
-	soc->ast_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q,
-				dp_ast_entry)));
-
-	if (!soc->ast_hash.bins)
+	soc->ast_hash.table = dp_peer_ast_hash_table_alloc(log2);
+	if (!soc->ast_hash.table)
 		return QDF_STATUS_E_NOMEM;
 
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->ast_hash.bins[i]);
+	soc->ast_hash.old_table = NULL;
+	soc->ast_hash.rehash_idx = 0;
+	soc->ast_hash.max_idx_bits = max_log2;
+	soc->ast_hash.grow_pending = false;
+
+	for (i = 0; i < DP_AST_HASH_LOCK_GROUPS; i++)
+		qdf_spinlock_create(&soc->ast_hash.lock[i]);
 
 	return 0;
 }
@@ -295,58 +399,291 @@ static inline void dp_peer_ast_cleanup(struct dp_soc *soc,
 }
 
 /*
- * dp_peer_ast_hash_detach() - Free AST Hash table
+ * dp_peer_ast_hash_table_flush() - Free all AST entries of a hash table
  * @soc: SoC handle
+ * @table: AST hash table
+ *
+ * It assumes caller has taken the ast lock
  *
  * Return: None
  */
-static void dp_peer_ast_hash_detach(struct dp_soc *soc)
+static void dp_peer_ast_hash_table_flush(struct dp_soc *soc,
+					 struct dp_ast_hash_table *table)
 {
 	unsigned int index;
 	struct dp_ast_entry *ast, *ast_next;
 
-	if (!soc->ast_hash.mask)
-		return;
-
-	if (!soc->ast_hash.bins)
+	if (!table)
 		return;
 
-	qdf_spin_lock_bh(&soc->ast_lock);
-	for (index = 0; index <= soc->ast_hash.mask; index++) {
-		if (!TAILQ_EMPTY(&soc->ast_hash.bins[index])) {
-			TAILQ_FOREACH_SAFE(ast, &soc->ast_hash.bins[index],
+	for (index = 0; index <= table->mask; index++) {
+		if (!TAILQ_EMPTY(&table->bins[index])) {
+			TAILQ_FOREACH_SAFE(ast, &table->bins[index],
 					   hash_list_elem, ast_next) {
-				TAILQ_REMOVE(&soc->ast_hash.bins[index], ast,
+				TAILQ_REMOVE(&table->bins[index], ast,
 					     hash_list_elem);
 				dp_peer_ast_cleanup(soc, ast);
 				qdf_mem_free(ast);
 			}
 		}
 	}
+}
+
+/*
+ * dp_peer_ast_hash_detach() - Free AST Hash table
+ * @soc: SoC handle
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_detach(struct dp_soc *soc)
+{
+	int i;
+
+	if (!soc->ast_hash.table)
+		return;
+
+	qdf_spin_lock_bh(&soc->ast_lock);
+	dp_peer_ast_hash_table_flush(soc, soc->ast_hash.old_table);
+	dp_peer_ast_hash_table_flush(soc, soc->ast_hash.table);
 	qdf_spin_unlock_bh(&soc->ast_lock);
 
-	qdf_mem_free(soc->ast_hash.bins);
-	soc->ast_hash.bins = NULL;
+	qdf_mem_free(soc->ast_hash.old_table);
+	soc->ast_hash.old_table = NULL;
+	qdf_mem_free(soc->ast_hash.table);
+	soc->ast_hash.table = NULL;
+
+	for (i = 0; i < DP_AST_HASH_LOCK_GROUPS; i++)
+		qdf_spinlock_destroy(&soc->ast_hash.lock[i]);
+}
+
+/*
+ * dp_peer_ast_hash_mix() - Compute the AST hash from MAC address
+ * @mac_addr: MAC address
+ *
+ * Folds the 48 bit address into 32 bits and runs the murmur3 finalizer
+ * on it, so that addresses differing only in a few bits (same OUI,
+ * sequential NIC part) still spread over all buckets and lock groups.
+ *
+ * Return: 32 bit AST hash, bucket index is hash & table->mask
+ */
+static inline uint32_t dp_peer_ast_hash_mix(union dp_align_mac_addr *mac_addr)
+{
+	uint32_t hash;
+
+	hash = mac_addr->align4.bytes_abcd ^
+		((uint32_t)mac_addr->align4.bytes_ef * 0x9e3779b1);
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+/*
+ * dp_peer_ast_hash_bin_find() - Find AST entry in one hash bucket
+ * @table: AST hash table
+ * @hash: AST hash of @mac_addr
+ * @mac_addr: MAC address
+ * @pdev_id: pdev id to match if @match_pdev is set
+ * @match_pdev: match pdev_id along with the MAC address
+ *
+ * Return: AST entry
+ */
+static inline struct dp_ast_entry *
+dp_peer_ast_hash_bin_find(struct dp_ast_hash_table *table, uint32_t hash,
+			  union dp_align_mac_addr *mac_addr,
+			  uint8_t pdev_id, bool match_pdev)
+{
+	struct dp_ast_entry *ase;
+
+	TAILQ_FOREACH(ase, &table->bins[hash & table->mask], hash_list_elem) {
+		if ((!match_pdev || pdev_id == ase->pdev_id) &&
+		    !dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr))
+			return ase;
+	}
+
+	return NULL;
 }
 
 /*
- * dp_peer_ast_hash_index() - Compute the AST hash from MAC address
+ * dp_peer_ast_hash_lookup() - Find AST entry in the current and old table
  * @soc: SoC handle
+ * @hash: AST hash of @mac_addr
+ * @mac_addr: MAC address
+ * @pdev_id: pdev id to match if @match_pdev is set
+ * @match_pdev: match pdev_id along with the MAC address
  *
- * Return: AST hash
+ * Caller must hold either the ast lock or the bucket group lock of @hash.
+ * The old table is searched first: an entry still there is older than
+ * any entry with the same MAC in the new table.
+ *
+ * Return: AST entry
  */
-static inline uint32_t dp_peer_ast_hash_index(struct dp_soc *soc,
-	union dp_align_mac_addr *mac_addr)
+static struct dp_ast_entry *
+dp_peer_ast_hash_lookup(struct dp_soc *soc, uint32_t hash,
+			union dp_align_mac_addr *mac_addr,
+			uint8_t pdev_id, bool match_pdev)
 {
-	uint32_t index;
+	struct dp_ast_hash_table *table, *old_table;
+	struct dp_ast_entry *ase = NULL;
 
-	index =
-		mac_addr->align2.bytes_ab ^
-		mac_addr->align2.bytes_cd ^
-		mac_addr->align2.bytes_ef;
-	index ^= index >> soc->ast_hash.idx_bits;
-	index &= soc->ast_hash.mask;
-	return index;
+	table = soc->ast_hash.table;
+	qdf_rmb();
+	old_table = soc->ast_hash.old_table;
+
+	if (old_table && old_table != table)
+		ase = dp_peer_ast_hash_bin_find(old_table, hash, mac_addr,
+						pdev_id, match_pdev);
+	if (!ase)
+		ase = dp_peer_ast_hash_bin_find(table, hash, mac_addr,
+						pdev_id, match_pdev);
+
+	return ase;
+}
+
+/*
+ * dp_peer_ast_hash_migrate_bin() - Move one old bucket into the new table
+ * @soc: SoC handle
+ * @old_idx: bucket index in the old table
+ *
+ * All entries of an old bucket share its lock group in the new table
+ * as well, so only that group lock is needed.
+ * It assumes caller has taken the ast lock and a rehash is in progress
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_migrate_bin(struct dp_soc *soc,
+					 unsigned int old_idx)
+{
+	struct dp_ast_hash_table *table = soc->ast_hash.table;
+	struct dp_ast_hash_bin *bin = &soc->ast_hash.old_table->bins[old_idx];
+	qdf_spinlock_t *lock = DP_AST_HASH_LOCK(soc, old_idx);
+	struct dp_ast_entry *ase;
+	uint32_t hash, moved = 0;
+
+	qdf_spin_lock_bh(lock);
+	while ((ase = TAILQ_FIRST(bin))) {
+		TAILQ_REMOVE(bin, ase, hash_list_elem);
+		hash = dp_peer_ast_hash_mix(&ase->mac_addr);
+		TAILQ_INSERT_TAIL(&table->bins[hash & table->mask], ase,
+				  hash_list_elem);
+		moved++;
+	}
+	qdf_spin_unlock_bh(lock);
+
+	DP_STATS_INC(soc, ast.hash_migrated, moved);
+}
+
+/*
+ * dp_peer_ast_hash_rehash_step() - Migrate a few old buckets
+ * @soc: SoC handle
+ *
+ * Once the last old bucket is migrated the old table is unpublished,
+ * every group lock is cycled so that no lockless reader can still be
+ * walking it, and it is freed.
+ * It assumes caller has taken the ast lock
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_rehash_step(struct dp_soc *soc)
+{
+	struct dp_ast_hash_table *old_table = soc->ast_hash.old_table;
+	int i;
+
+	if (qdf_likely(!old_table))
+		return;
+
+	for (i = 0; i < DP_AST_HASH_REHASH_STEP &&
+	     soc->ast_hash.rehash_idx <= old_table->mask; i++)
+		dp_peer_ast_hash_migrate_bin(soc, soc->ast_hash.rehash_idx++);
+
+	if (soc->ast_hash.rehash_idx <= old_table->mask)
+		return;
+
+	soc->ast_hash.old_table = NULL;
+	for (i = 0; i < DP_AST_HASH_LOCK_GROUPS; i++) {
+		qdf_spin_lock_bh(&soc->ast_hash.lock[i]);
+		qdf_spin_unlock_bh(&soc->ast_hash.lock[i]);
+	}
+	qdf_mem_free(old_table);
+}
+
+/*
+ * dp_peer_ast_hash_grow() - Request a 2x table if the load is too high
+ * @soc: SoC handle
+ *
+ * Only marks the resize as pending; the table is allocated by
+ * dp_peer_ast_hash_resize() once the ast lock is dropped.
+ * It assumes caller has taken the ast lock
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_grow(struct dp_soc *soc)
+{
+	struct dp_ast_hash_table *table = soc->ast_hash.table;
+
+	if (soc->ast_hash.grow_pending || soc->ast_hash.old_table ||
+	    table->idx_bits >= soc->ast_hash.max_idx_bits)
+		return;
+
+	if (soc->num_ast_entries <= (table->mask + 1) * DP_AST_HASH_GROW_LOAD)
+		return;
+
+	soc->ast_hash.grow_pending = true;
+}
+
+/*
+ * dp_peer_ast_hash_resize() - Start an incremental rehash into a 2x table
+ * @soc: SoC handle
+ *
+ * The new table is allocated without any lock held and the ast lock is
+ * taken only to install it. The old table is published before the new
+ * one, so a lockless reader that sees the new table also sees the old one.
+ * Must be called without the ast lock held.
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_resize(struct dp_soc *soc)
+{
+	struct dp_ast_hash_table *table, *new_table;
+	unsigned int idx_bits;
+
+	if (qdf_likely(!soc->ast_hash.grow_pending))
+		return;
+
+	qdf_spin_lock_bh(&soc->ast_lock);
+	table = soc->ast_hash.table;
+	idx_bits = table->idx_bits;
+	if (!soc->ast_hash.grow_pending || soc->ast_hash.old_table) {
+		qdf_spin_unlock_bh(&soc->ast_lock);
+		return;
+	}
+	qdf_spin_unlock_bh(&soc->ast_lock);
+
+	new_table = dp_peer_ast_hash_table_alloc(idx_bits + 1);
+
+	qdf_spin_lock_bh(&soc->ast_lock);
+	table = soc->ast_hash.table;
+	if (!new_table) {
+		soc->ast_hash.grow_pending = false;
+		DP_STATS_INC(soc, ast.hash_resize_fail, 1);
+	} else if (soc->ast_hash.grow_pending && !soc->ast_hash.old_table &&
+		   table->idx_bits == idx_bits) {
+		soc->ast_hash.grow_pending = false;
+		soc->ast_hash.rehash_idx = 0;
+		soc->ast_hash.old_table = table;
+		qdf_wmb();
+		soc->ast_hash.table = new_table;
+		new_table = NULL;
+		DP_STATS_INC(soc, ast.hash_resize, 1);
+	}
+	qdf_spin_unlock_bh(&soc->ast_lock);
+
+	/* lost the race against another resize */
+	if (new_table)
+		qdf_mem_free(new_table);
 }
 
 /*
@@ -361,10 +698,26 @@ static inline uint32_t dp_peer_ast_hash_index(struct dp_soc *soc,
 static inline void dp_peer_ast_hash_add(struct dp_soc *soc,
 		struct dp_ast_entry *ase)
 {
-	uint32_t index;
-
-	index = dp_peer_ast_hash_index(soc, &ase->mac_addr);
-	TAILQ_INSERT_TAIL(&soc->ast_hash.bins[index], ase, hash_list_elem);
+	struct dp_ast_hash_table *table;
+	qdf_spinlock_t *lock;
+	uint32_t hash;
+
+	hash = dp_peer_ast_hash_mix(&ase->mac_addr);
+
+	/* keep same-MAC entries in insertion order across the tables */
+	if (soc->ast_hash.old_table)
+		dp_peer_ast_hash_migrate_bin(soc, hash &
+					     soc->ast_hash.old_table->mask);
+
+	table = soc->ast_hash.table;
+	lock = DP_AST_HASH_LOCK(soc, hash);
+	qdf_spin_lock_bh(lock);
+	TAILQ_INSERT_TAIL(&table->bins[hash & table->mask], ase,
+			  hash_list_elem);
+	qdf_spin_unlock_bh(lock);
+
+	dp_peer_ast_hash_rehash_step(soc);
+	dp_peer_ast_hash_grow(soc);
 }
 
 /*
@@ -379,23 +732,158 @@ static inline void dp_peer_ast_hash_add(struct dp_soc *soc,
 void dp_peer_ast_hash_remove(struct dp_soc *soc,
 			     struct dp_ast_entry *ase)
 {
-	unsigned index;
+	struct dp_ast_hash_table *table = soc->ast_hash.old_table;
+	struct dp_ast_hash_bin *bin = NULL;
 	struct dp_ast_entry *tmpase;
-	int found = 0;
+	qdf_spinlock_t *lock;
+	uint32_t hash;
+
+	hash = dp_peer_ast_hash_mix(&ase->mac_addr);
+	lock = DP_AST_HASH_LOCK(soc, hash);
+
+	qdf_spin_lock_bh(lock);
+	if (table) {
+		TAILQ_FOREACH(tmpase, &table->bins[hash & table->mask],
+			      hash_list_elem) {
+			if (tmpase == ase) {
+				bin = &table->bins[hash & table->mask];
+				break;
+			}
+		}
+	}
 
-	index = dp_peer_ast_hash_index(soc, &ase->mac_addr);
-	/* Check if tail is not empty before delete*/
-	QDF_ASSERT(!TAILQ_EMPTY(&soc->ast_hash.bins[index]));
+	table = soc->ast_hash.table;
+	if (!bin) {
+		/* Check if tail is not empty before delete*/
+		QDF_ASSERT(!TAILQ_EMPTY(&table->bins[hash & table->mask]));
 
-	TAILQ_FOREACH(tmpase, &soc->ast_hash.bins[index], hash_list_elem) {
-		if (tmpase == ase) {
-			found = 1;
-			break;
+		TAILQ_FOREACH(tmpase, &table->bins[hash & table->mask],
+			      hash_list_elem) {
+			if (tmpase == ase) {
+				bin = &table->bins[hash & table->mask];
+				break;
+			}
 		}
 	}
 
-	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->ast_hash.bins[index], ase, hash_list_elem);
+	QDF_ASSERT(bin);
+	if (bin)
+		TAILQ_REMOVE(bin, ase, hash_list_elem);
+	qdf_spin_unlock_bh(lock);
+
+	dp_peer_ast_hash_rehash_step(soc);
+}
+
+/*
+ * dp_peer_ast_hash_peek() - Look up AST entry without taking the ast lock
+ * @soc: SoC handle
+ * @ast_mac_addr: mac address
+ * @pdev_id: pdev id to match if @match_pdev is set
+ * @match_pdev: match pdev_id along with the MAC address
+ * @info: filled with a snapshot of the entry, may be NULL
+ *
+ * Only the bucket group lock is taken, so this does not serialize against
+ * AST add/delete on other buckets and is meant for the per-frame lookups.
+ * The snapshot peer pointer carries no reference and is only valid for
+ * comparison.
+ *
+ * Return: true if an AST entry exists for the MAC address
+ */
+bool dp_peer_ast_hash_peek(struct dp_soc *soc, uint8_t *ast_mac_addr,
+			   uint8_t pdev_id, bool match_pdev,
+			   struct dp_ast_peek_info *info)
+{
+	union dp_align_mac_addr local_mac_addr_aligned;
+	struct dp_ast_entry *ase;
+	qdf_spinlock_t *lock;
+	uint32_t hash;
+
+	qdf_mem_copy(&local_mac_addr_aligned.raw[0],
+		     ast_mac_addr, QDF_MAC_ADDR_SIZE);
+	hash = dp_peer_ast_hash_mix(&local_mac_addr_aligned);
+	lock = DP_AST_HASH_LOCK(soc, hash);
+
+	qdf_spin_lock_bh(lock);
+	ase = dp_peer_ast_hash_lookup(soc, hash, &local_mac_addr_aligned,
+				      pdev_id, match_pdev);
+	if (ase && info) {
+		info->peer = ase->peer;
+		info->pdev_id = ase->pdev_id;
+		info->type = ase->type;
+	}
+	qdf_spin_unlock_bh(lock);
+
+	return !!ase;
+}
+
+/*
+ * dp_peer_ast_hash_table_stats() - Accumulate bucket stats of a table
+ * @table: AST hash table
+ * @max_chain: longest chain length
+ * @empty_bins: number of empty buckets
+ *
+ * Return: None
+ */
+static void dp_peer_ast_hash_table_stats(struct dp_ast_hash_table *table,
+					 uint32_t *max_chain,
+					 uint32_t *empty_bins)
+{
+	struct dp_ast_entry *ase;
+	unsigned int index;
+	uint32_t len;
+
+	if (!table)
+		return;
+
+	for (index = 0; index <= table->mask; index++) {
+		len = 0;
+		TAILQ_FOREACH(ase, &table->bins[index], hash_list_elem)
+			len++;
+
+		if (!len)
+			(*empty_bins)++;
+		if (len > *max_chain)
+			*max_chain = len;
+	}
+}
+
+/*
+ * dp_print_ast_hash_stats() - Print AST hash table occupancy
+ * @soc: SoC handle
+ *
+ * It assumes caller has taken the ast lock
+ *
+ * Return: None
+ */
+void dp_print_ast_hash_stats(struct dp_soc *soc)
+{
+	struct dp_ast_hash_table *table = soc->ast_hash.table;
+	struct dp_ast_hash_table *old_table = soc->ast_hash.old_table;
+	uint32_t max_chain = 0, empty_bins = 0, bins, load;
+
+	if (!table)
+		return;
+
+	dp_peer_ast_hash_table_stats(old_table, &max_chain, &empty_bins);
+	dp_peer_ast_hash_table_stats(table, &max_chain, &empty_bins);
+
+	bins = table->mask + 1;
+	if (old_table)
+		bins += old_table->mask + 1;
+	load = (soc->num_ast_entries * 100) / bins;
+
+	DP_PRINT_STATS("AST Hash:");
+	DP_PRINT_STATS("	Bins = %u (max %u) Empty bins = %u",
+		       bins, 1 << soc->ast_hash.max_idx_bits, empty_bins);
+	DP_PRINT_STATS("	Load factor = %u.%02u Max chain length = %u",
+		       load / 100, load % 100, max_chain);
+	DP_PRINT_STATS("	Resizes = %u Resize fail = %u Migrated = %u",
+		       soc->stats.ast.hash_resize,
+		       soc->stats.ast.hash_resize_fail,
+		       soc->stats.ast.hash_migrated);
+	if (old_table)
+		DP_PRINT_STATS("	Rehash progress = %u/%u",
+			       soc->ast_hash.rehash_idx, old_table->mask + 1);
 }
 
 /*
@@ -440,22 +928,13 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_pdevid(struct dp_soc *soc,
 						     uint8_t pdev_id)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
-	uint32_t index;
-	struct dp_ast_entry *ase;
 
 	qdf_mem_copy(&local_mac_addr_aligned.raw[0],
 		     ast_mac_addr, QDF_MAC_ADDR_SIZE);
 	mac_addr = &local_mac_addr_aligned;
 
-	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
-		if ((pdev_id == ase->pdev_id) &&
-		    !dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr)) {
-			return ase;
-		}
-	}
-
-	return NULL;
+	return dp_peer_ast_hash_lookup(soc, dp_peer_ast_hash_mix(mac_addr),
+				       mac_addr, pdev_id, true);
 }
 
 /*
@@ -471,21 +950,13 @@ struct dp_ast_entry *dp_peer_ast_hash_find_soc(struct dp_soc *soc,
 					       uint8_t *ast_mac_addr)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
-	unsigned index;
-	struct dp_ast_entry *ase;
 
 	qdf_mem_copy(&local_mac_addr_aligned.raw[0],
 			ast_mac_addr, QDF_MAC_ADDR_SIZE);
 	mac_addr = &local_mac_addr_aligned;
 
-	index = dp_peer_ast_hash_index(soc, mac_addr);
-	TAILQ_FOREACH(ase, &soc->ast_hash.bins[index], hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &ase->mac_addr) == 0) {
-			return ase;
-		}
-	}
-
-	return NULL;
+	return dp_peer_ast_hash_lookup(soc, dp_peer_ast_hash_mix(mac_addr),
+				       mac_addr, 0, false);
 }
 
 /*
@@ -826,9 +1297,9 @@ add_ast_entry:
 	ast_entry->is_active = TRUE;
 	DP_STATS_INC(soc, ast.added, 1);
 	soc->num_ast_entries++;
-	dp_peer_ast_hash_add(soc, ast_entry);
-
+	/* set before the entry becomes visible to dp_peer_ast_hash_peek() */
 	ast_entry->peer = peer;
+	dp_peer_ast_hash_add(soc, ast_entry);
 
 	if (type == CDP_TXRX_AST_TYPE_MEC)
 		qdf_mem_copy(next_node_mac, peer->vdev->mac_addr.raw, 6);
@@ -850,13 +1321,12 @@ add_ast_entry:
 				mac_addr,
 				next_node_mac,
 				flags,
-				ast_entry->type)) {
-			qdf_spin_unlock_bh(&soc->ast_lock);
-			return 0;
-		}
+				ast_entry->type))
+			ret = 0;
 	}
 
 	qdf_spin_unlock_bh(&soc->ast_lock);
+	dp_peer_ast_hash_resize(soc);
 	return ret;
 }
 
@@ -1121,6 +1591,17 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_pdevid(struct dp_soc *soc,
 	return NULL;
 }
 
+bool dp_peer_ast_hash_peek(struct dp_soc *soc, uint8_t *ast_mac_addr,
+			   uint8_t pdev_id, bool match_pdev,
+			   struct dp_ast_peek_info *info)
+{
+	return false;
+}
+
+void dp_print_ast_hash_stats(struct dp_soc *soc)
+{
+}
+
 static int dp_peer_ast_hash_attach(struct dp_soc *soc)
 {
 	return 0;
@@ -1329,6 +1810,52 @@ static int dp_peer_ast_free_entry_by_mac(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef DP_PEER_LOOKUP_RCU
+struct dp_peer *dp_peer_find_hash_find(struct dp_soc *soc,
+	uint8_t *peer_mac_addr, int mac_addr_is_aligned, uint8_t vdev_id)
+{
+	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
+	unsigned index;
+	struct dp_peer *peer;
+
+	if (mac_addr_is_aligned) {
+		mac_addr = (union dp_align_mac_addr *) peer_mac_addr;
+	} else {
+		qdf_mem_copy(
+			&local_mac_addr_aligned.raw[0],
+			peer_mac_addr, QDF_MAC_ADDR_SIZE);
+		mac_addr = &local_mac_addr_aligned;
+	}
+	index = dp_peer_find_hash_index(soc, mac_addr);
+
+	qdf_rcu_read_lock();
+	for (peer = qdf_rcu_dereference(
+			TAILQ_FIRST(&soc->peer_hash.bins[index]));
+	     peer;
+	     peer = qdf_rcu_dereference(TAILQ_NEXT(peer, hash_list_elem))) {
+		/*
+		 * Match on the cached vdev id, the peer memory is freed
+		 * through call_rcu but its vdev may already be gone once
+		 * the ref count dropped to zero. A reference is only taken
+		 * on a match, so no reference is ever dropped here.
+		 */
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) ||
+		    (peer->vdev_id != vdev_id && vdev_id != DP_VDEV_ALL))
+			continue;
+
+		if (qdf_unlikely(!qdf_atomic_inc_not_zero(&peer->ref_cnt))) {
+			qdf_atomic_inc(&soc->stats.peer_find.rcu_del_race);
+			continue;
+		}
+
+		qdf_rcu_read_unlock();
+		return peer;
+	}
+	qdf_rcu_read_unlock();
+
+	return NULL; /* failure */
+}
+#else
 struct dp_peer *dp_peer_find_hash_find(struct dp_soc *soc,
 	uint8_t *peer_mac_addr, int mac_addr_is_aligned, uint8_t vdev_id)
 {
@@ -1345,7 +1872,7 @@ struct dp_peer *dp_peer_find_hash_find(struct dp_soc *soc,
 		mac_addr = &local_mac_addr_aligned;
 	}
 	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(soc);
 	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
 			((peer->vdev->vdev_id == vdev_id) ||
@@ -1354,13 +1881,14 @@ struct dp_peer *dp_peer_find_hash_find(struct dp_soc *soc,
 			 * the lock
 			 */
 			qdf_atomic_inc(&peer->ref_cnt);
-			qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+			dp_peer_ref_mutex_unlock(soc);
 			return peer;
 		}
 	}
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 	return NULL; /* failure */
 }
+#endif /* DP_PEER_LOOKUP_RCU */
 
 void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 {
@@ -1392,7 +1920,7 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 		}
 	}
 	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	dp_peer_hash_bin_remove(&soc->peer_hash.bins[index], peer);
 }
 
 void dp_peer_find_hash_erase(struct dp_soc *soc)
@@ -1570,6 +2098,45 @@ void dp_rx_tid_stats_cb(struct dp_soc *soc, void *cb_ctxt,
 			rx_tid->pn_size);
 }
 
+#ifdef DP_PEER_LOOKUP_RCU
+/**
+ * dp_peer_id_map_publish() - Make a peer visible in peer_id_to_obj_map
+ * @soc: DP SOC handle
+ * @peer_id: peer id assigned by firmware
+ * @peer: peer to publish
+ *
+ * Return: None
+ */
+static inline void dp_peer_id_map_publish(struct dp_soc *soc,
+					  uint16_t peer_id,
+					  struct dp_peer *peer)
+{
+	qdf_rcu_assign_pointer(soc->peer_id_to_obj_map[peer_id], peer);
+}
+
+/**
+ * dp_peer_find_map_sync() - Wait for deferred peer frees to complete
+ * @soc: DP SOC handle
+ *
+ * Return: None
+ */
+static inline void dp_peer_find_map_sync(struct dp_soc *soc)
+{
+	qdf_rcu_barrier();
+}
+#else
+static inline void dp_peer_id_map_publish(struct dp_soc *soc,
+					  uint16_t peer_id,
+					  struct dp_peer *peer)
+{
+	soc->peer_id_to_obj_map[peer_id] = peer;
+}
+
+static inline void dp_peer_find_map_sync(struct dp_soc *soc)
+{
+}
+#endif /* DP_PEER_LOOKUP_RCU */
+
 static inline struct dp_peer *dp_peer_find_add_id(struct dp_soc *soc,
 	uint8_t *peer_mac_addr, uint16_t peer_id, uint16_t hw_peer_id,
 	uint8_t vdev_id)
@@ -1592,7 +2159,7 @@ static inline struct dp_peer *dp_peer_find_add_id(struct dp_soc *soc,
 			  "%s: ref_cnt: %d", __func__,
 			   qdf_atomic_read(&peer->ref_cnt));
 		if (!soc->peer_id_to_obj_map[peer_id])
-			soc->peer_id_to_obj_map[peer_id] = peer;
+			dp_peer_id_map_publish(soc, peer_id, peer);
 		else {
 			/* Peer map event came for peer_id which
 			 * is already mapped, this is not expected
@@ -1802,6 +2369,7 @@ dp_rx_peer_unmap_handler(struct dp_soc *soc, uint16_t peer_id,
 void
 dp_peer_find_detach(struct dp_soc *soc)
 {
+	dp_peer_find_map_sync(soc);
 	dp_peer_find_map_detach(soc);
 	dp_peer_find_hash_detach(soc);
 	dp_peer_ast_hash_detach(soc);
@@ -2538,6 +3106,7 @@ void dp_peer_rx_init(struct dp_pdev *pdev, struct dp_peer *peer)
 
 		rx_tid->defrag_waitlist_elem.tqe_next = NULL;
 		rx_tid->defrag_waitlist_elem.tqe_prev = NULL;
+		rx_tid->defrag_wheel_slot = DP_RX_DEFRAG_WHEEL_SLOTS;
 	}
 
 	peer->active_ba_session_cnt = 0;
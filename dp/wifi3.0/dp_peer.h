@@ -25,6 +25,33 @@
 #define DP_INVALID_PEER_ID 0xffff
 
 #define DP_FW_PEER_STATS_CMP_TIMEOUT_MSEC 5000
+
+/**
+ * dp_peer_ref_mutex_lock() - Take peer_ref_mutex and account contention
+ * @soc: core DP soc context
+ *
+ * Return: None
+ */
+static inline void dp_peer_ref_mutex_lock(struct dp_soc *soc)
+{
+	if (qdf_unlikely(!qdf_spin_trylock_bh(&soc->peer_ref_mutex))) {
+		qdf_spin_lock_bh(&soc->peer_ref_mutex);
+		soc->stats.peer_find.lock_contended++;
+	}
+	soc->stats.peer_find.lock_acquired++;
+}
+
+/**
+ * dp_peer_ref_mutex_unlock() - Release peer_ref_mutex
+ * @soc: core DP soc context
+ *
+ * Return: None
+ */
+static inline void dp_peer_ref_mutex_unlock(struct dp_soc *soc)
+{
+	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+}
+
 /**
  * __dp_peer_find_by_id() - Returns peer object given the peer id
  *
@@ -46,7 +73,7 @@ __dp_peer_find_by_id(struct dp_soc *soc,
 	return peer;
 }
 
-#ifdef PEER_PROTECTED_ACCESS
+#if defined(PEER_PROTECTED_ACCESS) && defined(DP_PEER_LOOKUP_RCU)
 /**
  * dp_peer_find_by_id() - Returns peer object given the peer id
  *                        if delete_in_progress in not set for peer
@@ -54,6 +81,10 @@ __dp_peer_find_by_id(struct dp_soc *soc,
  * @soc		: core DP soc context
  * @peer_id	: peer id from peer object can be retrieved
  *
+ * The peer_id_to_obj_map is read under RCU; the reference is only taken
+ * if the peer is not already on its way to deletion, and the peer memory
+ * is freed after a grace period, so no lock is needed.
+ *
  * Return: struct dp_peer*: Pointer to DP peer object
  */
 static inline
@@ -62,14 +93,48 @@ struct dp_peer *dp_peer_find_by_id(struct dp_soc *soc,
 {
 	struct dp_peer *peer;
 
-	qdf_spin_lock_bh(&soc->peer_ref_mutex);
+	if (qdf_unlikely(peer_id >= soc->max_peers))
+		return NULL;
+
+	qdf_rcu_read_lock();
+	peer = qdf_rcu_dereference(soc->peer_id_to_obj_map[peer_id]);
+	if (!peer || peer->delete_in_progress) {
+		qdf_rcu_read_unlock();
+		return NULL;
+	}
+
+	if (qdf_unlikely(!qdf_atomic_inc_not_zero(&peer->ref_cnt))) {
+		qdf_atomic_inc(&soc->stats.peer_find.rcu_del_race);
+		peer = NULL;
+	}
+	qdf_rcu_read_unlock();
+
+	return peer;
+}
+#elif defined(PEER_PROTECTED_ACCESS)
+/**
+ * dp_peer_find_by_id() - Returns peer object given the peer id
+ *                        if delete_in_progress in not set for peer
+ *
+ * @soc		: core DP soc context
+ * @peer_id	: peer id from peer object can be retrieved
+ *
+ * Return: struct dp_peer*: Pointer to DP peer object
+ */
+static inline
+struct dp_peer *dp_peer_find_by_id(struct dp_soc *soc,
+				   uint16_t peer_id)
+{
+	struct dp_peer *peer;
+
+	dp_peer_ref_mutex_lock(soc);
 	peer = __dp_peer_find_by_id(soc, peer_id);
 	if (!peer || (peer && peer->delete_in_progress)) {
-		qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+		dp_peer_ref_mutex_unlock(soc);
 		return NULL;
 	}
 	qdf_atomic_inc(&peer->ref_cnt);
-	qdf_spin_unlock_bh(&soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(soc);
 
 	return peer;
 }
@@ -151,6 +216,12 @@ struct dp_ast_entry *dp_peer_ast_hash_find_by_pdevid(struct dp_soc *soc,
 struct dp_ast_entry *dp_peer_ast_hash_find_soc(struct dp_soc *soc,
 					       uint8_t *ast_mac_addr);
 
+bool dp_peer_ast_hash_peek(struct dp_soc *soc, uint8_t *ast_mac_addr,
+			   uint8_t pdev_id, bool match_pdev,
+			   struct dp_ast_peek_info *info);
+
+void dp_print_ast_hash_stats(struct dp_soc *soc);
+
 struct dp_ast_entry *dp_peer_ast_list_find(struct dp_soc *soc,
 					   struct dp_peer *peer,
 					   uint8_t *ast_mac_addr);
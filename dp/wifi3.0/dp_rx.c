@@ -134,6 +134,119 @@ QDF_STATUS dp_rx_desc_sanity(struct dp_soc *soc, hal_soc_handle_t hal_soc,
 }
 #endif
 
+#ifdef QCA_DP_RX_NBUF_RECYCLE
+void dp_rx_nbuf_free(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	struct dp_rx_nbuf_recycle_pool *pool;
+	QDF_STATUS status;
+	int cpu;
+
+	qdf_local_bh_disable();
+	cpu = qdf_get_cpu();
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU))
+		goto free;
+
+	pool = &soc->rx_recycle[cpu];
+	if (!qdf_nbuf_is_recyclable(nbuf, RX_DATA_BUFFER_SIZE,
+				    RX_DATA_BUFFER_ALIGNMENT)) {
+		pool->not_recyclable++;
+		goto free;
+	}
+
+	if (pool->count >= DP_RX_NBUF_RECYCLE_MAX) {
+		pool->full++;
+		goto free;
+	}
+
+	qdf_nbuf_recycle_reset(nbuf, RX_BUFFER_RESERVATION,
+			       RX_DATA_BUFFER_ALIGNMENT);
+	status = qdf_nbuf_map_nbytes_single(soc->osdev, nbuf,
+					    QDF_DMA_FROM_DEVICE,
+					    RX_DATA_BUFFER_SIZE);
+	if (qdf_unlikely(QDF_IS_STATUS_ERROR(status)))
+		goto free;
+
+	qdf_nbuf_set_next(nbuf, pool->head);
+	pool->head = nbuf;
+	pool->count++;
+	pool->recycled++;
+	qdf_local_bh_enable();
+	return;
+
+free:
+	qdf_local_bh_enable();
+	qdf_nbuf_free(nbuf);
+}
+
+/**
+ * dp_rx_nbuf_recycle_get() - Get a mapped nbuf from this CPU's recycle pool
+ * @soc: core txrx main context
+ * @rx_desc_pool: Rx descriptor pool being replenished
+ *
+ * Only pools using RX_DATA_BUFFER_SIZE/RX_DATA_BUFFER_ALIGNMENT buffers
+ * are served, as that is what dp_rx_nbuf_free() recycles.
+ *
+ * Return: nbuf already mapped for QDF_DMA_FROM_DEVICE, or NULL
+ */
+static qdf_nbuf_t dp_rx_nbuf_recycle_get(struct dp_soc *soc,
+					 struct rx_desc_pool *rx_desc_pool)
+{
+	struct dp_rx_nbuf_recycle_pool *pool;
+	qdf_nbuf_t nbuf = NULL;
+	int cpu;
+
+	if (rx_desc_pool->buf_size != RX_DATA_BUFFER_SIZE ||
+	    rx_desc_pool->buf_alignment != RX_DATA_BUFFER_ALIGNMENT)
+		return NULL;
+
+	qdf_local_bh_disable();
+	cpu = qdf_get_cpu();
+	if (qdf_likely(cpu < QDF_MAX_AVAILABLE_CPU)) {
+		pool = &soc->rx_recycle[cpu];
+		nbuf = pool->head;
+		if (nbuf) {
+			pool->head = qdf_nbuf_next(nbuf);
+			qdf_nbuf_set_next(nbuf, NULL);
+			pool->count--;
+			pool->hit++;
+		} else {
+			pool->miss++;
+		}
+	}
+	qdf_local_bh_enable();
+
+	return nbuf;
+}
+
+void dp_rx_nbuf_recycle_pool_deinit(struct dp_soc *soc)
+{
+	struct dp_rx_nbuf_recycle_pool *pool;
+	qdf_nbuf_t nbuf, next;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		pool = &soc->rx_recycle[cpu];
+		nbuf = pool->head;
+		while (nbuf) {
+			next = qdf_nbuf_next(nbuf);
+			qdf_nbuf_unmap_nbytes_single(soc->osdev, nbuf,
+						     QDF_DMA_FROM_DEVICE,
+						     RX_DATA_BUFFER_SIZE);
+			qdf_nbuf_free(nbuf);
+			nbuf = next;
+		}
+		pool->head = NULL;
+		pool->count = 0;
+	}
+}
+#else
+static inline qdf_nbuf_t
+dp_rx_nbuf_recycle_get(struct dp_soc *soc, struct rx_desc_pool *rx_desc_pool)
+{
+	return NULL;
+}
+#endif
+
 /*
  * dp_rx_buffers_replenish() - replenish rxdma ring with rx nbufs
  *			       called during dp rx initialization
@@ -238,24 +351,31 @@ QDF_STATUS __dp_rx_buffers_replenish(struct dp_soc *dp_soc, uint32_t mac_id,
 	count = 0;
 
 	while (count < num_req_buffers) {
-		rx_netbuf = qdf_nbuf_alloc(dp_soc->osdev,
-					buf_size,
-					RX_BUFFER_RESERVATION,
-					buf_alignment,
-					FALSE);
-
-		if (qdf_unlikely(!rx_netbuf)) {
-			DP_STATS_INC(dp_pdev, replenish.nbuf_alloc_fail, 1);
-			break;
-		}
+		/* Recycled nbufs are already mapped */
+		rx_netbuf = dp_rx_nbuf_recycle_get(dp_soc, rx_desc_pool);
+		if (!rx_netbuf) {
+			rx_netbuf = qdf_nbuf_alloc(dp_soc->osdev,
+						   buf_size,
+						   RX_BUFFER_RESERVATION,
+						   buf_alignment,
+						   FALSE);
+
+			if (qdf_unlikely(!rx_netbuf)) {
+				DP_STATS_INC(dp_pdev,
+					     replenish.nbuf_alloc_fail, 1);
+				break;
+			}
 
-		ret = qdf_nbuf_map_nbytes_single(dp_soc->osdev, rx_netbuf,
-						 QDF_DMA_FROM_DEVICE, buf_size);
+			ret = qdf_nbuf_map_nbytes_single(dp_soc->osdev,
+							 rx_netbuf,
+							 QDF_DMA_FROM_DEVICE,
+							 buf_size);
 
-		if (qdf_unlikely(QDF_IS_STATUS_ERROR(ret))) {
-			qdf_nbuf_free(rx_netbuf);
-			DP_STATS_INC(dp_pdev, replenish.map_err, 1);
-			continue;
+			if (qdf_unlikely(QDF_IS_STATUS_ERROR(ret))) {
+				qdf_nbuf_free(rx_netbuf);
+				DP_STATS_INC(dp_pdev, replenish.map_err, 1);
+				continue;
+			}
 		}
 
 		paddr = qdf_nbuf_get_frag_paddr(rx_netbuf, 0);
@@ -444,6 +564,14 @@ dp_rx_da_learn(struct dp_soc *soc,
  * @ta_peer	: source peer entry
  * @rx_tlv_hdr	: start address of rx tlvs
  * @nbuf	: nbuf that has to be intrabss forwarded
+ * @msdu_metadata: msdu metadata
+ * @fwd_batch: batch the forwarded frames are queued to for TCL enqueue
+ *
+ * Unicast frames are handed to the TX batch with the TID and destination
+ * AST entry already known from RX. For mcast/bcast a clone, which shares
+ * the payload with the frame delivered to the stack, is forwarded; the
+ * stack unshares on write. A deep copy is only made when the TX path
+ * itself rewrites the payload (multipass VLAN tagging).
  *
  * Return: bool: true if it is forwarded else false
  */
@@ -452,7 +580,8 @@ dp_rx_intrabss_fwd(struct dp_soc *soc,
 			struct dp_peer *ta_peer,
 			uint8_t *rx_tlv_hdr,
 			qdf_nbuf_t nbuf,
-			struct hal_rx_msdu_metadata msdu_metadata)
+			struct hal_rx_msdu_metadata msdu_metadata,
+			struct dp_tx_fwd_batch *fwd_batch)
 {
 	uint16_t len;
 	uint8_t is_frag;
@@ -526,8 +655,10 @@ dp_rx_intrabss_fwd(struct dp_soc *soc,
 				}
 			}
 
-			if (!dp_tx_send((struct cdp_soc_t *)soc,
-					ta_peer->vdev->vdev_id, nbuf)) {
+			if (dp_tx_fwd_batch_add(soc, fwd_batch, ta_peer,
+						nbuf, tid, ring_id,
+						ast_entry) ==
+			    QDF_STATUS_SUCCESS) {
 				DP_STATS_INC_PKT(ta_peer, rx.intra_bss.pkts, 1,
 						 len);
 				return true;
@@ -558,7 +689,10 @@ dp_rx_intrabss_fwd(struct dp_soc *soc,
 		if (dp_get_peer_isolation(ta_peer))
 			goto end;
 
-		nbuf_copy = qdf_nbuf_copy(nbuf);
+		if (qdf_unlikely(ta_peer->vdev->multipass_en))
+			nbuf_copy = qdf_nbuf_copy(nbuf);
+		else
+			nbuf_copy = qdf_nbuf_clone(nbuf);
 		if (!nbuf_copy)
 			goto end;
 
@@ -567,8 +701,9 @@ dp_rx_intrabss_fwd(struct dp_soc *soc,
 
 		/* Set cb->ftype to intrabss FWD */
 		qdf_nbuf_set_tx_ftype(nbuf_copy, CB_FTYPE_INTRABSS_FWD);
-		if (dp_tx_send((struct cdp_soc_t *)soc,
-			       ta_peer->vdev->vdev_id, nbuf_copy)) {
+		if (dp_tx_fwd_batch_add(soc, fwd_batch, ta_peer,
+					nbuf_copy, tid, ring_id, NULL) !=
+		    QDF_STATUS_SUCCESS) {
 			DP_STATS_INC_PKT(ta_peer, rx.intra_bss.fail, 1, len);
 			tid_stats->fail_cnt[INTRABSS_DROP]++;
 			qdf_nbuf_free(nbuf_copy);
@@ -585,6 +720,66 @@ end:
 	return false;
 }
 
+/**
+ * dp_rx_intrabss_fwd_fail() - Handle intra-BSS frames TCL did not take
+ * @soc: core txrx main context
+ * @fwd_batch: flushed intra-BSS forward batch
+ *
+ * The frames were accounted as forwarded when they were queued to the
+ * batch, account them as intra-BSS failures instead. Unicast frames go up
+ * the stack, as when dp_rx_intrabss_fwd() fails to forward them, while
+ * the mcast/bcast copies are freed since the original was delivered.
+ *
+ * Return: none
+ */
+static void dp_rx_intrabss_fwd_fail(struct dp_soc *soc,
+				    struct dp_tx_fwd_batch *fwd_batch)
+{
+	struct cdp_tid_rx_stats *tid_stats;
+	qdf_ether_header_t *eh;
+	struct dp_peer *peer;
+	qdf_nbuf_t nbuf, next;
+	uint32_t len;
+
+	nbuf = fwd_batch->fail_head;
+	fwd_batch->fail_head = NULL;
+	fwd_batch->fail_tail = NULL;
+
+	for (; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		peer = dp_peer_find_by_id(soc, QDF_NBUF_CB_RX_PEER_ID(nbuf));
+		if (!peer) {
+			qdf_nbuf_free(nbuf);
+			continue;
+		}
+
+		len = qdf_nbuf_len(nbuf);
+		DP_STATS_DEC(peer, rx.intra_bss.pkts.num, 1);
+		DP_STATS_DEC(peer, rx.intra_bss.pkts.bytes, len);
+		DP_STATS_INC_PKT(peer, rx.intra_bss.fail, 1, len);
+
+		tid_stats = &peer->vdev->pdev->stats.tid_stats.
+			tid_rx_stats[QDF_NBUF_CB_RX_CTX_ID(nbuf)]
+				    [qdf_nbuf_get_tid_val(nbuf)];
+		tid_stats->intrabss_cnt--;
+		tid_stats->fail_cnt[INTRABSS_DROP]++;
+
+		eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
+		if (DP_FRAME_IS_MULTICAST(eh->ether_dhost)) {
+			qdf_nbuf_free(nbuf);
+		} else {
+			DP_PEER_RX_SHARD_STATS_INC_PKT(peer, to_stack, 1, len);
+			tid_stats->delivered_to_stack++;
+			dp_rx_deliver_to_stack(soc, peer->vdev, peer,
+					       nbuf, nbuf);
+		}
+
+		dp_peer_unref_del_find_by_id(peer);
+	}
+}
+
 #ifdef MESH_MODE_SUPPORT
 
 /**
@@ -1082,6 +1277,30 @@ static void dp_rx_fill_gro_info(struct dp_soc *soc, uint8_t *rx_tlv,
 }
 #endif /* RECEIVE_OFFLOAD */
 
+#ifdef HIF_EXEC_BUSY_POLL
+/**
+ * dp_rx_mark_napi_id() - stamp the NAPI id of the servicing context
+ * @int_ctx: interrupt context that reaped the msdu
+ * @nbuf: msdu delivered to the stack
+ *
+ * Sockets receiving the frame learn the NAPI id and may then busy poll
+ * the REO ring through napi_busy_loop().
+ *
+ * Return: None
+ */
+static inline void dp_rx_mark_napi_id(struct dp_intr *int_ctx,
+				      qdf_nbuf_t nbuf)
+{
+	if (int_ctx->napi)
+		qdf_nbuf_mark_napi_id(nbuf, int_ctx->napi);
+}
+#else
+static inline void dp_rx_mark_napi_id(struct dp_intr *int_ctx,
+				      qdf_nbuf_t nbuf)
+{
+}
+#endif
+
 /**
  * dp_rx_adjust_nbuf_len() - set appropriate msdu length in nbuf.
  *
@@ -1573,19 +1792,24 @@ static void dp_rx_msdu_stats_update(struct dp_soc *soc,
 	is_not_amsdu = qdf_nbuf_is_rx_chfrag_start(nbuf) &
 			qdf_nbuf_is_rx_chfrag_end(nbuf);
 
-	DP_STATS_INC_PKT(peer, rx.rcvd_reo[ring_id], 1, msdu_len);
-	DP_STATS_INCC(peer, rx.non_amsdu_cnt, 1, is_not_amsdu);
-	DP_STATS_INCC(peer, rx.amsdu_cnt, 1, !is_not_amsdu);
-	DP_STATS_INCC(peer, rx.rx_retries, 1, qdf_nbuf_is_rx_retry_flag(nbuf));
+	DP_PEER_RX_SHARD_STATS_RCVD(peer, ring_id, msdu_len);
+	DP_PEER_RX_SHARD_STATS_INCC(peer, non_amsdu_cnt, 1,
+				    is_not_amsdu);
+	DP_PEER_RX_SHARD_STATS_INCC(peer, amsdu_cnt, 1,
+				    !is_not_amsdu);
+	DP_PEER_RX_SHARD_STATS_INCC(peer, rx_retries, 1,
+				    qdf_nbuf_is_rx_retry_flag(nbuf));
 
 	tid_stats->msdu_cnt++;
 	if (qdf_unlikely(qdf_nbuf_is_da_mcbc(nbuf) &&
 			 (vdev->rx_decap_type == htt_cmn_pkt_type_ethernet))) {
 		eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
-		DP_STATS_INC_PKT(peer, rx.multicast, 1, msdu_len);
+		DP_PEER_RX_SHARD_STATS_INC_PKT(peer, multicast, 1,
+					       msdu_len);
 		tid_stats->mcast_msdu_cnt++;
 		if (QDF_IS_ADDR_BROADCAST(eh->ether_dhost)) {
-			DP_STATS_INC_PKT(peer, rx.bcast, 1, msdu_len);
+			DP_PEER_RX_SHARD_STATS_INC_PKT(peer, bcast, 1,
+						       msdu_len);
 			tid_stats->bcast_msdu_cnt++;
 		}
 	}
@@ -1909,13 +2133,15 @@ void dp_rx_set_hdr_pad(qdf_nbuf_t nbuf, uint32_t l3_padding)
  * @rx_tlv_hdr: start address of rx tlvs
  * @nbuf: nbuf that has to be intrabss forwarded
  * @msdu_metadata: msdu metadata
+ * @fwd_batch: batch the forwarded frames are queued to for TCL enqueue
  *
  * Return: true if it is forwarded else false
  */
 static inline
 bool dp_rx_intrabss_fwd_wrapper(struct dp_soc *soc, struct dp_peer *ta_peer,
 				uint8_t *rx_tlv_hdr, qdf_nbuf_t nbuf,
-				struct hal_rx_msdu_metadata msdu_metadata)
+				struct hal_rx_msdu_metadata msdu_metadata,
+				struct dp_tx_fwd_batch *fwd_batch)
 {
 	if (qdf_unlikely(qdf_nbuf_is_ipv4_eapol_pkt(nbuf) &&
 			 qdf_mem_cmp(qdf_nbuf_data(nbuf) +
@@ -1928,15 +2154,191 @@ bool dp_rx_intrabss_fwd_wrapper(struct dp_soc *soc, struct dp_peer *ta_peer,
 	}
 
 	return dp_rx_intrabss_fwd(soc, ta_peer, rx_tlv_hdr, nbuf,
-				  msdu_metadata);
+				  msdu_metadata, fwd_batch);
 
 }
-#define DP_RX_INTRABSS_FWD(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata) \
+#define DP_RX_INTRABSS_FWD(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata, \
+			   fwd_batch) \
 		dp_rx_intrabss_fwd_wrapper(soc, peer, rx_tlv_hdr, nbuf, \
-					   msdu_metadata)
+					   msdu_metadata, fwd_batch)
+#else
+#define DP_RX_INTRABSS_FWD(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata, \
+			   fwd_batch) \
+		dp_rx_intrabss_fwd(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata, \
+				   fwd_batch)
+#endif
+
+#ifdef QCA_DP_RX_REAP_PREFETCH
+/**
+ * dp_rx_reap_prefetch() - Prefetch ahead of the REO ring reap position
+ * @soc: core txrx main context
+ * @hal_soc: HAL SOC handle
+ * @hal_ring_hdl: REO destination ring being reaped
+ * @dist: prefetch distance in ring entries, 0 disables prefetching
+ *
+ * Called while entry N is reaped. Warms ring entry N + dist, the SW Rx
+ * descriptor of N + dist / 2 (whose ring entry was warmed earlier) and
+ * the nbuf of N + 1 (whose Rx descriptor was warmed earlier), so that
+ * each stage only touches lines fetched by a previous iteration.
+ *
+ * Return: None
+ */
+static inline void dp_rx_reap_prefetch(struct dp_soc *soc,
+				       hal_soc_handle_t hal_soc,
+				       hal_ring_handle_t hal_ring_hdl,
+				       uint8_t dist)
+{
+	hal_ring_desc_t ring_desc;
+	struct dp_rx_desc *rx_desc;
+
+	if (!dist)
+		return;
+
+	ring_desc = hal_srng_dst_peek_nth(hal_soc, hal_ring_hdl, dist);
+	if (ring_desc)
+		qdf_prefetch(ring_desc);
+
+	if (dist > 1) {
+		ring_desc = hal_srng_dst_peek_nth(hal_soc, hal_ring_hdl,
+						  dist >> 1);
+		if (ring_desc) {
+			rx_desc = dp_rx_cookie_2_va_rxdma_buf(soc,
+					HAL_RX_REO_BUF_COOKIE_GET(ring_desc));
+			if (rx_desc)
+				qdf_prefetch(rx_desc);
+		}
+	}
+
+	ring_desc = hal_srng_dst_peek_nth(hal_soc, hal_ring_hdl, 1);
+	if (ring_desc) {
+		rx_desc = dp_rx_cookie_2_va_rxdma_buf(soc,
+					HAL_RX_REO_BUF_COOKIE_GET(ring_desc));
+		if (rx_desc && rx_desc->nbuf)
+			qdf_prefetch(rx_desc->nbuf);
+	}
+}
+
+/**
+ * dp_rx_tlv_prefetch() - Prefetch the Rx TLVs of the next nbuf
+ * @nbuf: next nbuf to be processed, already unmapped
+ * @dist: prefetch distance, 0 disables prefetching
+ *
+ * Return: None
+ */
+static inline void dp_rx_tlv_prefetch(qdf_nbuf_t nbuf, uint8_t dist)
+{
+	struct rx_pkt_tlvs *pkt_tlvs;
+
+	if (!dist || !nbuf)
+		return;
+
+	pkt_tlvs = (struct rx_pkt_tlvs *)qdf_nbuf_data(nbuf);
+	qdf_prefetch(pkt_tlvs);
+	qdf_prefetch(&pkt_tlvs->attn_tlv);
+}
+#else
+static inline void dp_rx_reap_prefetch(struct dp_soc *soc,
+				       hal_soc_handle_t hal_soc,
+				       hal_ring_handle_t hal_ring_hdl,
+				       uint8_t dist)
+{
+}
+
+static inline void dp_rx_tlv_prefetch(qdf_nbuf_t nbuf, uint8_t dist)
+{
+}
+#endif
+
+#ifdef QCA_DP_RX_BATCH_UNMAP
+/* Synced past msdu_len + Rx TLVs to cover L3 header padding */
+#define DP_RX_PARTIAL_INV_MARGIN 64
+
+/**
+ * dp_rx_reap_nbuf_unmap() - Unmap a reaped Rx buffer
+ * @soc: core txrx main context
+ * @rx_desc: SW Rx descriptor of the reaped buffer
+ * @rx_desc_pool: Rx descriptor pool of @rx_desc
+ * @reo_ring_num: REO destination ring the buffer was reaped from
+ *
+ * The buffer is unmapped later along with the rest of the reaped list by
+ * dp_rx_reaped_list_unmap(), only the descriptor state is updated here.
+ *
+ * Return: None
+ */
+static inline void dp_rx_reap_nbuf_unmap(struct dp_soc *soc,
+					 struct dp_rx_desc *rx_desc,
+					 struct rx_desc_pool *rx_desc_pool,
+					 uint8_t reo_ring_num)
+{
+	rx_desc->unmapped = 1;
+}
+
+/**
+ * dp_rx_reaped_list_unmap() - Unmap all Rx buffers reaped in one pass
+ * @soc: core txrx main context
+ * @nbuf_list: reaped nbufs, linked through qdf_nbuf_next()
+ * @reo_ring_num: REO destination ring the buffers were reaped from
+ *
+ * IPA SMMU mappings are released for the whole list in one go. With
+ * dp_rx_partial_inv_enable set only msdu_len + RX_PKT_TLVS_LEN (plus
+ * margin) is made coherent for the CPU instead of the full Rx buffer.
+ *
+ * Return: None
+ */
+static void dp_rx_reaped_list_unmap(struct dp_soc *soc, qdf_nbuf_t nbuf_list,
+				    uint8_t reo_ring_num)
+{
+	bool partial = wlan_cfg_is_rx_partial_inv_enabled(soc->wlan_cfg_ctx);
+	uint64_t inv_bytes = 0;
+	uint32_t sync_len;
+	qdf_nbuf_t nbuf;
+
+	if (!nbuf_list)
+		return;
+
+	dp_ipa_handle_rx_buf_list_smmu_mapping(soc, nbuf_list,
+					       RX_DATA_BUFFER_SIZE, false);
+
+	for (nbuf = nbuf_list; nbuf; nbuf = qdf_nbuf_next(nbuf)) {
+		sync_len = RX_DATA_BUFFER_SIZE;
+		if (partial) {
+			sync_len = QDF_NBUF_CB_RX_PKT_LEN(nbuf) +
+				   RX_PKT_TLVS_LEN + DP_RX_PARTIAL_INV_MARGIN;
+			if (sync_len > RX_DATA_BUFFER_SIZE)
+				sync_len = RX_DATA_BUFFER_SIZE;
+		}
+
+		qdf_nbuf_unmap_nbytes_single_partial(soc->osdev, nbuf,
+						     QDF_DMA_FROM_DEVICE,
+						     RX_DATA_BUFFER_SIZE,
+						     sync_len);
+		inv_bytes += sync_len;
+	}
+
+	DP_STATS_INC(soc, rx.buf_inv_bytes[reo_ring_num], inv_bytes);
+}
 #else
-#define DP_RX_INTRABSS_FWD(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata) \
-		dp_rx_intrabss_fwd(soc, peer, rx_tlv_hdr, nbuf, msdu_metadata)
+static inline void dp_rx_reap_nbuf_unmap(struct dp_soc *soc,
+					 struct dp_rx_desc *rx_desc,
+					 struct rx_desc_pool *rx_desc_pool,
+					 uint8_t reo_ring_num)
+{
+	dp_ipa_handle_rx_buf_smmu_mapping(soc, rx_desc->nbuf,
+					  rx_desc_pool->buf_size,
+					  false);
+	qdf_nbuf_unmap_nbytes_single(soc->osdev, rx_desc->nbuf,
+				     QDF_DMA_FROM_DEVICE,
+				     rx_desc_pool->buf_size);
+	rx_desc->unmapped = 1;
+	DP_STATS_INC(soc, rx.buf_inv_bytes[reo_ring_num],
+		     rx_desc_pool->buf_size);
+}
+
+static inline void dp_rx_reaped_list_unmap(struct dp_soc *soc,
+					   qdf_nbuf_t nbuf_list,
+					   uint8_t reo_ring_num)
+{
+}
 #endif
 
 /**
@@ -1998,12 +2400,15 @@ uint32_t dp_rx_process(struct dp_intr *int_ctx, hal_ring_handle_t hal_ring_hdl,
 	uint32_t num_entries = 0;
 	struct hal_rx_msdu_metadata msdu_metadata;
 	QDF_STATUS status;
+	uint8_t prefetch_dist;
+	struct dp_tx_fwd_batch fwd_batch;
 
 	DP_HIST_INIT();
 
 	qdf_assert_always(soc && hal_ring_hdl);
 	hal_soc = soc->hal_soc;
 	qdf_assert_always(hal_soc);
+	prefetch_dist = wlan_cfg_get_dp_soc_rx_prefetch_dist(soc->wlan_cfg_ctx);
 
 	scn = soc->hif_handle;
 	hif_pm_runtime_mark_dp_rx_busy(scn);
@@ -2047,6 +2452,8 @@ more_data:
 			  (ring_desc = hal_srng_dst_peek(hal_soc,
 							 hal_ring_hdl)))) {
 
+		dp_rx_reap_prefetch(soc, hal_soc, hal_ring_hdl, prefetch_dist);
+
 		error = HAL_RX_ERROR_STATUS_GET(ring_desc);
 		ring_id = hal_srng_ring_id_get(hal_ring_hdl);
 
@@ -2213,13 +2620,8 @@ more_data:
 		 * in case double skb unmap happened.
 		 */
 		rx_desc_pool = &soc->rx_desc_buf[rx_desc->pool_id];
-		dp_ipa_handle_rx_buf_smmu_mapping(soc, rx_desc->nbuf,
-						  rx_desc_pool->buf_size,
-						  false);
-		qdf_nbuf_unmap_nbytes_single(soc->osdev, rx_desc->nbuf,
-					     QDF_DMA_FROM_DEVICE,
-					     rx_desc_pool->buf_size);
-		rx_desc->unmapped = 1;
+		dp_rx_reap_nbuf_unmap(soc, rx_desc, rx_desc_pool,
+				      reo_ring_num);
 		DP_RX_LIST_APPEND(nbuf_head, nbuf_tail, rx_desc->nbuf);
 
 		/*
@@ -2246,6 +2648,8 @@ more_data:
 done:
 	dp_rx_srng_access_end(int_ctx, soc, hal_ring_hdl);
 
+	dp_rx_reaped_list_unmap(soc, nbuf_head, reo_ring_num);
+
 	for (mac_id = 0; mac_id < MAX_PDEV_CNT; mac_id++) {
 		/*
 		 * continue with next mac_id if no pkts were reaped
@@ -2275,15 +2679,17 @@ done:
 	 * or a new nbuf dequeued from global queue has a different
 	 * vdev when compared to previous nbuf.
 	 */
+	dp_tx_fwd_batch_init(&fwd_batch);
 	nbuf = nbuf_head;
 	while (nbuf) {
 		next = nbuf->next;
+		dp_rx_tlv_prefetch(next, prefetch_dist);
 		rx_tlv_hdr = qdf_nbuf_data(nbuf);
 		vdev_id = QDF_NBUF_CB_RX_VDEV_ID(nbuf);
 
 		if (qdf_unlikely(hal_rx_attn_msdu_len_err_get(rx_tlv_hdr))) {
 			DP_STATS_INC(soc, rx.err.msdu_len_err, 1);
-			qdf_nbuf_free(nbuf);
+			dp_rx_nbuf_free(soc, nbuf);
 			nbuf = next;
 			continue;
 		}
@@ -2323,7 +2729,7 @@ done:
 		}
 
 		if (qdf_unlikely(!vdev)) {
-			qdf_nbuf_free(nbuf);
+			dp_rx_nbuf_free(soc, nbuf);
 			nbuf = next;
 			DP_STATS_INC(soc, rx.err.invalid_vdev, 1);
 			dp_peer_unref_del_find_by_id(peer);
@@ -2350,7 +2756,7 @@ done:
 			hal_rx_dump_pkt_tlvs(hal_soc, rx_tlv_hdr,
 					     QDF_TRACE_LEVEL_INFO);
 			tid_stats->fail_cnt[MSDU_DONE_FAILURE]++;
-			qdf_nbuf_free(nbuf);
+			dp_rx_nbuf_free(soc, nbuf);
 			qdf_assert(0);
 			nbuf = next;
 			continue;
@@ -2409,7 +2815,7 @@ done:
 				DP_STATS_INC(vdev->pdev, rx_raw_pkts, 1);
 				DP_STATS_INC_PKT(peer, rx.raw, 1, msdu_len);
 			} else {
-				qdf_nbuf_free(nbuf);
+				dp_rx_nbuf_free(soc, nbuf);
 				DP_STATS_INC(soc, rx.err.scatter_msdu, 1);
 				dp_info_rl("scatter msdu len %d, dropped",
 					   msdu_len);
@@ -2434,7 +2840,7 @@ done:
 		if (qdf_unlikely(vdev->multipass_en)) {
 			if (dp_rx_multipass_process(peer, nbuf, tid) == false) {
 				DP_STATS_INC(peer, rx.multipass_rx_pkt_drop, 1);
-				qdf_nbuf_free(nbuf);
+				dp_rx_nbuf_free(soc, nbuf);
 				nbuf = next;
 				dp_peer_unref_del_find_by_id(peer);
 				continue;
@@ -2447,7 +2853,7 @@ done:
 					FL("Policy Check Drop pkt"));
 			tid_stats->fail_cnt[POLICY_CHECK_DROP]++;
 			/* Drop & free packet */
-			qdf_nbuf_free(nbuf);
+			dp_rx_nbuf_free(soc, nbuf);
 			/* Statistics */
 			nbuf = next;
 			dp_peer_unref_del_find_by_id(peer);
@@ -2461,7 +2867,7 @@ done:
 				  false))) {
 			tid_stats->fail_cnt[NAWDS_MCAST_DROP]++;
 			DP_STATS_INC(peer, rx.nawds_mcast_drop, 1);
-			qdf_nbuf_free(nbuf);
+			dp_rx_nbuf_free(soc, nbuf);
 			nbuf = next;
 			dp_peer_unref_del_find_by_id(peer);
 			continue;
@@ -2478,7 +2884,7 @@ done:
 				DP_STATS_INC(soc,
 					     rx.err.peer_unauth_rx_pkt_drop,
 					     1);
-				qdf_nbuf_free(nbuf);
+				dp_rx_nbuf_free(soc, nbuf);
 				nbuf = next;
 				continue;
 			}
@@ -2507,7 +2913,7 @@ done:
 				DP_STATS_INC(vdev->pdev, dropped.mesh_filter,
 					     1);
 
-				qdf_nbuf_free(nbuf);
+				dp_rx_nbuf_free(soc, nbuf);
 				nbuf = next;
 				dp_peer_unref_del_find_by_id(peer);
 				continue;
@@ -2533,7 +2939,7 @@ done:
 			 */
 			if (!is_sa_da_idx_valid(soc, rx_tlv_hdr, nbuf,
 						msdu_metadata)) {
-				qdf_nbuf_free(nbuf);
+				dp_rx_nbuf_free(soc, nbuf);
 				nbuf = next;
 				DP_STATS_INC(soc, rx.err.invalid_sa_da_idx, 1);
 				dp_peer_unref_del_find_by_id(peer);
@@ -2553,7 +2959,8 @@ done:
 							peer,
 							rx_tlv_hdr,
 							nbuf,
-							msdu_metadata)) {
+							msdu_metadata,
+							&fwd_batch)) {
 					nbuf = next;
 					dp_peer_unref_del_find_by_id(peer);
 					tid_stats->intrabss_cnt++;
@@ -2562,18 +2969,23 @@ done:
 		}
 
 		dp_rx_fill_gro_info(soc, rx_tlv_hdr, nbuf, &rx_ol_pkt_cnt);
+		dp_rx_mark_napi_id(int_ctx, nbuf);
 
 		DP_RX_LIST_APPEND(deliver_list_head,
 				  deliver_list_tail,
 				  nbuf);
-		DP_STATS_INC_PKT(peer, rx.to_stack, 1,
-				 QDF_NBUF_CB_RX_PKT_LEN(nbuf));
+		DP_PEER_RX_SHARD_STATS_INC_PKT(peer, to_stack, 1,
+					       QDF_NBUF_CB_RX_PKT_LEN(nbuf));
 
 		tid_stats->delivered_to_stack++;
 		nbuf = next;
 		dp_peer_unref_del_find_by_id(peer);
 	}
 
+	dp_tx_fwd_batch_flush(soc, &fwd_batch);
+	if (qdf_unlikely(fwd_batch.fail_head))
+		dp_rx_intrabss_fwd_fail(soc, &fwd_batch);
+
 	if (qdf_likely(deliver_list_head)) {
 		if (qdf_likely(peer))
 			dp_rx_deliver_to_stack(soc, vdev, peer,
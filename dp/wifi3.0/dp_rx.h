@@ -1121,6 +1121,38 @@ void dp_rx_mon_update_protocol_flow_tag(struct dp_soc *soc,
 }
 #endif /* WLAN_SUPPORT_RX_PROTOCOL_TYPE_TAG || WLAN_SUPPORT_RX_FLOW_TAG */
 
+#ifdef QCA_DP_RX_NBUF_RECYCLE
+/**
+ * dp_rx_nbuf_free() - Free an Rx nbuf owned by DP
+ * @soc: core txrx main context
+ * @nbuf: nbuf to be freed, already unmapped
+ *
+ * Buffers which were never handed to the network stack are reset, mapped
+ * and parked in the per-CPU recycle pool for the next RXDMA replenish
+ * instead of being freed. Anything else is freed with qdf_nbuf_free().
+ *
+ * Return: None
+ */
+void dp_rx_nbuf_free(struct dp_soc *soc, qdf_nbuf_t nbuf);
+
+/**
+ * dp_rx_nbuf_recycle_pool_deinit() - Unmap and free all recycled nbufs
+ * @soc: core txrx main context
+ *
+ * Return: None
+ */
+void dp_rx_nbuf_recycle_pool_deinit(struct dp_soc *soc);
+#else
+static inline void dp_rx_nbuf_free(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_free(nbuf);
+}
+
+static inline void dp_rx_nbuf_recycle_pool_deinit(struct dp_soc *soc)
+{
+}
+#endif
+
 /*
  * dp_rx_buffers_replenish() - replenish rxdma ring with rx nbufs
  *			       called during dp rx initialization
@@ -147,11 +147,35 @@ void dp_rx_reorder_flush_frag(struct dp_peer *peer,
 	dp_rx_defrag_cleanup(peer, tid);
 }
 
+/*
+ * dp_rx_defrag_waitlist_unlink(): Take a TID off the defrag wait list
+ * @soc: DP SOC
+ * @rx_tid: TID waiting for fragments
+ *
+ * Caller holds the defrag lock
+ *
+ * Returns: None
+ */
+static inline void dp_rx_defrag_waitlist_unlink(struct dp_soc *soc,
+						struct dp_rx_tid *rx_tid)
+{
+	TAILQ_REMOVE(&soc->rx.defrag.waitlist[rx_tid->defrag_wheel_slot],
+		     rx_tid, defrag_waitlist_elem);
+	rx_tid->defrag_waitlist_elem.tqe_prev = NULL;
+	rx_tid->defrag_wheel_slot = DP_RX_DEFRAG_WHEEL_SLOTS;
+	soc->rx.defrag.waitlist_len--;
+	DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
+}
+
 /*
  * dp_rx_defrag_waitlist_flush(): Flush SOC defrag wait list
  * @soc: DP SOC
  *
- * Flush fragments of all waitlisted TID's
+ * Flush fragments of all waitlisted TID's which timed out. The wait list
+ * is a timer wheel of DP_RX_DEFRAG_WHEEL_SLOTS slots hashed on the
+ * timeout, so only the slots whose tick elapsed since the last flush are
+ * walked. If more than DP_RX_DEFRAG_WAITLIST_MAX TIDs are waiting, the
+ * sequences closest to their timeout are evicted as well.
  *
  * Returns: None
  */
@@ -160,6 +184,8 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 	struct dp_rx_tid *rx_reorder = NULL;
 	struct dp_rx_tid *tmp;
 	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	uint32_t now_tick = now_ms / DP_RX_DEFRAG_WHEEL_GRAN_MS;
+	uint32_t tick, slot;
 	TAILQ_HEAD(, dp_rx_tid) temp_list;
 
 	TAILQ_INIT(&temp_list);
@@ -168,30 +194,53 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 		  FL("Current time  %u"), now_ms);
 
 	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		uint32_t tid;
+	tick = soc->rx.defrag.wheel_tick;
+	if (now_tick - tick >= DP_RX_DEFRAG_WHEEL_SLOTS)
+		tick = now_tick - DP_RX_DEFRAG_WHEEL_SLOTS + 1;
+
+	for (; soc->rx.defrag.waitlist_len && tick <= now_tick; tick++) {
+		slot = tick & (DP_RX_DEFRAG_WHEEL_SLOTS - 1);
+		TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist[slot],
+				   defrag_waitlist_elem, tmp) {
+			/* Due in a later turn of the wheel */
+			if (rx_reorder->defrag_timeout_ms > now_ms)
+				continue;
+
+			if (rx_reorder->tid >= DP_MAX_TIDS) {
+				qdf_assert(0);
+				continue;
+			}
 
-		if (rx_reorder->defrag_timeout_ms > now_ms)
-			break;
+			dp_rx_defrag_waitlist_unlink(soc, rx_reorder);
+			DP_STATS_INC(soc, rx.rx_frag_timeout, 1);
 
-		tid = rx_reorder->tid;
-		if (tid >= DP_MAX_TIDS) {
-			qdf_assert(0);
-			continue;
+			/* Move to temp list and clean-up later */
+			TAILQ_INSERT_TAIL(&temp_list, rx_reorder,
+					  defrag_waitlist_elem);
 		}
+	}
 
-		TAILQ_REMOVE(&soc->rx.defrag.waitlist, rx_reorder,
-			     defrag_waitlist_elem);
-		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
+	for (tick = now_tick + 1;
+	     soc->rx.defrag.waitlist_len > DP_RX_DEFRAG_WAITLIST_MAX &&
+	     tick <= now_tick + DP_RX_DEFRAG_WHEEL_SLOTS; tick++) {
+		slot = tick & (DP_RX_DEFRAG_WHEEL_SLOTS - 1);
+		TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist[slot],
+				   defrag_waitlist_elem, tmp) {
+			if (soc->rx.defrag.waitlist_len <=
+			    DP_RX_DEFRAG_WAITLIST_MAX)
+				break;
 
-		/* Move to temp list and clean-up later */
-		TAILQ_INSERT_TAIL(&temp_list, rx_reorder,
-				  defrag_waitlist_elem);
+			dp_rx_defrag_waitlist_unlink(soc, rx_reorder);
+			DP_STATS_INC(soc, rx.rx_frag_evict, 1);
+			TAILQ_INSERT_TAIL(&temp_list, rx_reorder,
+					  defrag_waitlist_elem);
+		}
 	}
-	if (rx_reorder) {
+
+	soc->rx.defrag.wheel_tick = now_tick;
+	if (soc->rx.defrag.waitlist_len) {
 		soc->rx.defrag.next_flush_ms =
-			rx_reorder->defrag_timeout_ms;
+			(now_tick + 1) * DP_RX_DEFRAG_WHEEL_GRAN_MS;
 	} else {
 		soc->rx.defrag.next_flush_ms =
 			now_ms + soc->rx.defrag.timeout_ms;
@@ -206,6 +255,7 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 		qdf_spin_lock_bh(&rx_reorder->tid_lock);
 		TAILQ_REMOVE(&temp_list, rx_reorder,
 			     defrag_waitlist_elem);
+		rx_reorder->defrag_waitlist_elem.tqe_prev = NULL;
 		/* get address of current peer */
 		peer =
 			container_of(rx_reorder, struct dp_peer,
@@ -230,7 +280,7 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
  * @peer: Pointer to the peer data structure
  * @tid: Transmit ID (TID)
  *
- * Appends per-tid fragments to global fragment wait list
+ * Adds per-tid fragments to the wheel slot of their timeout
  *
  * Returns: None
  */
@@ -238,17 +288,35 @@ static void dp_rx_defrag_waitlist_add(struct dp_peer *peer, unsigned tid)
 {
 	struct dp_soc *psoc = peer->vdev->pdev->soc;
 	struct dp_rx_tid *rx_reorder = &peer->rx_tid[tid];
+	uint32_t now_ms;
+	uint8_t slot;
 
 	dp_debug("Adding TID %u to waitlist for peer %pK at MAC address %pM",
 		 tid, peer, peer->mac_addr.raw);
 
-	/* TODO: use LIST macros instead of TAIL macros */
+	slot = (rx_reorder->defrag_timeout_ms / DP_RX_DEFRAG_WHEEL_GRAN_MS) &
+		(DP_RX_DEFRAG_WHEEL_SLOTS - 1);
+
 	qdf_spin_lock_bh(&psoc->rx.defrag.defrag_lock);
-	if (TAILQ_EMPTY(&psoc->rx.defrag.waitlist))
+	if (!psoc->rx.defrag.waitlist_len) {
+		now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+		psoc->rx.defrag.wheel_tick = now_ms /
+					     DP_RX_DEFRAG_WHEEL_GRAN_MS;
 		psoc->rx.defrag.next_flush_ms = rx_reorder->defrag_timeout_ms;
-	TAILQ_INSERT_TAIL(&psoc->rx.defrag.waitlist, rx_reorder,
-				defrag_waitlist_elem);
+	} else if (rx_reorder->defrag_timeout_ms <
+		   psoc->rx.defrag.next_flush_ms) {
+		psoc->rx.defrag.next_flush_ms = rx_reorder->defrag_timeout_ms;
+	}
+
+	TAILQ_INSERT_TAIL(&psoc->rx.defrag.waitlist[slot], rx_reorder,
+			  defrag_waitlist_elem);
+	rx_reorder->defrag_wheel_slot = slot;
+	psoc->rx.defrag.waitlist_len++;
 	DP_STATS_INC(psoc, rx.rx_frag_wait, 1);
+
+	/* Let the next flush evict the oldest sequences */
+	if (psoc->rx.defrag.waitlist_len > DP_RX_DEFRAG_WAITLIST_MAX)
+		psoc->rx.defrag.next_flush_ms = 0;
 	qdf_spin_unlock_bh(&psoc->rx.defrag.defrag_lock);
 }
 
@@ -266,7 +334,6 @@ void dp_rx_defrag_waitlist_remove(struct dp_peer *peer, unsigned tid)
 	struct dp_pdev *pdev = peer->vdev->pdev;
 	struct dp_soc *soc = pdev->soc;
 	struct dp_rx_tid *rx_reorder;
-	struct dp_rx_tid *tmp;
 
 	dp_debug("Removing TID %u to waitlist for peer %pK at MAC address %pM",
 		 tid, peer, peer->mac_addr.raw);
@@ -276,23 +343,13 @@ void dp_rx_defrag_waitlist_remove(struct dp_peer *peer, unsigned tid)
 		qdf_assert_always(0);
 	}
 
-	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		struct dp_peer *peer_on_waitlist;
-
-		/* get address of current peer */
-		peer_on_waitlist =
-			container_of(rx_reorder, struct dp_peer,
-				     rx_tid[rx_reorder->tid]);
+	rx_reorder = &peer->rx_tid[tid];
 
-		/* Ensure it is TID for same peer */
-		if (peer_on_waitlist == peer && rx_reorder->tid == tid) {
-			TAILQ_REMOVE(&soc->rx.defrag.waitlist,
-				rx_reorder, defrag_waitlist_elem);
-			DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
-		}
-	}
+	/* TIDs moved to a flush temp list are not on the wheel any more */
+	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
+	if (rx_reorder->defrag_waitlist_elem.tqe_prev &&
+	    rx_reorder->defrag_wheel_slot < DP_RX_DEFRAG_WHEEL_SLOTS)
+		dp_rx_defrag_waitlist_unlink(soc, rx_reorder);
 	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
 }
 
@@ -319,6 +376,7 @@ static QDF_STATUS dp_rx_defrag_fraglist_insert(struct dp_peer *peer, unsigned ti
 	uint16_t head_fragno, cur_fragno, next_fragno;
 	uint8_t last_morefrag = 1, count = 0;
 	struct dp_rx_tid *rx_tid = &peer->rx_tid[tid];
+	struct dp_soc *soc = peer->vdev->pdev->soc;
 	uint8_t *rx_desc_info;
 
 
@@ -353,7 +411,7 @@ static QDF_STATUS dp_rx_defrag_fraglist_insert(struct dp_peer *peer, unsigned ti
 		head_fragno = dp_rx_frag_get_mpdu_frag_number(rx_desc_info);
 
 		if (cur_fragno == head_fragno) {
-			qdf_nbuf_free(frag);
+			dp_rx_nbuf_free(soc, frag);
 			goto insert_fail;
 		} else if (head_fragno > cur_fragno) {
 			qdf_nbuf_set_next(frag, cur);
@@ -370,7 +428,7 @@ static QDF_STATUS dp_rx_defrag_fraglist_insert(struct dp_peer *peer, unsigned ti
 			}
 
 			if (cur_fragno == head_fragno) {
-				qdf_nbuf_free(frag);
+				dp_rx_nbuf_free(soc, frag);
 				goto insert_fail;
 			}
 
@@ -875,6 +933,7 @@ dp_rx_construct_fraglist(struct dp_peer *peer, int tid, qdf_nbuf_t head,
 {
 	qdf_nbuf_t msdu = qdf_nbuf_next(head);
 	qdf_nbuf_t rx_nbuf = msdu;
+	qdf_nbuf_t next;
 	struct dp_rx_tid *rx_tid = &peer->rx_tid[tid];
 	uint32_t len = 0;
 	uint64_t cur_pn128[2] = {0, 0}, prev_pn128[2];
@@ -921,6 +980,30 @@ dp_rx_construct_fraglist(struct dp_peer *peer, int tid, qdf_nbuf_t head,
 		msdu = qdf_nbuf_next(msdu);
 	}
 
+	/*
+	 * The head fragment sits in a full sized RX buffer, so a sequence
+	 * of a few small fragments usually fits in its tailroom. Copy it in
+	 * place and hand a linear buffer on instead of a fraglist which is
+	 * linearized again further up the stack. The buffer keeps the head
+	 * fragment TLVs, whose l3 header padding does not describe the
+	 * reassembled frame, so it is still marked as frag for the rx path
+	 * to only strip the TLVs.
+	 */
+	if (len <= qdf_nbuf_tailroom(head)) {
+		for (msdu = rx_nbuf; msdu; msdu = next) {
+			next = qdf_nbuf_next(msdu);
+			qdf_mem_copy(qdf_nbuf_put_tail(head,
+						       qdf_nbuf_len(msdu)),
+				     qdf_nbuf_data(msdu), qdf_nbuf_len(msdu));
+			qdf_nbuf_free(msdu);
+		}
+		qdf_nbuf_set_next(head, NULL);
+		qdf_nbuf_set_is_frag(head, 1);
+		DP_STATS_INC(peer->vdev->pdev->soc, rx.rx_frag_linear, 1);
+
+		return QDF_STATUS_SUCCESS;
+	}
+
 	qdf_nbuf_append_ext_list(head, rx_nbuf, len);
 	qdf_nbuf_set_next(head, NULL);
 	qdf_nbuf_set_is_frag(head, 1);
@@ -988,7 +1071,9 @@ static void dp_rx_defrag_err(struct dp_vdev *vdev, qdf_nbuf_t nbuf)
  * @nbuf: Pointer to the fragment buffer
  * @hdrsize: Size of headers
  *
- * Transcap the fragment from 802.11 to 802.3
+ * Transcap the fragment from 802.11 to 802.3. The addresses are read from
+ * the RX TLVs in place, then the TLVs are moved up over the 802.11 header
+ * so they end right in front of the new 802.3 header.
  *
  * Returns: None
  */
@@ -1000,13 +1085,15 @@ dp_rx_defrag_nwifi_to_8023(struct dp_soc *soc, struct dp_peer *peer, int tid,
 	struct ethernet_hdr_t *eth_hdr;
 	uint8_t ether_type[2];
 	uint16_t fc = 0;
-	union dp_align_mac_addr mac_addr;
-	uint8_t *rx_desc_info = qdf_mem_malloc(RX_PKT_TLVS_LEN);
+	union dp_align_mac_addr da, sa;
+	uint8_t *rx_desc_info = qdf_nbuf_data(nbuf);
 	struct rx_pkt_tlvs *rx_pkt_tlv =
 				(struct rx_pkt_tlvs *)qdf_nbuf_data(nbuf);
 	struct rx_mpdu_info *rx_mpdu_info_details =
 		&rx_pkt_tlv->mpdu_start_tlv.rx_mpdu_start.rx_mpdu_info_details;
 	struct dp_rx_tid *rx_tid = &peer->rx_tid[tid];
+	uint16_t hdr_pull_len = hdrsize + sizeof(struct llc_snap_hdr_t) -
+				sizeof(struct ethernet_hdr_t);
 
 	dp_debug("head_nbuf pn_31_0 0x%x pn_63_32 0x%x pn_95_64 0x%x pn_127_96 0x%x\n",
 		 rx_mpdu_info_details->pn_31_0, rx_mpdu_info_details->pn_63_32,
@@ -1018,72 +1105,36 @@ dp_rx_defrag_nwifi_to_8023(struct dp_soc *soc, struct dp_peer *peer, int tid,
 	rx_tid->pn128[1] = rx_mpdu_info_details->pn_95_64;
 	rx_tid->pn128[1] |= ((uint64_t)rx_mpdu_info_details->pn_127_96 << 32);
 
-	if (!rx_desc_info) {
-		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
-			"%s: Memory alloc failed ! ", __func__);
-		QDF_ASSERT(0);
-		return;
-	}
-
-	qdf_mem_copy(rx_desc_info, qdf_nbuf_data(nbuf), RX_PKT_TLVS_LEN);
-
 	llchdr = (struct llc_snap_hdr_t *)(qdf_nbuf_data(nbuf) +
 					RX_PKT_TLVS_LEN + hdrsize);
 	qdf_mem_copy(ether_type, llchdr->ethertype, 2);
 
-	qdf_nbuf_pull_head(nbuf, (RX_PKT_TLVS_LEN + hdrsize +
-				  sizeof(struct llc_snap_hdr_t) -
-				  sizeof(struct ethernet_hdr_t)));
-
-	eth_hdr = (struct ethernet_hdr_t *)(qdf_nbuf_data(nbuf));
-
 	if (hal_rx_get_mpdu_frame_control_valid(soc->hal_soc,
 						rx_desc_info))
 		fc = hal_rx_get_frame_ctrl_field(rx_desc_info);
 
 	dp_debug("%s: frame control type: 0x%x", __func__, fc);
 
+	qdf_mem_zero(&da, sizeof(da));
+	qdf_mem_zero(&sa, sizeof(sa));
+
 	switch (((fc & 0xff00) >> 8) & IEEE80211_FC1_DIR_MASK) {
 	case IEEE80211_FC1_DIR_NODS:
-		hal_rx_mpdu_get_addr1(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->dest_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
-		hal_rx_mpdu_get_addr2(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->src_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
+		hal_rx_mpdu_get_addr1(soc->hal_soc, rx_desc_info, &da.raw[0]);
+		hal_rx_mpdu_get_addr2(soc->hal_soc, rx_desc_info, &sa.raw[0]);
 		break;
 	case IEEE80211_FC1_DIR_TODS:
-		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->dest_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
-		hal_rx_mpdu_get_addr2(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->src_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
+		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info, &da.raw[0]);
+		hal_rx_mpdu_get_addr2(soc->hal_soc, rx_desc_info, &sa.raw[0]);
 		break;
 	case IEEE80211_FC1_DIR_FROMDS:
-		hal_rx_mpdu_get_addr1(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->dest_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
-		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->src_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
+		hal_rx_mpdu_get_addr1(soc->hal_soc, rx_desc_info, &da.raw[0]);
+		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info, &sa.raw[0]);
 		break;
 
 	case IEEE80211_FC1_DIR_DSTODS:
-		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->dest_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
-		hal_rx_mpdu_get_addr4(soc->hal_soc, rx_desc_info,
-				      &mac_addr.raw[0]);
-		qdf_mem_copy(eth_hdr->src_addr, &mac_addr.raw[0],
-			QDF_MAC_ADDR_SIZE);
+		hal_rx_mpdu_get_addr3(soc->hal_soc, rx_desc_info, &da.raw[0]);
+		hal_rx_mpdu_get_addr4(soc->hal_soc, rx_desc_info, &sa.raw[0]);
 		break;
 
 	default:
@@ -1091,12 +1142,17 @@ dp_rx_defrag_nwifi_to_8023(struct dp_soc *soc, struct dp_peer *peer, int tid,
 		"%s: Unknown frame control type: 0x%x", __func__, fc);
 	}
 
+	/* TLVs overlap their new place, the 802.11 header is overwritten */
+	qdf_mem_move(qdf_nbuf_data(nbuf) + hdr_pull_len, qdf_nbuf_data(nbuf),
+		     RX_PKT_TLVS_LEN);
+	qdf_nbuf_pull_head(nbuf, hdr_pull_len);
+
+	eth_hdr = (struct ethernet_hdr_t *)(qdf_nbuf_data(nbuf) +
+					    RX_PKT_TLVS_LEN);
+	qdf_mem_copy(eth_hdr->dest_addr, &da.raw[0], QDF_MAC_ADDR_SIZE);
+	qdf_mem_copy(eth_hdr->src_addr, &sa.raw[0], QDF_MAC_ADDR_SIZE);
 	qdf_mem_copy(eth_hdr->ethertype, ether_type,
 			sizeof(ether_type));
-
-	qdf_nbuf_push_head(nbuf, RX_PKT_TLVS_LEN);
-	qdf_mem_copy(qdf_nbuf_data(nbuf), rx_desc_info, RX_PKT_TLVS_LEN);
-	qdf_mem_free(rx_desc_info);
 }
 
 #ifdef RX_DEFRAG_DO_NOT_REINJECT
@@ -1491,6 +1547,25 @@ static QDF_STATUS dp_rx_defrag(struct dp_peer *peer, unsigned tid,
 	return QDF_STATUS_SUCCESS;
 }
 
+/*
+ * dp_rx_defrag_reasm_stats_update(): Account a reassembled sequence
+ * @soc: DP SOC
+ * @rx_tid: TID the sequence was reassembled on
+ *
+ * Returns: None
+ */
+static inline void dp_rx_defrag_reasm_stats_update(struct dp_soc *soc,
+						   struct dp_rx_tid *rx_tid)
+{
+	uint32_t lat_ms = qdf_system_ticks_to_msecs(qdf_system_ticks()) -
+			  rx_tid->defrag_start_ms;
+
+	DP_STATS_INC(soc, rx.rx_frag_reasm, 1);
+	DP_STATS_INC(soc, rx.rx_frag_reasm_lat_ms, lat_ms);
+	if (lat_ms > soc->stats.rx.rx_frag_reasm_lat_max_ms)
+		DP_STATS_UPD(soc, rx.rx_frag_reasm_lat_max_ms, lat_ms);
+}
+
 /*
  * dp_rx_defrag_cleanup(): Clean up activities
  * @peer: Pointer to the peer
@@ -1710,12 +1785,16 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 			 * new sequence number to be processed
 			 */
 			rx_tid->curr_seq_num = rxseq;
+			rx_tid->defrag_start_ms =
+				qdf_system_ticks_to_msecs(qdf_system_ticks());
 		}
 	} else {
 		dp_debug("cur rxseq %d\n", rxseq);
 		/* Start of a new sequence */
 		dp_rx_defrag_cleanup(peer, tid);
 		rx_tid->curr_seq_num = rxseq;
+		rx_tid->defrag_start_ms =
+			qdf_system_ticks_to_msecs(qdf_system_ticks());
 		/* store PN number also */
 	}
 
@@ -1807,6 +1886,7 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 	if (QDF_IS_STATUS_SUCCESS(status)) {
 		rx_reorder_array_elem->head = NULL;
 		rx_reorder_array_elem->tail = NULL;
+		dp_rx_defrag_reasm_stats_update(soc, rx_tid);
 		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_DEBUG,
 			  "Fragmented sequence successfully reinjected");
 	} else {
@@ -1822,7 +1902,7 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 
 discard_frag:
-	qdf_nbuf_free(frag);
+	dp_rx_nbuf_free(soc, frag);
 	dp_rx_add_to_free_desc_list(head, tail, rx_desc);
 	if (dp_rx_link_desc_return(soc, ring_desc,
 				   HAL_BM_ACTION_PUT_IN_IDLE_LIST) !=
@@ -1954,7 +2034,7 @@ QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 			peer->peer_id,
 			peer->mac_addr.raw);
 		DP_STATS_INC(soc, rx.err.defrag_peer_uninit, 1);
-		qdf_nbuf_free(nbuf);
+		dp_rx_nbuf_free(soc, nbuf);
 		goto fail;
 	}
 
@@ -1968,10 +2048,14 @@ QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
 			  "%s: No list found for TID %d Seq# %d",
 				__func__, tid, rxseq);
-		qdf_nbuf_free(nbuf);
+		dp_rx_nbuf_free(soc, nbuf);
 		goto fail;
 	}
 
+	if (!rx_reorder_array_elem->head)
+		rx_tid->defrag_start_ms =
+			qdf_system_ticks_to_msecs(qdf_system_ticks());
+
 	msdu_len = hal_rx_msdu_start_msdu_len_get(qdf_nbuf_data(nbuf));
 
 	qdf_nbuf_set_pktlen(nbuf, (msdu_len + RX_PKT_TLVS_LEN));
@@ -2022,6 +2106,7 @@ QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 	if (QDF_IS_STATUS_SUCCESS(status)) {
 		rx_reorder_array_elem->head = NULL;
 		rx_reorder_array_elem->tail = NULL;
+		dp_rx_defrag_reasm_stats_update(soc, rx_tid);
 		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO,
 			  "%s: Frag seq successfully reinjected",
 			__func__);
@@ -54,6 +54,8 @@ static inline bool dp_rx_mcast_echo_check(struct dp_soc *soc,
 {
 	struct dp_vdev *vdev = peer->vdev;
 	struct dp_ast_entry *ase = NULL;
+	struct dp_ast_peek_info sa_info;
+	bool found;
 	uint16_t sa_idx = 0;
 	uint8_t *data;
 
@@ -92,20 +94,17 @@ static inline bool dp_rx_mcast_echo_check(struct dp_soc *soc,
 	 * wireless STAs MAC addr which are behind the Repeater,
 	 * then drop the pkt as it is looped back
 	 */
-	qdf_spin_lock_bh(&soc->ast_lock);
 	if (hal_rx_msdu_end_sa_is_valid_get(soc->hal_soc, rx_tlv_hdr)) {
 		sa_idx = hal_rx_msdu_end_sa_idx_get(soc->hal_soc, rx_tlv_hdr);
 
 		if ((sa_idx < 0) ||
 		    (sa_idx >= wlan_cfg_get_max_ast_idx(soc->wlan_cfg_ctx))) {
-			qdf_spin_unlock_bh(&soc->ast_lock);
 			QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_ERROR,
 					"invalid sa_idx: %d", sa_idx);
 			qdf_assert_always(0);
 		}
 
-		ase = soc->ast_table[sa_idx];
-		if (!ase) {
+		if (qdf_unlikely(!soc->ast_table[sa_idx])) {
 			/* We do not get a peer map event for STA and without
 			 * this event we don't know what is STA's sa_idx.
 			 * For this reason the AST is still not associated to
@@ -114,35 +113,42 @@ static inline bool dp_rx_mcast_echo_check(struct dp_soc *soc,
 			 * ast is not in ast_table, we use the below API to get
 			 * AST entry for STA's own mac_address.
 			 */
+			qdf_spin_lock_bh(&soc->ast_lock);
 			ase = dp_peer_ast_list_find(soc, peer,
 						    &data[QDF_MAC_ADDR_SIZE]);
-			if (ase) {
+			if (ase && !soc->ast_table[sa_idx]) {
 				ase->ast_idx = sa_idx;
 				soc->ast_table[sa_idx] = ase;
 				ase->is_mapped = TRUE;
 			}
+			qdf_spin_unlock_bh(&soc->ast_lock);
 		}
+
+		/* HW found the SA, it may belong to the other radio */
+		found = dp_peer_ast_hash_peek(soc, &data[QDF_MAC_ADDR_SIZE],
+					      vdev->pdev->pdev_id, true,
+					      &sa_info) ||
+			dp_peer_ast_hash_peek(soc, &data[QDF_MAC_ADDR_SIZE],
+					      0, false, &sa_info);
 	} else {
-		ase = dp_peer_ast_hash_find_by_pdevid(soc,
-						      &data[QDF_MAC_ADDR_SIZE],
-						      vdev->pdev->pdev_id);
+		found = dp_peer_ast_hash_peek(soc, &data[QDF_MAC_ADDR_SIZE],
+					      vdev->pdev->pdev_id, true,
+					      &sa_info);
 	}
 
-	if (ase) {
+	if (found) {
 
-		if (ase->pdev_id != vdev->pdev->pdev_id) {
-			qdf_spin_unlock_bh(&soc->ast_lock);
+		if (sa_info.pdev_id != vdev->pdev->pdev_id) {
 			QDF_TRACE(QDF_MODULE_ID_DP,
 				QDF_TRACE_LEVEL_INFO,
 				"Detected DBDC Root AP %pM, %d %d",
 				&data[QDF_MAC_ADDR_SIZE], vdev->pdev->pdev_id,
-				ase->pdev_id);
+				sa_info.pdev_id);
 			return false;
 		}
 
-		if ((ase->type == CDP_TXRX_AST_TYPE_MEC) ||
-				(ase->peer != peer)) {
-			qdf_spin_unlock_bh(&soc->ast_lock);
+		if ((sa_info.type == CDP_TXRX_AST_TYPE_MEC) ||
+				(sa_info.peer != peer)) {
 			QDF_TRACE(QDF_MODULE_ID_DP,
 				QDF_TRACE_LEVEL_INFO,
 				"received pkt with same src mac %pM",
@@ -151,7 +157,6 @@ static inline bool dp_rx_mcast_echo_check(struct dp_soc *soc,
 			return true;
 		}
 	}
-	qdf_spin_unlock_bh(&soc->ast_lock);
 	return false;
 }
 
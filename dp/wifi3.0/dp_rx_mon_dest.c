@@ -473,6 +473,147 @@ void dp_rx_msdus_set_payload(struct dp_soc *soc, qdf_nbuf_t msdu)
 	qdf_nbuf_pull_head(msdu, rx_pkt_offset + l2_hdr_offset);
 }
 
+/*
+ * DP_RX_MON_FRAG_RESTITCH is not enabled by default as the monitor
+ * consumers must accept non-linear MPDUs. Platforms whose monitor
+ * interface handles paged skbs enable it from the driver build config,
+ * e.g. "ccflags-y += -DDP_RX_MON_FRAG_RESTITCH" in the wlan Kbuild.
+ * restitch_frag_mpdu/restitch_frag_fallback of the rx monitor stats show
+ * whether the fast path is taken.
+ */
+#ifdef DP_RX_MON_FRAG_RESTITCH
+/**
+ * dp_rx_mon_frag_restitch_eligible() - check if an MPDU can be restitched
+ *					without copying the MSDU payloads
+ * @dp_pdev: pdev handle
+ * @head_msdu: head of the MSDU list of the MPDU
+ *
+ * Return: true if every MSDU can be attached as a page fragment
+ */
+static inline
+bool dp_rx_mon_frag_restitch_eligible(struct dp_pdev *dp_pdev,
+				      qdf_nbuf_t head_msdu)
+{
+	qdf_nbuf_t msdu;
+	uint32_t num_msdus = 0;
+
+	for (msdu = head_msdu; msdu; msdu = qdf_nbuf_next(msdu)) {
+		if (!qdf_nbuf_is_frag_attachable(msdu) ||
+		    ++num_msdus > qdf_nbuf_get_max_frags()) {
+			dp_pdev->rx_mon_stats.restitch_frag_fallback++;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * dp_rx_mon_restitch_mpdu_frags() - restitch a decapped MPDU with the MSDU
+ *				     payloads referenced as page fragments
+ * @soc: core txrx main context
+ * @dp_pdev: pdev handle
+ * @head_msdu: head of the MSDU list of the MPDU
+ * @hdr_desc: 802.11 header of the first MSDU from the RX TLVs
+ * @wifi_hdr_len: length of the 802.11 header including security header
+ * @msdu_llc_len: length of the LLC (and A-MSDU subframe) header per MSDU
+ * @decap_hdr_pull_bytes: decap header to knock off each MSDU
+ *
+ * Only the 802.11 header and the first LLC header are written into a new
+ * nbuf, which keeps MAX_MONITOR_HEADER of headroom for the radiotap header.
+ * The LLC header and A-MSDU pad of the following MSDUs are written into
+ * their own headroom, freed by the decap pull, so that no payload is copied.
+ * The MSDU nbufs are released once their pages are referenced by the MPDU.
+ * As the MSDU nbufs do not outlive the restitch, protocol and flow tags of
+ * the first MSDU are applied to the MPDU.
+ *
+ * Return: MPDU nbuf on success, NULL on failure in which case the MSDU list
+ *	   is left to the caller to free
+ */
+static qdf_nbuf_t
+dp_rx_mon_restitch_mpdu_frags(struct dp_soc *soc, struct dp_pdev *dp_pdev,
+			      qdf_nbuf_t head_msdu, char *hdr_desc,
+			      uint32_t wifi_hdr_len, uint32_t msdu_llc_len,
+			      uint32_t decap_hdr_pull_bytes)
+{
+	qdf_nbuf_t mpdu_buf, msdu, msdu_next;
+	uint32_t amsdu_pad = 0, payload_len;
+	unsigned char *dest;
+	void *rx_desc;
+
+	mpdu_buf = qdf_nbuf_alloc(soc->osdev,
+				  MAX_MONITOR_HEADER + wifi_hdr_len +
+				  msdu_llc_len,
+				  MAX_MONITOR_HEADER, 4, FALSE);
+	if (!mpdu_buf)
+		return NULL;
+
+	dest = qdf_nbuf_put_tail(mpdu_buf, wifi_hdr_len + msdu_llc_len);
+	if (!dest)
+		goto fail;
+
+	qdf_mem_copy(dest, hdr_desc, wifi_hdr_len + msdu_llc_len);
+
+	rx_desc = qdf_nbuf_data(head_msdu);
+	dp_rx_mon_update_protocol_flow_tag(soc, dp_pdev, mpdu_buf, rx_desc);
+
+	for (msdu = head_msdu; msdu; msdu = qdf_nbuf_next(msdu)) {
+		rx_desc = qdf_nbuf_data(msdu);
+		hdr_desc = HAL_RX_DESC_GET_80211_HDR(rx_desc);
+
+		dp_rx_msdus_set_payload(soc, msdu);
+		qdf_nbuf_pull_head(msdu, decap_hdr_pull_bytes);
+		payload_len = qdf_nbuf_len(msdu);
+
+		/* pad of the previous subframe precedes this subframe header */
+		if (msdu != head_msdu) {
+			dest = qdf_nbuf_push_head(msdu,
+						  amsdu_pad + msdu_llc_len);
+			qdf_mem_zero(dest, amsdu_pad);
+			qdf_mem_copy(dest + amsdu_pad, hdr_desc, msdu_llc_len);
+		}
+
+		amsdu_pad = (msdu_llc_len + payload_len) & 0x3;
+		amsdu_pad = amsdu_pad ? (4 - amsdu_pad) : 0;
+
+		if (qdf_nbuf_attach_as_rx_frag(mpdu_buf, msdu) !=
+		    QDF_STATUS_SUCCESS)
+			goto fail;
+	}
+
+	msdu = head_msdu;
+	while (msdu) {
+		msdu_next = qdf_nbuf_next(msdu);
+		qdf_nbuf_free(msdu);
+		msdu = msdu_next;
+	}
+
+	dp_pdev->rx_mon_stats.restitch_frag_mpdu++;
+
+	return mpdu_buf;
+
+fail:
+	qdf_nbuf_free(mpdu_buf);
+	return NULL;
+}
+#else
+static inline
+bool dp_rx_mon_frag_restitch_eligible(struct dp_pdev *dp_pdev,
+				      qdf_nbuf_t head_msdu)
+{
+	return false;
+}
+
+static inline qdf_nbuf_t
+dp_rx_mon_restitch_mpdu_frags(struct dp_soc *soc, struct dp_pdev *dp_pdev,
+			      qdf_nbuf_t head_msdu, char *hdr_desc,
+			      uint32_t wifi_hdr_len, uint32_t msdu_llc_len,
+			      uint32_t decap_hdr_pull_bytes)
+{
+	return NULL;
+}
+#endif /* DP_RX_MON_FRAG_RESTITCH */
+
 static inline
 qdf_nbuf_t dp_rx_mon_restitch_mpdu_from_msdus(struct dp_soc *soc,
 	uint32_t mac_id, qdf_nbuf_t head_msdu, qdf_nbuf_t last_msdu,
@@ -642,6 +783,15 @@ qdf_nbuf_t dp_rx_mon_restitch_mpdu_from_msdus(struct dp_soc *soc,
 	/* "Decap" header to remove from MSDU buffer */
 	decap_hdr_pull_bytes = 14;
 
+	if (dp_rx_mon_frag_restitch_eligible(dp_pdev, head_msdu)) {
+		mpdu_buf = dp_rx_mon_restitch_mpdu_frags(soc, dp_pdev,
+							 head_msdu, hdr_desc,
+							 wifi_hdr_len,
+							 msdu_llc_len,
+							 decap_hdr_pull_bytes);
+		goto mpdu_stitch_done;
+	}
+
 	/* Allocate a new nbuf for holding the 802.11 header retrieved from the
 	 * status of the now decapped first msdu. Leave enough headroom for
 	 * accomodating any radio-tap /prism like PHY header
@@ -921,6 +1071,15 @@ QDF_STATUS dp_rx_mon_deliver(struct dp_soc *soc, uint32_t mac_id,
 	return QDF_STATUS_SUCCESS;
 
 mon_deliver_fail:
+	/*
+	 * A restitched MPDU owns the MSDUs, either as its ext list or as
+	 * page fragments once the MSDU nbufs were released.
+	 */
+	if (mon_mpdu) {
+		qdf_nbuf_free(mon_mpdu);
+		return QDF_STATUS_E_INVAL;
+	}
+
 	mon_skb = head_msdu;
 	while (mon_skb) {
 		skb_next = qdf_nbuf_next(mon_skb);
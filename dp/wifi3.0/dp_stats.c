@@ -4434,6 +4434,7 @@ QDF_STATUS dp_peer_stats_notify(struct dp_pdev *dp_pdev, struct dp_peer *peer)
 	if ((peer_stats->rx.rssi && peer_stats_intf.rssi_changed) ||
 	    (peer_stats->tx.tx_rate &&
 	     peer_stats->tx.tx_rate != peer_stats->tx.last_tx_rate)) {
+		dp_peer_stats_shard_sync(peer);
 		qdf_mem_copy(peer_stats_intf.peer_mac, peer->mac_addr.raw,
 			     QDF_MAC_ADDR_SIZE);
 		peer_stats_intf.vdev_id = peer->vdev->vdev_id;
@@ -5728,6 +5729,8 @@ void dp_print_per_ring_stats(struct dp_soc *soc)
 		}
 		DP_PRINT_STATS("Total packets on ring %u: %llu",
 			       ring, total_packets);
+		DP_PRINT_STATS("Bytes invalidated on ring %u: %llu",
+			       ring, soc->stats.rx.buf_inv_bytes[ring]);
 	}
 }
 
@@ -6099,6 +6102,12 @@ dp_print_pdev_tx_stats(struct dp_pdev *pdev)
 		       pdev->stats.ack_ba_comes_twice);
 	DP_PRINT_STATS("ppdu dropped because of incomplete tlv: %llu",
 		       pdev->stats.ppdu_drop);
+	DP_PRINT_STATS("ppdu_info reused from slab: %llu",
+		       pdev->stats.ppdu_info_reuse);
+	DP_PRINT_STATS("ppdu_info allocated from heap: %llu",
+		       pdev->stats.ppdu_info_heap_alloc);
+	DP_PRINT_STATS("ppdu desc nbuf reused: %llu",
+		       pdev->stats.ppdu_desc_reuse);
 
 	for (i = 0; i < CDP_WDI_NUM_EVENTS; i++) {
 		if (!pdev->stats.wdi_event[i])
@@ -6250,8 +6259,69 @@ dp_print_pdev_rx_mon_stats(struct dp_pdev *pdev)
 	qdf_mem_free(dest_ring_ppdu_ids);
 	DP_PRINT_STATS("mon_rx_dest_stuck = %d",
 		       rx_mon_stats->mon_rx_dest_stuck);
+	DP_PRINT_STATS("restitch_frag_mpdu = %u",
+		       rx_mon_stats->restitch_frag_mpdu);
+	DP_PRINT_STATS("restitch_frag_fallback = %u",
+		       rx_mon_stats->restitch_frag_fallback);
 }
 
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/**
+ * dp_print_tx_desc_cpu_cache_stats() - Print per-CPU Tx descriptor cache
+ *					stats of a pool
+ * @pool: Tx descriptor pool
+ * @pool_id: pool id
+ *
+ * Return: None
+ */
+static void
+dp_print_tx_desc_cpu_cache_stats(struct dp_tx_desc_pool_s *pool,
+				 uint8_t pool_id)
+{
+	struct dp_tx_desc_cpu_cache *cache;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		cache = &pool->cpu_cache[cpu];
+		if (!cache->alloc_hit && !cache->alloc_miss &&
+		    !cache->free_hit)
+			continue;
+		DP_PRINT_STATS("Tx desc pool %u cpu %d: cached = %u alloc hit = %u miss = %u steal = %u free hit = %u drain = %u",
+			       pool_id, cpu, cache->count, cache->alloc_hit,
+			       cache->alloc_miss, cache->alloc_steal,
+			       cache->free_hit, cache->free_drain);
+	}
+}
+
+/**
+ * dp_tx_desc_pool_cached() - Free Tx descriptors held by the CPU caches
+ * @pool: Tx descriptor pool
+ *
+ * Return: number of descriptors parked in the CPU caches of @pool
+ */
+static uint32_t dp_tx_desc_pool_cached(struct dp_tx_desc_pool_s *pool)
+{
+	uint32_t cached = 0;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		cached += pool->cpu_cache[cpu].count;
+
+	return cached;
+}
+#else
+static inline void
+dp_print_tx_desc_cpu_cache_stats(struct dp_tx_desc_pool_s *pool,
+				 uint8_t pool_id)
+{
+}
+
+static inline uint32_t dp_tx_desc_pool_cached(struct dp_tx_desc_pool_s *pool)
+{
+	return 0;
+}
+#endif
+
 void
 dp_print_soc_tx_stats(struct dp_soc *soc)
 {
@@ -6265,10 +6335,16 @@ dp_print_soc_tx_stats(struct dp_soc *soc)
 	     desc_pool_id < wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
 	     desc_pool_id++)
 		soc->stats.tx.desc_in_use +=
-			soc->tx_desc[desc_pool_id].num_allocated;
+			soc->tx_desc[desc_pool_id].num_allocated -
+			dp_tx_desc_pool_cached(&soc->tx_desc[desc_pool_id]);
 
 	DP_PRINT_STATS("Tx Descriptors In Use = %d",
 		       soc->stats.tx.desc_in_use);
+	for (desc_pool_id = 0;
+	     desc_pool_id < wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
+	     desc_pool_id++)
+		dp_print_tx_desc_cpu_cache_stats(&soc->tx_desc[desc_pool_id],
+						 desc_pool_id);
 	DP_PRINT_STATS("Tx Invalid peer:");
 	DP_PRINT_STATS("	Packets = %d",
 		       soc->stats.tx.tx_invalid_peer.num);
@@ -6292,8 +6368,60 @@ dp_print_soc_tx_stats(struct dp_soc *soc)
 		       soc->stats.tx.tx_comp_loop_pkt_limit_hit);
 	DP_PRINT_STATS("Tx comp HP out of sync2 = %d",
 		       soc->stats.tx.hp_oos2);
+	DP_PRINT_STATS("Tx burst ring accesses = %u msdus = %u",
+		       soc->stats.tx.batch_enqueue,
+		       soc->stats.tx.batch_msdus);
 }
 
+#ifdef DP_INTR_ADAPTIVE_MODERATION
+/**
+ * dp_print_intr_mod_stats() - Print adaptive interrupt moderation state
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+static void dp_print_intr_mod_stats(struct dp_soc *soc)
+{
+	struct dp_intr_mod_record *record;
+	struct dp_intr_mod *mod;
+	int i, j, idx;
+
+	if (!wlan_cfg_is_intr_mod_enabled(soc->wlan_cfg_ctx))
+		return;
+
+	DP_PRINT_STATS("Interrupt moderation: timer %u-%u us, batch %u-%u",
+		       wlan_cfg_get_intr_mod_timer_min(soc->wlan_cfg_ctx),
+		       wlan_cfg_get_intr_mod_timer_max(soc->wlan_cfg_ctx),
+		       wlan_cfg_get_intr_mod_batch_min(soc->wlan_cfg_ctx),
+		       wlan_cfg_get_intr_mod_batch_max(soc->wlan_cfg_ctx));
+	for (i = 0; i < WLAN_CFG_INT_NUM_CONTEXTS; i++) {
+		mod = &soc->intr_ctx[i].intr_mod;
+		if (!mod->changes)
+			continue;
+		DP_PRINT_STATS("%3u: profile %u changes %u windows per profile %u %u %u %u %u",
+			       i, mod->profile, mod->changes,
+			       mod->profile_windows[0],
+			       mod->profile_windows[1],
+			       mod->profile_windows[2],
+			       mod->profile_windows[3],
+			       mod->profile_windows[4]);
+		for (j = 0; j < DP_INTR_MOD_HIST_SIZE; j++) {
+			idx = (mod->hist_idx + j) % DP_INTR_MOD_HIST_SIZE;
+			record = &mod->hist[idx];
+			if (!record->ts_us)
+				continue;
+			DP_PRINT_STATS("     ts %llu us: profile %u avg work %u avg gap %u us",
+				       record->ts_us, record->profile,
+				       record->avg_work, record->avg_gap_us);
+		}
+	}
+}
+#else
+static inline void dp_print_intr_mod_stats(struct dp_soc *soc)
+{
+}
+#endif
+
 void dp_print_soc_interrupt_stats(struct dp_soc *soc)
 {
 	int i = 0;
@@ -6318,7 +6446,40 @@ void dp_print_soc_interrupt_stats(struct dp_soc *soc)
 			       intr_stats->num_rxdma2host_ring_masks,
 			       intr_stats->num_host2rxdma_ring_masks);
 		}
+
+	dp_print_intr_mod_stats(soc);
+}
+
+#ifdef QCA_DP_RX_NBUF_RECYCLE
+/**
+ * dp_print_rx_nbuf_recycle_stats() - Print per-CPU Rx nbuf recycle stats
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+static void dp_print_rx_nbuf_recycle_stats(struct dp_soc *soc)
+{
+	struct dp_rx_nbuf_recycle_pool *pool;
+	uint32_t hit_rate;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		pool = &soc->rx_recycle[cpu];
+		if (!pool->hit && !pool->miss && !pool->recycled)
+			continue;
+		hit_rate = (pool->hit + pool->miss) ?
+			   (pool->hit * 100ULL) / (pool->hit + pool->miss) : 0;
+		DP_PRINT_STATS("Rx nbuf recycle cpu %d: depth = %u hit = %u miss = %u hit rate = %u%% recycled = %u not recyclable = %u full = %u",
+			       cpu, pool->count, pool->hit, pool->miss,
+			       hit_rate, pool->recycled,
+			       pool->not_recyclable, pool->full);
+	}
+}
+#else
+static inline void dp_print_rx_nbuf_recycle_stats(struct dp_soc *soc)
+{
 }
+#endif
 
 void
 dp_print_soc_rx_stats(struct dp_soc *soc)
@@ -6363,6 +6524,17 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("RX frags: %d", soc->stats.rx.rx_frags);
 	DP_PRINT_STATS("RX frag wait: %d", soc->stats.rx.rx_frag_wait);
 	DP_PRINT_STATS("RX frag err: %d", soc->stats.rx.rx_frag_err);
+	DP_PRINT_STATS("RX frag timeout: %u evict: %u",
+		       soc->stats.rx.rx_frag_timeout,
+		       soc->stats.rx.rx_frag_evict);
+	DP_PRINT_STATS("RX frag reassembled: %u linear: %u",
+		       soc->stats.rx.rx_frag_reasm,
+		       soc->stats.rx.rx_frag_linear);
+	DP_PRINT_STATS("RX frag reassembly latency avg: %llu ms max: %u ms",
+		       soc->stats.rx.rx_frag_reasm ?
+		       qdf_do_div(soc->stats.rx.rx_frag_reasm_lat_ms,
+				  soc->stats.rx.rx_frag_reasm) : 0,
+		       soc->stats.rx.rx_frag_reasm_lat_max_ms);
 
 	DP_PRINT_STATS("RX HP out_of_sync: %d", soc->stats.rx.hp_oos2);
 	DP_PRINT_STATS("RX Ring Near Full: %d", soc->stats.rx.near_full);
@@ -6422,6 +6594,8 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("REO Error(0-14):%s", reo_error);
 	DP_PRINT_STATS("REO CMD SEND FAIL: %d",
 		       soc->stats.rx.err.reo_cmd_send_fail);
+
+	dp_print_rx_nbuf_recycle_stats(soc);
 }
 
 #ifdef FEATURE_TSO_STATS
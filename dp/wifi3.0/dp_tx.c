@@ -156,6 +156,23 @@ dp_tx_outstanding_dec(struct dp_pdev *pdev)
 	qdf_atomic_dec(&soc->num_tx_outstanding);
 }
 
+/**
+ * dp_tx_outstanding_sub - Subtract a batch of completed tx descs from
+ *			   outstanding values on pdev and soc
+ * @pdev: DP pdev handle
+ * @count: number of completed descriptors
+ *
+ * Return: void
+ */
+static inline void
+dp_tx_outstanding_sub(struct dp_pdev *pdev, int count)
+{
+	struct dp_soc *soc = pdev->soc;
+
+	qdf_atomic_sub(count, &pdev->num_tx_outstanding);
+	qdf_atomic_sub(count, &soc->num_tx_outstanding);
+}
+
 #else //QCA_TX_LIMIT_CHECK
 static inline bool
 dp_tx_limit_check(struct dp_vdev *vdev)
@@ -180,6 +197,12 @@ dp_tx_outstanding_dec(struct dp_pdev *pdev)
 {
 	qdf_atomic_dec(&pdev->num_tx_outstanding);
 }
+
+static inline void
+dp_tx_outstanding_sub(struct dp_pdev *pdev, int count)
+{
+	qdf_atomic_sub(count, &pdev->num_tx_outstanding);
+}
 #endif //QCA_TX_LIMIT_CHECK
 
 #if defined(FEATURE_TSO)
@@ -1122,7 +1145,7 @@ static void dp_tx_raw_prepare_unset(struct dp_soc *soc,
 #endif
 
 /**
- * dp_tx_hw_enqueue() - Enqueue to TCL HW for transmit
+ * dp_tx_hw_desc_prepare() - Fill the cached TCL descriptor for an MSDU
  * @soc: DP Soc Handle
  * @vdev: DP vdev handle
  * @tx_desc: Tx Descriptor Handle
@@ -1130,28 +1153,23 @@ static void dp_tx_raw_prepare_unset(struct dp_soc *soc,
  * @fw_metadata: Metadata to send to Target Firmware along with frame
  * @ring_id: Ring ID of H/W ring to which we enqueue the packet
  * @tx_exc_metadata: Handle that holds exception path meta data
+ * @hal_tx_desc_cached: zeroed local copy of the TCL descriptor to fill
  *
- *  Gets the next free TCL HW DMA descriptor and sets up required parameters
- *  from software Tx descriptor
+ * Sets up the required HW descriptor parameters from the software Tx
+ * descriptor. No ring access is done here, so this can be called for
+ * every MSDU of a burst before the ring is accessed once.
  *
  * Return: QDF_STATUS_SUCCESS: success
  *         QDF_STATUS_E_RESOURCES: Error return
  */
-static QDF_STATUS dp_tx_hw_enqueue(struct dp_soc *soc, struct dp_vdev *vdev,
-				   struct dp_tx_desc_s *tx_desc, uint8_t tid,
-				   uint16_t fw_metadata, uint8_t ring_id,
-				   struct cdp_tx_exception_metadata
-					*tx_exc_metadata)
+static inline QDF_STATUS
+dp_tx_hw_desc_prepare(struct dp_soc *soc, struct dp_vdev *vdev,
+		      struct dp_tx_desc_s *tx_desc, uint8_t tid,
+		      uint16_t fw_metadata, uint8_t ring_id,
+		      struct cdp_tx_exception_metadata *tx_exc_metadata,
+		      uint32_t *hal_tx_desc_cached)
 {
 	uint8_t type;
-	void *hal_tx_desc;
-	uint32_t *hal_tx_desc_cached;
-
-	/*
-	 * Setting it initialization statically here to avoid
-	 * a memset call jump with qdf_mem_set call
-	 */
-	uint8_t cached_desc[HAL_TX_DESC_LEN_BYTES] = { 0 };
 
 	enum cdp_sec_type sec_type = ((tx_exc_metadata &&
 			tx_exc_metadata->sec_type != CDP_INVALID_SEC_TYPE) ?
@@ -1160,17 +1178,11 @@ static QDF_STATUS dp_tx_hw_enqueue(struct dp_soc *soc, struct dp_vdev *vdev,
 	/* Return Buffer Manager ID */
 	uint8_t bm_id = dp_tx_get_rbm_id(soc, ring_id);
 
-	hal_ring_handle_t hal_ring_hdl = NULL;
-
-	QDF_STATUS status = QDF_STATUS_E_RESOURCES;
-
 	if (!dp_tx_is_desc_id_valid(soc, tx_desc->id)) {
 		dp_err_rl("Invalid tx desc id:%d", tx_desc->id);
 		return QDF_STATUS_E_RESOURCES;
 	}
 
-	hal_tx_desc_cached = (void *) cached_desc;
-
 	if (tx_desc->flags & DP_TX_DESC_FLAG_FRAG) {
 		tx_desc->length = HAL_TX_EXT_DESC_WITH_META_DATA;
 		type = HAL_TX_BUF_TYPE_EXT_DESC;
@@ -1232,6 +1244,76 @@ static QDF_STATUS dp_tx_hw_enqueue(struct dp_soc *soc, struct dp_vdev *vdev,
 			 tx_desc->length, type, (uint64_t)tx_desc->dma_addr,
 			 tx_desc->pkt_offset, tx_desc->id);
 
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_tx_hw_ring_access_end() - Finish TCL ring access after enqueue
+ * @soc: DP Soc Handle
+ * @hal_ring_hdl: TCL ring handle
+ *
+ * Updates the ring head pointer if the target is awake, else defers the
+ * head pointer update to the runtime PM resume flush.
+ *
+ * Return: none
+ */
+static inline void dp_tx_hw_ring_access_end(struct dp_soc *soc,
+					    hal_ring_handle_t hal_ring_hdl)
+{
+	if (hif_pm_runtime_get(soc->hif_handle,
+			       RTPM_ID_DW_TX_HW_ENQUEUE) == 0) {
+		dp_tx_hal_ring_access_end(soc, hal_ring_hdl);
+		hif_pm_runtime_put(soc->hif_handle,
+				   RTPM_ID_DW_TX_HW_ENQUEUE);
+	} else {
+		dp_tx_hal_ring_access_end_reap(soc, hal_ring_hdl);
+		hal_srng_set_event(hal_ring_hdl, HAL_SRNG_FLUSH_EVENT);
+		hal_srng_inc_flush_cnt(hal_ring_hdl);
+	}
+}
+
+/**
+ * dp_tx_hw_enqueue() - Enqueue to TCL HW for transmit
+ * @soc: DP Soc Handle
+ * @vdev: DP vdev handle
+ * @tx_desc: Tx Descriptor Handle
+ * @tid: TID from HLOS for overriding default DSCP-TID mapping
+ * @fw_metadata: Metadata to send to Target Firmware along with frame
+ * @ring_id: Ring ID of H/W ring to which we enqueue the packet
+ * @tx_exc_metadata: Handle that holds exception path meta data
+ *
+ *  Gets the next free TCL HW DMA descriptor and sets up required parameters
+ *  from software Tx descriptor
+ *
+ * Return: QDF_STATUS_SUCCESS: success
+ *         QDF_STATUS_E_RESOURCES: Error return
+ */
+static QDF_STATUS dp_tx_hw_enqueue(struct dp_soc *soc, struct dp_vdev *vdev,
+				   struct dp_tx_desc_s *tx_desc, uint8_t tid,
+				   uint16_t fw_metadata, uint8_t ring_id,
+				   struct cdp_tx_exception_metadata
+					*tx_exc_metadata)
+{
+	void *hal_tx_desc;
+	uint32_t *hal_tx_desc_cached;
+
+	/*
+	 * Setting it initialization statically here to avoid
+	 * a memset call jump with qdf_mem_set call
+	 */
+	uint8_t cached_desc[HAL_TX_DESC_LEN_BYTES] = { 0 };
+
+	hal_ring_handle_t hal_ring_hdl = NULL;
+
+	QDF_STATUS status = QDF_STATUS_E_RESOURCES;
+
+	hal_tx_desc_cached = (void *) cached_desc;
+
+	if (dp_tx_hw_desc_prepare(soc, vdev, tx_desc, tid, fw_metadata,
+				  ring_id, tx_exc_metadata,
+				  hal_tx_desc_cached) != QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_RESOURCES;
+
 	hal_ring_hdl = dp_tx_get_hal_ring_hdl(soc, ring_id);
 
 	if (qdf_unlikely(dp_tx_hal_ring_access_start(soc, hal_ring_hdl))) {
@@ -1256,20 +1338,11 @@ static QDF_STATUS dp_tx_hw_enqueue(struct dp_soc *soc, struct dp_vdev *vdev,
 	tx_desc->flags |= DP_TX_DESC_FLAG_QUEUED_TX;
 	dp_vdev_peer_stats_update_protocol_cnt_tx(vdev, tx_desc->nbuf);
 	hal_tx_desc_sync(hal_tx_desc_cached, hal_tx_desc);
-	DP_STATS_INC_PKT(vdev, tx_i.processed, 1, tx_desc->length);
+	DP_VDEV_SHARD_STATS_INC_PKT(vdev, processed, 1, tx_desc->length);
 	status = QDF_STATUS_SUCCESS;
 
 ring_access_fail:
-	if (hif_pm_runtime_get(soc->hif_handle,
-			       RTPM_ID_DW_TX_HW_ENQUEUE) == 0) {
-		dp_tx_hal_ring_access_end(soc, hal_ring_hdl);
-		hif_pm_runtime_put(soc->hif_handle,
-				   RTPM_ID_DW_TX_HW_ENQUEUE);
-	} else {
-		dp_tx_hal_ring_access_end_reap(soc, hal_ring_hdl);
-		hal_srng_set_event(hal_ring_hdl, HAL_SRNG_FLUSH_EVENT);
-		hal_srng_inc_flush_cnt(hal_ring_hdl);
-	}
+	dp_tx_hw_ring_access_end(soc, hal_ring_hdl);
 
 	return status;
 }
@@ -1671,32 +1744,34 @@ int dp_tx_frame_is_drop(struct dp_vdev *vdev, uint8_t *srcmac, uint8_t *dstmac)
 }
 
 /**
- * dp_tx_send_msdu_single() - Setup descriptor and enqueue single MSDU to TCL
+ * dp_tx_msdu_single_setup() - Setup and map SW descriptor for a single MSDU
  * @vdev: DP vdev handle
  * @nbuf: skb
- * @tid: TID from HLOS for overriding default DSCP-TID mapping
- * @meta_data: Metadata to the fw
- * @tx_q: Tx queue to be used for this Tx frame
+ * @msdu_info: MSDU info of the frame
  * @peer_id: peer_id of the peer in case of NAWDS frames
  * @tx_exc_metadata: Handle that holds exception path metadata
+ * @tid: TID to be programmed in the TCL descriptor (updated on CCE match)
+ * @htt_tcl_metadata: TCL metadata to be programmed for the frame
+ * @drop_code: drop reason, filled on failure
  *
- * Return: NULL on success,
- *         nbuf when it fails to send
+ * Prepares everything needed to enqueue a linear frame to TCL short of
+ * touching the ring, so it is shared by the single frame and the burst
+ * transmit paths.
+ *
+ * Return: Tx descriptor on success, NULL on failure (descriptor released)
  */
-qdf_nbuf_t
-dp_tx_send_msdu_single(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
-		       struct dp_tx_msdu_info_s *msdu_info, uint16_t peer_id,
-		       struct cdp_tx_exception_metadata *tx_exc_metadata)
+static struct dp_tx_desc_s *
+dp_tx_msdu_single_setup(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
+			struct dp_tx_msdu_info_s *msdu_info, uint16_t peer_id,
+			struct cdp_tx_exception_metadata *tx_exc_metadata,
+			uint8_t *tid, uint16_t *htt_tcl_metadata,
+			enum cdp_tx_sw_drop *drop_code)
 {
 	struct dp_pdev *pdev = vdev->pdev;
 	struct dp_soc *soc = pdev->soc;
 	struct dp_tx_desc_s *tx_desc;
-	QDF_STATUS status;
 	struct dp_tx_queue *tx_q = &(msdu_info->tx_queue);
-	uint16_t htt_tcl_metadata = 0;
-	enum cdp_tx_sw_drop drop_code = TX_MAX_DROP;
-	uint8_t tid = msdu_info->tid;
-	struct cdp_tid_tx_stats *tid_stats = NULL;
+	uint16_t metadata = 0;
 
 	/* Setup Tx descriptor for an MSDU, and MSDU extension descriptor */
 	tx_desc = dp_tx_prepare_desc_single(vdev, nbuf, tx_q->desc_pool_id,
@@ -1704,14 +1779,14 @@ dp_tx_send_msdu_single(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 	if (!tx_desc) {
 		dp_err_rl("Tx_desc prepare Fail vdev %pK queue %d",
 			  vdev, tx_q->desc_pool_id);
-		drop_code = TX_DESC_ERR;
-		goto fail_return;
+		*drop_code = TX_DESC_ERR;
+		return NULL;
 	}
 
 	if (qdf_unlikely(soc->cce_disable)) {
 		if (dp_cce_classify(vdev, nbuf) == true) {
 			DP_STATS_INC(vdev, tx_i.cce_classified, 1);
-			tid = DP_VO_TID;
+			*tid = DP_VO_TID;
 			tx_desc->flags |= DP_TX_DESC_FLAG_TO_FW;
 		}
 	}
@@ -1719,18 +1794,18 @@ dp_tx_send_msdu_single(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 	dp_tx_update_tdls_flags(tx_desc);
 
 	if (qdf_unlikely(peer_id == DP_INVALID_PEER)) {
-		htt_tcl_metadata = vdev->htt_tcl_metadata;
-		HTT_TX_TCL_METADATA_HOST_INSPECTED_SET(htt_tcl_metadata, 1);
+		metadata = vdev->htt_tcl_metadata;
+		HTT_TX_TCL_METADATA_HOST_INSPECTED_SET(metadata, 1);
 	} else if (qdf_unlikely(peer_id != HTT_INVALID_PEER)) {
-		HTT_TX_TCL_METADATA_TYPE_SET(htt_tcl_metadata,
+		HTT_TX_TCL_METADATA_TYPE_SET(metadata,
 				HTT_TCL_METADATA_TYPE_PEER_BASED);
-		HTT_TX_TCL_METADATA_PEER_ID_SET(htt_tcl_metadata,
+		HTT_TX_TCL_METADATA_PEER_ID_SET(metadata,
 				peer_id);
 	} else
-		htt_tcl_metadata = vdev->htt_tcl_metadata;
+		metadata = vdev->htt_tcl_metadata;
 
 	if (msdu_info->exception_fw)
-		HTT_TX_TCL_METADATA_VALID_HTT_SET(htt_tcl_metadata, 1);
+		HTT_TX_TCL_METADATA_VALID_HTT_SET(metadata, 1);
 
 	dp_tx_desc_update_fast_comp_flag(soc, tx_desc,
 					 !pdev->enhanced_stats_en);
@@ -1740,10 +1815,72 @@ dp_tx_send_msdu_single(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		/* Handle failure */
 		dp_err("qdf_nbuf_map failed");
 		DP_STATS_INC(vdev, tx_i.dropped.dma_error, 1);
-		drop_code = TX_DMA_MAP_ERR;
-		goto release_desc;
+		*drop_code = TX_DMA_MAP_ERR;
+		dp_tx_desc_release(tx_desc, tx_q->desc_pool_id);
+		return NULL;
 	}
 
+	*htt_tcl_metadata = metadata;
+
+	return tx_desc;
+}
+
+/**
+ * dp_tx_sw_drop_stats_inc() - Account a frame dropped before TCL enqueue
+ * @vdev: DP vdev handle
+ * @nbuf: skb
+ * @msdu_info: MSDU info of the frame
+ * @tid: TID the frame was classified to
+ * @drop_code: drop reason
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_sw_drop_stats_inc(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
+			struct dp_tx_msdu_info_s *msdu_info, uint8_t tid,
+			enum cdp_tx_sw_drop drop_code)
+{
+	struct cdp_tid_tx_stats *tid_stats;
+
+	dp_tx_get_tid(vdev, nbuf, msdu_info);
+	tid_stats = &vdev->pdev->stats.tid_stats.
+		    tid_tx_stats[msdu_info->tx_queue.ring_id][tid];
+	tid_stats->swdrop_cnt[drop_code]++;
+}
+
+/**
+ * dp_tx_send_msdu_single() - Setup descriptor and enqueue single MSDU to TCL
+ * @vdev: DP vdev handle
+ * @nbuf: skb
+ * @tid: TID from HLOS for overriding default DSCP-TID mapping
+ * @meta_data: Metadata to the fw
+ * @tx_q: Tx queue to be used for this Tx frame
+ * @peer_id: peer_id of the peer in case of NAWDS frames
+ * @tx_exc_metadata: Handle that holds exception path metadata
+ *
+ * Return: NULL on success,
+ *         nbuf when it fails to send
+ */
+qdf_nbuf_t
+dp_tx_send_msdu_single(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
+		       struct dp_tx_msdu_info_s *msdu_info, uint16_t peer_id,
+		       struct cdp_tx_exception_metadata *tx_exc_metadata)
+{
+	struct dp_pdev *pdev = vdev->pdev;
+	struct dp_soc *soc = pdev->soc;
+	struct dp_tx_desc_s *tx_desc;
+	QDF_STATUS status;
+	struct dp_tx_queue *tx_q = &(msdu_info->tx_queue);
+	uint16_t htt_tcl_metadata = 0;
+	enum cdp_tx_sw_drop drop_code = TX_MAX_DROP;
+	uint8_t tid = msdu_info->tid;
+
+	tx_desc = dp_tx_msdu_single_setup(vdev, nbuf, msdu_info, peer_id,
+					  tx_exc_metadata, &tid,
+					  &htt_tcl_metadata, &drop_code);
+	if (!tx_desc)
+		goto fail_return;
+
 	/* Enqueue the Tx MSDU descriptor to HW for transmit */
 	status = dp_tx_hw_enqueue(soc, vdev, tx_desc, tid,
 			htt_tcl_metadata, tx_q->ring_id, tx_exc_metadata);
@@ -1765,20 +1902,248 @@ release_desc:
 	dp_tx_desc_release(tx_desc, tx_q->desc_pool_id);
 
 fail_return:
-	dp_tx_get_tid(vdev, nbuf, msdu_info);
-	tid_stats = &pdev->stats.tid_stats.
-		    tid_tx_stats[tx_q->ring_id][tid];
-	tid_stats->swdrop_cnt[drop_code]++;
+	dp_tx_sw_drop_stats_inc(vdev, nbuf, msdu_info, tid, drop_code);
 	return nbuf;
 }
 
+/**
+ * dp_tx_batch_fail_nbuf() - Append a frame that could not be sent
+ * @head: head of the failed frame list
+ * @tail: tail of the failed frame list
+ * @nbuf: frame to be returned to the caller
+ *
+ * Return: none
+ */
+static inline void dp_tx_batch_fail_nbuf(qdf_nbuf_t *head, qdf_nbuf_t *tail,
+					 qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_set_next(nbuf, NULL);
+	if (!*head)
+		*head = nbuf;
+	else
+		qdf_nbuf_set_next(*tail, nbuf);
+	*tail = nbuf;
+}
+
+/**
+ * dp_tx_batch_flush() - Enqueue all prepared MSDUs of a burst to TCL
+ * @soc: DP soc handle
+ * @vdev: DP vdev handle
+ * @batch: prepared burst
+ * @fail_head: head of the failed frame list
+ * @fail_tail: tail of the failed frame list
+ *
+ * Takes TCL ring access once, fills one TCL descriptor per prepared MSDU
+ * and updates the ring head pointer (and runtime PM refcount) once for the
+ * whole burst. MSDUs which do not fit in the ring are unmapped, their
+ * descriptors released and the frames handed back through @fail_head.
+ *
+ * Return: number of MSDUs enqueued, the entries of @batch from that index
+ *	   on were handed back in order
+ */
+static uint8_t dp_tx_batch_flush(struct dp_soc *soc, struct dp_vdev *vdev,
+				 struct dp_tx_batch *batch,
+				 qdf_nbuf_t *fail_head, qdf_nbuf_t *fail_tail)
+{
+	struct dp_tx_queue *tx_q = &batch->tx_queue;
+	struct dp_tx_desc_s *tx_desc;
+	hal_ring_handle_t hal_ring_hdl;
+	void *hal_tx_desc;
+	uint32_t *hal_tx_desc_cached;
+	uint8_t cached_desc[HAL_TX_DESC_LEN_BYTES];
+	uint8_t i = 0;
+	uint8_t num_enqueued = 0;
+	bool ring_full = false;
+
+	if (!batch->num)
+		return 0;
+
+	hal_ring_hdl = dp_tx_get_hal_ring_hdl(soc, tx_q->ring_id);
+	hal_tx_desc_cached = (void *)cached_desc;
+
+	if (qdf_unlikely(dp_tx_hal_ring_access_start(soc, hal_ring_hdl))) {
+		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_ERROR,
+			  "%s %d : HAL RING Access Failed -- %pK",
+			  __func__, __LINE__, hal_ring_hdl);
+		DP_STATS_INC(soc, tx.tcl_ring_full[tx_q->ring_id], 1);
+		goto fail;
+	}
+
+	for (; i < batch->num; i++) {
+		tx_desc = batch->elem[i].tx_desc;
+
+		qdf_mem_zero(cached_desc, sizeof(cached_desc));
+		if (dp_tx_hw_desc_prepare(soc, vdev, tx_desc,
+					  batch->elem[i].tid,
+					  batch->elem[i].htt_tcl_metadata,
+					  tx_q->ring_id, NULL,
+					  hal_tx_desc_cached) !=
+		    QDF_STATUS_SUCCESS)
+			break;
+
+		if (batch->elem[i].index_search) {
+			hal_tx_desc_set_search_type(soc->hal_soc,
+						    hal_tx_desc_cached,
+						    HAL_TX_ADDR_INDEX_SEARCH);
+			hal_tx_desc_set_search_index(soc->hal_soc,
+						     hal_tx_desc_cached,
+						     batch->elem[i].search_idx);
+			hal_tx_desc_set_cache_set_num(soc->hal_soc,
+						      hal_tx_desc_cached,
+						      batch->elem[i].
+						      cache_set_num);
+		}
+
+		hal_tx_desc = hal_srng_src_get_next(soc->hal_soc,
+						    hal_ring_hdl);
+		if (qdf_unlikely(!hal_tx_desc)) {
+			dp_verbose_debug("TCL ring full ring_id:%d",
+					 tx_q->ring_id);
+			DP_STATS_INC(soc, tx.tcl_ring_full[tx_q->ring_id], 1);
+			ring_full = true;
+			break;
+		}
+
+		tx_desc->flags |= DP_TX_DESC_FLAG_QUEUED_TX;
+		dp_vdev_peer_stats_update_protocol_cnt_tx(vdev, tx_desc->nbuf);
+		hal_tx_desc_sync(hal_tx_desc_cached, hal_tx_desc);
+		DP_VDEV_SHARD_STATS_INC_PKT(vdev, processed, 1,
+					    tx_desc->length);
+		num_enqueued++;
+	}
+
+	dp_tx_hw_ring_access_end(soc, hal_ring_hdl);
+
+	if (num_enqueued) {
+		DP_STATS_INC(soc, tx.batch_enqueue, 1);
+		DP_STATS_INC(soc, tx.batch_msdus, num_enqueued);
+	}
+
+fail:
+	for (; i < batch->num; i++) {
+		tx_desc = batch->elem[i].tx_desc;
+
+		if (!ring_full)
+			dp_err_rl("Tx_hw_enqueue Fail tx_desc %pK queue %d",
+				  tx_desc, tx_q->ring_id);
+		DP_STATS_INC(vdev, tx_i.dropped.enqueue_fail, 1);
+		qdf_nbuf_unmap_nbytes_single(vdev->osdev, tx_desc->nbuf,
+					     QDF_DMA_TO_DEVICE,
+					     tx_desc->nbuf->len);
+		dp_tx_batch_fail_nbuf(fail_head, fail_tail, tx_desc->nbuf);
+		dp_tx_desc_release(tx_desc, tx_q->desc_pool_id);
+	}
+
+	batch->num = 0;
+
+	return num_enqueued;
+}
+
+/**
+ * dp_tx_send_me_batch() - Enqueue the unicast copies of a multicast frame
+ * @vdev: DP vdev handle
+ * @nbuf: multicast frame the copies were made from
+ * @msdu_info: MSDU info with one segment per unicast copy
+ * @is_cce_classified: frame was classified by CCE to be sent to FW
+ *
+ * Each segment carries its own DA header buffer (ME buffer) followed by
+ * the DMA mapped payload shared by all copies, and is described to HW by
+ * an MSDU extension descriptor. All copies are prepared up front and
+ * enqueued through dp_tx_batch_flush(), so the TCL ring access and head
+ * pointer update are paid once per DP_TX_BATCH_MAX_MSDU clients instead
+ * of once per client. Copies which cannot be sent are freed, those which
+ * did not fit in the TCL ring are also accounted as TX_HW_ENQUEUE drops of
+ * the frame's TID.
+ *
+ * Return: none
+ */
+static void dp_tx_send_me_batch(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
+				struct dp_tx_msdu_info_s *msdu_info,
+				bool is_cce_classified)
+{
+	struct dp_pdev *pdev = vdev->pdev;
+	struct dp_soc *soc = pdev->soc;
+	struct dp_tx_queue *tx_q = &msdu_info->tx_queue;
+	struct dp_tx_seg_info_s *seg = msdu_info->u.sg_info.curr_seg;
+	struct dp_tx_batch batch;
+	struct dp_tx_batch_elem *elem;
+	struct dp_tx_desc_s *tx_desc;
+	struct cdp_tid_tx_stats *tid_stats;
+	qdf_nbuf_t fail_head = NULL;
+	qdf_nbuf_t fail_tail = NULL;
+	qdf_nbuf_t copy, next;
+	uint16_t htt_tcl_metadata;
+	uint16_t enqueue_fail = 0;
+	uint16_t i;
+
+	htt_tcl_metadata = vdev->htt_tcl_metadata;
+	if (msdu_info->exception_fw)
+		HTT_TX_TCL_METADATA_VALID_HTT_SET(htt_tcl_metadata, 1);
+
+	batch.num = 0;
+	batch.tx_queue = *tx_q;
+
+	for (i = 0; i < msdu_info->num_seg && seg; i++, seg = seg->next) {
+		msdu_info->u.sg_info.curr_seg = seg;
+
+		tx_desc = dp_tx_prepare_desc(vdev, seg->nbuf, msdu_info,
+					     tx_q->desc_pool_id);
+		if (!tx_desc) {
+			dp_tx_me_free_buf(pdev, (void *)seg->frags[0].vaddr);
+			qdf_nbuf_unmap_nbytes_single(vdev->osdev, seg->nbuf,
+						     QDF_DMA_TO_DEVICE,
+						     seg->nbuf->len);
+			dp_tx_batch_fail_nbuf(&fail_head, &fail_tail,
+					      seg->nbuf);
+			continue;
+		}
+
+		tx_desc->me_buffer = seg->frags[0].vaddr;
+		tx_desc->flags |= DP_TX_DESC_FLAG_ME;
+		if (is_cce_classified)
+			tx_desc->flags |= DP_TX_DESC_FLAG_TO_FW;
+
+		elem = &batch.elem[batch.num++];
+		elem->tx_desc = tx_desc;
+		elem->htt_tcl_metadata = htt_tcl_metadata;
+		elem->tid = msdu_info->tid;
+		elem->index_search = 0;
+
+		if (batch.num == DP_TX_BATCH_MAX_MSDU)
+			enqueue_fail += batch.num -
+					dp_tx_batch_flush(soc, vdev, &batch,
+							  &fail_head,
+							  &fail_tail);
+	}
+
+	enqueue_fail += batch.num -
+			dp_tx_batch_flush(soc, vdev, &batch,
+					  &fail_head, &fail_tail);
+
+	if (qdf_unlikely(enqueue_fail)) {
+		dp_tx_get_tid(vdev, nbuf, msdu_info);
+		tid_stats = &pdev->stats.tid_stats.
+			    tid_tx_stats[tx_q->ring_id][msdu_info->tid];
+		tid_stats->swdrop_cnt[TX_HW_ENQUEUE] += enqueue_fail;
+	}
+
+	for (copy = fail_head; copy; copy = next) {
+		next = qdf_nbuf_next(copy);
+		qdf_nbuf_set_next(copy, NULL);
+		DP_STATS_INC(vdev, tx_i.mcast_en.dropped_send_fail, 1);
+		qdf_nbuf_free(copy);
+	}
+}
+
 /**
  * dp_tx_send_msdu_multiple() - Enqueue multiple MSDUs
  * @vdev: DP vdev handle
  * @nbuf: skb
  * @msdu_info: MSDU info to be setup in MSDU extension descriptor
  *
- * Prepare descriptors for multiple MSDUs (TSO segments) and enqueue to TCL
+ * Prepare descriptors for multiple MSDUs (TSO segments) and enqueue to TCL.
+ * Multicast to unicast converted frames are enqueued in bursts by
+ * dp_tx_send_me_batch().
  *
  * Return: NULL on success,
  *         nbuf when it fails to send
@@ -1808,8 +2173,10 @@ qdf_nbuf_t dp_tx_send_msdu_multiple(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		}
 	}
 
-	if (msdu_info->frm_type == dp_tx_frm_me)
-		nbuf = msdu_info->u.sg_info.curr_seg->nbuf;
+	if (msdu_info->frm_type == dp_tx_frm_me) {
+		dp_tx_send_me_batch(vdev, nbuf, msdu_info, is_cce_classified);
+		return NULL;
+	}
 
 	i = 0;
 	/* Print statement to track i and num_seg */
@@ -1825,22 +2192,8 @@ qdf_nbuf_t dp_tx_send_msdu_multiple(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		tx_desc = dp_tx_prepare_desc(vdev, nbuf, msdu_info,
 				tx_q->desc_pool_id);
 
-		if (!tx_desc) {
-			if (msdu_info->frm_type == dp_tx_frm_me) {
-				dp_tx_me_free_buf(pdev,
-					(void *)(msdu_info->u.sg_info
-						.curr_seg->frags[0].vaddr));
-				i++;
-				continue;
-			}
+		if (!tx_desc)
 			goto done;
-		}
-
-		if (msdu_info->frm_type == dp_tx_frm_me) {
-			tx_desc->me_buffer =
-				msdu_info->u.sg_info.curr_seg->frags[0].vaddr;
-			tx_desc->flags |= DP_TX_DESC_FLAG_ME;
-		}
 
 		if (is_cce_classified)
 			tx_desc->flags |= DP_TX_DESC_FLAG_TO_FW;
@@ -1910,13 +2263,7 @@ qdf_nbuf_t dp_tx_send_msdu_multiple(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		 * can be combined into 1
 		 */
 
-		/*
-		 * For Multicast-Unicast converted packets,
-		 * each converted frame (for a client) is represented as
-		 * 1 segment
-		 */
-		if ((msdu_info->frm_type == dp_tx_frm_sg) ||
-				(msdu_info->frm_type == dp_tx_frm_me)) {
+		if (msdu_info->frm_type == dp_tx_frm_sg) {
 			if (msdu_info->u.sg_info.curr_seg->next) {
 				msdu_info->u.sg_info.curr_seg =
 					msdu_info->u.sg_info.curr_seg->next;
@@ -2188,7 +2535,7 @@ dp_tx_send_exception(struct cdp_soc_t *soc, uint8_t vdev_id, qdf_nbuf_t nbuf,
 	eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
 	dp_verbose_debug("skb %pM", nbuf->data);
 
-	DP_STATS_INC_PKT(vdev, tx_i.rcvd, 1, qdf_nbuf_len(nbuf));
+	DP_VDEV_SHARD_STATS_INC_PKT(vdev, rcvd, 1, qdf_nbuf_len(nbuf));
 
 	if (qdf_unlikely(!dp_check_exc_metadata(tx_exc_metadata))) {
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
@@ -2384,23 +2731,16 @@ void dp_tx_nawds_handler(struct cdp_soc_t *soc, struct dp_vdev *vdev,
 	struct dp_soc *dp_soc = (struct dp_soc *)soc;
 	uint16_t peer_id = DP_INVALID_PEER;
 	struct dp_peer *sa_peer = NULL;
-	struct dp_ast_entry *ast_entry = NULL;
+	struct dp_ast_peek_info sa_info;
 	qdf_ether_header_t *eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
 
-	if (qdf_nbuf_get_tx_ftype(nbuf) == CB_FTYPE_INTRABSS_FWD) {
-		qdf_spin_lock_bh(&dp_soc->ast_lock);
+	/* sa_peer is only compared against, no reference is needed */
+	if (qdf_nbuf_get_tx_ftype(nbuf) == CB_FTYPE_INTRABSS_FWD &&
+	    dp_peer_ast_hash_peek(dp_soc, (uint8_t *)(eh->ether_shost),
+				  vdev->pdev->pdev_id, true, &sa_info))
+		sa_peer = sa_info.peer;
 
-		ast_entry = dp_peer_ast_hash_find_by_pdevid
-					(dp_soc,
-					 (uint8_t *)(eh->ether_shost),
-					 vdev->pdev->pdev_id);
-
-		if (ast_entry)
-			sa_peer = ast_entry->peer;
-		qdf_spin_unlock_bh(&dp_soc->ast_lock);
-	}
-
-	qdf_spin_lock_bh(&dp_soc->peer_ref_mutex);
+	dp_peer_ref_mutex_lock(dp_soc);
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (!peer->bss_peer && peer->nawds_enabled) {
 			peer_id = peer->peer_id;
@@ -2440,7 +2780,7 @@ void dp_tx_nawds_handler(struct cdp_soc_t *soc, struct dp_vdev *vdev,
 		}
 	}
 
-	qdf_spin_unlock_bh(&dp_soc->peer_ref_mutex);
+	dp_peer_ref_mutex_unlock(dp_soc);
 }
 
 /**
@@ -2477,7 +2817,7 @@ qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc, uint8_t vdev_id, qdf_nbuf_t nbuf)
 	 * (TID override disabled)
 	 */
 	msdu_info.tid = HTT_TX_EXT_TID_INVALID;
-	DP_STATS_INC_PKT(vdev, tx_i.rcvd, 1, qdf_nbuf_len(nbuf));
+	DP_VDEV_SHARD_STATS_INC_PKT(vdev, rcvd, 1, qdf_nbuf_len(nbuf));
 
 	if (qdf_unlikely(vdev->mesh_vdev)) {
 		qdf_nbuf_t nbuf_mesh = dp_tx_extract_mesh_meta_data(vdev, nbuf,
@@ -2612,6 +2952,266 @@ send_multiple:
 	return nbuf;
 }
 
+/**
+ * dp_tx_batch_eligible() - Check if a frame can take the batched TX path
+ * @vdev: DP vdev handle
+ * @nbuf: skb
+ *
+ * Only plain linear frames, which dp_tx_send() would hand to
+ * dp_tx_send_msdu_single() without any special processing, are batched.
+ *
+ * Return: true if frame can be batched
+ */
+static inline bool dp_tx_batch_eligible(struct dp_vdev *vdev, qdf_nbuf_t nbuf)
+{
+	if (qdf_unlikely(vdev->mesh_vdev || vdev->nawds_enabled ||
+			 vdev->tx_encap_type == htt_cmn_pkt_type_raw))
+		return false;
+
+	if (qdf_nbuf_is_tso(nbuf) || qdf_unlikely(qdf_nbuf_is_nonlinear(nbuf)))
+		return false;
+
+#ifdef ATH_SUPPORT_IQUE
+	if (qdf_unlikely(vdev->mcast_enhancement_en > 0)) {
+		qdf_ether_header_t *eh = (qdf_ether_header_t *)
+					  qdf_nbuf_data(nbuf);
+
+		if (DP_FRAME_IS_MULTICAST((eh)->ether_dhost) &&
+		    !DP_FRAME_IS_BROADCAST((eh)->ether_dhost))
+			return false;
+	}
+#endif
+
+	return true;
+}
+
+/**
+ * dp_tx_send_list() - Transmit a chain of frames on a given VAP
+ * @soc: DP soc handle
+ * @vdev_id: id of DP vdev handle
+ * @nbuf_list: chain of skbs linked through qdf_nbuf_next()
+ *
+ * Burst variant of dp_tx_send() for callers which already have several
+ * frames queued for the same vdev (xmit_more, GSO segments). Linear frames
+ * are classified and prepared one by one, but are enqueued to a TCL ring
+ * in bursts of up to DP_TX_BATCH_MAX_MSDU so the ring access, the head
+ * pointer register write and the runtime PM get/put are paid once per
+ * burst instead of once per frame. Frames needing special handling (TSO,
+ * SG, raw, mesh, NAWDS, mcast enhancement) go through dp_tx_send().
+ *
+ * Return: NULL on success,
+ *         chain of the frames which could not be sent
+ */
+qdf_nbuf_t dp_tx_send_list(struct cdp_soc_t *soc, uint8_t vdev_id,
+			   qdf_nbuf_t nbuf_list)
+{
+	struct dp_soc *dp_soc = (struct dp_soc *)soc;
+	struct dp_tx_batch batch;
+	struct dp_tx_msdu_info_s msdu_info;
+	struct dp_tx_desc_s *tx_desc;
+	qdf_nbuf_t nbuf, next;
+	qdf_nbuf_t fail_head = NULL;
+	qdf_nbuf_t fail_tail = NULL;
+	uint16_t htt_tcl_metadata;
+	enum cdp_tx_sw_drop drop_code;
+	uint8_t tid;
+	struct dp_vdev *vdev =
+		dp_get_vdev_from_soc_vdev_id_wifi3(dp_soc, vdev_id);
+
+	if (qdf_unlikely(!vdev))
+		return nbuf_list;
+
+	batch.num = 0;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		if (!dp_tx_batch_eligible(vdev, nbuf)) {
+			dp_tx_batch_flush(dp_soc, vdev, &batch,
+					  &fail_head, &fail_tail);
+			if (dp_tx_send(soc, vdev_id, nbuf))
+				dp_tx_batch_fail_nbuf(&fail_head, &fail_tail,
+						      nbuf);
+			continue;
+		}
+
+		qdf_mem_zero(&msdu_info, sizeof(msdu_info));
+		msdu_info.tid = HTT_TX_EXT_TID_INVALID;
+		DP_VDEV_SHARD_STATS_INC_PKT(vdev, rcvd, 1, qdf_nbuf_len(nbuf));
+
+		dp_tx_get_queue(vdev, nbuf, &msdu_info.tx_queue);
+
+		if (batch.num &&
+		    (batch.num == DP_TX_BATCH_MAX_MSDU ||
+		     batch.tx_queue.ring_id != msdu_info.tx_queue.ring_id ||
+		     batch.tx_queue.desc_pool_id !=
+					msdu_info.tx_queue.desc_pool_id))
+			dp_tx_batch_flush(dp_soc, vdev, &batch,
+					  &fail_head, &fail_tail);
+
+		dp_tx_classify_tid(vdev, nbuf, &msdu_info);
+
+		tid = msdu_info.tid;
+		drop_code = TX_MAX_DROP;
+		htt_tcl_metadata = 0;
+		tx_desc = dp_tx_msdu_single_setup(vdev, nbuf, &msdu_info,
+						  HTT_INVALID_PEER, NULL, &tid,
+						  &htt_tcl_metadata,
+						  &drop_code);
+		if (!tx_desc) {
+			dp_tx_sw_drop_stats_inc(vdev, nbuf, &msdu_info, tid,
+						drop_code);
+			dp_tx_batch_fail_nbuf(&fail_head, &fail_tail, nbuf);
+			continue;
+		}
+
+		batch.tx_queue = msdu_info.tx_queue;
+		batch.elem[batch.num].tx_desc = tx_desc;
+		batch.elem[batch.num].htt_tcl_metadata = htt_tcl_metadata;
+		batch.elem[batch.num].tid = tid;
+		batch.elem[batch.num].index_search = 0;
+		batch.num++;
+	}
+
+	dp_tx_batch_flush(dp_soc, vdev, &batch, &fail_head, &fail_tail);
+
+	return fail_head;
+}
+
+/**
+ * dp_tx_fwd_batch_flush() - Enqueue the pending intra-BSS frames to TCL
+ * @soc: DP soc handle
+ * @fwd: intra-BSS forward batch
+ *
+ * Frames which do not fit in the TCL ring are accounted as enqueue
+ * failures of the vdev by dp_tx_batch_flush(). Their RX context is
+ * restored and they are queued to the fail list of @fwd, for the RX path
+ * to account them as intra-BSS failures and deliver them to the stack.
+ *
+ * Return: none
+ */
+void dp_tx_fwd_batch_flush(struct dp_soc *soc, struct dp_tx_fwd_batch *fwd)
+{
+	qdf_nbuf_t fail_head = NULL;
+	qdf_nbuf_t fail_tail = NULL;
+	struct dp_tx_fwd_rx_ctx *rx_ctx;
+	qdf_nbuf_t nbuf, next;
+	uint8_t i;
+
+	if (!fwd->batch.num)
+		return;
+
+	i = dp_tx_batch_flush(soc, fwd->vdev, &fwd->batch,
+			      &fail_head, &fail_tail);
+
+	for (nbuf = fail_head; nbuf; nbuf = next, i++) {
+		next = qdf_nbuf_next(nbuf);
+		rx_ctx = &fwd->rx_ctx[i];
+
+		memset(nbuf->cb, 0x0, sizeof(nbuf->cb));
+		QDF_NBUF_CB_RX_PEER_ID(nbuf) = rx_ctx->peer_id;
+		QDF_NBUF_CB_RX_CTX_ID(nbuf) = rx_ctx->ring_id;
+		qdf_nbuf_set_tid_val(nbuf, rx_ctx->tid);
+		dp_tx_batch_fail_nbuf(&fwd->fail_head, &fwd->fail_tail, nbuf);
+	}
+}
+
+/**
+ * dp_tx_fwd_batch_add() - Queue an intra-BSS frame for a batched TCL enqueue
+ * @soc: DP soc handle
+ * @fwd: intra-BSS forward batch
+ * @ta_peer: peer the frame was received from, forwarded on its vdev
+ * @nbuf: linear ethernet frame
+ * @tid: TID from the REO destination ring descriptor
+ * @ring_id: REO destination ring the frame was received on
+ * @ast_entry: AST entry of the unicast destination, NULL for mcast/bcast
+ *
+ * Forward path of dp_rx_intrabss_fwd(). The vdev, the TID and the
+ * destination are already known from the RX TLVs, so the vdev lookup,
+ * TID classification and mesh/ME/NAWDS checks of dp_tx_send() are
+ * skipped and the frame is prepared straight into @fwd. A mapped unicast
+ * destination is searched by its AST index instead of the vdev defaults.
+ * Frames which need the special handling of dp_tx_send() still go
+ * through it. The caller has to dp_tx_fwd_batch_flush() @fwd before the
+ * vdev can go away.
+ *
+ * Return: QDF_STATUS_SUCCESS if the frame was taken over,
+ *         error status if the frame is still owned by the caller
+ */
+QDF_STATUS dp_tx_fwd_batch_add(struct dp_soc *soc,
+			       struct dp_tx_fwd_batch *fwd,
+			       struct dp_peer *ta_peer, qdf_nbuf_t nbuf,
+			       uint8_t tid, uint8_t ring_id,
+			       struct dp_ast_entry *ast_entry)
+{
+	struct dp_vdev *vdev = ta_peer->vdev;
+	struct dp_tx_batch *batch = &fwd->batch;
+	struct dp_tx_fwd_rx_ctx *rx_ctx;
+	struct dp_tx_batch_elem *elem;
+	struct dp_tx_msdu_info_s msdu_info;
+	struct dp_tx_desc_s *tx_desc;
+	uint16_t htt_tcl_metadata;
+	enum cdp_tx_sw_drop drop_code;
+	uint8_t tx_tid;
+
+	if (batch->num && fwd->vdev != vdev)
+		dp_tx_fwd_batch_flush(soc, fwd);
+
+	if (!dp_tx_batch_eligible(vdev, nbuf)) {
+		dp_tx_fwd_batch_flush(soc, fwd);
+		if (dp_tx_send((struct cdp_soc_t *)soc, vdev->vdev_id, nbuf))
+			return QDF_STATUS_E_FAILURE;
+
+		return QDF_STATUS_SUCCESS;
+	}
+
+	qdf_mem_zero(&msdu_info, sizeof(msdu_info));
+	msdu_info.tid = (tid < CDP_DATA_TID_MAX) ? tid : HTT_TX_EXT_TID_INVALID;
+	DP_VDEV_SHARD_STATS_INC_PKT(vdev, rcvd, 1, qdf_nbuf_len(nbuf));
+
+	dp_tx_get_queue(vdev, nbuf, &msdu_info.tx_queue);
+
+	if (batch->num &&
+	    (batch->num == DP_TX_BATCH_MAX_MSDU ||
+	     batch->tx_queue.ring_id != msdu_info.tx_queue.ring_id ||
+	     batch->tx_queue.desc_pool_id != msdu_info.tx_queue.desc_pool_id))
+		dp_tx_fwd_batch_flush(soc, fwd);
+
+	tx_tid = msdu_info.tid;
+	drop_code = TX_MAX_DROP;
+	htt_tcl_metadata = 0;
+	tx_desc = dp_tx_msdu_single_setup(vdev, nbuf, &msdu_info,
+					  HTT_INVALID_PEER, NULL, &tx_tid,
+					  &htt_tcl_metadata, &drop_code);
+	if (!tx_desc) {
+		dp_tx_sw_drop_stats_inc(vdev, nbuf, &msdu_info, tx_tid,
+					drop_code);
+		return QDF_STATUS_E_RESOURCES;
+	}
+
+	fwd->vdev = vdev;
+	batch->tx_queue = msdu_info.tx_queue;
+	rx_ctx = &fwd->rx_ctx[batch->num];
+	rx_ctx->peer_id = ta_peer->peer_id;
+	rx_ctx->ring_id = ring_id;
+	rx_ctx->tid = tid;
+	elem = &batch->elem[batch->num++];
+	elem->tx_desc = tx_desc;
+	elem->htt_tcl_metadata = htt_tcl_metadata;
+	elem->tid = tx_tid;
+	elem->index_search = 0;
+
+	/* AST index and hash are only valid once HTT peer map v2 set them */
+	if (ast_entry && soc->is_peer_map_unmap_v2 && ast_entry->is_mapped) {
+		elem->index_search = 1;
+		elem->search_idx = ast_entry->ast_idx;
+		elem->cache_set_num = ast_entry->ast_hash_value & 0xF;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * dp_tx_reinject_handler() - Tx Reinject Handler
  * @tx_desc: software descriptor head pointer
@@ -3084,7 +3684,7 @@ dp_tx_update_peer_stats(struct dp_tx_desc_s *tx_desc,
 	}
 
 	length = qdf_nbuf_len(tx_desc->nbuf);
-	DP_STATS_INC_PKT(peer, tx.comp_pkt, 1, length);
+	DP_PEER_TX_SHARD_STATS_INC_PKT(peer, comp_pkt, 1, length);
 
 	if (qdf_unlikely(pdev->delay_stats_flag))
 		dp_tx_compute_delay(peer->vdev, tx_desc, tid, ring_id);
@@ -3135,8 +3735,10 @@ dp_tx_update_peer_stats(struct dp_tx_desc_s *tx_desc,
 
 	DP_STATS_INCC(peer, tx.ofdma, 1, ts->ofdma);
 
-	DP_STATS_INCC(peer, tx.amsdu_cnt, 1, ts->msdu_part_of_amsdu);
-	DP_STATS_INCC(peer, tx.non_amsdu_cnt, 1, !ts->msdu_part_of_amsdu);
+	DP_PEER_TX_SHARD_STATS_INCC(peer, amsdu_cnt, 1,
+				    ts->msdu_part_of_amsdu);
+	DP_PEER_TX_SHARD_STATS_INCC(peer, non_amsdu_cnt, 1,
+				    !ts->msdu_part_of_amsdu);
 
 	/*
 	 * Following Rate Statistics are updated from HTT PPDU events from FW.
@@ -3506,18 +4108,21 @@ void dp_tx_comp_process_tx_status(struct dp_tx_desc_s *tx_desc,
 
 	if (qdf_unlikely(peer->bss_peer && vdev->opmode == wlan_op_mode_ap)) {
 		if (ts->status != HAL_TX_TQM_RR_REM_CMD_REM) {
-			DP_STATS_INC_PKT(peer, tx.mcast, 1, length);
+			DP_PEER_TX_SHARD_STATS_INC_PKT(peer, mcast, 1,
+						       length);
 
 			if ((peer->vdev->tx_encap_type ==
 				htt_cmn_pkt_type_ethernet) &&
 				QDF_IS_ADDR_BROADCAST(eh->ether_dhost)) {
-				DP_STATS_INC_PKT(peer, tx.bcast, 1, length);
+				DP_PEER_TX_SHARD_STATS_INC_PKT(peer, bcast, 1,
+							       length);
 			}
 		}
 	} else {
-		DP_STATS_INC_PKT(peer, tx.ucast, 1, length);
+		DP_PEER_TX_SHARD_STATS_INC_PKT(peer, ucast, 1, length);
 		if (ts->status == HAL_TX_TQM_RR_FRAME_ACKED)
-			DP_STATS_INC_PKT(peer, tx.tx_success, 1, length);
+			DP_PEER_TX_SHARD_STATS_INC_PKT(peer, tx_success, 1,
+						       length);
 	}
 
 	dp_tx_update_peer_stats(tx_desc, ts, peer, ring_id);
@@ -3532,6 +4137,271 @@ void dp_tx_comp_process_tx_status(struct dp_tx_desc_s *tx_desc,
 out:
 	return;
 }
+#ifdef QCA_DP_TX_COMP_BATCH
+/**
+ * struct dp_tx_comp_batch - state of one batched Tx completion pass
+ * @peer: peer of the current run of completions, referenced
+ * @peer_id: peer id of the current run
+ * @comp_pkts: completions of the run not yet added to @peer stats
+ * @comp_bytes: bytes of the run not yet added to @peer stats
+ * @tx_failed: non acked completions of the run not yet added to @peer
+ * @pdev: pdev of the pending outstanding count
+ * @outstanding: completed descriptors not yet subtracted from @pdev
+ * @nbuf_head: nbufs to be freed in bulk
+ * @nbuf_tail: last nbuf of @nbuf_head
+ * @desc_head: descriptors to be returned to the pool as one chain
+ * @desc_tail: last descriptor of @desc_head
+ * @desc_cnt: number of descriptors in @desc_head
+ * @pool_id: pool of the descriptors in @desc_head
+ */
+struct dp_tx_comp_batch {
+	struct dp_peer *peer;
+	uint16_t peer_id;
+	uint32_t comp_pkts;
+	uint32_t comp_bytes;
+	uint32_t tx_failed;
+	struct dp_pdev *pdev;
+	int outstanding;
+	qdf_nbuf_t nbuf_head;
+	qdf_nbuf_t nbuf_tail;
+	struct dp_tx_desc_s *desc_head;
+	struct dp_tx_desc_s *desc_tail;
+	uint16_t desc_cnt;
+	uint8_t pool_id;
+};
+
+/**
+ * dp_tx_comp_batch_peer_flush() - Apply accumulated stats of a peer run
+ *				   and release the peer reference
+ * @batch: completion batch
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_comp_batch_peer_flush(struct dp_tx_comp_batch *batch)
+{
+	struct dp_peer *peer = batch->peer;
+
+	if (!peer) {
+		batch->peer_id = HTT_INVALID_PEER;
+		return;
+	}
+
+	if (batch->comp_pkts) {
+		DP_PEER_TX_SHARD_STATS_INC_PKT(peer, comp_pkt,
+					       batch->comp_pkts,
+					       batch->comp_bytes);
+		peer->stats.tx.tx_failed += batch->tx_failed;
+	}
+
+	dp_peer_unref_del_find_by_id(peer);
+
+	batch->peer = NULL;
+	batch->peer_id = HTT_INVALID_PEER;
+	batch->comp_pkts = 0;
+	batch->comp_bytes = 0;
+	batch->tx_failed = 0;
+}
+
+/**
+ * dp_tx_comp_batch_peer_get() - Get the peer of a completion
+ * @soc: core txrx main context
+ * @batch: completion batch
+ * @peer_id: peer id of the completion
+ *
+ * The peer is looked up only when @peer_id differs from the one of the
+ * current run; the reference is held by the batch until the run ends.
+ *
+ * Return: peer, or NULL if the peer is gone
+ */
+static inline struct dp_peer *
+dp_tx_comp_batch_peer_get(struct dp_soc *soc, struct dp_tx_comp_batch *batch,
+			  uint16_t peer_id)
+{
+	if (qdf_likely(peer_id == batch->peer_id))
+		return batch->peer;
+
+	dp_tx_comp_batch_peer_flush(batch);
+
+	batch->peer = dp_peer_find_by_id(soc, peer_id);
+	batch->peer_id = peer_id;
+
+	return batch->peer;
+}
+
+/**
+ * dp_tx_comp_batch_outstanding_flush() - Subtract the pending outstanding
+ *					  count from its pdev
+ * @batch: completion batch
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_comp_batch_outstanding_flush(struct dp_tx_comp_batch *batch)
+{
+	if (batch->outstanding)
+		dp_tx_outstanding_sub(batch->pdev, batch->outstanding);
+
+	batch->pdev = NULL;
+	batch->outstanding = 0;
+}
+
+/**
+ * dp_tx_comp_batch_desc_flush() - Return the descriptor chain to its pool
+ * @soc: core txrx main context
+ * @batch: completion batch
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_comp_batch_desc_flush(struct dp_soc *soc, struct dp_tx_comp_batch *batch)
+{
+	if (!batch->desc_cnt)
+		return;
+
+	batch->desc_tail->next = NULL;
+	dp_tx_desc_free_list(soc, batch->desc_head, batch->desc_tail,
+			     batch->desc_cnt, batch->pool_id);
+
+	batch->desc_head = NULL;
+	batch->desc_tail = NULL;
+	batch->desc_cnt = 0;
+}
+
+/**
+ * dp_tx_comp_batch_add() - Queue a simple descriptor and its nbuf for
+ *			    bulk release
+ * @soc: core txrx main context
+ * @batch: completion batch
+ * @desc: completed descriptor, already unmapped
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_comp_batch_add(struct dp_soc *soc, struct dp_tx_comp_batch *batch,
+		     struct dp_tx_desc_s *desc)
+{
+	qdf_nbuf_t nbuf = desc->nbuf;
+
+	if (qdf_unlikely(batch->pdev != desc->pdev)) {
+		dp_tx_comp_batch_outstanding_flush(batch);
+		batch->pdev = desc->pdev;
+	}
+	batch->outstanding++;
+
+	qdf_nbuf_set_next(nbuf, NULL);
+	if (batch->nbuf_tail)
+		qdf_nbuf_set_next(batch->nbuf_tail, nbuf);
+	else
+		batch->nbuf_head = nbuf;
+	batch->nbuf_tail = nbuf;
+
+	if (qdf_unlikely(batch->desc_cnt && batch->pool_id != desc->pool_id))
+		dp_tx_comp_batch_desc_flush(soc, batch);
+
+	if (batch->desc_tail)
+		batch->desc_tail->next = desc;
+	else
+		batch->desc_head = desc;
+	batch->desc_tail = desc;
+	batch->pool_id = desc->pool_id;
+	batch->desc_cnt++;
+}
+
+/**
+ * dp_tx_comp_batch_flush() - Complete a batched Tx completion pass
+ * @soc: core txrx main context
+ * @batch: completion batch
+ *
+ * Return: none
+ */
+static inline void
+dp_tx_comp_batch_flush(struct dp_soc *soc, struct dp_tx_comp_batch *batch)
+{
+	dp_tx_comp_batch_peer_flush(batch);
+	dp_tx_comp_batch_outstanding_flush(batch);
+
+	if (batch->nbuf_head) {
+		qdf_nbuf_free_bulk(batch->nbuf_head);
+		batch->nbuf_head = NULL;
+		batch->nbuf_tail = NULL;
+	}
+
+	dp_tx_comp_batch_desc_flush(soc, batch);
+}
+
+/**
+ * dp_tx_comp_process_desc_list() - Tx complete software descriptor handler
+ * @soc: core txrx main context
+ * @comp_head: software descriptor head pointer
+ * @ring_id: ring number
+ *
+ * This function will process batch of descriptors reaped by dp_tx_comp_handler
+ * and release the software descriptors after processing is complete.
+ *
+ * Completions mostly come in runs for the same peer, so the peer is looked
+ * up once per run and its stats are applied once at the end of the run.
+ * Buffers of simple descriptors are freed in bulk and the descriptors are
+ * returned to their pool as a single chain.
+ *
+ * Return: none
+ */
+static void
+dp_tx_comp_process_desc_list(struct dp_soc *soc,
+			     struct dp_tx_desc_s *comp_head, uint8_t ring_id)
+{
+	struct dp_tx_desc_s *desc;
+	struct dp_tx_desc_s *next;
+	struct hal_tx_completion_status ts;
+	struct dp_peer *peer;
+	qdf_nbuf_t netbuf;
+	struct dp_tx_comp_batch batch = {0};
+
+	batch.peer_id = HTT_INVALID_PEER;
+	desc = comp_head;
+
+	while (desc) {
+		next = desc->next;
+
+		if (qdf_likely(desc->flags & DP_TX_DESC_FLAG_SIMPLE)) {
+			peer = dp_tx_comp_batch_peer_get(soc, &batch,
+							 desc->peer_id);
+			if (qdf_likely(peer)) {
+				batch.comp_pkts++;
+				batch.comp_bytes += desc->length;
+				if (desc->tx_status !=
+						HAL_TX_TQM_RR_FRAME_ACKED)
+					batch.tx_failed++;
+			}
+
+			qdf_assert(desc->pdev);
+
+			qdf_mem_unmap_nbytes_single(soc->osdev,
+						    desc->dma_addr,
+						    QDF_DMA_TO_DEVICE,
+						    desc->length);
+			dp_tx_comp_batch_add(soc, &batch, desc);
+			desc = next;
+			continue;
+		}
+		hal_tx_comp_get_status(&desc->comp, &ts, soc->hal_soc);
+		peer = dp_tx_comp_batch_peer_get(soc, &batch, ts.peer_id);
+		dp_tx_comp_process_tx_status(desc, &ts, peer, ring_id);
+
+		netbuf = desc->nbuf;
+		/* check tx complete notification */
+		if (QDF_NBUF_CB_TX_EXTRA_FRAG_FLAGS_NOTIFY_COMP(netbuf))
+			dp_tx_notify_completion(soc, desc, netbuf);
+
+		dp_tx_comp_process_desc(soc, desc, &ts, peer);
+
+		dp_tx_desc_release(desc, desc->pool_id);
+		desc = next;
+	}
+
+	dp_tx_comp_batch_flush(soc, &batch);
+}
+#else
 /**
  * dp_tx_comp_process_desc_list() - Tx complete software descriptor handler
  * @soc: core txrx main context
@@ -3565,8 +4435,8 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 				 * Increment peer statistics
 				 * Minimal statistics update done here
 				 */
-				DP_STATS_INC_PKT(peer, tx.comp_pkt, 1,
-						 desc->length);
+				DP_PEER_TX_SHARD_STATS_INC_PKT(peer, comp_pkt, 1,
+							       desc->length);
 
 				if (desc->tx_status !=
 						HAL_TX_TQM_RR_FRAME_ACKED)
@@ -3613,6 +4483,7 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 	}
 
 }
+#endif /* QCA_DP_TX_COMP_BATCH */
 
 /**
  * dp_tx_process_htt_completion() - Tx HTT Completion Indication Handler
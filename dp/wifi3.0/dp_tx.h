@@ -154,6 +154,82 @@ struct dp_tx_msdu_info_s {
 	uint8_t is_tx_sniffer;
 };
 
+/* Max number of MSDUs enqueued to TCL with a single head pointer update */
+#define DP_TX_BATCH_MAX_MSDU 32
+
+/**
+ * struct dp_tx_batch_elem - MSDU prepared for a batched TCL enqueue
+ * @tx_desc: SW Tx descriptor (mapped, ready to be enqueued)
+ * @htt_tcl_metadata: TCL metadata to be programmed for the MSDU
+ * @tid: TID override for the MSDU
+ * @index_search: program @search_idx instead of the vdev AST search defaults
+ * @cache_set_num: AST cache set of @search_idx
+ * @search_idx: AST index used for HAL_TX_ADDR_INDEX_SEARCH
+ */
+struct dp_tx_batch_elem {
+	struct dp_tx_desc_s *tx_desc;
+	uint16_t htt_tcl_metadata;
+	uint8_t tid;
+	uint8_t index_search:1,
+		cache_set_num:4;
+	uint16_t search_idx;
+};
+
+/**
+ * struct dp_tx_batch - Burst of MSDUs sharing one TCL ring access
+ * @elem: prepared MSDUs
+ * @num: number of valid entries in @elem
+ * @tx_queue: descriptor pool and TCL ring used by all entries
+ */
+struct dp_tx_batch {
+	struct dp_tx_batch_elem elem[DP_TX_BATCH_MAX_MSDU];
+	uint8_t num;
+	struct dp_tx_queue tx_queue;
+};
+
+/**
+ * struct dp_tx_fwd_rx_ctx - RX context of a frame in an intra-BSS batch
+ * @peer_id: id of the peer the frame was received from
+ * @ring_id: REO destination ring the frame was received on
+ * @tid: TID the frame was received on
+ */
+struct dp_tx_fwd_rx_ctx {
+	uint16_t peer_id;
+	uint8_t ring_id;
+	uint8_t tid;
+};
+
+/**
+ * struct dp_tx_fwd_batch - Intra-BSS frames pending a batched TCL enqueue
+ * @vdev: vdev all frames of @batch are forwarded on
+ * @batch: prepared burst
+ * @rx_ctx: RX context of each entry of @batch
+ * @fail_head: head of the frames TCL did not take, with their RX context
+ *	       restored in the nbuf cb
+ * @fail_tail: tail of the frames TCL did not take
+ */
+struct dp_tx_fwd_batch {
+	struct dp_vdev *vdev;
+	struct dp_tx_batch batch;
+	struct dp_tx_fwd_rx_ctx rx_ctx[DP_TX_BATCH_MAX_MSDU];
+	qdf_nbuf_t fail_head;
+	qdf_nbuf_t fail_tail;
+};
+
+/**
+ * dp_tx_fwd_batch_init() - Initialize an intra-BSS forward batch
+ * @fwd: intra-BSS forward batch
+ *
+ * Return: none
+ */
+static inline void dp_tx_fwd_batch_init(struct dp_tx_fwd_batch *fwd)
+{
+	fwd->vdev = NULL;
+	fwd->batch.num = 0;
+	fwd->fail_head = NULL;
+	fwd->fail_tail = NULL;
+}
+
 /**
  * dp_tx_deinit_pair_by_index() - Deinit TX rings based on index
  * @soc: core txrx context
@@ -221,6 +297,17 @@ QDF_STATUS dp_tx_pdev_init(struct dp_pdev *pdev);
 
 qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc, uint8_t vdev_id, qdf_nbuf_t nbuf);
 
+qdf_nbuf_t dp_tx_send_list(struct cdp_soc_t *soc, uint8_t vdev_id,
+			   qdf_nbuf_t nbuf_list);
+
+QDF_STATUS dp_tx_fwd_batch_add(struct dp_soc *soc,
+			       struct dp_tx_fwd_batch *fwd,
+			       struct dp_peer *ta_peer, qdf_nbuf_t nbuf,
+			       uint8_t tid, uint8_t ring_id,
+			       struct dp_ast_entry *ast_entry);
+
+void dp_tx_fwd_batch_flush(struct dp_soc *soc, struct dp_tx_fwd_batch *fwd);
+
 qdf_nbuf_t dp_tx_send_exception(struct cdp_soc_t *soc, uint8_t vdev_id,
 				qdf_nbuf_t nbuf,
 				struct cdp_tx_exception_metadata *tx_exc);
@@ -62,6 +62,50 @@ dp_tx_desc_pool_counter_initialize(struct dp_tx_desc_pool_s *tx_desc_pool,
 }
 #endif
 
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/**
+ * dp_tx_desc_cpu_cache_init() - Initialize the per-CPU descriptor caches
+ * @tx_desc_pool: Handle to DP tx_desc_pool structure
+ *
+ * Return: None
+ */
+static void dp_tx_desc_cpu_cache_init(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+	int cpu;
+
+	qdf_mem_zero(tx_desc_pool->cpu_cache, sizeof(tx_desc_pool->cpu_cache));
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		qdf_spinlock_create(&tx_desc_pool->cpu_cache[cpu].lock);
+}
+
+/**
+ * dp_tx_desc_cpu_cache_deinit() - De-initialize the per-CPU descriptor caches
+ * @tx_desc_pool: Handle to DP tx_desc_pool structure
+ *
+ * Return: None
+ */
+static void dp_tx_desc_cpu_cache_deinit(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		tx_desc_pool->cpu_cache[cpu].freelist = NULL;
+		tx_desc_pool->cpu_cache[cpu].count = 0;
+		qdf_spinlock_destroy(&tx_desc_pool->cpu_cache[cpu].lock);
+	}
+}
+#else
+static inline void
+dp_tx_desc_cpu_cache_init(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+}
+
+static inline void
+dp_tx_desc_cpu_cache_deinit(struct dp_tx_desc_pool_s *tx_desc_pool)
+{
+}
+#endif /* QCA_DP_TX_DESC_PERCPU_CACHE */
+
 /**
  * dp_tx_desc_pool_alloc() - Allocate Tx Descriptor pool(s)
  * @soc Handle to DP SoC structure
@@ -177,6 +221,7 @@ QDF_STATUS dp_tx_desc_pool_init(struct dp_soc *soc, uint8_t pool_id,
 	tx_desc_pool->elem_size = DP_TX_DESC_SIZE(sizeof(*tx_desc_elem));
 
 	dp_tx_desc_pool_counter_initialize(tx_desc_pool, num_elem);
+	dp_tx_desc_cpu_cache_init(tx_desc_pool);
 	TX_DESC_LOCK_CREATE(&tx_desc_pool->lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -194,6 +239,7 @@ void dp_tx_desc_pool_deinit(struct dp_soc *soc, uint8_t pool_id)
 
 	tx_desc_pool = &((soc)->tx_desc[(pool_id)]);
 	TX_DESC_POOL_MEMBER_CLEAN(tx_desc_pool);
+	dp_tx_desc_cpu_cache_deinit(tx_desc_pool);
 	TX_DESC_LOCK_DESTROY(&tx_desc_pool->lock);
 }
 
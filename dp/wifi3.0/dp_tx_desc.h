@@ -544,19 +544,177 @@ static inline void dp_tx_flow_pool_unmap_handler(struct dp_pdev *pdev,
 {
 }
 
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/* Descriptors moved between a CPU cache and the pool per lock acquisition */
+#define DP_TX_DESC_CACHE_BATCH 16
+/* CPU cache is drained back to the pool once it holds this many */
+#define DP_TX_DESC_CACHE_MAX (2 * DP_TX_DESC_CACHE_BATCH)
+
 /**
- * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ * dp_tx_desc_cpu_cache_get() - Get the Tx descriptor cache of current CPU
+ * @pool: Tx descriptor pool
  *
- * @param soc Handle to DP SoC structure
- * @param pool_id
+ * Caller must have bottom halves disabled.
  *
- * Return:
+ * Return: CPU cache, NULL if current CPU has no cache
  */
-static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
-						uint8_t desc_pool_id)
+static inline struct dp_tx_desc_cpu_cache *
+dp_tx_desc_cpu_cache_get(struct dp_tx_desc_pool_s *pool)
+{
+	int cpu = qdf_get_cpu();
+
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU))
+		return NULL;
+
+	return &pool->cpu_cache[cpu];
+}
+
+/**
+ * dp_tx_desc_cpu_cache_refill() - Move a batch of descriptors from the pool
+ *				   freelist to a CPU cache
+ * @pool: Tx descriptor pool
+ * @cache: empty CPU cache of the current CPU
+ *
+ * Descriptors held by a CPU cache are accounted as allocated in the pool.
+ * Caller must hold @cache->lock.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_cpu_cache_refill(struct dp_tx_desc_pool_s *pool,
+			    struct dp_tx_desc_cpu_cache *cache)
+{
+	struct dp_tx_desc_s *head, *tail;
+	uint16_t count = 1;
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+
+	head = pool->freelist;
+	if (!head) {
+		TX_DESC_LOCK_UNLOCK(&pool->lock);
+		return;
+	}
+
+	tail = head;
+	while (tail->next && count < DP_TX_DESC_CACHE_BATCH) {
+		tail = tail->next;
+		count++;
+	}
+
+	pool->freelist = tail->next;
+	pool->num_allocated += count;
+	pool->num_free -= count;
+
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+
+	tail->next = NULL;
+	cache->freelist = head;
+	cache->count = count;
+}
+
+/**
+ * dp_tx_desc_cpu_cache_drain() - Return a batch of descriptors from a CPU
+ *				  cache to the pool freelist
+ * @pool: Tx descriptor pool
+ * @cache: full CPU cache of the current CPU
+ *
+ * Caller must hold @cache->lock.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_cpu_cache_drain(struct dp_tx_desc_pool_s *pool,
+			   struct dp_tx_desc_cpu_cache *cache)
+{
+	struct dp_tx_desc_s *head, *tail;
+	uint16_t count = 1;
+
+	head = cache->freelist;
+	tail = head;
+	while (count < DP_TX_DESC_CACHE_BATCH) {
+		tail = tail->next;
+		count++;
+	}
+
+	cache->freelist = tail->next;
+	cache->count -= count;
+	cache->free_drain++;
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	tail->next = pool->freelist;
+	pool->freelist = head;
+	pool->num_allocated -= count;
+	pool->num_free += count;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+
+/**
+ * dp_tx_desc_cpu_cache_steal() - Take the free descriptors of another CPU's
+ *				  cache once the pool freelist is exhausted
+ * @pool: Tx descriptor pool
+ * @cache: CPU cache of the current CPU
+ *
+ * Descriptors freed on a completion CPU that never transmits would
+ * otherwise stay parked in its cache. The first non-empty remote cache is
+ * emptied: one descriptor is returned and the rest go to @cache. Only one
+ * cache lock is held at a time. Caller must have bottom halves disabled
+ * and must not hold @cache->lock.
+ *
+ * Return: Tx descriptor or NULL if every cache is empty too
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_cpu_cache_steal(struct dp_tx_desc_pool_s *pool,
+			   struct dp_tx_desc_cpu_cache *cache)
+{
+	struct dp_tx_desc_cpu_cache *victim;
+	struct dp_tx_desc_s *head = NULL, *tail;
+	uint16_t count = 0;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU && !head; cpu++) {
+		victim = &pool->cpu_cache[cpu];
+		if (victim == cache || !victim->count)
+			continue;
+
+		qdf_spin_lock(&victim->lock);
+		head = victim->freelist;
+		count = victim->count;
+		victim->freelist = NULL;
+		victim->count = 0;
+		qdf_spin_unlock(&victim->lock);
+	}
+
+	if (!head)
+		return NULL;
+
+	tail = head;
+	while (tail->next)
+		tail = tail->next;
+
+	qdf_spin_lock(&cache->lock);
+	if (--count) {
+		tail->next = cache->freelist;
+		cache->freelist = head->next;
+		cache->count += count;
+	}
+	cache->alloc_steal++;
+	qdf_spin_unlock(&cache->lock);
+
+	return head;
+}
+#endif /* QCA_DP_TX_DESC_PERCPU_CACHE */
+
+/**
+ * dp_tx_desc_pool_get() - Allocate a Software Tx Descriptor from the shared
+ *			   pool freelist
+ * @pool: Tx descriptor pool
+ *
+ * Return: Tx descriptor or NULL if the pool is exhausted
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_pool_get(struct dp_tx_desc_pool_s *pool)
 {
 	struct dp_tx_desc_s *tx_desc = NULL;
-	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
 
 	TX_DESC_LOCK_LOCK(&pool->lock);
 
@@ -579,6 +737,99 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
 	return tx_desc;
 }
 
+/**
+ * dp_tx_desc_pool_put() - Return a Software Tx Descriptor to the shared
+ *			   pool freelist
+ * @pool: Tx descriptor pool
+ * @tx_desc: Tx descriptor, already reset
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pool_put(struct dp_tx_desc_pool_s *pool,
+		    struct dp_tx_desc_s *tx_desc)
+{
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	tx_desc->next = pool->freelist;
+	pool->freelist = tx_desc;
+	pool->num_allocated--;
+	pool->num_free++;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/**
+ * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: pool to allocate from
+ *
+ * Serves the allocation from the current CPU's descriptor cache, which is
+ * refilled from the pool in batches of DP_TX_DESC_CACHE_BATCH, so the pool
+ * lock and freelist cache line are only touched once per batch. The cache
+ * lock is normally only taken by its own CPU. When the pool is exhausted
+ * the descriptors of another CPU's cache are stolen before failing.
+ *
+ * Return: Tx descriptor or NULL
+ */
+static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
+						    uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_s *tx_desc = NULL;
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_cpu_cache *cache;
+
+	qdf_local_bh_disable();
+
+	cache = dp_tx_desc_cpu_cache_get(pool);
+	if (qdf_unlikely(!cache)) {
+		qdf_local_bh_enable();
+		return dp_tx_desc_pool_get(pool);
+	}
+
+	qdf_spin_lock(&cache->lock);
+	if (qdf_unlikely(!cache->count)) {
+		cache->alloc_miss++;
+		dp_tx_desc_cpu_cache_refill(pool, cache);
+	} else {
+		cache->alloc_hit++;
+	}
+
+	if (qdf_likely(cache->count)) {
+		tx_desc = cache->freelist;
+		cache->freelist = tx_desc->next;
+		cache->count--;
+	}
+	qdf_spin_unlock(&cache->lock);
+
+	/* pool exhausted, the free descriptors may sit in other caches */
+	if (qdf_unlikely(!tx_desc))
+		tx_desc = dp_tx_desc_cpu_cache_steal(pool, cache);
+
+	qdf_local_bh_enable();
+
+	if (qdf_unlikely(!tx_desc))
+		return NULL;
+
+	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+
+	return tx_desc;
+}
+#else
+/**
+ * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ *
+ * @param soc Handle to DP SoC structure
+ * @param pool_id
+ *
+ * Return:
+ */
+static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
+						uint8_t desc_pool_id)
+{
+	return dp_tx_desc_pool_get(&soc->tx_desc[desc_pool_id]);
+}
+#endif /* QCA_DP_TX_DESC_PERCPU_CACHE */
+
 /**
  * dp_tx_desc_alloc_multiple() - Allocate batch of software Tx Descriptors
  *                            from given pool
@@ -628,6 +879,49 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc_multiple(
 	return h_desc;
 }
 
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/**
+ * dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: descriptor to free
+ * @desc_pool_id: pool the descriptor belongs to
+ *
+ * The descriptor is put in the current CPU's cache; a batch is returned to
+ * the pool once the cache holds DP_TX_DESC_CACHE_MAX descriptors.
+ */
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_cpu_cache *cache;
+
+	tx_desc->vdev = NULL;
+	tx_desc->nbuf = NULL;
+	tx_desc->flags = 0;
+
+	qdf_local_bh_disable();
+
+	cache = dp_tx_desc_cpu_cache_get(pool);
+	if (qdf_unlikely(!cache)) {
+		qdf_local_bh_enable();
+		dp_tx_desc_pool_put(pool, tx_desc);
+		return;
+	}
+
+	qdf_spin_lock(&cache->lock);
+	tx_desc->next = cache->freelist;
+	cache->freelist = tx_desc;
+	cache->count++;
+	cache->free_hit++;
+
+	if (qdf_unlikely(cache->count >= DP_TX_DESC_CACHE_MAX))
+		dp_tx_desc_cpu_cache_drain(pool, cache);
+	qdf_spin_unlock(&cache->lock);
+
+	qdf_local_bh_enable();
+}
+#else
 /**
  * dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
  *
@@ -639,22 +933,82 @@ static inline void
 dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		uint8_t desc_pool_id)
 {
-	struct dp_tx_desc_pool_s *pool = NULL;
 	tx_desc->vdev = NULL;
 	tx_desc->nbuf = NULL;
 	tx_desc->flags = 0;
 
-	pool = &soc->tx_desc[desc_pool_id];
-	TX_DESC_LOCK_LOCK(&pool->lock);
-	tx_desc->next = pool->freelist;
-	pool->freelist = tx_desc;
-	pool->num_allocated--;
-	pool->num_free++;
-	TX_DESC_LOCK_UNLOCK(&pool->lock);
+	dp_tx_desc_pool_put(&soc->tx_desc[desc_pool_id], tx_desc);
 }
+#endif /* QCA_DP_TX_DESC_PERCPU_CACHE */
 
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 
+#if defined(QCA_LL_TX_FLOW_CONTROL_V2) || defined(QCA_DP_TX_DESC_PERCPU_CACHE)
+/**
+ * dp_tx_desc_free_list() - Free a chain of tx descriptors of one pool
+ * @soc: Handle to DP SoC structure
+ * @head: first descriptor of the chain, linked through ->next
+ * @tail: last descriptor of the chain
+ * @count: number of descriptors in the chain
+ * @desc_pool_id: pool all descriptors of the chain belong to
+ *
+ * Flow control pools need per descriptor threshold checks, and with the
+ * CPU caches each free only takes the lock of the local CPU's cache, which
+ * is contended only by a steal from another CPU. Descriptors are freed one
+ * by one.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_list(struct dp_soc *soc, struct dp_tx_desc_s *head,
+		     struct dp_tx_desc_s *tail, uint16_t count,
+		     uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_s *next;
+
+	while (head) {
+		next = head->next;
+		dp_tx_desc_free(soc, head, desc_pool_id);
+		head = next;
+	}
+}
+#else
+/**
+ * dp_tx_desc_free_list() - Free a chain of tx descriptors of one pool
+ * @soc: Handle to DP SoC structure
+ * @head: first descriptor of the chain, linked through ->next
+ * @tail: last descriptor of the chain
+ * @count: number of descriptors in the chain
+ * @desc_pool_id: pool all descriptors of the chain belong to
+ *
+ * The whole chain is spliced onto the pool freelist under a single
+ * acquisition of the pool lock.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free_list(struct dp_soc *soc, struct dp_tx_desc_s *head,
+		     struct dp_tx_desc_s *tail, uint16_t count,
+		     uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_s *tx_desc;
+
+	for (tx_desc = head; tx_desc; tx_desc = tx_desc->next) {
+		tx_desc->vdev = NULL;
+		tx_desc->nbuf = NULL;
+		tx_desc->flags = 0;
+	}
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	tail->next = pool->freelist;
+	pool->freelist = head;
+	pool->num_allocated -= count;
+	pool->num_free += count;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+#endif
+
 #ifdef QCA_DP_TX_DESC_ID_CHECK
 /**
  * dp_tx_is_desc_id_valid() - check is the tx desc id valid
@@ -28,6 +28,9 @@
 #include <qdf_lro.h>
 #include <queue.h>
 #include <htt_common.h>
+#ifdef DP_PEER_LOOKUP_RCU
+#include <qdf_rcu.h>
+#endif
 
 #include <cdp_txrx_cmn.h>
 #ifdef DP_MOB_DEFS
@@ -89,6 +92,15 @@
 #define MAX_TXDESC_POOLS 4
 #define MAX_RXDESC_POOLS 4
 #define MAX_REO_DEST_RINGS 4
+
+/* Slots and granularity of the rx defrag waitlist timer wheel */
+#define DP_RX_DEFRAG_WHEEL_SLOTS 64
+#define DP_RX_DEFRAG_WHEEL_GRAN_MS 16
+/* TIDs waiting for fragments before the oldest sequences are evicted */
+#define DP_RX_DEFRAG_WAITLIST_MAX 256
+/* Buckets of the TX PPDU stats ppdu_id index, power of 2 */
+#define DP_PPDU_INFO_HASH_SIZE 32
+#define DP_PPDU_DESC_NBUF_CACHE_SIZE 4
 #define EXCEPTION_DEST_RING_ID 0
 #define MAX_TCL_DATA_RINGS 4
 #define MAX_IDLE_SCATTER_BUFS 16
@@ -323,6 +335,31 @@ struct rx_desc_pool {
 	uint8_t buf_alignment;
 };
 
+#ifdef QCA_DP_RX_NBUF_RECYCLE
+/* Max nbufs parked in each per-CPU Rx recycle pool */
+#define DP_RX_NBUF_RECYCLE_MAX 256
+
+/**
+ * struct dp_rx_nbuf_recycle_pool - Per-CPU pool of DMA mapped Rx nbufs
+ * @head: recycled nbufs, linked through qdf_nbuf_next()
+ * @count: number of nbufs in @head
+ * @hit: replenish requests served from the pool
+ * @miss: replenish requests which fell back to qdf_nbuf_alloc()
+ * @recycled: nbufs returned to the pool instead of being freed
+ * @not_recyclable: nbufs freed as they failed qdf_nbuf_is_recyclable()
+ * @full: nbufs freed as the pool was full
+ */
+struct dp_rx_nbuf_recycle_pool {
+	qdf_nbuf_t head;
+	uint32_t count;
+	uint32_t hit;
+	uint32_t miss;
+	uint32_t recycled;
+	uint32_t not_recyclable;
+	uint32_t full;
+} qdf_cacheline_aligned;
+#endif
+
 /**
  * struct dp_tx_ext_desc_elem_s
  * @next: next extension descriptor pointer
@@ -455,6 +492,38 @@ struct dp_tx_tso_num_seg_pool_s {
 	qdf_spinlock_t lock;
 };
 
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+/*
+ * Flow control V2 pauses/unpauses netif queues on exact per-pool descriptor
+ * counts, which descriptors parked in CPU caches would skew.
+ */
+#ifdef QCA_LL_TX_FLOW_CONTROL_V2
+#error /*QCA_DP_TX_DESC_PERCPU_CACHE cannot be used with QCA_LL_TX_FLOW_CONTROL_V2*/
+#endif
+
+/**
+ * struct dp_tx_desc_cpu_cache - Per-CPU cache of free Tx descriptors
+ * @lock: taken by the owning CPU and by other CPUs stealing descriptors
+ * @freelist: free descriptors owned by this CPU
+ * @count: number of descriptors in @freelist
+ * @alloc_hit: allocations served from the cache
+ * @alloc_miss: allocations which refilled the cache from the pool
+ * @alloc_steal: allocations served from another CPU's cache
+ * @free_hit: frees absorbed by the cache
+ * @free_drain: cache drains back to the pool
+ */
+struct dp_tx_desc_cpu_cache {
+	qdf_spinlock_t lock;
+	struct dp_tx_desc_s *freelist;
+	uint16_t count;
+	uint32_t alloc_hit;
+	uint32_t alloc_miss;
+	uint32_t alloc_steal;
+	uint32_t free_hit;
+	uint32_t free_drain;
+} qdf_cacheline_aligned;
+#endif
+
 /**
  * struct dp_tx_desc_pool_s - Tx Descriptor pool information
  * @elem_size: Size of each descriptor in the pool
@@ -467,6 +536,7 @@ struct dp_tx_tso_num_seg_pool_s {
  * @flow_pool_array_lock: Lock when operating on flow_pool_array.
  * @flow_pool_array: List of allocated flow pools
  * @lock- Lock for descriptor allocation/free from/to the pool
+ * @cpu_cache: per-CPU caches of free descriptors
  */
 struct dp_tx_desc_pool_s {
 	uint16_t elem_size;
@@ -497,6 +567,9 @@ struct dp_tx_desc_pool_s {
 	uint16_t elem_count;
 	uint32_t num_free;
 	qdf_spinlock_t lock;
+#ifdef QCA_DP_TX_DESC_PERCPU_CACHE
+	struct dp_tx_desc_cpu_cache cpu_cache[QDF_MAX_AVAILABLE_CPU];
+#endif
 #endif
 };
 
@@ -612,6 +685,10 @@ struct dp_rx_tid {
 	uint64_t pn128[2];
 
 	uint32_t defrag_timeout_ms;
+	/* defrag waitlist wheel slot, valid while on the waitlist */
+	uint8_t defrag_wheel_slot;
+	/* time the first fragment of the current sequence was stored */
+	uint32_t defrag_start_ms;
 	uint16_t dialogtoken;
 	uint16_t statuscode;
 	/* user defined ADDBA response status code */
@@ -674,6 +751,51 @@ struct dp_intr_stats {
 	uint32_t num_masks;
 };
 
+#ifdef DP_INTR_ADAPTIVE_MODERATION
+/* Moderation profiles, spread evenly between the ini min and max */
+#define DP_INTR_MOD_NUM_PROFILES 5
+/* Profile changes kept for the stats dump */
+#define DP_INTR_MOD_HIST_SIZE 16
+
+/**
+ * struct dp_intr_mod_record - Moderation profile change record
+ * @ts_us: time of the change
+ * @avg_work: average entries processed per poll in the decision window
+ * @avg_gap_us: average time between polls in the decision window
+ * @profile: profile selected
+ */
+struct dp_intr_mod_record {
+	uint64_t ts_us;
+	uint32_t avg_work;
+	uint32_t avg_gap_us;
+	uint8_t profile;
+};
+
+/**
+ * struct dp_intr_mod - Adaptive interrupt moderation state of a dp_intr
+ * @profile: current profile index
+ * @applied: @profile has been programmed to the rings
+ * @polls: polls in the current decision window
+ * @work: entries processed in the current decision window
+ * @window_start_us: start time of the current decision window
+ * @changes: number of profile changes
+ * @profile_windows: decision windows spent in each profile
+ * @hist: last profile changes
+ * @hist_idx: next slot in @hist
+ */
+struct dp_intr_mod {
+	uint8_t profile;
+	bool applied;
+	uint32_t polls;
+	uint32_t work;
+	uint64_t window_start_us;
+	uint32_t changes;
+	uint32_t profile_windows[DP_INTR_MOD_NUM_PROFILES];
+	struct dp_intr_mod_record hist[DP_INTR_MOD_HIST_SIZE];
+	uint8_t hist_idx;
+};
+#endif
+
 /* per interrupt context  */
 struct dp_intr {
 	uint8_t tx_ring_mask;   /* WBM Tx completion rings (0-2)
@@ -695,6 +817,15 @@ struct dp_intr {
 
 	/* Interrupt Stats for individual masks */
 	struct dp_intr_stats intr_stats;
+
+#ifdef DP_INTR_ADAPTIVE_MODERATION
+	/* Adaptive SRNG interrupt moderation state */
+	struct dp_intr_mod intr_mod;
+#endif
+#ifdef HIF_EXEC_BUSY_POLL
+	/* NAPI instance of the HIF exec context, marked on Rx frames */
+	void *napi;
+#endif
 };
 
 #define REO_DESC_FREELIST_SIZE 64
@@ -739,8 +870,23 @@ struct dp_soc_stats {
 		uint32_t aged_out;
 		uint32_t map_err;
 		uint32_t ast_mismatch;
+		/* AST hash table resizes and failed resize allocations */
+		uint32_t hash_resize;
+		uint32_t hash_resize_fail;
+		/* entries moved by incremental rehash */
+		uint32_t hash_migrated;
 	} ast;
 
+	/* peer_ref_mutex and peer lookup stats */
+	struct {
+		/* peer_ref_mutex acquisitions, all taken via dp_peer_ref_mutex_lock */
+		uint32_t lock_acquired;
+		/* acquisitions which found peer_ref_mutex already held */
+		uint32_t lock_contended;
+		/* lockless lookups which found the peer being deleted */
+		qdf_atomic_t rcu_del_race;
+	} peer_find;
+
 	/* SOC level TX stats */
 	struct {
 		/* packets dropped on tx because of no peer */
@@ -761,6 +907,10 @@ struct dp_soc_stats {
 		uint32_t tx_comp_loop_pkt_limit_hit;
 		/* Head pointer Out of sync at the end of dp_tx_comp_handler */
 		uint32_t hp_oos2;
+		/* TCL ring accesses done for a burst of MSDUs */
+		uint32_t batch_enqueue;
+		/* MSDUs enqueued through burst TCL ring accesses */
+		uint32_t batch_msdus;
 	} tx;
 
 	/* SOC level RX stats */
@@ -778,6 +928,17 @@ struct dp_soc_stats {
 		uint32_t rx_frag_err_len_error;
 		/* Fragments dropped due to no peer found */
 		uint32_t rx_frag_err_no_peer;
+		/* Incomplete fragment sequences dropped on timeout */
+		uint32_t rx_frag_timeout;
+		/* Incomplete fragment sequences evicted on a full waitlist */
+		uint32_t rx_frag_evict;
+		/* Fragment sequences reassembled */
+		uint32_t rx_frag_reasm;
+		/* Fragment sequences reassembled into the head buffer */
+		uint32_t rx_frag_linear;
+		/* First fragment to reassembly latency, total and max */
+		uint64_t rx_frag_reasm_lat_ms;
+		uint32_t rx_frag_reasm_lat_max_ms;
 		/* No of reinjected packets */
 		uint32_t reo_reinject;
 		/* Reap loop packet limit hit */
@@ -861,6 +1022,8 @@ struct dp_soc_stats {
 
 		/* packet count per core - per ring */
 		uint64_t ring_packets[NR_CPUS][MAX_REO_DEST_RINGS];
+		/* bytes synced for CPU on Rx buffer unmap per ring */
+		uint64_t buf_inv_bytes[MAX_REO_DEST_RINGS];
 	} rx;
 
 #ifdef WLAN_FEATURE_DP_EVENT_HISTORY
@@ -885,6 +1048,36 @@ union dp_align_mac_addr {
 	} align4_2;
 };
 
+TAILQ_HEAD(dp_ast_hash_bin, dp_ast_entry);
+
+/* Bucket lock groups of the AST hash; a power of 2 */
+#define DP_AST_HASH_LOCK_GROUPS 16
+
+/**
+ * struct dp_ast_hash_table - AST hash bucket array
+ * @mask: bucket index mask, at least DP_AST_HASH_LOCK_GROUPS - 1
+ * @idx_bits: log2 of number of buckets
+ * @bins: hash buckets
+ */
+struct dp_ast_hash_table {
+	unsigned int mask;
+	unsigned int idx_bits;
+	struct dp_ast_hash_bin bins[];
+};
+
+/**
+ * struct dp_ast_peek_info - AST entry fields copied out under the
+ *			     bucket group lock
+ * @peer: peer the entry points to, no reference held
+ * @pdev_id: pdev id of the entry
+ * @type: AST entry type
+ */
+struct dp_ast_peek_info {
+	struct dp_peer *peer;
+	uint8_t pdev_id;
+	enum cdp_txrx_ast_entry_type type;
+};
+
 /**
  * struct dp_ast_free_cb_params - HMWDS free callback cookie
  * @mac_addr: ast mac address
@@ -1119,6 +1312,11 @@ struct dp_soc {
 	/* Rx SW descriptor pool for RXDMA buffer */
 	struct rx_desc_pool rx_desc_buf[MAX_RXDESC_POOLS];
 
+#ifdef QCA_DP_RX_NBUF_RECYCLE
+	/* Per-CPU pools of mapped nbufs for RXDMA buffer replenish */
+	struct dp_rx_nbuf_recycle_pool rx_recycle[QDF_MAX_AVAILABLE_CPU];
+#endif
+
 	/* Number of REO destination rings */
 	uint8_t num_reo_dest_rings;
 
@@ -1153,13 +1351,17 @@ struct dp_soc {
 	struct {
 		unsigned mask;
 		unsigned idx_bits;
-		TAILQ_HEAD(, dp_peer) * bins;
+		TAILQ_HEAD(dp_peer_hash_bin, dp_peer) * bins;
 	} peer_hash;
 
 	/* rx defrag state – TBD: do we need this per radio? */
 	struct {
 		struct {
-			TAILQ_HEAD(, dp_rx_tid) waitlist;
+			/* timer wheel, hashed on defrag_timeout_ms */
+			TAILQ_HEAD(, dp_rx_tid)
+				waitlist[DP_RX_DEFRAG_WHEEL_SLOTS];
+			uint32_t waitlist_len;
+			uint32_t wheel_tick;
 			uint32_t timeout_ms;
 			uint32_t next_flush_ms;
 			qdf_spinlock_t defrag_lock;
@@ -1197,6 +1399,11 @@ struct dp_soc {
 	 */
 	DP_MUTEX_TYPE peer_ref_mutex;
 
+#ifdef QCA_DP_PCPU_STATS
+	/* Serializes folding of vdev/peer stats shards */
+	qdf_spinlock_t stats_shard_lock;
+#endif
+
 	/* maximum value for peer_id */
 	uint32_t max_peers;
 
@@ -1207,10 +1414,22 @@ struct dp_soc {
 	bool process_tx_status;
 	bool process_rx_status;
 	struct dp_ast_entry **ast_table;
+	/*
+	 * AST MAC hash. Each bucket chain is guarded by
+	 * lock[hash & (groups - 1)]; per-frame lookups take only that lock
+	 * through dp_peer_ast_hash_peek(). ast_lock serializes the control
+	 * path (entry state, peer AST lists, ast_table) and the table swap:
+	 * old_table is non-NULL while buckets are being migrated into a
+	 * larger table, rehash_idx is the next old bucket to migrate and
+	 * grow_pending asks for a new table to be allocated outside ast_lock.
+	 */
 	struct {
-		unsigned mask;
-		unsigned idx_bits;
-		TAILQ_HEAD(, dp_ast_entry) * bins;
+		struct dp_ast_hash_table *table;
+		struct dp_ast_hash_table *old_table;
+		unsigned int rehash_idx;
+		unsigned int max_idx_bits;
+		bool grow_pending;
+		qdf_spinlock_t lock[DP_AST_HASH_LOCK_GROUPS];
 	} ast_hash;
 
 	qdf_spinlock_t ast_lock;
@@ -1453,6 +1672,7 @@ struct dp_neighbour_peer {
  * @ppdu_desc: ppdu descriptor
  * @ppdu_info_list_elem: linked list of ppdu tlvs
  * @ppdu_info_queue_elem: Singly linked list (queue) of ppdu tlvs
+ * @hash_next: next ppdu_info in the ppdu_id hash bucket or in the free list
  * @mpdu_compltn_common_tlv: Successful tlv counter from COMPLTN COMMON tlv
  * @mpdu_ack_ba_tlv: Successful tlv counter from ACK BA tlv
  */
@@ -1478,6 +1698,7 @@ struct ppdu_info {
 #endif
 	uint8_t compltn_common_tlv;
 	uint8_t ack_ba_tlv;
+	struct ppdu_info *hash_next;
 };
 
 /**
@@ -1787,6 +2008,16 @@ struct dp_pdev {
 	TAILQ_HEAD(, ppdu_info) ppdu_info_list;
 	uint32_t tlv_count;
 	uint32_t list_depth;
+#ifndef WLAN_TX_PKT_CAPTURE_ENH
+	/* ppdu_info list entries indexed by ppdu_id */
+	struct ppdu_info *ppdu_info_hash[DP_PPDU_INFO_HASH_SIZE];
+	/* pre-allocated ppdu_info entries and free list of the slab */
+	struct ppdu_info *ppdu_info_slab;
+	struct ppdu_info *ppdu_info_freelist;
+#endif
+	/* ppdu desc nbufs dropped before delivery, kept for reuse */
+	qdf_nbuf_t ppdu_desc_nbuf_cache[DP_PPDU_DESC_NBUF_CACHE_SIZE];
+	uint8_t ppdu_desc_nbuf_cache_cnt;
 	uint32_t ppdu_id;
 	bool first_nbuf;
 	struct {
@@ -1908,6 +2139,93 @@ struct dp_pdev {
 
 struct dp_peer;
 
+#if defined(DISABLE_DP_STATS) && defined(QCA_DP_PCPU_STATS)
+#undef QCA_DP_PCPU_STATS
+#endif
+
+#ifdef QCA_DP_PCPU_STATS
+/**
+ * struct dp_vdev_tx_i_shard_stats - Hot vdev Tx ingress counters
+ * @rcvd: frames received from the stack
+ * @processed: frames enqueued to TCL
+ */
+struct dp_vdev_tx_i_shard_stats {
+	struct cdp_pkt_info rcvd;
+	struct cdp_pkt_info processed;
+};
+
+/**
+ * struct dp_vdev_stats_shard - Per-CPU shard of vdev stats
+ * @cur: counters updated by the datapath on this CPU
+ * @synced: values of @cur already folded into vdev->stats
+ */
+struct dp_vdev_stats_shard {
+	struct dp_vdev_tx_i_shard_stats cur;
+	struct dp_vdev_tx_i_shard_stats synced;
+} qdf_cacheline_aligned;
+
+/**
+ * struct dp_peer_rx_shard_stats - Hot peer Rx counters of one CPU
+ * @rcvd_reo: msdus reaped from each REO destination ring
+ * @to_stack: msdus delivered to the stack
+ * @multicast: multicast msdus
+ * @bcast: broadcast msdus
+ * @non_amsdu_cnt: msdus not part of an A-MSDU
+ * @amsdu_cnt: msdus part of an A-MSDU
+ * @rx_retries: msdus with the retry bit set
+ */
+struct dp_peer_rx_shard_stats {
+	struct cdp_pkt_info rcvd_reo[MAX_REO_DEST_RINGS];
+	struct cdp_pkt_info to_stack;
+	struct cdp_pkt_info multicast;
+	struct cdp_pkt_info bcast;
+	uint32_t non_amsdu_cnt;
+	uint32_t amsdu_cnt;
+	uint32_t rx_retries;
+};
+
+/**
+ * struct dp_peer_rx_stats_shard - Per-CPU shard of peer Rx stats
+ * @cur: counters updated by the datapath on this CPU
+ * @synced: values of @cur already folded into peer->stats
+ */
+struct dp_peer_rx_stats_shard {
+	struct dp_peer_rx_shard_stats cur;
+	struct dp_peer_rx_shard_stats synced;
+} qdf_cacheline_aligned;
+
+/**
+ * struct dp_peer_tx_shard_stats - Hot peer Tx completion counters of one
+ *				   CPU
+ * @comp_pkt: completed msdus
+ * @ucast: unicast msdus
+ * @mcast: multicast msdus
+ * @bcast: broadcast msdus
+ * @tx_success: acked msdus
+ * @non_amsdu_cnt: msdus not part of an A-MSDU
+ * @amsdu_cnt: msdus part of an A-MSDU
+ */
+struct dp_peer_tx_shard_stats {
+	struct cdp_pkt_info comp_pkt;
+	struct cdp_pkt_info ucast;
+	struct cdp_pkt_info mcast;
+	struct cdp_pkt_info bcast;
+	struct cdp_pkt_info tx_success;
+	uint32_t non_amsdu_cnt;
+	uint32_t amsdu_cnt;
+};
+
+/**
+ * struct dp_peer_tx_stats_shard - Per-CPU shard of peer Tx stats
+ * @cur: counters updated by the datapath on this CPU
+ * @synced: values of @cur already folded into peer->stats
+ */
+struct dp_peer_tx_stats_shard {
+	struct dp_peer_tx_shard_stats cur;
+	struct dp_peer_tx_shard_stats synced;
+} qdf_cacheline_aligned;
+#endif
+
 /* VDEV structure for data path state */
 struct dp_vdev {
 	/* OS device abstraction */
@@ -2065,6 +2383,11 @@ struct dp_vdev {
 	/* VDEV Stats */
 	struct cdp_vdev_stats stats;
 
+#ifdef QCA_DP_PCPU_STATS
+	/* Per-CPU Tx ingress stats, folded into stats on stats requests */
+	struct dp_vdev_stats_shard stats_shard[QDF_MAX_AVAILABLE_CPU];
+#endif
+
 	/* Is this a proxySTA VAP */
 	bool proxysta_vdev;
 	/* Is isolation mode enabled */
@@ -2230,6 +2553,12 @@ struct dp_peer {
 	TAILQ_ENTRY(dp_peer) peer_list_elem;
 	/* node in the hash table bin's list of peers */
 	TAILQ_ENTRY(dp_peer) hash_list_elem;
+#ifdef DP_PEER_LOOKUP_RCU
+	/* deferred free once lockless lookups can no longer see the peer */
+	qdf_rcu_head_t rcu;
+	/* vdev id, checked by lockless lookups before taking a reference */
+	uint8_t vdev_id;
+#endif
 
 	/* TID structures */
 	struct dp_rx_tid rx_tid[DP_MAX_TIDS];
@@ -2265,6 +2594,12 @@ struct dp_peer {
 	/* Peer Stats */
 	struct cdp_peer_stats stats;
 
+#ifdef QCA_DP_PCPU_STATS
+	/* Per-CPU Rx/Tx stats shards, folded into stats on stats requests */
+	struct dp_peer_rx_stats_shard rx_shard[QDF_MAX_AVAILABLE_CPU];
+	struct dp_peer_tx_stats_shard tx_shard[QDF_MAX_AVAILABLE_CPU];
+#endif
+
 	TAILQ_HEAD(, dp_ast_entry) ast_entry_list;
 	/* TBD */
 
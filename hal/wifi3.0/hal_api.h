@@ -1099,6 +1099,43 @@ void *hal_srng_dst_peek(hal_soc_handle_t hal_soc_hdl,
 	return NULL;
 }
 
+/**
+ * hal_srng_dst_peek_nth - Peek the entry n slots after the tail pointer
+ * @hal_soc: Opaque HAL SOC handle
+ * @hal_ring_hdl: Destination ring pointer
+ * @n: number of entries after the current tail pointer
+ *
+ * Tail pointer is not moved. Only entries already covered by the cached
+ * head pointer are returned. Rings with HAL_SRNG_CACHED_DESC are not
+ * supported since their entries are synced only when reaped.
+ * Caller takes responsibility for any locking needs.
+ *
+ * Return: Opaque pointer for the ring entry; NULL if not available
+ */
+static inline
+void *hal_srng_dst_peek_nth(hal_soc_handle_t hal_soc_hdl,
+			    hal_ring_handle_t hal_ring_hdl, uint32_t n)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t tp = srng->u.dst_ring.tp;
+	uint32_t hp = srng->u.dst_ring.cached_hp;
+	uint32_t offset = n * srng->entry_size;
+	uint32_t avail;
+
+	if (srng->flags & HAL_SRNG_CACHED_DESC)
+		return NULL;
+
+	avail = (hp >= tp) ? (hp - tp) : (srng->ring_size - tp + hp);
+	if (offset >= avail)
+		return NULL;
+
+	tp += offset;
+	if (tp >= srng->ring_size)
+		tp -= srng->ring_size;
+
+	return (void *)(&srng->ring_base_vaddr[tp]);
+}
+
 /**
  * hal_srng_access_start_unlocked - Start ring access (unlocked). Should use
  * hal_srng_access_start if locked access is required
@@ -2108,6 +2145,26 @@ void hal_get_srng_params(hal_soc_handle_t hal_soc_hdl,
 			 hal_ring_handle_t hal_ring_hdl,
 			 struct hal_srng_params *ring_params);
 
+/**
+ * hal_srng_dst_set_intr_thres - Reprogram interrupt thresholds of an
+ *				 initialized destination ring
+ *
+ * @hal_soc_hdl: Opaque HAL SOC handle
+ * @hal_ring_hdl: Destination ring pointer
+ * @intr_timer_thres_us: interrupt timer threshold in us, 0 to disable
+ * @intr_batch_cntr_thres_entries: batch counter threshold in entries,
+ *				   0 to disable
+ *
+ * The caller must hold a runtime PM vote, the register write is not
+ * deferred to the resume flush like head/tail pointer updates.
+ *
+ * Return: None
+ */
+void hal_srng_dst_set_intr_thres(hal_soc_handle_t hal_soc_hdl,
+				 hal_ring_handle_t hal_ring_hdl,
+				 uint32_t intr_timer_thres_us,
+				 uint32_t intr_batch_cntr_thres_entries);
+
 /**
  * hal_mem_info - Retrieve hal memory base address
  *
@@ -228,6 +228,12 @@ typedef struct hal_ring_handle *hal_ring_handle_t;
 #define HAL_SRNG_FLUSH_EVENT BIT(0)
 
 #ifdef FEATURE_HAL_DELAYED_REG_WRITE
+/* Hal srng reg_write_flags bits
+ * HAL_SRNG_REG_WRITE_DIRTY: HP/TP update pending in the delayed write queue
+ * HAL_SRNG_REG_WRITE_BUSY: delayed write worker is writing HP/TP register
+ */
+#define HAL_SRNG_REG_WRITE_DIRTY 0
+#define HAL_SRNG_REG_WRITE_BUSY 1
 
 /**
  * struct hal_reg_write_q_elem - delayed register write queue element
@@ -235,7 +241,8 @@ typedef struct hal_ring_handle *hal_ring_handle_t;
  * @addr: iomem address of the register
  * @enqueue_val: register value at the time of delayed write enqueue
  * @dequeue_val: register value at the time of delayed write dequeue
- * @valid: whether this entry is valid or not
+ * @seq: slot sequence; equals write index + 1 once the entry is published
+ *	 and read index + queue length once the worker has consumed it
  * @enqueue_time: enqueue time (qdf_log_timestamp)
  * @work_scheduled_time: work scheduled time (qdf_log_timestamp)
  * @dequeue_time: dequeue time (qdf_log_timestamp)
@@ -245,24 +252,46 @@ struct hal_reg_write_q_elem {
 	void __iomem *addr;
 	uint32_t enqueue_val;
 	uint32_t dequeue_val;
-	uint8_t valid;
+	qdf_atomic_t seq;
 	qdf_time_t enqueue_time;
 	qdf_time_t work_scheduled_time;
 	qdf_time_t dequeue_time;
 };
 
+/**
+ * enum hal_reg_write_coalesce - ENUM for delayed write coalescing histogram
+ * @REG_WRITE_COALESCE_1: index for writes covering a single HP/TP update
+ * @REG_WRITE_COALESCE_2_4: index for writes covering 2 to 4 updates
+ * @REG_WRITE_COALESCE_5_16: index for writes covering 5 to 16 updates
+ * @REG_WRITE_COALESCE_GT_16: index for writes covering more than 16 updates
+ * @REG_WRITE_COALESCE_HIST_MAX: Max value (size of histogram array)
+ */
+enum hal_reg_write_coalesce {
+	REG_WRITE_COALESCE_1,
+	REG_WRITE_COALESCE_2_4,
+	REG_WRITE_COALESCE_5_16,
+	REG_WRITE_COALESCE_GT_16,
+	REG_WRITE_COALESCE_HIST_MAX,
+};
+
 /**
  * struct hal_reg_write_srng_stats - srng stats to keep track of register writes
  * @enqueues: writes enqueued to delayed work
  * @dequeues: writes dequeued from delayed work (not written yet)
  * @coalesces: writes not enqueued since srng is already queued up
  * @direct: writes not enqueued and written to register directly
+ * @q_full: writes done directly since the delayed write queue was full
+ * @pending: HP/TP updates since the last delayed write of the srng
+ * @coalesce_hist: histogram of HP/TP updates covered by one delayed write
  */
 struct hal_reg_write_srng_stats {
 	uint32_t enqueues;
 	uint32_t dequeues;
 	uint32_t coalesces;
 	uint32_t direct;
+	uint32_t q_full;
+	qdf_atomic_t pending;
+	uint32_t coalesce_hist[REG_WRITE_COALESCE_HIST_MAX];
 };
 
 /**
@@ -288,6 +317,7 @@ enum hal_reg_sched_delay {
  * @coalesces: writes not enqueued since srng is already queued up
  * @direct: writes not enqueud and writted to register directly
  * @prevent_l1_fails: prevent l1 API failed
+ * @q_full: writes done directly since the delayed write queue was full
  * @q_depth: current queue depth in delayed register write queue
  * @max_q_depth: maximum queue for delayed register write queue
  * @sched_delay: = kernel work sched delay + bus wakeup delay, histogram
@@ -298,6 +328,7 @@ struct hal_reg_write_soc_stats {
 	qdf_atomic_t coalesces;
 	qdf_atomic_t direct;
 	uint32_t prevent_l1_fails;
+	qdf_atomic_t q_full;
 	qdf_atomic_t q_depth;
 	uint32_t max_q_depth;
 	uint32_t sched_delay[REG_WRITE_SCHED_DELAY_HIST_MAX];
@@ -418,8 +449,8 @@ struct hal_srng {
 	/* last flushed time stamp */
 	uint64_t last_flush_ts;
 #ifdef FEATURE_HAL_DELAYED_REG_WRITE
-	/* flag to indicate whether srng is already queued for delayed write */
-	uint8_t reg_write_in_progress;
+	/* HAL_SRNG_REG_WRITE_* flags of the srng for delayed writes */
+	unsigned long reg_write_flags;
 
 	/* srng specific delayed write stats */
 	struct hal_reg_write_srng_stats wstats;
@@ -749,15 +780,15 @@ struct hal_soc {
 	struct hal_reg_write_fail_history *reg_wr_fail_hist;
 #endif
 #ifdef FEATURE_HAL_DELAYED_REG_WRITE
-	/* queue(array) to hold register writes */
+	/* bounded lock-free MPSC queue of srngs pending a register write */
 	struct hal_reg_write_q_elem *reg_write_queue;
 	/* delayed work to be queued into workqueue */
 	qdf_work_t reg_write_work;
 	/* workqueue for delayed register writes */
 	qdf_workqueue_t *reg_write_wq;
-	/* write index used by caller to enqueue delayed work */
+	/* free running write index claimed by producers to enqueue */
 	qdf_atomic_t write_idx;
-	/* read index used by worker thread to dequeue/write registers */
+	/* free running read index used by the worker to dequeue/write */
 	uint32_t read_idx;
 #endif
 	qdf_atomic_t active_work_cnt;
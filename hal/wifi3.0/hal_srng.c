@@ -434,7 +434,9 @@ qdf_export_symbol(hal_get_target_type);
 #ifdef MEMORY_DEBUG
 /*
  * Length of the queue(array) used to hold delayed register writes.
- * Must be a multiple of 2.
+ * Must be a power of 2. An srng is queued at most once at a time, so the
+ * queue only fills up when more srngs than this are pending; such writes
+ * then fall back to a direct register write.
  */
 #define HAL_REG_WRITE_QUEUE_LEN 128
 #else
@@ -454,11 +456,40 @@ static inline bool hal_is_reg_write_tput_level_high(struct hal_soc *hal)
 	return (bw_level >= PLD_BUS_WIDTH_MEDIUM) ? true : false;
 }
 
+/**
+ * hal_reg_write_fill_coalesce_hist() - account HP/TP updates covered by
+ *					one delayed register write
+ * @srng: hal_srng pointer
+ * @updates: HP/TP updates since the previous delayed write of the srng
+ *
+ * Return: None
+ */
+static inline void hal_reg_write_fill_coalesce_hist(struct hal_srng *srng,
+						    uint32_t updates)
+{
+	uint32_t *hist = srng->wstats.coalesce_hist;
+
+	if (updates <= 1)
+		hist[REG_WRITE_COALESCE_1]++;
+	else if (updates <= 4)
+		hist[REG_WRITE_COALESCE_2_4]++;
+	else if (updates <= 16)
+		hist[REG_WRITE_COALESCE_5_16]++;
+	else
+		hist[REG_WRITE_COALESCE_GT_16]++;
+}
+
 /**
  * hal_process_reg_write_q_elem() - process a regiter write queue element
  * @hal: hal_soc pointer
  * @q_elem: pointer to hal regiter write queue element
  *
+ * The SRNG lock is not taken. The dirty flag is cleared before HP/TP is
+ * sampled, so an update racing with this write either sees the flag
+ * clear and queues the srng again, or is covered by the value written
+ * here. The busy flag lets direct writers wait for the register write
+ * to land before writing a newer value.
+ *
  * Return: The value which was written to the address
  */
 static uint32_t
@@ -467,32 +498,66 @@ hal_process_reg_write_q_elem(struct hal_soc *hal,
 {
 	struct hal_srng *srng = q_elem->srng;
 	uint32_t write_val;
+	uint32_t updates;
 
-	SRNG_LOCK(&srng->lock);
-
-	srng->reg_write_in_progress = false;
 	srng->wstats.dequeues++;
 
+	qdf_local_bh_disable();
+	qdf_atomic_test_and_set_bit(HAL_SRNG_REG_WRITE_BUSY,
+				    &srng->reg_write_flags);
+	qdf_atomic_test_and_clear_bit(HAL_SRNG_REG_WRITE_DIRTY,
+				      &srng->reg_write_flags);
+
+	updates = qdf_atomic_read(&srng->wstats.pending);
+	qdf_atomic_sub(updates, &srng->wstats.pending);
+
 	if (srng->ring_dir == HAL_SRNG_SRC_RING) {
-		q_elem->dequeue_val = srng->u.src_ring.hp;
-		hal_write_address_32_mb(hal,
-					srng->u.src_ring.hp_addr,
-					srng->u.src_ring.hp, false);
 		write_val = srng->u.src_ring.hp;
+		hal_write_address_32_mb(hal, srng->u.src_ring.hp_addr,
+					write_val, false);
 	} else {
-		q_elem->dequeue_val = srng->u.dst_ring.tp;
-		hal_write_address_32_mb(hal,
-					srng->u.dst_ring.tp_addr,
-					srng->u.dst_ring.tp, false);
 		write_val = srng->u.dst_ring.tp;
+		hal_write_address_32_mb(hal, srng->u.dst_ring.tp_addr,
+					write_val, false);
 	}
 
-	q_elem->valid = 0;
-	SRNG_UNLOCK(&srng->lock);
+	qdf_atomic_test_and_clear_bit(HAL_SRNG_REG_WRITE_BUSY,
+				      &srng->reg_write_flags);
+	qdf_local_bh_enable();
+
+	q_elem->dequeue_val = write_val;
+	hal_reg_write_fill_coalesce_hist(srng, updates);
 
 	return write_val;
 }
 
+/**
+ * hal_reg_write_direct() - write HP/TP register from the caller context
+ * @hal: hal_soc pointer
+ * @srng: srng pointer
+ * @addr: iomem address of regiter
+ * @value: value to be written to iomem address
+ *
+ * This function executes from within the SRNG LOCK. If the delayed write
+ * worker is writing this srng right now, wait for it so that the older
+ * value it sampled cannot overwrite @value.
+ *
+ * Return: None
+ */
+static inline void hal_reg_write_direct(struct hal_soc *hal,
+					struct hal_srng *srng,
+					void __iomem *addr,
+					uint32_t value)
+{
+	/* Order the HP/TP update against the busy flag check */
+	qdf_mb();
+	while (qdf_atomic_test_bit(HAL_SRNG_REG_WRITE_BUSY,
+				   &srng->reg_write_flags))
+		;
+
+	hal_write_address_32_mb(hal, addr, value, false);
+}
+
 /**
  * hal_reg_write_fill_sched_delay_hist() - fill reg write delay histogram in hal
  * @hal: hal_soc pointer
@@ -517,10 +582,53 @@ static inline void hal_reg_write_fill_sched_delay_hist(struct hal_soc *hal,
 		hist[REG_WRITE_SCHED_DELAY_GT_5000us]++;
 }
 
+/**
+ * hal_reg_write_q_elem_get() - get the next published queue element
+ * @hal: hal_soc pointer
+ *
+ * Return: queue element at the read index, NULL if the queue is empty
+ */
+static inline struct hal_reg_write_q_elem *
+hal_reg_write_q_elem_get(struct hal_soc *hal)
+{
+	struct hal_reg_write_q_elem *q_elem;
+
+	q_elem = &hal->reg_write_queue[hal->read_idx &
+				       (HAL_REG_WRITE_QUEUE_LEN - 1)];
+	if ((uint32_t)qdf_atomic_read(&q_elem->seq) != hal->read_idx + 1)
+		return NULL;
+
+	/* Read the element only after it is seen published */
+	qdf_rmb();
+
+	return q_elem;
+}
+
+/**
+ * hal_reg_write_q_elem_put() - hand a consumed queue element back to
+ *				producers
+ * @hal: hal_soc pointer
+ * @q_elem: queue element at the read index
+ *
+ * Return: None
+ */
+static inline void hal_reg_write_q_elem_put(struct hal_soc *hal,
+					    struct hal_reg_write_q_elem *q_elem)
+{
+	/* Finish reading the element before producers may reuse it */
+	qdf_mb();
+	qdf_atomic_set(&q_elem->seq, hal->read_idx + HAL_REG_WRITE_QUEUE_LEN);
+	hal->read_idx++;
+}
+
 /**
  * hal_reg_write_work() - Worker to process delayed writes
  * @arg: hal_soc pointer
  *
+ * Every srng is in the queue at most once, however many HP/TP updates it
+ * had since it was queued, so one pass issues one register write per
+ * dirty srng.
+ *
  * Return: None
  */
 static void hal_reg_write_work(void *arg)
@@ -528,16 +636,15 @@ static void hal_reg_write_work(void *arg)
 	int32_t q_depth, write_val;
 	struct hal_soc *hal = arg;
 	struct hal_reg_write_q_elem *q_elem;
+	qdf_time_t work_scheduled_time;
 	uint64_t delta_us;
 	uint8_t ring_id;
 	uint32_t *addr;
 
-	q_elem = &hal->reg_write_queue[(hal->read_idx)];
-	q_elem->work_scheduled_time = qdf_get_log_timestamp();
+	work_scheduled_time = qdf_get_log_timestamp();
 
-	/* Make sure q_elem consistent in the memory for multi-cores */
-	qdf_rmb();
-	if (!q_elem->valid)
+	q_elem = hal_reg_write_q_elem_get(hal);
+	if (!q_elem)
 		return;
 
 	q_depth = qdf_atomic_read(&hal->stats.wstats.q_depth);
@@ -549,11 +656,8 @@ static void hal_reg_write_work(void *arg)
 		return;
 	}
 
-	while (true) {
-		qdf_rmb();
-		if (!q_elem->valid)
-			break;
-
+	while (q_elem) {
+		q_elem->work_scheduled_time = work_scheduled_time;
 		q_elem->dequeue_time = qdf_get_log_timestamp();
 		ring_id = q_elem->srng->ring_id;
 		addr = q_elem->addr;
@@ -568,10 +672,10 @@ static void hal_reg_write_work(void *arg)
 		hal_verbose_debug("read_idx %u srng 0x%x, addr 0x%pK dequeue_val %u sched delay %llu us",
 				  hal->read_idx, ring_id, addr, write_val, delta_us);
 
+		hal_reg_write_q_elem_put(hal, q_elem);
 		qdf_atomic_dec(&hal->active_work_cnt);
-		hal->read_idx = (hal->read_idx + 1) &
-					(HAL_REG_WRITE_QUEUE_LEN - 1);
-		q_elem = &hal->reg_write_queue[(hal->read_idx)];
+
+		q_elem = hal_reg_write_q_elem_get(hal);
 	}
 
 	hif_allow_link_low_power_states(hal->hif_handle);
@@ -590,6 +694,46 @@ static inline void hal_flush_reg_write_work(struct hal_soc *hal)
 	qdf_flush_workqueue(0, hal->reg_write_wq);
 }
 
+/**
+ * hal_reg_write_q_elem_claim() - claim a free slot of the delayed write queue
+ * @hal_soc: hal_soc pointer
+ * @claimed_idx: filled with the write index of the claimed slot
+ *
+ * Producers on different srngs claim slots concurrently by advancing the
+ * write index with a compare and exchange; a slot is free once its
+ * sequence equals the write index that maps to it.
+ *
+ * Return: claimed queue element, NULL if the queue is full
+ */
+static struct hal_reg_write_q_elem *
+hal_reg_write_q_elem_claim(struct hal_soc *hal_soc, uint32_t *claimed_idx)
+{
+	struct hal_reg_write_q_elem *q_elem;
+	uint32_t write_idx;
+	int32_t diff;
+
+	write_idx = qdf_atomic_read(&hal_soc->write_idx);
+	while (true) {
+		q_elem = &hal_soc->reg_write_queue[write_idx &
+					(HAL_REG_WRITE_QUEUE_LEN - 1)];
+		diff = (int32_t)((uint32_t)qdf_atomic_read(&q_elem->seq) -
+				 write_idx);
+		if (diff < 0)
+			return NULL;
+
+		if (!diff &&
+		    (uint32_t)qdf_atomic_cmpxchg(&hal_soc->write_idx, write_idx,
+						 write_idx + 1) == write_idx)
+			break;
+
+		write_idx = qdf_atomic_read(&hal_soc->write_idx);
+	}
+
+	*claimed_idx = write_idx;
+
+	return q_elem;
+}
+
 /**
  * hal_reg_write_enqueue() - enqueue register writes into kworker
  * @hal_soc: hal_soc pointer
@@ -597,7 +741,9 @@ static inline void hal_flush_reg_write_work(struct hal_soc *hal)
  * @addr: iomem address of regiter
  * @value: value to be written to iomem address
  *
- * This function executes from within the SRNG LOCK
+ * This function executes from within the SRNG LOCK. An srng already
+ * queued is not queued again; the worker writes its latest HP/TP. If the
+ * queue is full the register is written directly.
  *
  * Return: None
  */
@@ -609,7 +755,10 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 	struct hal_reg_write_q_elem *q_elem;
 	uint32_t write_idx;
 
-	if (srng->reg_write_in_progress) {
+	qdf_atomic_inc(&srng->wstats.pending);
+
+	if (qdf_atomic_test_and_set_bit(HAL_SRNG_REG_WRITE_DIRTY,
+					&srng->reg_write_flags)) {
 		hal_verbose_debug("Already in progress srng ring id 0x%x addr 0x%pK val %u",
 				  srng->ring_id, addr, value);
 		qdf_atomic_inc(&hal_soc->stats.wstats.coalesces);
@@ -617,15 +766,16 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 		return;
 	}
 
-	write_idx = qdf_atomic_inc_return(&hal_soc->write_idx);
-
-	write_idx = write_idx & (HAL_REG_WRITE_QUEUE_LEN - 1);
-
-	q_elem = &hal_soc->reg_write_queue[write_idx];
-
-	if (q_elem->valid) {
-		hal_err("queue full");
-		QDF_BUG(0);
+	q_elem = hal_reg_write_q_elem_claim(hal_soc, &write_idx);
+	if (qdf_unlikely(!q_elem)) {
+		hal_err_rl("queue full, srng ring id 0x%x written directly",
+			   srng->ring_id);
+		qdf_atomic_test_and_clear_bit(HAL_SRNG_REG_WRITE_DIRTY,
+					      &srng->reg_write_flags);
+		qdf_atomic_set(&srng->wstats.pending, 0);
+		qdf_atomic_inc(&hal_soc->stats.wstats.q_full);
+		srng->wstats.q_full++;
+		hal_reg_write_direct(hal_soc, srng, addr, value);
 		return;
 	}
 
@@ -633,6 +783,7 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 	srng->wstats.enqueues++;
 
 	qdf_atomic_inc(&hal_soc->stats.wstats.q_depth);
+	qdf_atomic_inc(&hal_soc->active_work_cnt);
 
 	q_elem->srng = srng;
 	q_elem->addr = addr;
@@ -640,27 +791,13 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 	q_elem->enqueue_time = qdf_get_log_timestamp();
 
 	/*
-	 * Before the valid flag is set to true, all the other
+	 * Before the sequence publishes the entry, all the other
 	 * fields in the q_elem needs to be updated in memory.
 	 * Else there is a chance that the dequeuing worker thread
 	 * might read stale entries and process incorrect srng.
 	 */
 	qdf_wmb();
-	q_elem->valid = true;
-
-	/*
-	 * After all other fields in the q_elem has been updated
-	 * in memory successfully, the valid flag needs to be updated
-	 * in memory in time too.
-	 * Else there is a chance that the dequeuing worker thread
-	 * might read stale valid flag and the work will be bypassed
-	 * for this round. And if there is no other work scheduled
-	 * later, this hal register writing won't be updated any more.
-	 */
-	qdf_wmb();
-
-	srng->reg_write_in_progress  = true;
-	qdf_atomic_inc(&hal_soc->active_work_cnt);
+	qdf_atomic_set(&q_elem->seq, write_idx + 1);
 
 	hal_verbose_debug("write_idx %u srng ring id 0x%x addr 0x%pK val %u",
 			  write_idx, srng->ring_id, addr, value);
@@ -678,7 +815,7 @@ void hal_delayed_reg_write(struct hal_soc *hal_soc,
 	    hal_is_reg_write_tput_level_high(hal_soc)) {
 		qdf_atomic_inc(&hal_soc->stats.wstats.direct);
 		srng->wstats.direct++;
-		hal_write_address_32_mb(hal_soc, addr, value, false);
+		hal_reg_write_direct(hal_soc, srng, addr, value);
 	} else {
 		hal_reg_write_enqueue(hal_soc, srng, addr, value);
 	}
@@ -695,6 +832,8 @@ void hal_delayed_reg_write(struct hal_soc *hal_soc,
  */
 static QDF_STATUS hal_delayed_reg_write_init(struct hal_soc *hal)
 {
+	int i;
+
 	hal->reg_write_wq =
 		qdf_alloc_high_prior_ordered_workqueue("hal_register_write_wq");
 	qdf_create_work(0, &hal->reg_write_work, hal_reg_write_work, hal);
@@ -706,9 +845,12 @@ static QDF_STATUS hal_delayed_reg_write_init(struct hal_soc *hal)
 		return QDF_STATUS_E_NOMEM;
 	}
 
-	/* Initial value of indices */
+	/* Initial value of indices, every slot free for its own index */
+	for (i = 0; i < HAL_REG_WRITE_QUEUE_LEN; i++)
+		qdf_atomic_set(&hal->reg_write_queue[i].seq, i);
+
 	hal->read_idx = 0;
-	qdf_atomic_set(&hal->write_idx, -1);
+	qdf_atomic_set(&hal->write_idx, 0);
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -732,14 +874,26 @@ static inline
 char *hal_fill_reg_write_srng_stats(struct hal_srng *srng,
 				    char *buf, qdf_size_t size)
 {
-	qdf_scnprintf(buf, size, "enq %u deq %u coal %u direct %u",
+	uint32_t *hist = srng->wstats.coalesce_hist;
+	uint32_t updates = srng->wstats.enqueues + srng->wstats.coalesces;
+	uint32_t writes = srng->wstats.dequeues;
+
+	qdf_scnprintf(buf, size,
+		      "enq %u deq %u coal %u direct %u q_full %u coal-ratio %u.%02u coal-hist %u %u %u %u",
 		      srng->wstats.enqueues, srng->wstats.dequeues,
-		      srng->wstats.coalesces, srng->wstats.direct);
+		      srng->wstats.coalesces, srng->wstats.direct,
+		      srng->wstats.q_full,
+		      writes ? updates / writes : 0,
+		      writes ? ((updates % writes) * 100) / writes : 0,
+		      hist[REG_WRITE_COALESCE_1],
+		      hist[REG_WRITE_COALESCE_2_4],
+		      hist[REG_WRITE_COALESCE_5_16],
+		      hist[REG_WRITE_COALESCE_GT_16]);
 	return buf;
 }
 
 /* bytes for local buffer */
-#define HAL_REG_WRITE_SRNG_STATS_LEN 100
+#define HAL_REG_WRITE_SRNG_STATS_LEN 160
 
 void hal_dump_reg_write_srng_stats(hal_soc_handle_t hal_soc_hdl)
 {
@@ -775,11 +929,12 @@ void hal_dump_reg_write_stats(hal_soc_handle_t hal_soc_hdl)
 
 	hist = hal->stats.wstats.sched_delay;
 
-	hal_debug("enq %u deq %u coal %u direct %u q_depth %u max_q %u sched-delay hist %u %u %u %u",
+	hal_debug("enq %u deq %u coal %u direct %u q_full %u q_depth %u max_q %u sched-delay hist %u %u %u %u",
 		  qdf_atomic_read(&hal->stats.wstats.enqueues),
 		  hal->stats.wstats.dequeues,
 		  qdf_atomic_read(&hal->stats.wstats.coalesces),
 		  qdf_atomic_read(&hal->stats.wstats.direct),
+		  qdf_atomic_read(&hal->stats.wstats.q_full),
 		  qdf_atomic_read(&hal->stats.wstats.q_depth),
 		  hal->stats.wstats.max_q_depth,
 		  hist[REG_WRITE_SCHED_DELAY_SUB_100us],
@@ -1398,6 +1553,40 @@ extern void hal_get_srng_params(hal_soc_handle_t hal_soc_hdl,
 }
 qdf_export_symbol(hal_get_srng_params);
 
+void hal_srng_dst_set_intr_thres(hal_soc_handle_t hal_soc_hdl,
+				 hal_ring_handle_t hal_ring_hdl,
+				 uint32_t intr_timer_thres_us,
+				 uint32_t intr_batch_cntr_thres_entries)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t reg_val = 0;
+
+	if (qdf_unlikely(!srng->initialized ||
+			 srng->ring_dir != HAL_SRNG_DST_RING))
+		return;
+
+	srng->intr_timer_thres_us = intr_timer_thres_us;
+	srng->intr_batch_cntr_thres_entries = intr_batch_cntr_thres_entries;
+
+	/* Same layout as programmed by hal_srng_dst_hw_init */
+	if (srng->intr_timer_thres_us) {
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+			INTERRUPT_TIMER_THRESHOLD),
+			srng->intr_timer_thres_us >> 3);
+	}
+
+	if (srng->intr_batch_cntr_thres_entries) {
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+			BATCH_COUNTER_THRESHOLD),
+			srng->intr_batch_cntr_thres_entries *
+			srng->entry_size);
+	}
+
+	SRNG_DST_REG_WRITE(srng, PRODUCER_INT_SETUP, reg_val);
+}
+
+qdf_export_symbol(hal_srng_dst_set_intr_thres);
+
 void hal_set_low_threshold(hal_ring_handle_t hal_ring_hdl,
 				 uint32_t low_threshold)
 {
@@ -42,6 +42,12 @@ extern "C" {
 #include "qdf_dev.h"
 #define ENABLE_MBOX_DUMMY_SPACE_FEATURE 1
 
+/* Socket busy polling needs NAPI exec contexts and kernel support */
+#if defined(HIF_EXEC_BUSY_POLL) && \
+	(!defined(FEATURE_NAPI) || !defined(CONFIG_NET_RX_BUSY_POLL))
+#undef HIF_EXEC_BUSY_POLL
+#endif
+
 typedef void __iomem *A_target_id_t;
 typedef void *hif_handle_t;
 
@@ -155,6 +161,8 @@ struct CE_state;
  * @time_limit_reache - count of yields due to time limit threshholds
  * @rxpkt_thresh_reached - count of yields due to a work limit
  * @poll_time_buckets - histogram of poll times for the napi
+ * @busy_poll_iters - number of polls driven by socket layer busy polling
+ * @busy_poll_workdone - cumulative work done in busy polls
  *
  */
 struct qca_napi_stat {
@@ -170,6 +178,10 @@ struct qca_napi_stat {
 #ifdef WLAN_FEATURE_RX_SOFTIRQ_TIME_LIMIT
 	uint32_t poll_time_buckets[QCA_NAPI_NUM_BUCKETS];
 #endif
+#ifdef HIF_EXEC_BUSY_POLL
+	uint32_t busy_poll_iters;
+	uint32_t busy_poll_workdone;
+#endif
 };
 
 
@@ -883,6 +895,7 @@ void hif_clear_stats(struct hif_opaque_softc *hif_ctx);
  * @RTPM_ID_DW_TX_HW_ENQUEUE:   operation in functin dp_tx_hw_enqueue
  * @RTPM_ID_HAL_REO_CMD:        HAL_REO_CMD operation
  * @RTPM_ID_DP_PRINT_RING_STATS:  operation in dp_print_ring_stats
+ * @RTPM_ID_DP_INTR_MOD:        interrupt moderation threshold update
  */
 /* New value added to the enum must also be reflected in function
  *  rtpm_string_from_dbgid()
@@ -898,6 +911,7 @@ typedef enum {
 	RTPM_ID_DW_TX_HW_ENQUEUE   = 7,
 	RTPM_ID_HAL_REO_CMD        = 8,
 	RTPM_ID_DP_PRINT_RING_STATS  = 9,
+	RTPM_ID_DP_INTR_MOD        = 10,
 
 	RTPM_ID_MAX,
 } wlan_rtpm_dbgid;
@@ -922,6 +936,7 @@ static inline char *rtpm_string_from_dbgid(wlan_rtpm_dbgid id)
 					"RTPM_ID_DW_TX_HW_ENQUEUE",
 					"RTPM_ID_HAL_REO_CMD",
 					"RTPM_ID_DP_PRINT_RING_STATS",
+					"RTPM_ID_DP_INTR_MOD",
 					"RTPM_ID_MAX"};
 
 	return (char *)strings[id];
@@ -1209,6 +1224,27 @@ uint32_t  hif_register_ext_group(struct hif_opaque_softc *hif_ctx,
 void hif_deregister_exec_group(struct hif_opaque_softc *hif_ctx,
 				const char *context_name);
 
+/**
+ * hif_get_ext_group_napi() - NAPI instance of an ext group exec context
+ * @hif_ctx: HIF opaque context
+ * @cb_ctx: context the ext group was registered with
+ *
+ * Delivered frames are marked with the NAPI instance so that busy polling
+ * sockets can drive the exec context through napi_busy_loop().
+ *
+ * Return: opaque napi_struct, NULL if busy polling is not supported for
+ *	   the group
+ */
+#ifdef HIF_EXEC_BUSY_POLL
+void *hif_get_ext_group_napi(struct hif_opaque_softc *hif_ctx, void *cb_ctx);
+#else
+static inline
+void *hif_get_ext_group_napi(struct hif_opaque_softc *hif_ctx, void *cb_ctx)
+{
+	return NULL;
+}
+#endif
+
 void hif_update_pipe_callback(struct hif_opaque_softc *osc,
 				u_int8_t pipeid,
 				struct hif_msg_callbacks *callbacks);
@@ -184,6 +184,49 @@ void hif_clear_napi_stats(struct hif_opaque_softc *hif_ctx)
 
 qdf_export_symbol(hif_clear_napi_stats);
 
+#ifdef HIF_EXEC_BUSY_POLL
+/**
+ * hif_print_napi_busy_poll_stats() - print socket busy poll stats
+ * @hif_state: hif context
+ *
+ * Return: void
+ */
+static void hif_print_napi_busy_poll_stats(struct HIF_CE_state *hif_state)
+{
+	struct hif_exec_context *hif_ext_group;
+	struct qca_napi_stat *napi_stats;
+	int i, j;
+
+	QDF_TRACE(QDF_MODULE_ID_HIF, QDF_TRACE_LEVEL_ERROR,
+		  "NAPI[#]CPU[#] |busy-polls |busy-dones |dones/poll");
+
+	for (i = 0;
+	     (i < hif_state->hif_num_extgroup && hif_state->hif_ext_group[i]);
+	     i++) {
+		hif_ext_group = hif_state->hif_ext_group[i];
+		for (j = 0; j < num_possible_cpus(); j++) {
+			napi_stats = &hif_ext_group->stats[j];
+			if (!napi_stats->busy_poll_iters)
+				continue;
+
+			QDF_TRACE(QDF_MODULE_ID_HIF,
+				  QDF_TRACE_LEVEL_ERROR,
+				  "NAPI[%d]CPU[%d]: %10u %10u %10u",
+				  i, j,
+				  napi_stats->busy_poll_iters,
+				  napi_stats->busy_poll_workdone,
+				  napi_stats->busy_poll_workdone /
+				  napi_stats->busy_poll_iters);
+		}
+	}
+}
+#else
+static inline
+void hif_print_napi_busy_poll_stats(struct HIF_CE_state *hif_state)
+{
+}
+#endif
+
 #ifdef WLAN_FEATURE_RX_SOFTIRQ_TIME_LIMIT
 /**
  * hif_get_poll_times_hist_str() - Get HIF poll times histogram string
@@ -340,6 +383,7 @@ void hif_print_napi_stats(struct hif_opaque_softc *hif_ctx)
 		}
 	}
 
+	hif_print_napi_busy_poll_stats(hif_state);
 	hif_print_napi_latency_stats(hif_state);
 }
 
@@ -392,6 +436,7 @@ void hif_print_napi_stats(struct hif_opaque_softc *hif_ctx)
 		}
 	}
 
+	hif_print_napi_busy_poll_stats(hif_state);
 	hif_print_napi_latency_stats(hif_state);
 }
 qdf_export_symbol(hif_print_napi_stats);
@@ -492,6 +537,117 @@ void hif_latency_profile_start(struct hif_exec_context *hif_ext_group)
 #endif
 
 #ifdef FEATURE_NAPI
+#ifdef HIF_EXEC_BUSY_POLL
+/**
+ * hif_exec_napi_complete() - complete a napi poll of an ext group
+ * @hif_ext_group: hif exec context
+ * @napi: napi struct
+ *
+ * A socket busy polling on the group's NAPI id owns the napi instance
+ * while napi_busy_loop() runs and napi_complete() refuses to complete
+ * it; the group IRQ is then left masked so the busy poller is not
+ * competing with interrupts. The IRQ is re-enabled only once the napi
+ * really completes and only if the interrupt handler had masked it,
+ * since a busy poll may run without any interrupt having fired.
+ *
+ * Return: true if the caller should re-enable the group IRQ
+ */
+static bool hif_exec_napi_complete(struct hif_exec_context *hif_ext_group,
+				   struct napi_struct *napi)
+{
+	if (!napi_complete(napi))
+		return false;
+
+	return qdf_atomic_test_and_clear_bit(HIF_EXEC_IRQ_MASKED,
+					     &hif_ext_group->irq_state);
+}
+
+/**
+ * hif_exec_busy_poll_stats_update() - account polls run by busy polling
+ * @hif_ext_group: hif exec context
+ * @napi: napi struct
+ * @cpu: current cpu
+ * @work_done: work done by the handler in this poll
+ *
+ * Return: void
+ */
+static inline
+void hif_exec_busy_poll_stats_update(struct hif_exec_context *hif_ext_group,
+				     struct napi_struct *napi, int cpu,
+				     int work_done)
+{
+	if (!test_bit(NAPI_STATE_IN_BUSY_POLL, &napi->state))
+		return;
+
+	hif_ext_group->stats[cpu].busy_poll_iters++;
+	hif_ext_group->stats[cpu].busy_poll_workdone += work_done;
+}
+
+/**
+ * hif_exec_grp_active_put() - drop the group's active_grp_tasklet_cnt count
+ * @hif_ext_group: hif exec context
+ * @scn: hif context
+ *
+ * Called on every poll exit that does not ask to be polled again, whether
+ * or not napi_complete() let go of the napi. The count taken by the
+ * interrupt handler is dropped exactly once, and busy polls that ran
+ * without an interrupt do not touch it.
+ *
+ * Return: void
+ */
+static inline void hif_exec_grp_active_put(struct hif_exec_context *hif_ext_group,
+					   struct hif_softc *scn)
+{
+	if (qdf_atomic_test_and_clear_bit(HIF_EXEC_GRP_ACTIVE,
+					  &hif_ext_group->irq_state))
+		qdf_atomic_dec(&scn->active_grp_tasklet_cnt);
+}
+
+void *hif_get_ext_group_napi(struct hif_opaque_softc *hif_ctx, void *cb_ctx)
+{
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(hif_ctx);
+	struct hif_exec_context *hif_ext_group;
+	int i;
+
+	for (i = 0; i < hif_state->hif_num_extgroup; i++) {
+		hif_ext_group = hif_state->hif_ext_group[i];
+		if (!hif_ext_group || hif_ext_group->context != cb_ctx)
+			continue;
+
+		if (hif_ext_group->type != HIF_EXEC_NAPI_TYPE)
+			return NULL;
+
+		return &hif_exec_get_napi(hif_ext_group)->napi;
+	}
+
+	return NULL;
+}
+
+qdf_export_symbol(hif_get_ext_group_napi);
+#else
+static inline bool
+hif_exec_napi_complete(struct hif_exec_context *hif_ext_group,
+		       struct napi_struct *napi)
+{
+	napi_complete(napi);
+
+	return true;
+}
+
+static inline
+void hif_exec_busy_poll_stats_update(struct hif_exec_context *hif_ext_group,
+				     struct napi_struct *napi, int cpu,
+				     int work_done)
+{
+}
+
+static inline void hif_exec_grp_active_put(struct hif_exec_context *hif_ext_group,
+					   struct hif_softc *scn)
+{
+	qdf_atomic_dec(&scn->active_grp_tasklet_cnt);
+}
+#endif /* HIF_EXEC_BUSY_POLL */
+
 /**
  * hif_exec_poll() - napi poll
  * napi: napi struct
@@ -527,11 +683,14 @@ static int hif_exec_poll(struct napi_struct *napi, int budget)
 
 	actual_dones = work_done;
 
+	hif_exec_busy_poll_stats_update(hif_ext_group, napi, cpu, work_done);
+
 	if (!hif_ext_group->force_break && work_done < normalized_budget) {
-		napi_complete(napi);
-		qdf_atomic_dec(&scn->active_grp_tasklet_cnt);
-		hif_ext_group->irq_enable(hif_ext_group);
-		hif_ext_group->stats[cpu].napi_completes++;
+		if (hif_exec_napi_complete(hif_ext_group, napi)) {
+			hif_ext_group->irq_enable(hif_ext_group);
+			hif_ext_group->stats[cpu].napi_completes++;
+		}
+		hif_exec_grp_active_put(hif_ext_group, scn);
 	} else {
 		/* if the ext_group supports time based yield, claim full work
 		 * done anyways */
@@ -766,6 +925,44 @@ static inline void hif_check_and_trigger_ut_resume(struct hif_softc *scn)
 }
 #endif
 
+#ifdef HIF_EXEC_BUSY_POLL
+/**
+ * hif_exec_irq_masked_set() - note that the group IRQ awaits re-enable
+ *			       and that the group holds an active count
+ * @hif_ext_group: hif exec context
+ *
+ * Return: void
+ */
+static inline
+void hif_exec_irq_masked_set(struct hif_exec_context *hif_ext_group)
+{
+	qdf_atomic_set_bit(HIF_EXEC_GRP_ACTIVE, &hif_ext_group->irq_state);
+	qdf_atomic_set_bit(HIF_EXEC_IRQ_MASKED, &hif_ext_group->irq_state);
+}
+
+/**
+ * hif_exec_grp_active_clear() - forget the group's active count on kill
+ * @hif_ext_group: hif exec context
+ *
+ * Return: void
+ */
+static inline
+void hif_exec_grp_active_clear(struct hif_exec_context *hif_ext_group)
+{
+	qdf_atomic_clear_bit(HIF_EXEC_GRP_ACTIVE, &hif_ext_group->irq_state);
+}
+#else
+static inline
+void hif_exec_irq_masked_set(struct hif_exec_context *hif_ext_group)
+{
+}
+
+static inline
+void hif_exec_grp_active_clear(struct hif_exec_context *hif_ext_group)
+{
+}
+#endif
+
 /**
  * hif_ext_group_interrupt_handler() - handler for related interrupts
  * @irq: irq number of the interrupt
@@ -801,6 +998,7 @@ irqreturn_t hif_ext_group_interrupt_handler(int irq, void *context)
 		 */
 		hif_check_and_trigger_ut_resume(scn);
 		qdf_atomic_inc(&scn->active_grp_tasklet_cnt);
+		hif_exec_irq_masked_set(hif_ext_group);
 
 		hif_ext_group->sched_ops->schedule(hif_ext_group);
 	}
@@ -819,9 +1017,11 @@ void hif_exec_kill(struct hif_opaque_softc *hif_ctx)
 	int i;
 	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(hif_ctx);
 
-	for (i = 0; i < hif_state->hif_num_extgroup; i++)
+	for (i = 0; i < hif_state->hif_num_extgroup; i++) {
 		hif_state->hif_ext_group[i]->sched_ops->kill(
 			hif_state->hif_ext_group[i]);
+		hif_exec_grp_active_clear(hif_state->hif_ext_group[i]);
+	}
 
 	qdf_atomic_set(&hif_state->ol_sc.active_grp_tasklet_cnt, 0);
 }
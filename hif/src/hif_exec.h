@@ -40,6 +40,11 @@
 /*Buckets for latency between 250 to 500 ms*/
 #define HIF_SCHED_LATENCY_BUCKET_251_500 500
 
+/* irq_state bit: group IRQ disabled by the handler, pending re-enable */
+#define HIF_EXEC_IRQ_MASKED 0
+/* irq_state bit: group holds a count in active_grp_tasklet_cnt */
+#define HIF_EXEC_GRP_ACTIVE 1
+
 struct hif_exec_context;
 
 struct hif_execution_ops {
@@ -112,6 +117,10 @@ struct hif_exec_context {
 	/* Stores the affinity hint mask for each WLAN IRQ */
 	qdf_cpu_mask new_cpu_mask[HIF_MAX_GRP_IRQ];
 #endif
+#ifdef HIF_EXEC_BUSY_POLL
+	/* HIF_EXEC_IRQ_MASKED and HIF_EXEC_GRP_ACTIVE bits */
+	unsigned long irq_state;
+#endif
 };
 
 /**
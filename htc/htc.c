@@ -58,14 +58,26 @@ extern unsigned int htc_credit_flow;
 
 static void reset_endpoint_states(HTC_TARGET *target);
 
-static void destroy_htc_tx_ctrl_packet(HTC_PACKET *pPacket)
+static void destroy_htc_tx_ctrl_packet(HTC_TARGET *target,
+				       HTC_PACKET *pPacket)
 {
+	HTC_ENDPOINT *pEndpoint;
 	qdf_nbuf_t netbuf;
 
 	netbuf = (qdf_nbuf_t) GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket);
 	if (netbuf)
 		qdf_nbuf_free(netbuf);
-	qdf_mem_free(pPacket);
+
+	if (!(pPacket->PktInfo.AsTx.Flags & HTC_TX_PACKET_FLAG_POOLED)) {
+		qdf_mem_free(pPacket);
+		return;
+	}
+
+	/* pooled packets go back to the pool of the service that sent them */
+	pEndpoint = &target->endpoint[pPacket->Endpoint];
+	if (pEndpoint->EpCallBacks.ep_pkt_release)
+		pEndpoint->EpCallBacks.ep_pkt_release(
+				pEndpoint->EpCallBacks.pContext, pPacket);
 }
 
 static HTC_PACKET *build_htc_tx_ctrl_packet(qdf_device_t osdev)
@@ -99,7 +111,7 @@ void htc_free_control_tx_packet(HTC_TARGET *target, HTC_PACKET *pPacket)
 	UNLOCK_HTC(target);
 	/* TODO_FIXME netbufs cannot be RESET! */
 #else
-	destroy_htc_tx_ctrl_packet(pPacket);
+	destroy_htc_tx_ctrl_packet(target, pPacket);
 #endif
 
 }
@@ -130,6 +130,12 @@ typedef HTC_PACKET *(*HTC_EP_RECV_ALLOC)(void *,
  */
 typedef void (*HTC_EP_LOG_PKT)(void *, HTC_PACKET *);
 
+/* Optional per service connection callback to return a packet flagged with
+ * HTC_TX_PACKET_FLAG_POOLED to its owner when HTC drops it without calling
+ * the send completion, e.g. on target failure.
+ */
+typedef void (*HTC_EP_PKT_RELEASE)(void *, HTC_PACKET *);
+
 enum htc_send_full_action {
 	/* packet that overflowed should be kept in the queue */
 	HTC_SEND_FULL_KEEP = 0,
@@ -193,6 +199,8 @@ struct htc_ep_callbacks {
 	int RecvRefillWaterMark;
 	/* OPTIONAL callback to log packet information */
 	HTC_EP_LOG_PKT ep_log_pkt;
+	/* OPTIONAL callback to release pooled tx packets */
+	HTC_EP_PKT_RELEASE ep_pkt_release;
 };
 
 /* service connection information */
@@ -502,6 +510,24 @@ void htc_ce_tasklet_debug_dump(HTC_HANDLE htc_handle);
  */
 QDF_STATUS htc_send_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket);
 
+#if defined(HIF_SDIO) || defined(HIF_USB)
+/**
+ * htc_send_pkts_multiple - Send a queue of HTC packets in one go
+ * @HTCHandle - HTC handle
+ * @pPktQueue - packets to send, all for the same endpoint
+ *
+ * Caller must initialize each packet using SET_HTC_PACKET_INFO_TX() macro.
+ * The packets are handed to the endpoint as one queue so that
+ * htc_issue_packets() can bundle them into a single transfer. Only the
+ * SDIO and USB buses bundle tx, so this is not provided for CE based
+ * buses, where each packet is its own copy engine descriptor anyway.
+ * Packets that could not be accepted are left in @pPktQueue for the caller.
+ * Return: QDF_STATUS_SUCCESS if all packets were accepted
+ */
+QDF_STATUS htc_send_pkts_multiple(HTC_HANDLE HTCHandle,
+				  HTC_PACKET_QUEUE *pPktQueue);
+#endif /* HIF_SDIO || HIF_USB */
+
 /**
  * htc_send_data_pkt - Send an HTC packet containing a tx descriptor and data
  * @HTCHandle - HTC handle
@@ -79,6 +79,10 @@ struct htc_tx_packet_info {
 
 #define HTC_TX_PACKET_FLAG_FIXUP_NETBUF (1 << 0)
 #define HTC_TX_PACKET_FLAG_HTC_HEADER_IN_NETBUF_DATA (1 << 1)
+/* packet memory is owned by a sender side pool, HTC must not free it but
+ * hand it back through the endpoint's ep_pkt_release callback
+ */
+#define HTC_TX_PACKET_FLAG_POOLED (1 << 2)
 
 /**
  * struct htc_rx_packet_info - HTC RX Packet information
@@ -1710,26 +1710,28 @@ static A_STATUS htc_send_pkts_sched_queue(HTC_TARGET *target,
 
 #endif
 
-static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
-				HTC_PACKET *pPacket)
+/**
+ * htc_send_pkt_prepare() - validate a tx packet and set up its HTC header
+ * @target: HTC target
+ * @pPacket: packet to send
+ *
+ * Return: endpoint the packet goes to, NULL on failure
+ */
+static HTC_ENDPOINT *htc_send_pkt_prepare(HTC_TARGET *target,
+					  HTC_PACKET *pPacket)
 {
-	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
 	HTC_ENDPOINT *pEndpoint;
-	HTC_PACKET_QUEUE pPktQueue;
 	qdf_nbuf_t netbuf;
 	HTC_FRAME_HDR *htc_hdr;
 	QDF_STATUS status;
 
-	/*AR_DEBUG_PRINTF(ATH_DEBUG_SEND,
-			("+__htc_send_pkt\n"));*/
-
 	/* get packet at head to figure out which endpoint these packets will
 	 * go into
 	 */
 	if (!pPacket) {
 		OL_ATH_HTC_PKT_ERROR_COUNT_INCR(target, GET_HTC_PKT_Q_FAIL);
 		//AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("-__htc_send_pkt\n"));
-		return QDF_STATUS_E_INVAL;
+		return NULL;
 	}
 
 	if ((pPacket->Endpoint >= ENDPOINT_MAX) ||
@@ -1737,14 +1739,14 @@ static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
 		/*AR_DEBUG_PRINTF(ATH_DEBUG_SEND,
 			("%s endpoint is invalid\n", __func__));*/
 		AR_DEBUG_ASSERT(0);
-		return QDF_STATUS_E_INVAL;
+		return NULL;
 	}
 	pEndpoint = &target->endpoint[pPacket->Endpoint];
 
 	if (!pEndpoint->service_id) {
 		/*AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("%s service_id is invalid\n",
 								__func__));*/
-		return QDF_STATUS_E_INVAL;
+		return NULL;
 	}
 
 #ifdef HTC_EP_STAT_PROFILING
@@ -1757,7 +1759,7 @@ static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
 	netbuf = GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket);
 	AR_DEBUG_ASSERT(netbuf);
 	if (!netbuf)
-		return QDF_STATUS_E_INVAL;
+		return NULL;
 
 	qdf_nbuf_push_head(netbuf, sizeof(HTC_FRAME_HDR));
 	pPacket->PktInfo.AsTx.Flags |=
@@ -1766,7 +1768,7 @@ static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
 	htc_hdr = (HTC_FRAME_HDR *)qdf_nbuf_get_frag_vaddr(netbuf, 0);
 	AR_DEBUG_ASSERT(htc_hdr);
 	if (!htc_hdr)
-		return QDF_STATUS_E_INVAL;
+		return NULL;
 
 	HTC_WRITE32(htc_hdr,
 		    SM(pPacket->ActualLength,
@@ -1798,23 +1800,42 @@ static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
 			AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
 					("%s: nbuf map failed, endpoint %pK, seq_no. %d\n",
 					 __func__, pEndpoint, pEndpoint->SeqNo));
-			return status;
+			pPacket->PktInfo.AsTx.Flags &=
+					~HTC_TX_PACKET_FLAG_FIXUP_NETBUF;
+			return NULL;
 		}
 	}
 
-	INIT_HTC_PACKET_QUEUE_AND_ADD(&pPktQueue, pPacket);
+	return pEndpoint;
+}
+
+/**
+ * htc_send_pkt_queue() - hand a queue of prepared packets to an endpoint
+ * @target: HTC target
+ * @pEndpoint: endpoint all packets of @pPktQueue go to
+ * @pPktQueue: prepared packets
+ *
+ * Packets that could not get in are completed with an error status.
+ *
+ * Return: none
+ */
+static void htc_send_pkt_queue(HTC_TARGET *target, HTC_ENDPOINT *pEndpoint,
+			       HTC_PACKET_QUEUE *pPktQueue)
+{
+	HTC_PACKET *pPacket;
+
 #ifdef USB_HIF_SINGLE_PIPE_DATA_SCHED
-	if (!htc_send_pkts_sched_check(HTCHandle, pEndpoint->Id))
-		htc_send_pkts_sched_queue(HTCHandle, &pPktQueue, pEndpoint->Id);
+	if (!htc_send_pkts_sched_check((HTC_HANDLE)target, pEndpoint->Id))
+		htc_send_pkts_sched_queue(target, pPktQueue, pEndpoint->Id);
 	else
-		htc_try_send(target, pEndpoint, &pPktQueue);
+		htc_try_send(target, pEndpoint, pPktQueue);
 #else
-	htc_try_send(target, pEndpoint, &pPktQueue);
+	htc_try_send(target, pEndpoint, pPktQueue);
 #endif
 
 	/* do completion on any packets that couldn't get in */
-	while (!HTC_QUEUE_EMPTY(&pPktQueue)) {
-		pPacket = htc_packet_dequeue(&pPktQueue);
+	while (!HTC_QUEUE_EMPTY(pPktQueue)) {
+		pPacket = htc_packet_dequeue(pPktQueue);
 
 		if (HTC_STOPPING(target))
 			pPacket->Status = QDF_STATUS_E_CANCELED;
@@ -1823,6 +1844,24 @@ static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
 
 		send_packet_completion(target, pPacket);
 	}
+}
+
+static inline QDF_STATUS __htc_send_pkt(HTC_HANDLE HTCHandle,
+				HTC_PACKET *pPacket)
+{
+	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
+	HTC_ENDPOINT *pEndpoint;
+	HTC_PACKET_QUEUE pPktQueue;
+
+	/*AR_DEBUG_PRINTF(ATH_DEBUG_SEND,
+			("+__htc_send_pkt\n"));*/
+
+	pEndpoint = htc_send_pkt_prepare(target, pPacket);
+	if (!pEndpoint)
+		return QDF_STATUS_E_INVAL;
+
+	INIT_HTC_PACKET_QUEUE_AND_ADD(&pPktQueue, pPacket);
+	htc_send_pkt_queue(target, pEndpoint, &pPktQueue);
 
 	//AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("-__htc_send_pkt\n"));
 
@@ -1852,6 +1891,56 @@ QDF_STATUS htc_send_pkt(HTC_HANDLE htc_handle, HTC_PACKET *htc_packet)
 }
 qdf_export_symbol(htc_send_pkt);
 
+#if defined(HIF_SDIO) || defined(HIF_USB)
+QDF_STATUS htc_send_pkts_multiple(HTC_HANDLE htc_handle,
+				  HTC_PACKET_QUEUE *pkt_queue)
+{
+	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(htc_handle);
+	HTC_ENDPOINT *pEndpoint = NULL;
+	HTC_ENDPOINT *ep;
+	HTC_PACKET_QUEUE send_queue;
+	HTC_PACKET_QUEUE fail_queue;
+	HTC_PACKET *pPacket;
+
+	if (!htc_handle || !pkt_queue) {
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("%s: invalid HTC handle or queue\n",
+				 __func__));
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	INIT_HTC_PACKET_QUEUE(&send_queue);
+	INIT_HTC_PACKET_QUEUE(&fail_queue);
+	while ((pPacket = htc_packet_dequeue(pkt_queue))) {
+		if (pEndpoint && pPacket->Endpoint != pEndpoint->Id) {
+			HTC_PACKET_ENQUEUE(&fail_queue, pPacket);
+			continue;
+		}
+
+		ep = htc_send_pkt_prepare(target, pPacket);
+		if (!ep) {
+			HTC_PACKET_ENQUEUE(&fail_queue, pPacket);
+			continue;
+		}
+
+		pEndpoint = ep;
+		HTC_PACKET_ENQUEUE(&send_queue, pPacket);
+	}
+
+	if (pEndpoint)
+		htc_send_pkt_queue(target, pEndpoint, &send_queue);
+
+	/* packets that were not accepted are given back to the caller */
+	if (!HTC_QUEUE_EMPTY(&fail_queue)) {
+		HTC_PACKET_QUEUE_TRANSFER_TO_TAIL(pkt_queue, &fail_queue);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+qdf_export_symbol(htc_send_pkts_multiple);
+#endif /* HIF_SDIO || HIF_USB */
+
 #ifdef ATH_11AC_TXCOMPACT
 /**
  * htc_send_data_pkt() - send single data packet on an endpoint
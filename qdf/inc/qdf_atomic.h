@@ -36,6 +36,13 @@
 
 typedef __qdf_atomic_t qdf_atomic_t;
 
+/**
+ * qdf_atomic64_t - 64 bit atomic type of variable
+ *
+ * Use this for counters that may overflow 32 bits, e.g. accumulated times.
+ */
+typedef __qdf_atomic64_t qdf_atomic64_t;
+
 /**
  * qdf_atomic_init() - initialize an atomic type variable
  * @v: A pointer to an opaque atomic variable
@@ -165,6 +172,56 @@ static inline int32_t qdf_atomic_inc_not_zero(qdf_atomic_t *v)
 	return __qdf_atomic_inc_not_zero(v);
 }
 
+/**
+ * qdf_atomic_cmpxchg() - compare and exchange the value of an atomic variable
+ * @v: A pointer to an opaque atomic variable
+ * @old: expected current value
+ * @new: value to store if the current value is @old
+ *
+ * Return: The value of the variable before the operation; the exchange
+ *	   happened if it equals @old
+ */
+static inline int32_t qdf_atomic_cmpxchg(qdf_atomic_t *v, int32_t old,
+					 int32_t new)
+{
+	return __qdf_atomic_cmpxchg(v, old, new);
+}
+
+/**
+ * qdf_atomic64_read() - read the value of a 64 bit atomic variable
+ * @v: A pointer to an opaque 64 bit atomic variable
+ *
+ * Return: The current value of the variable
+ */
+static inline int64_t qdf_atomic64_read(qdf_atomic64_t *v)
+{
+	return __qdf_atomic64_read(v);
+}
+
+/**
+ * qdf_atomic64_set() - set the value of a 64 bit atomic variable
+ * @v: A pointer to an opaque 64 bit atomic variable
+ * @i: required value to set
+ *
+ * Return: None
+ */
+static inline void qdf_atomic64_set(qdf_atomic64_t *v, int64_t i)
+{
+	__qdf_atomic64_set(v, i);
+}
+
+/**
+ * qdf_atomic64_add() - add a value to a 64 bit atomic variable
+ * @i: value to add
+ * @v: A pointer to an opaque 64 bit atomic variable
+ *
+ * Return: None
+ */
+static inline void qdf_atomic64_add(int64_t i, qdf_atomic64_t *v)
+{
+	__qdf_atomic64_add(i, v);
+}
+
 /**
  * qdf_atomic_set_bit - Atomically set a bit in memory
  * @nr: bit to set
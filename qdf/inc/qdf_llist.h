@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_llist.h
+ * QCA driver framework (QDF) lock-less list APIs
+ *
+ * Any number of producers may add nodes concurrently with qdf_llist_add().
+ * A single consumer detaches the whole list at once with qdf_llist_del_all();
+ * the detached chain is in LIFO order and may be put in FIFO order with
+ * qdf_llist_reverse_order().
+ */
+
+#ifndef __QDF_LLIST_H
+#define __QDF_LLIST_H
+
+#include <i_qdf_llist.h>
+
+/**
+ * typedef qdf_llist_head_t - lock-less list head
+ */
+typedef __qdf_llist_head_t qdf_llist_head_t;
+
+/**
+ * typedef qdf_llist_node_t - lock-less list node embedded in list entries
+ */
+typedef __qdf_llist_node_t qdf_llist_node_t;
+
+/**
+ * qdf_init_llist_head() - initialize an empty lock-less list
+ * @head: list head
+ */
+#define qdf_init_llist_head(head)	__qdf_init_llist_head(head)
+
+/**
+ * qdf_llist_add() - add a node to the head of a lock-less list
+ * @node: node to be added
+ * @head: list head
+ *
+ * Return: true if the list was empty before the node was added
+ */
+#define qdf_llist_add(node, head)	__qdf_llist_add(node, head)
+
+/**
+ * qdf_llist_add_batch() - add a chain of nodes to the head of a lock-less list
+ * @first: first node of the chain
+ * @last: last node of the chain
+ * @head: list head
+ *
+ * Return: true if the list was empty before the chain was added
+ */
+#define qdf_llist_add_batch(first, last, head) \
+	__qdf_llist_add_batch(first, last, head)
+
+/**
+ * qdf_llist_del_all() - detach all the nodes of a lock-less list
+ * @head: list head
+ *
+ * Return: the first node of the detached chain, most recently added first
+ */
+#define qdf_llist_del_all(head)		__qdf_llist_del_all(head)
+
+/**
+ * qdf_llist_del_first() - remove the first node of a lock-less list
+ * @head: list head
+ *
+ * Only one caller may remove nodes from @head at a time, adding nodes
+ * concurrently is fine.
+ *
+ * Return: the removed node or NULL if the list is empty
+ */
+#define qdf_llist_del_first(head)	__qdf_llist_del_first(head)
+
+/**
+ * qdf_llist_empty() - check if a lock-less list is empty
+ * @head: list head
+ *
+ * Return: true if the list is empty
+ */
+#define qdf_llist_empty(head)		__qdf_llist_empty(head)
+
+/**
+ * qdf_llist_next() - get the node following @node in a detached chain
+ * @node: current node
+ *
+ * Return: next node or NULL at the end of the chain
+ */
+#define qdf_llist_next(node)		__qdf_llist_next(node)
+
+/**
+ * qdf_llist_reverse_order() - reverse a chain detached from a list
+ * @first: first node of the chain
+ *
+ * Return: the first node of the reversed chain
+ */
+#define qdf_llist_reverse_order(first)	__qdf_llist_reverse_order(first)
+
+#endif /* __QDF_LLIST_H */
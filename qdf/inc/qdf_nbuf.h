@@ -787,6 +787,20 @@ void qdf_nbuf_unmap_nbytes_single_debug(qdf_device_t osdev,
 	qdf_nbuf_unmap_nbytes_single_debug(osdev, buf, dir, nbytes, \
 					   __func__, __LINE__)
 
+void qdf_nbuf_unmap_nbytes_single_partial_debug(qdf_device_t osdev,
+						qdf_nbuf_t buf,
+						qdf_dma_dir_t dir,
+						int nbytes,
+						int sync_bytes,
+						const char *func,
+						uint32_t line);
+
+#define qdf_nbuf_unmap_nbytes_single_partial(osdev, buf, dir, nbytes, \
+					     sync_bytes) \
+	qdf_nbuf_unmap_nbytes_single_partial_debug(osdev, buf, dir, nbytes, \
+						   sync_bytes, \
+						   __func__, __LINE__)
+
 #else /* NBUF_MAP_UNMAP_DEBUG */
 
 static inline void qdf_nbuf_map_check_for_leaks(void) {}
@@ -842,6 +856,26 @@ qdf_nbuf_unmap_nbytes_single(
 {
 	return __qdf_nbuf_unmap_nbytes_single(osdev, buf, dir, nbytes);
 }
+
+/**
+ * qdf_nbuf_unmap_nbytes_single_partial() - unmap nbytes, sync only a prefix
+ * @osdev: os device
+ * @buf: buffer
+ * @dir: direction
+ * @nbytes: number of bytes that were mapped
+ * @sync_bytes: number of bytes from the start of the mapping to make
+ *		coherent for the CPU; bytes past it must not be read
+ *
+ * Return: none
+ */
+static inline void
+qdf_nbuf_unmap_nbytes_single_partial(
+	qdf_device_t osdev, qdf_nbuf_t buf, qdf_dma_dir_t dir, int nbytes,
+	int sync_bytes)
+{
+	__qdf_nbuf_unmap_nbytes_single_partial(osdev, buf, dir, nbytes,
+					       sync_bytes);
+}
 #endif /* NBUF_MAP_UNMAP_DEBUG */
 
 /**
@@ -1729,6 +1763,27 @@ static inline void qdf_nbuf_list_free(qdf_nbuf_t buf_list)
 	}
 }
 
+/**
+ * qdf_nbuf_free_bulk() - free a list of nbufs in one go
+ * @buf_list: A list of nbufs, linked through qdf_nbuf_set_next()
+ *
+ * Memory debug builds free the buffers one by one so each free is still
+ * tracked.
+ *
+ * Return: none
+ */
+#ifdef NBUF_MEMORY_DEBUG
+static inline void qdf_nbuf_free_bulk(qdf_nbuf_t buf_list)
+{
+	qdf_nbuf_list_free(buf_list);
+}
+#else
+static inline void qdf_nbuf_free_bulk(qdf_nbuf_t buf_list)
+{
+	__qdf_nbuf_free_bulk(buf_list);
+}
+#endif
+
 static inline void qdf_nbuf_tx_free(qdf_nbuf_t buf_list, int tx_err)
 {
 	qdf_nbuf_list_free(buf_list);
@@ -1972,6 +2027,37 @@ static inline void qdf_nbuf_reset(qdf_nbuf_t buf, int reserve, int align)
 	__qdf_nbuf_reset(buf, reserve, align);
 }
 
+/**
+ * qdf_nbuf_is_recyclable() - check if a buffer can be reset and reused
+ * @buf: Network buf instance
+ * @size: size the buffer must be able to hold, as passed to qdf_nbuf_alloc
+ * @align: alignment, as passed to qdf_nbuf_alloc
+ *
+ * Return: true if the buffer is linear, not shared or cloned, carries no
+ *	   destructor or dst and its data area is large enough
+ */
+static inline bool qdf_nbuf_is_recyclable(qdf_nbuf_t buf, int size, int align)
+{
+	return __qdf_nbuf_is_recyclable(buf, size, align);
+}
+
+/**
+ * qdf_nbuf_recycle_reset() - reset a recyclable buffer to its alloc state
+ * @buf: Network buf instance
+ * @reserve: reserve
+ * @align: align
+ *
+ * Unlike qdf_nbuf_reset() the data area is not zeroed. Only for buffers
+ * owned by the driver that never reached the network stack.
+ *
+ * Return: none
+ */
+static inline void qdf_nbuf_recycle_reset(qdf_nbuf_t buf, int reserve,
+					  int align)
+{
+	__qdf_nbuf_recycle_reset(buf, reserve, align);
+}
+
 /**
  * qdf_nbuf_dev_scratch_is_supported() - dev_scratch support for network buffer
  *                                       in kernel
@@ -2243,6 +2329,44 @@ static inline qdf_nbuf_t qdf_nbuf_get_ext_list(qdf_nbuf_t head_buf)
 	return (qdf_nbuf_t)__qdf_nbuf_get_ext_list(head_buf);
 }
 
+/**
+ * qdf_nbuf_get_max_frags() - max number of page fragments of a network buf
+ *
+ * Return: max number of fragments qdf_nbuf_attach_as_rx_frag() can add
+ */
+static inline uint32_t qdf_nbuf_get_max_frags(void)
+{
+	return __qdf_nbuf_get_max_frags();
+}
+
+/**
+ * qdf_nbuf_is_frag_attachable() - check if nbuf data can be shared as frag
+ * @buf: Network buf
+ *
+ * Return: true if the data of @buf can be attached as a page fragment
+ */
+static inline bool qdf_nbuf_is_frag_attachable(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_is_frag_attachable(buf);
+}
+
+/**
+ * qdf_nbuf_attach_as_rx_frag() - attach the data of a network buf to another
+ *				  network buf as a page fragment
+ * @head_buf: Network buf the fragment is added to
+ * @buf: Network buf whose data is referenced without a copy
+ *
+ * The page backing @buf is referenced by @head_buf, @buf can be freed by
+ * the caller once this returns success.
+ *
+ * Return: QDF_STATUS_SUCCESS if the fragment was added
+ */
+static inline QDF_STATUS
+qdf_nbuf_attach_as_rx_frag(qdf_nbuf_t head_buf, qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_attach_as_rx_frag(head_buf, buf);
+}
+
 /**
  * qdf_nbuf_get_tx_cksum() - gets the tx checksum offload demand
  * @buf: Network buffer
@@ -3573,6 +3697,19 @@ qdf_nbuf_get_timestamp(struct sk_buff *skb)
 	return __qdf_nbuf_get_timestamp(skb);
 }
 
+/**
+ * qdf_nbuf_mark_napi_id() - record the NAPI instance the frame arrived on
+ * @buf: sk buff
+ * @napi: opaque napi_struct of the polling context delivering the frame
+ *
+ * Return: void
+ */
+static inline void
+qdf_nbuf_mark_napi_id(struct sk_buff *skb, void *napi)
+{
+	__qdf_nbuf_mark_napi_id(skb, napi);
+}
+
 /**
  * qdf_nbuf_get_timedelta_ms() - get time difference in ms
  *
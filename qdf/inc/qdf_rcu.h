@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_rcu.h
+ * QCA driver framework (QDF) read-copy-update APIs
+ *
+ * Readers enclose lookups in qdf_rcu_read_lock()/qdf_rcu_read_unlock() and
+ * load shared pointers with qdf_rcu_dereference(). Writers serialize among
+ * themselves, publish with qdf_rcu_assign_pointer() and free unlinked
+ * objects only after a grace period, using qdf_call_rcu().
+ */
+
+#ifndef __QDF_RCU_H
+#define __QDF_RCU_H
+
+#include <i_qdf_rcu.h>
+
+/**
+ * typedef qdf_rcu_head_t - RCU callback head embedded in protected objects
+ */
+typedef __qdf_rcu_head_t qdf_rcu_head_t;
+
+/**
+ * typedef qdf_rcu_callback_t - callback invoked after a grace period
+ */
+typedef __qdf_rcu_callback_t qdf_rcu_callback_t;
+
+/**
+ * qdf_rcu_read_lock() - enter an RCU read side critical section
+ */
+#define qdf_rcu_read_lock()		__qdf_rcu_read_lock()
+
+/**
+ * qdf_rcu_read_unlock() - exit an RCU read side critical section
+ */
+#define qdf_rcu_read_unlock()		__qdf_rcu_read_unlock()
+
+/**
+ * qdf_rcu_dereference() - load an RCU protected pointer
+ * @p: pointer to load
+ */
+#define qdf_rcu_dereference(p)		__qdf_rcu_dereference(p)
+
+/**
+ * qdf_rcu_assign_pointer() - publish an RCU protected pointer
+ * @p: pointer to be assigned
+ * @v: fully initialized object to publish
+ */
+#define qdf_rcu_assign_pointer(p, v)	__qdf_rcu_assign_pointer(p, v)
+
+/**
+ * qdf_call_rcu() - invoke a callback once all current readers are done
+ * @head: RCU head embedded in the object
+ * @func: callback, typically freeing the object
+ */
+#define qdf_call_rcu(head, func)	__qdf_call_rcu(head, func)
+
+/**
+ * qdf_synchronize_rcu() - wait for all current readers to finish
+ */
+#define qdf_synchronize_rcu()		__qdf_synchronize_rcu()
+
+/**
+ * qdf_rcu_barrier() - wait for all pending qdf_call_rcu() callbacks
+ */
+#define qdf_rcu_barrier()		__qdf_rcu_barrier()
+
+#endif /* __QDF_RCU_H */
@@ -601,6 +601,24 @@ static inline uint8_t *qdf_get_u32(uint8_t *ptr, uint32_t *value)
  */
 #define qdf_prefetch(x)                   __qdf_prefetch(x)
 
+/**
+ * qdf_local_bh_disable() - disable bottom halves on the local CPU
+ *
+ * Also keeps the caller on the current CPU, so per-CPU data indexed with
+ * qdf_get_cpu() can be accessed without a lock until qdf_local_bh_enable().
+ */
+#define qdf_local_bh_disable()            __qdf_local_bh_disable()
+
+/**
+ * qdf_local_bh_enable() - re-enable bottom halves on the local CPU
+ */
+#define qdf_local_bh_enable()             __qdf_local_bh_enable()
+
+/**
+ * qdf_cacheline_aligned - align a structure to the CPU cache line size
+ */
+#define qdf_cacheline_aligned             __qdf_cacheline_aligned
+
 /**
  * qdf_get_pwr2() - get next power of 2 integer from input value
  * @value: input value to find next power of 2 integer
@@ -29,6 +29,7 @@
 #include <linux/bitops.h>
 
 typedef atomic_t __qdf_atomic_t;
+typedef atomic64_t __qdf_atomic64_t;
 
 /**
  * __qdf_atomic_init() - initialize an atomic type variable
@@ -158,6 +159,55 @@ static inline int32_t __qdf_atomic_inc_not_zero(__qdf_atomic_t *v)
 	return atomic_inc_not_zero(v);
 }
 
+/**
+ * __qdf_atomic_cmpxchg() - compare and exchange the value of an atomic variable
+ * @v: A pointer to an opaque atomic variable
+ * @old: expected current value
+ * @new: value to store if the current value is @old
+ *
+ * Return: The value of the variable before the operation
+ */
+static inline int32_t __qdf_atomic_cmpxchg(__qdf_atomic_t *v, int32_t old,
+					   int32_t new)
+{
+	return atomic_cmpxchg(v, old, new);
+}
+
+/**
+ * __qdf_atomic64_read() - read the value of a 64 bit atomic variable
+ * @v: A pointer to an opaque 64 bit atomic variable
+ *
+ * Return: The current value of the variable
+ */
+static inline int64_t __qdf_atomic64_read(__qdf_atomic64_t *v)
+{
+	return atomic64_read(v);
+}
+
+/**
+ * __qdf_atomic64_set() - set the value of a 64 bit atomic variable
+ * @v: A pointer to an opaque 64 bit atomic variable
+ * @i: required value to set
+ *
+ * Return: None
+ */
+static inline void __qdf_atomic64_set(__qdf_atomic64_t *v, int64_t i)
+{
+	atomic64_set(v, i);
+}
+
+/**
+ * __qdf_atomic64_add() - add a value to a 64 bit atomic variable
+ * @i: value to add
+ * @v: A pointer to an opaque 64 bit atomic variable
+ *
+ * Return: None
+ */
+static inline void __qdf_atomic64_add(int64_t i, __qdf_atomic64_t *v)
+{
+	atomic64_add(i, v);
+}
+
 /**
  * __qdf_atomic_set_bit - Atomically set a bit in memory
  * @nr: bit to set
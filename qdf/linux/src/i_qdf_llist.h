@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: i_qdf_llist.h
+ * Linux-specific definitions for QDF lock-less list API's
+ */
+
+#ifndef __I_QDF_LLIST_H
+#define __I_QDF_LLIST_H
+
+#include <linux/llist.h>
+
+typedef struct llist_head __qdf_llist_head_t;
+typedef struct llist_node __qdf_llist_node_t;
+
+#define __qdf_init_llist_head(head)		init_llist_head(head)
+#define __qdf_llist_add(node, head)		llist_add(node, head)
+#define __qdf_llist_add_batch(first, last, head) \
+	llist_add_batch(first, last, head)
+#define __qdf_llist_del_all(head)		llist_del_all(head)
+#define __qdf_llist_del_first(head)		llist_del_first(head)
+#define __qdf_llist_empty(head)			llist_empty(head)
+#define __qdf_llist_next(node)			llist_next(node)
+#define __qdf_llist_reverse_order(first)	llist_reverse_order(first)
+
+#endif /* __I_QDF_LLIST_H */
@@ -27,6 +27,7 @@
 #include <linux/skbuff.h>
 #include <linux/netdevice.h>
 #include <linux/etherdevice.h>
+#include <linux/if_vlan.h>
 #include <linux/dma-mapping.h>
 #include <linux/version.h>
 #include <asm/cacheflush.h>
@@ -36,6 +37,7 @@
 #include <qdf_util.h>
 #include <qdf_mem.h>
 #include <linux/tcp.h>
+#include <net/busy_poll.h>
 #include <qdf_util.h>
 
 /*
@@ -752,6 +754,7 @@ __qdf_nbuf_alloc(__qdf_device_t osdev, size_t size, int reserve, int align,
 		 int prio, const char *func, uint32_t line);
 
 void __qdf_nbuf_free(struct sk_buff *skb);
+void __qdf_nbuf_free_bulk(struct sk_buff *skb_list);
 QDF_STATUS __qdf_nbuf_map(__qdf_device_t osdev,
 			struct sk_buff *skb, qdf_dma_dir_t dir);
 void __qdf_nbuf_unmap(__qdf_device_t osdev,
@@ -1147,6 +1150,95 @@ __qdf_nbuf_reset(struct sk_buff *skb, int reserve, int align)
 	skb_reserve(skb, reserve);
 }
 
+/**
+ * __qdf_nbuf_is_recyclable() - check if a buffer can be reset and reused
+ * @skb: Network buf instance
+ * @size: size the buffer must be able to hold
+ * @align: alignment
+ *
+ * Return: true if recyclable
+ */
+static inline bool
+__qdf_nbuf_is_recyclable(struct sk_buff *skb, int size, int align)
+{
+	if (align)
+		size += (align - 1);
+
+	if (skb_is_nonlinear(skb) || skb_cloned(skb) || skb_shared(skb) ||
+	    skb->destructor || skb_dst(skb))
+		return false;
+
+	return skb_end_offset(skb) >= (NET_SKB_PAD + size);
+}
+
+/**
+ * __qdf_nbuf_recycle_clear_vlan() - clear the hw accel VLAN tag of a buffer
+ * @skb: Network buf instance
+ *
+ * Return: none
+ */
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 0, 0))
+static inline void __qdf_nbuf_recycle_clear_vlan(struct sk_buff *skb)
+{
+	__vlan_hwaccel_clear_tag(skb);
+	skb->vlan_proto = 0;
+}
+#else
+static inline void __qdf_nbuf_recycle_clear_vlan(struct sk_buff *skb)
+{
+	skb->vlan_tci = 0;
+	skb->vlan_proto = 0;
+}
+#endif
+
+/**
+ * __qdf_nbuf_recycle_reset() - reset a buffer to its alloc state
+ * @skb: Network buf instance
+ * @reserve: reserve
+ * @align: align
+ *
+ * Every field the stack or the driver may have set on the previous use is
+ * put back to what __netdev_alloc_skb() hands out, so a recycled buffer
+ * is indistinguishable from a fresh one.
+ *
+ * Return: none
+ */
+static inline void
+__qdf_nbuf_recycle_reset(struct sk_buff *skb, int reserve, int align)
+{
+	unsigned long offset;
+
+	skb->next = NULL;
+	skb->len = 0;
+	skb->data_len = 0;
+	skb->data = skb->head + NET_SKB_PAD;
+	skb_reset_tail_pointer(skb);
+	skb->ip_summed = CHECKSUM_NONE;
+	skb->protocol = 0;
+	skb->pkt_type = PACKET_HOST;
+	skb->priority = 0;
+	skb->mark = 0;
+	skb->queue_mapping = 0;
+	skb->tstamp = ktime_set(0, 0);
+	skb_clear_hash(skb);
+	__qdf_nbuf_recycle_clear_vlan(skb);
+	skb->mac_header = (typeof(skb->mac_header))~0U;
+	skb->network_header = 0;
+	skb->transport_header = (typeof(skb->transport_header))~0U;
+	memset(skb->cb, 0x0, sizeof(skb->cb));
+
+	QDF_NBUF_CB_TX_EXTRA_FRAG_WORDSTR_EFRAG(skb) = 1;
+	QDF_NBUF_CB_TX_EXTRA_FRAG_WORDSTR_NBUF(skb) = 1;
+
+	if (align) {
+		offset = ((unsigned long)skb->data) % align;
+		if (offset)
+			skb_reserve(skb, align - offset);
+	}
+
+	skb_reserve(skb, reserve);
+}
+
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 14, 0))
 /**
  * qdf_nbuf_dev_scratch_is_supported() - dev_scratch support for network buffer
@@ -1371,6 +1463,59 @@ static inline struct sk_buff *__qdf_nbuf_get_ext_list(struct sk_buff *head_buf)
 	return (skb_shinfo(head_buf)->frag_list);
 }
 
+/**
+ * __qdf_nbuf_get_max_frags() - max number of page fragments of an skb
+ *
+ * Return: MAX_SKB_FRAGS
+ */
+static inline uint32_t __qdf_nbuf_get_max_frags(void)
+{
+	return MAX_SKB_FRAGS;
+}
+
+/**
+ * __qdf_nbuf_is_frag_attachable() - check if skb data can be shared as frag
+ * @skb: sk buff
+ *
+ * The data of an skb can be referenced from another skb as a page fragment
+ * only if its head was carved out of a page and is not shared with a clone.
+ *
+ * Return: true if the skb data can be attached as a page fragment
+ */
+static inline bool __qdf_nbuf_is_frag_attachable(struct sk_buff *skb)
+{
+	return skb->head_frag && !skb_cloned(skb) && !skb_is_nonlinear(skb);
+}
+
+/**
+ * __qdf_nbuf_attach_as_rx_frag() - attach the data of an skb to another skb
+ *				    as a page fragment
+ * @skb_head: sk buff the fragment is added to
+ * @skb: sk buff whose data [data, data + len) is referenced
+ *
+ * A reference is taken on the page backing @skb, hence @skb can be freed
+ * by the caller once this returns success without releasing the data.
+ *
+ * Return: QDF_STATUS_SUCCESS if the fragment was added
+ */
+static inline QDF_STATUS
+__qdf_nbuf_attach_as_rx_frag(struct sk_buff *skb_head, struct sk_buff *skb)
+{
+	int nr_frags = skb_shinfo(skb_head)->nr_frags;
+	struct page *page;
+
+	if (!__qdf_nbuf_is_frag_attachable(skb) || nr_frags >= MAX_SKB_FRAGS)
+		return QDF_STATUS_E_INVAL;
+
+	page = virt_to_head_page(skb->data);
+	get_page(page);
+	skb_add_rx_frag(skb_head, nr_frags, page,
+			skb->data - (unsigned char *)page_address(page),
+			skb->len, skb_end_offset(skb));
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * __qdf_nbuf_get_age() - return the checksum value of the skb
  * @skb: Pointer to network buffer
@@ -2185,6 +2330,29 @@ __qdf_nbuf_get_timestamp(struct sk_buff *skb)
 	return ktime_to_ms(skb_get_ktime(skb));
 }
 
+/**
+ * __qdf_nbuf_mark_napi_id() - record the NAPI instance the frame arrived on
+ * @skb: sk buff
+ * @napi: napi_struct of the polling context delivering the frame
+ *
+ * The socket layer learns the NAPI id from the skb and uses it to drive
+ * napi_busy_loop() for busy polling sockets.
+ *
+ * Return: void
+ */
+#ifdef CONFIG_NET_RX_BUSY_POLL
+static inline void
+__qdf_nbuf_mark_napi_id(struct sk_buff *skb, void *napi)
+{
+	skb_mark_napi_id(skb, (struct napi_struct *)napi);
+}
+#else
+static inline void
+__qdf_nbuf_mark_napi_id(struct sk_buff *skb, void *napi)
+{
+}
+#endif
+
 /**
  * __qdf_nbuf_get_timedelta_ms() - get time difference in ms
  *
@@ -2290,6 +2458,59 @@ __qdf_nbuf_unmap_nbytes_single(qdf_device_t osdev, struct sk_buff *buf,
 }
 #endif
 
+/**
+ * __qdf_nbuf_unmap_nbytes_single_partial() - unmap nbytes, sync fewer
+ * @osdev: os device
+ * @buf: buffer
+ * @dir: direction
+ * @nbytes: number of bytes mapped
+ * @sync_bytes: number of bytes from the start to sync for the CPU
+ *
+ * Return: none
+ */
+#if defined(A_SIMOS_DEVHOST)
+static inline void
+__qdf_nbuf_unmap_nbytes_single_partial(qdf_device_t osdev,
+				       struct sk_buff *buf,
+				       qdf_dma_dir_t dir, int nbytes,
+				       int sync_bytes)
+{
+}
+#elif (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0))
+static inline void
+__qdf_nbuf_unmap_nbytes_single_partial(qdf_device_t osdev,
+				       struct sk_buff *buf,
+				       qdf_dma_dir_t dir, int nbytes,
+				       int sync_bytes)
+{
+	qdf_dma_addr_t paddr = QDF_NBUF_CB_PADDR(buf);
+
+	if (qdf_unlikely(!paddr))
+		return;
+
+	if (sync_bytes >= nbytes) {
+		dma_unmap_single(osdev->dev, paddr, nbytes,
+				 __qdf_dma_dir_to_os(dir));
+		return;
+	}
+
+	dma_sync_single_for_cpu(osdev->dev, paddr, sync_bytes,
+				__qdf_dma_dir_to_os(dir));
+	dma_unmap_single_attrs(osdev->dev, paddr, nbytes,
+			       __qdf_dma_dir_to_os(dir),
+			       DMA_ATTR_SKIP_CPU_SYNC);
+}
+#else
+static inline void
+__qdf_nbuf_unmap_nbytes_single_partial(qdf_device_t osdev,
+				       struct sk_buff *buf,
+				       qdf_dma_dir_t dir, int nbytes,
+				       int sync_bytes)
+{
+	__qdf_nbuf_unmap_nbytes_single(osdev, buf, dir, nbytes);
+}
+#endif
+
 static inline struct sk_buff *
 __qdf_nbuf_queue_head_dequeue(struct sk_buff_head *skb_queue_head)
 {
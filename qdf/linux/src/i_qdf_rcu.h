@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: i_qdf_rcu.h
+ * Linux-specific definitions for QDF RCU API's
+ */
+
+#ifndef __I_QDF_RCU_H
+#define __I_QDF_RCU_H
+
+#include <linux/rcupdate.h>
+
+typedef struct rcu_head __qdf_rcu_head_t;
+typedef void (*__qdf_rcu_callback_t)(struct rcu_head *head);
+
+#define __qdf_rcu_read_lock()			rcu_read_lock()
+#define __qdf_rcu_read_unlock()			rcu_read_unlock()
+#define __qdf_rcu_dereference(p)		rcu_dereference(p)
+#define __qdf_rcu_assign_pointer(p, v)		rcu_assign_pointer(p, v)
+#define __qdf_call_rcu(head, func)		call_rcu(head, func)
+#define __qdf_synchronize_rcu()			synchronize_rcu()
+#define __qdf_rcu_barrier()			rcu_barrier()
+
+#endif /* __I_QDF_RCU_H */
@@ -30,6 +30,8 @@
 #include <linux/mm.h>
 #include <linux/errno.h>
 #include <linux/average.h>
+#include <linux/bottom_half.h>
+#include <linux/cache.h>
 
 #include <linux/random.h>
 #include <linux/io.h>
@@ -295,6 +297,10 @@ static inline bool __qdf_is_macaddr_equal(struct qdf_mac_addr *mac_addr1,
 
 #define __qdf_prefetch(x)     prefetch(x)
 
+#define __qdf_local_bh_disable()	local_bh_disable()
+#define __qdf_local_bh_enable()		local_bh_enable()
+#define __qdf_cacheline_aligned		____cacheline_aligned
+
 #ifdef QCA_CONFIG_SMP
 /**
  * __qdf_get_cpu() - get cpu_index
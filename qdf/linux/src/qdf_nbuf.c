@@ -560,6 +560,47 @@ void __qdf_nbuf_free(struct sk_buff *skb)
 
 qdf_export_symbol(__qdf_nbuf_free);
 
+/**
+ * __qdf_nbuf_free_bulk() - free a list of nbufs chained through skb->next
+ * @skb_list: head of the list
+ *
+ * The kernel frees the chain in one call, which lets it batch the slab
+ * frees instead of going through the free path once per buffer.
+ *
+ * Return: none
+ */
+void __qdf_nbuf_free_bulk(struct sk_buff *skb_list)
+{
+	struct sk_buff *skb, *next;
+	struct sk_buff *head = NULL, *tail = NULL;
+
+	for (skb = skb_list; skb; skb = next) {
+		next = skb->next;
+		skb->next = NULL;
+
+		if (pld_nbuf_pre_alloc_free(skb))
+			continue;
+
+		qdf_nbuf_count_dec(skb);
+		qdf_mem_skb_dec(skb->truesize);
+		if (nbuf_free_cb) {
+			nbuf_free_cb(skb);
+			continue;
+		}
+
+		if (tail)
+			tail->next = skb;
+		else
+			head = skb;
+		tail = skb;
+	}
+
+	if (head)
+		kfree_skb_list(head);
+}
+
+qdf_export_symbol(__qdf_nbuf_free_bulk);
+
 #ifdef NBUF_MEMORY_DEBUG
 enum qdf_nbuf_event_type {
 	QDF_NBUF_ALLOC,
@@ -805,6 +846,22 @@ void qdf_nbuf_unmap_nbytes_single_debug(qdf_device_t osdev,
 
 qdf_export_symbol(qdf_nbuf_unmap_nbytes_single_debug);
 
+void qdf_nbuf_unmap_nbytes_single_partial_debug(qdf_device_t osdev,
+						qdf_nbuf_t buf,
+						qdf_dma_dir_t dir,
+						int nbytes,
+						int sync_bytes,
+						const char *func,
+						uint32_t line)
+{
+	qdf_nbuf_untrack_map(buf, func, line);
+	__qdf_nbuf_unmap_nbytes_single_partial(osdev, buf, dir, nbytes,
+					       sync_bytes);
+	qdf_net_buf_debug_update_unmap_node(buf, func, line);
+}
+
+qdf_export_symbol(qdf_nbuf_unmap_nbytes_single_partial_debug);
+
 static void qdf_nbuf_panic_on_free_if_mapped(qdf_nbuf_t nbuf,
 					     const char *func,
 					     uint32_t line)
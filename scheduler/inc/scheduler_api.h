@@ -24,6 +24,7 @@
 #include <qdf_lock.h>
 #include <qdf_mc_timer.h>
 #include <qdf_status.h>
+#include <qdf_llist.h>
 
 /* Controller thread various event masks
  * MC_POST_EVENT_MASK: wake up thread after posting message
@@ -47,6 +48,21 @@
 #define scheduler_get_qid(src, dest, que_id)    ((que_id) | ((dest) << 10) |\
 					     ((src) << 20))
 
+/**
+ * enum scheduler_affinity - execution context of a scheduler message queue
+ * @SCHEDULER_AFFINITY_SERIAL: messages are serialized with every other
+ *	serial queue on the MC thread
+ * @SCHEDULER_AFFINITY_PARALLEL: the component shares no state with other
+ *	components; its messages may run on a scheduler worker thread, in
+ *	parallel with other queues but still in order within the queue
+ * @SCHEDULER_AFFINITY_MAX: number of affinity classes
+ */
+enum scheduler_affinity {
+	SCHEDULER_AFFINITY_SERIAL,
+	SCHEDULER_AFFINITY_PARALLEL,
+	SCHEDULER_AFFINITY_MAX,
+};
+
 typedef enum {
 	SYS_MSG_ID_MC_TIMER,
 	SYS_MSG_ID_FTM_RSP,
@@ -72,7 +88,7 @@ typedef enum {
  *   like PSOC, PDEV, VDEV and PEER. A component needs to populate flush
  *   callback in message body pointer for those messages which have taken ref
  *   count for above mentioned common objects.
- * @node: list node for queue membership
+ * @node: lock-less list node for queue membership
  * @queue_id: Id of the queue the message was added to
  * @queue_depth: depth of the queue when the message was queued
  * @queued_at_us: timestamp when the message was queued in microseconds
@@ -84,7 +100,7 @@ struct scheduler_msg {
 	void *bodyptr;
 	void *callback;
 	void *flush_callback;
-	qdf_list_node_t node;
+	qdf_llist_node_t node;
 #ifdef WLAN_SCHED_HISTORY_SIZE
 	QDF_MODULE_ID queue_id;
 	uint32_t queue_depth;
@@ -153,6 +169,23 @@ QDF_STATUS scheduler_disable(void);
 QDF_STATUS scheduler_register_module(QDF_MODULE_ID qid,
 		scheduler_msg_process_fn_t callback);
 
+/**
+ * scheduler_register_module_affinity() - register module with an affinity
+ * @qid: queue id to get registered
+ * @callback: queue message to be called when a message is posted
+ * @affinity: execution context of the queue's messages
+ *
+ * Same as scheduler_register_module(), except that queues registered with
+ * SCHEDULER_AFFINITY_PARALLEL are processed by the scheduler worker pool
+ * when WLAN_SCHED_WORKER_POOL is enabled. Without the worker pool, every
+ * queue is processed by the MC thread.
+ *
+ * Return: QDF status
+ */
+QDF_STATUS scheduler_register_module_affinity(QDF_MODULE_ID qid,
+		scheduler_msg_process_fn_t callback,
+		enum scheduler_affinity affinity);
+
 /**
  * scheduler_deregister_module() - deregister input module/queue id
  * @qid: queue id to get deregistered
@@ -22,7 +22,10 @@
 #include <qdf_threads.h>
 #include <qdf_timer.h>
 #include <scheduler_api.h>
-#include <qdf_list.h>
+#include <qdf_llist.h>
+#include <qdf_atomic.h>
+#include <qdf_time.h>
+#include <qdf_util.h>
 
 #ifndef SCHEDULER_CORE_MAX_MESSAGES
 #define SCHEDULER_CORE_MAX_MESSAGES 4000
@@ -33,6 +36,25 @@
 #define SCHEDULER_NUMBER_OF_MSG_QUEUE 6
 #define SCHEDULER_WRAPPER_MAX_FAIL_COUNT (SCHEDULER_CORE_MAX_MESSAGES * 3)
 #define SCHEDULER_WATCHDOG_TIMEOUT (10 * 1000) /* 10s */
+#define SCHEDULER_WATCHDOG_POLL_INTERVAL 1000 /* 1s */
+/* bit in scheduler_ctx.watchdog_flags set while the watchdog timer runs */
+#define SCHEDULER_WATCHDOG_ARMED 0
+
+#ifdef WLAN_SCHED_WORKER_POOL
+#ifndef SCHEDULER_WORKER_POOL_SIZE
+#define SCHEDULER_WORKER_POOL_SIZE 2
+#endif
+/* messages a worker drains from a queue before it looks at the others */
+#define SCHEDULER_WORKER_BATCH 16
+
+/* scheduler_worker_pool flags */
+#define SCHEDULER_WORKER_POST_EVENT 0
+#define SCHEDULER_WORKER_SHUTDOWN_EVENT 1
+#define SCHEDULER_WORKER_PAUSE_EVENT 2
+#endif /* WLAN_SCHED_WORKER_POOL */
+
+/* scheduler_mq_type flags */
+#define SCHEDULER_MQ_CLAIMED 0
 
 #define sched_fatal(params...) \
 	QDF_TRACE_FATAL(QDF_MODULE_ID_SCHEDULER, params)
@@ -61,14 +83,27 @@
 
 /**
  * struct scheduler_mq_type -  scheduler message queue
- * @mq_lock: message queue lock
- * @mq_list: message queue list
+ * @mq_front: lock-less list of messages posted to the front of the queue
+ * @mq_back: lock-less list of messages posted to the back of the queue
+ * @mq_local: messages detached by the consumer, in processing order
+ * @mq_depth: number of messages in the queue
+ * @mq_flags: SCHEDULER_MQ_CLAIMED while a worker thread consumes the queue
  * @qid: queue id
+ * @affinity: thread(s) processing the queue
+ *
+ * Producers only add to @mq_front and @mq_back. There is a single consumer
+ * at a time, the MC thread for serial queues and the worker which claimed
+ * the queue for parallel ones. It detaches whole lists at once into
+ * @mq_local and pops messages from there.
  */
 struct scheduler_mq_type {
-	qdf_spinlock_t mq_lock;
-	qdf_list_t mq_list;
+	qdf_llist_head_t mq_front;
+	qdf_llist_head_t mq_back;
+	qdf_llist_head_t mq_local;
+	qdf_atomic_t mq_depth;
+	unsigned long mq_flags;
 	QDF_MODULE_ID qid;
+	enum scheduler_affinity affinity;
 };
 
 /**
@@ -84,6 +119,51 @@ struct scheduler_mq_ctx {
 					(struct scheduler_msg *msg);
 };
 
+#ifdef WLAN_SCHED_WORKER_POOL
+struct scheduler_ctx;
+
+/**
+ * struct scheduler_worker - scheduler worker thread
+ * @sched_ctx: scheduler context
+ * @thread: worker thread
+ * @start_event: worker thread start wait event
+ * @shutdown_event: worker thread shutdown wait event
+ * @id: index of the worker in the pool
+ * @watchdog_msg_type: 'type' of the current msg being processed
+ * @watchdog_callback: the callback of the current msg being processed
+ * @watchdog_msg_start: ticks when the current msg started processing, 0 when
+ *	the worker is not processing any msg
+ * @watchdog_last_bite: value of @watchdog_msg_start the watchdog last bit on
+ */
+struct scheduler_worker {
+	struct scheduler_ctx *sched_ctx;
+	qdf_thread_t *thread;
+	qdf_event_t start_event;
+	qdf_event_t shutdown_event;
+	uint8_t id;
+	uint16_t watchdog_msg_type;
+	void *watchdog_callback;
+	qdf_time_t watchdog_msg_start;
+	qdf_time_t watchdog_last_bite;
+};
+
+/**
+ * struct scheduler_worker_pool - threads processing parallel queues
+ * @workers: worker threads
+ * @wait_queue: workers wait queue
+ * @idle_event: set by the last busy worker once the pool is paused
+ * @flags: SCHEDULER_WORKER_*_EVENT bits
+ * @busy: number of workers currently looking for or processing messages
+ */
+struct scheduler_worker_pool {
+	struct scheduler_worker workers[SCHEDULER_WORKER_POOL_SIZE];
+	qdf_wait_queue_head_t wait_queue;
+	qdf_event_t idle_event;
+	unsigned long flags;
+	qdf_atomic_t busy;
+};
+#endif /* WLAN_SCHED_WORKER_POOL */
+
 /**
  * struct scheduler_ctx - scheduler context
  * @queue_ctx: message queue context
@@ -99,8 +179,14 @@ struct scheduler_mq_ctx {
  * @hdd_callback: os if suspend callback
  * @legacy_wma_handler: legacy wma message handler
  * @legacy_sys_handler: legacy sys message handler
- * @watchdog_timer: timer for triggering a scheduler watchdog bite
+ * @watchdog_timer: timer checking for a scheduler watchdog bite, only kept
+ *	running while the scheduler thread is processing messages
+ * @watchdog_flags: SCHEDULER_WATCHDOG_ARMED bit
  * @watchdog_callback: the callback of the current msg being processed
+ * @watchdog_msg_start: ticks when the current msg started processing, 0 when
+ *	the scheduler thread is not processing any msg
+ * @watchdog_last_bite: value of @watchdog_msg_start the watchdog last bit on
+ * @worker_pool: worker threads processing parallel queues
  */
 struct scheduler_ctx {
 	struct scheduler_mq_ctx queue_ctx;
@@ -117,7 +203,13 @@ struct scheduler_ctx {
 	scheduler_msg_process_fn_t legacy_wma_handler;
 	scheduler_msg_process_fn_t legacy_sys_handler;
 	qdf_timer_t watchdog_timer;
+	unsigned long watchdog_flags;
 	void *watchdog_callback;
+	qdf_time_t watchdog_msg_start;
+	qdf_time_t watchdog_last_bite;
+#ifdef WLAN_SCHED_WORKER_POOL
+	struct scheduler_worker_pool worker_pool;
+#endif
 };
 
 /**
@@ -202,9 +294,10 @@ void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
  * scheduler_mq_get() - to get message from message queue
  * @msg_q: Pointer to the message queue
  *
- * This function is used to get message from given message queue
+ * This function is used to get message from given message queue. It must
+ * only be called from the single consumer of the queue.
  *
- *  Return: none
+ *  Return: message or NULL if the queue is empty
  */
 struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q);
 
@@ -237,4 +330,95 @@ QDF_STATUS scheduler_queues_deinit(struct scheduler_ctx *gp_sch_ctx);
  * Return: none
  */
 void scheduler_queues_flush(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_watchdog_arm() - start the watchdog timer if it is not running
+ * @sch_ctx: scheduler context
+ *
+ * Called by the MC thread and the workers once they set the watchdog start
+ * time of a new message. The timer stops itself once it finds every thread
+ * idle, so that idle threads do not cause periodic wakeups.
+ *
+ * Return: none
+ */
+void scheduler_watchdog_arm(struct scheduler_ctx *sch_ctx);
+
+#ifdef WLAN_SCHED_WORKER_POOL
+/**
+ * scheduler_workers_init() - initialize the scheduler worker pool
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: QDF_STATUS based on success or failure
+ */
+QDF_STATUS scheduler_workers_init(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_workers_deinit() - de-initialize the scheduler worker pool
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: none
+ */
+void scheduler_workers_deinit(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_workers_start() - create and start the worker threads
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: QDF_STATUS based on success or failure
+ */
+QDF_STATUS scheduler_workers_start(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_workers_stop() - stop the worker threads and wait for them
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: none
+ */
+void scheduler_workers_stop(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_workers_wake() - wake the workers after a parallel queue post
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: none
+ */
+void scheduler_workers_wake(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_workers_busy() - check if a worker is processing a message
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: true if any worker has a message in progress
+ */
+bool scheduler_workers_busy(struct scheduler_ctx *sched_ctx);
+#else
+static inline QDF_STATUS
+scheduler_workers_init(struct scheduler_ctx *sched_ctx)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void scheduler_workers_deinit(struct scheduler_ctx *sched_ctx)
+{
+}
+
+static inline QDF_STATUS
+scheduler_workers_start(struct scheduler_ctx *sched_ctx)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void scheduler_workers_stop(struct scheduler_ctx *sched_ctx)
+{
+}
+
+static inline void scheduler_workers_wake(struct scheduler_ctx *sched_ctx)
+{
+}
+
+static inline bool scheduler_workers_busy(struct scheduler_ctx *sched_ctx)
+{
+	return false;
+}
+#endif /* WLAN_SCHED_WORKER_POOL */
 #endif
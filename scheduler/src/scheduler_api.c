@@ -39,6 +39,8 @@ QDF_STATUS scheduler_disable(void)
 
 	/* wait for scheduler thread to shutdown */
 	qdf_wait_single_event(&sched_ctx->sch_shutdown, 0);
+	scheduler_workers_stop(sched_ctx);
+	qdf_timer_sync_cancel(&sched_ctx->watchdog_timer);
 	sched_ctx->sch_thread = NULL;
 
 	/* flush any unprocessed scheduler messages */
@@ -47,37 +49,124 @@ QDF_STATUS scheduler_disable(void)
 	return QDF_STATUS_SUCCESS;
 }
 
-static inline void scheduler_watchdog_notify(struct scheduler_ctx *sched)
+static inline void scheduler_watchdog_notify(void *callback,
+					     uint16_t msg_type)
 {
 	char symbol[QDF_SYMBOL_LEN];
 
-	if (sched->watchdog_callback)
-		qdf_sprint_symbol(symbol, sched->watchdog_callback);
+	if (callback)
+		qdf_sprint_symbol(symbol, callback);
 
 	sched_fatal("Callback %s (type 0x%x) exceeded its allotted time of %ds",
-		    sched->watchdog_callback ? symbol : "<null>",
-		    sched->watchdog_msg_type,
+		    callback ? symbol : "<null>", msg_type,
 		    SCHEDULER_WATCHDOG_TIMEOUT / 1000);
 }
 
+/**
+ * scheduler_watchdog_expired() - check a thread's message against the timeout
+ * @msg_start: start of the message being processed, 0 if the thread is idle
+ * @last_bite: start of the message the watchdog already bit on
+ *
+ * Return: true if the message exceeded the timeout and was not bit on yet
+ */
+static bool scheduler_watchdog_expired(qdf_time_t msg_start,
+				       qdf_time_t *last_bite)
+{
+	qdf_time_t deadline;
+
+	/* idle, or already bit on the message currently being processed */
+	if (!msg_start || msg_start == *last_bite)
+		return false;
+
+	deadline = msg_start +
+		   qdf_system_msecs_to_ticks(SCHEDULER_WATCHDOG_TIMEOUT);
+	if (qdf_system_time_after(deadline, qdf_system_ticks()))
+		return false;
+
+	*last_bite = msg_start;
+
+	return true;
+}
+
+static void scheduler_watchdog_bite(struct scheduler_ctx *sched,
+				    qdf_thread_t *thread)
+{
+	if (thread)
+		qdf_print_thread_trace(thread);
+
+	/* avoid crashing during shutdown */
+	if (!qdf_atomic_test_bit(MC_SHUTDOWN_EVENT_MASK,
+				 &sched->sch_event_flag))
+		QDF_DEBUG_PANIC("Going down for Scheduler Watchdog Bite!");
+}
+
+#ifdef WLAN_SCHED_WORKER_POOL
+static void scheduler_workers_watchdog(struct scheduler_ctx *sched)
+{
+	struct scheduler_worker *worker;
+	int i;
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		worker = &sched->worker_pool.workers[i];
+		if (!scheduler_watchdog_expired(worker->watchdog_msg_start,
+						&worker->watchdog_last_bite))
+			continue;
+
+		scheduler_watchdog_notify(worker->watchdog_callback,
+					  worker->watchdog_msg_type);
+		scheduler_watchdog_bite(sched, worker->thread);
+	}
+}
+#else
+static inline void scheduler_workers_watchdog(struct scheduler_ctx *sched)
+{
+}
+#endif
+
+static inline bool scheduler_watchdog_idle(struct scheduler_ctx *sched)
+{
+	return !sched->watchdog_msg_start && !scheduler_workers_busy(sched);
+}
+
 static void scheduler_watchdog_timeout(void *arg)
 {
 	struct scheduler_ctx *sched = arg;
 
-	scheduler_watchdog_notify(sched);
-	if (sched->sch_thread)
-		qdf_print_thread_trace(sched->sch_thread);
+	if (scheduler_watchdog_idle(sched)) {
+		/*
+		 * All scheduler threads are idle, let the timer stop. Pairs
+		 * with scheduler_watchdog_arm() for a message started
+		 * meanwhile.
+		 */
+		qdf_atomic_clear_bit(SCHEDULER_WATCHDOG_ARMED,
+				     &sched->watchdog_flags);
+		qdf_mb();
+		if (scheduler_watchdog_idle(sched) ||
+		    qdf_atomic_test_and_set_bit(SCHEDULER_WATCHDOG_ARMED,
+						&sched->watchdog_flags))
+			return;
+
+		goto rearm;
+	}
+
+	if (scheduler_watchdog_expired(sched->watchdog_msg_start,
+				       &sched->watchdog_last_bite)) {
+		scheduler_watchdog_notify(sched->watchdog_callback,
+					  sched->watchdog_msg_type);
+		scheduler_watchdog_bite(sched, sched->sch_thread);
+	}
 
-	/* avoid crashing during shutdown */
-	if (qdf_atomic_test_bit(MC_SHUTDOWN_EVENT_MASK, &sched->sch_event_flag))
-		return;
+	scheduler_workers_watchdog(sched);
 
-	QDF_DEBUG_PANIC("Going down for Scheduler Watchdog Bite!");
+rearm:
+	qdf_timer_mod(&sched->watchdog_timer,
+		      SCHEDULER_WATCHDOG_POLL_INTERVAL);
 }
 
 QDF_STATUS scheduler_enable(void)
 {
 	struct scheduler_ctx *sched_ctx;
+	QDF_STATUS status;
 
 	sched_debug("Enabling Scheduler");
 
@@ -91,11 +180,21 @@ QDF_STATUS scheduler_enable(void)
 	qdf_atomic_clear_bit(MC_POST_EVENT_MASK,
 			     &sched_ctx->sch_event_flag);
 
+	/* reset before any thread can start a message and arm the watchdog */
+	sched_ctx->watchdog_msg_start = 0;
+	sched_ctx->watchdog_last_bite = 0;
+	sched_ctx->watchdog_flags = 0;
+
+	status = scheduler_workers_start(sched_ctx);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
 	/* create the scheduler thread */
 	sched_ctx->sch_thread = qdf_create_thread(scheduler_thread, sched_ctx,
 						  "scheduler_thread");
 	if (!sched_ctx->sch_thread) {
 		sched_fatal("Failed to create scheduler thread");
+		scheduler_workers_stop(sched_ctx);
 		return QDF_STATUS_E_RESOURCES;
 	}
 
@@ -155,6 +254,12 @@ QDF_STATUS scheduler_init(void)
 		goto shutdown_event_destroy;
 	}
 
+	status = scheduler_workers_init(sched_ctx);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		sched_fatal("Failed to init workers; status:%d", status);
+		goto resume_event_destroy;
+	}
+
 	qdf_spinlock_create(&sched_ctx->sch_thread_lock);
 	qdf_init_waitqueue_head(&sched_ctx->sch_wait_queue);
 	sched_ctx->sch_event_flag = 0;
@@ -168,6 +273,9 @@ QDF_STATUS scheduler_init(void)
 
 	return QDF_STATUS_SUCCESS;
 
+resume_event_destroy:
+	qdf_event_destroy(&sched_ctx->resume_sch_event);
+
 shutdown_event_destroy:
 	qdf_event_destroy(&sched_ctx->sch_shutdown);
 
@@ -196,6 +304,7 @@ QDF_STATUS scheduler_deinit(void)
 		return QDF_STATUS_E_INVAL;
 
 	qdf_timer_free(&sched_ctx->watchdog_timer);
+	scheduler_workers_deinit(sched_ctx);
 	qdf_spinlock_destroy(&sched_ctx->sch_thread_lock);
 	qdf_event_destroy(&sched_ctx->resume_sch_event);
 	qdf_event_destroy(&sched_ctx->sch_shutdown);
@@ -292,6 +401,11 @@ QDF_STATUS scheduler_post_msg_by_priority(uint32_t qid,
 	else
 		scheduler_mq_put(target_mq, queue_msg);
 
+	if (target_mq->affinity == SCHEDULER_AFFINITY_PARALLEL) {
+		scheduler_workers_wake(sched_ctx);
+		return QDF_STATUS_SUCCESS;
+	}
+
 	qdf_atomic_set_bit(MC_POST_EVENT_MASK, &sched_ctx->sch_event_flag);
 	qdf_wake_up_interruptible(&sched_ctx->sch_wait_queue);
 
@@ -300,6 +414,15 @@ QDF_STATUS scheduler_post_msg_by_priority(uint32_t qid,
 
 QDF_STATUS scheduler_register_module(QDF_MODULE_ID qid,
 				     scheduler_msg_process_fn_t callback)
+{
+	return scheduler_register_module_affinity(qid, callback,
+						  SCHEDULER_AFFINITY_SERIAL);
+}
+
+QDF_STATUS
+scheduler_register_module_affinity(QDF_MODULE_ID qid,
+				   scheduler_msg_process_fn_t callback,
+				   enum scheduler_affinity affinity)
 {
 	struct scheduler_mq_ctx *ctx;
 	struct scheduler_ctx *sched_ctx = scheduler_get_context();
@@ -310,6 +433,16 @@ QDF_STATUS scheduler_register_module(QDF_MODULE_ID qid,
 	if (!sched_ctx)
 		return QDF_STATUS_E_FAILURE;
 
+	if (affinity >= SCHEDULER_AFFINITY_MAX) {
+		sched_err("Invalid affinity %d for qid %d", affinity, qid);
+		return QDF_STATUS_E_INVAL;
+	}
+
+#ifndef WLAN_SCHED_WORKER_POOL
+	/* without workers every queue is processed by the scheduler thread */
+	affinity = SCHEDULER_AFFINITY_SERIAL;
+#endif
+
 	if (sched_ctx->sch_last_qidx >= SCHEDULER_NUMBER_OF_MSG_QUEUE) {
 		sched_err("Already registered max %d no of message queues",
 			  SCHEDULER_NUMBER_OF_MSG_QUEUE);
@@ -320,6 +453,7 @@ QDF_STATUS scheduler_register_module(QDF_MODULE_ID qid,
 	ctx->scheduler_msg_qid_to_qidx[qid] = sched_ctx->sch_last_qidx;
 	ctx->sch_msg_q[sched_ctx->sch_last_qidx].qid = qid;
 	ctx->scheduler_msg_process_fn[sched_ctx->sch_last_qidx] = callback;
+	ctx->sch_msg_q[sched_ctx->sch_last_qidx].affinity = affinity;
 	sched_ctx->sch_last_qidx++;
 
 	sched_exit();
@@ -342,6 +476,7 @@ QDF_STATUS scheduler_deregister_module(QDF_MODULE_ID qid)
 	ctx = &sched_ctx->queue_ctx;
 	qidx = ctx->scheduler_msg_qid_to_qidx[qid];
 	ctx->scheduler_msg_process_fn[qidx] = NULL;
+	ctx->sch_msg_q[qidx].affinity = SCHEDULER_AFFINITY_SERIAL;
 	sched_ctx->sch_last_qidx--;
 	ctx->scheduler_msg_qid_to_qidx[qidx] = SCHEDULER_NUMBER_OF_MSG_QUEUE;
 
@@ -671,7 +806,7 @@ QDF_STATUS scheduler_get_queue_size(QDF_MODULE_ID qid, uint32_t *size)
 
 	target_mq = &(sched_ctx->queue_ctx.sch_msg_q[qidx]);
 
-	*size = qdf_list_size(&target_mq->mq_list);
+	*size = qdf_atomic_read(&target_mq->mq_depth);
 
 	return QDF_STATUS_SUCCESS;
 }
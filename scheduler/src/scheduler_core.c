@@ -47,6 +47,7 @@ DEFINE_QDF_FLEX_MEM_POOL(sched_pool, sizeof(struct scheduler_msg),
  * @queue_depth: depth of the queue when the message was queued
  * @run_start_us: timesatmp when the message started execution in microseconds
  * @run_duration_us: duration the message was executed in microseconds
+ * @affinity: affinity class of the queue the message was added to
  */
 struct sched_history_item {
 	void *callback;
@@ -57,22 +58,47 @@ struct sched_history_item {
 	uint32_t queue_depth;
 	uint64_t run_start_us;
 	uint32_t run_duration_us;
+	enum scheduler_affinity affinity;
+};
+
+/**
+ * struct sched_class_latency - latency of an affinity class over the history
+ * @count: number of messages in the history
+ * @queue_total_us: sum of the queue durations
+ * @queue_max_us: max queue duration
+ * @run_total_us: sum of the run durations
+ * @run_max_us: max run duration
+ */
+struct sched_class_latency {
+	uint32_t count;
+	uint64_t queue_total_us;
+	uint32_t queue_max_us;
+	uint64_t run_total_us;
+	uint32_t run_max_us;
+};
+
+static const char *sched_affinity_name[SCHEDULER_AFFINITY_MAX] = {
+	[SCHEDULER_AFFINITY_SERIAL] = "serial",
+	[SCHEDULER_AFFINITY_PARALLEL] = "parallel",
 };
 
 static struct sched_history_item sched_history[WLAN_SCHED_HISTORY_SIZE];
-static uint32_t sched_history_index;
+/* messages may be processed by several threads, slots are claimed atomically */
+static qdf_atomic_t sched_history_index;
 
 static void sched_history_queue(struct scheduler_mq_type *queue,
 				struct scheduler_msg *msg)
 {
 	msg->queue_id = queue->qid;
-	msg->queue_depth = qdf_list_size(&queue->mq_list);
+	msg->queue_depth = qdf_atomic_read(&queue->mq_depth);
 	msg->queued_at_us = qdf_get_log_timestamp_usecs();
 }
 
-static void sched_history_start(struct scheduler_msg *msg)
+static uint32_t sched_history_start(struct scheduler_msg *msg,
+				    enum scheduler_affinity affinity)
 {
 	uint64_t started_at_us = qdf_get_log_timestamp_usecs();
+	uint32_t index;
 	struct sched_history_item hist = {
 		.callback = msg->callback,
 		.type_id = msg->type,
@@ -80,20 +106,62 @@ static void sched_history_start(struct scheduler_msg *msg)
 		.queue_duration_us = started_at_us - msg->queued_at_us,
 		.queue_depth = msg->queue_depth,
 		.run_start_us = started_at_us,
+		.affinity = affinity,
 	};
 
-	sched_history[sched_history_index] = hist;
+	index = (uint32_t)qdf_atomic_inc_return(&sched_history_index) - 1;
+	index %= WLAN_SCHED_HISTORY_SIZE;
+	sched_history[index] = hist;
+
+	return index;
 }
 
-static void sched_history_stop(void)
+static void sched_history_stop(uint32_t index)
 {
-	struct sched_history_item *hist = &sched_history[sched_history_index];
+	struct sched_history_item *hist = &sched_history[index];
 	uint64_t stopped_at_us = qdf_get_log_timestamp_usecs();
 
 	hist->run_duration_us = stopped_at_us - hist->run_start_us;
+}
+
+static void sched_history_print_latency(struct sched_history_item *history)
+{
+	struct sched_class_latency latency[SCHEDULER_AFFINITY_MAX] = { {0} };
+	struct sched_class_latency *lat;
+	struct sched_history_item *item;
+	uint32_t idx;
+
+	for (idx = 0; idx < WLAN_SCHED_HISTORY_SIZE; idx++) {
+		item = history + idx;
+		if (!item->callback || item->affinity >= SCHEDULER_AFFINITY_MAX)
+			continue;
+
+		lat = &latency[item->affinity];
+		lat->count++;
+		lat->queue_total_us += item->queue_duration_us;
+		if (item->queue_duration_us > lat->queue_max_us)
+			lat->queue_max_us = item->queue_duration_us;
+		lat->run_total_us += item->run_duration_us;
+		if (item->run_duration_us > lat->run_max_us)
+			lat->run_max_us = item->run_duration_us;
+	}
+
+	sched_nofl_fatal("|Class   |Count|Queue Avg(us)|Queue Max(us)"
+			 "|Run Avg(us)|Run Max(us)|");
+	for (idx = 0; idx < SCHEDULER_AFFINITY_MAX; idx++) {
+		lat = &latency[idx];
+		if (!lat->count)
+			continue;
+
+		sched_nofl_fatal("|%8s|%5u|%13llu|%13u|%11llu|%11u|",
+				 sched_affinity_name[idx], lat->count,
+				 qdf_do_div(lat->queue_total_us, lat->count),
+				 lat->queue_max_us,
+				 qdf_do_div(lat->run_total_us, lat->count),
+				 lat->run_max_us);
+	}
 
-	sched_history_index++;
-	sched_history_index %= WLAN_SCHED_HISTORY_SIZE;
+	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
 }
 
 void sched_history_print(void)
@@ -111,7 +179,8 @@ void sched_history_print(void)
 
 	qdf_mem_copy(history, &sched_history,
 		     (sizeof(*history) * WLAN_SCHED_HISTORY_SIZE));
-	history_idx = sched_history_index;
+	history_idx = (uint32_t)qdf_atomic_read(&sched_history_index);
+	history_idx %= WLAN_SCHED_HISTORY_SIZE;
 
 	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
 	sched_nofl_fatal(SCHEDULER_HISTORY_HEADER);
@@ -133,14 +202,21 @@ void sched_history_print(void)
 
 	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
 
+	sched_history_print_latency(history);
+
 	qdf_mem_free(history);
 }
 #else /* WLAN_SCHED_HISTORY_SIZE */
 
 static inline void sched_history_queue(struct scheduler_mq_type *queue,
 				       struct scheduler_msg *msg) { }
-static inline void sched_history_start(struct scheduler_msg *msg) { }
-static inline void sched_history_stop(void) { }
+static inline uint32_t sched_history_start(struct scheduler_msg *msg,
+					   enum scheduler_affinity affinity)
+{
+	return 0;
+}
+
+static inline void sched_history_stop(uint32_t index) { }
 void sched_history_print(void) { }
 
 #endif /* WLAN_SCHED_HISTORY_SIZE */
@@ -172,8 +248,12 @@ static QDF_STATUS scheduler_mq_init(struct scheduler_mq_type *msg_q)
 {
 	sched_enter();
 
-	qdf_spinlock_create(&msg_q->mq_lock);
-	qdf_list_create(&msg_q->mq_list, SCHEDULER_CORE_MAX_MESSAGES);
+	qdf_init_llist_head(&msg_q->mq_front);
+	qdf_init_llist_head(&msg_q->mq_back);
+	qdf_init_llist_head(&msg_q->mq_local);
+	qdf_atomic_init(&msg_q->mq_depth);
+	msg_q->mq_flags = 0;
+	msg_q->affinity = SCHEDULER_AFFINITY_SERIAL;
 
 	sched_exit();
 
@@ -184,8 +264,7 @@ static void scheduler_mq_deinit(struct scheduler_mq_type *msg_q)
 {
 	sched_enter();
 
-	qdf_list_destroy(&msg_q->mq_list);
-	qdf_spinlock_destroy(&msg_q->mq_lock);
+	qdf_init_llist_head(&msg_q->mq_local);
 
 	sched_exit();
 }
@@ -250,36 +329,77 @@ static QDF_STATUS scheduler_all_queues_deinit(struct scheduler_ctx *sched_ctx)
 void scheduler_mq_put(struct scheduler_mq_type *msg_q,
 		      struct scheduler_msg *msg)
 {
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
-	qdf_list_insert_back(&msg_q->mq_list, &msg->node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+	qdf_atomic_inc(&msg_q->mq_depth);
+	qdf_llist_add(&msg->node, &msg_q->mq_back);
 }
 
 void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
 			    struct scheduler_msg *msg)
 {
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
-	qdf_list_insert_front(&msg_q->mq_list, &msg->node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+	qdf_atomic_inc(&msg_q->mq_depth);
+	qdf_llist_add(&msg->node, &msg_q->mq_front);
 }
 
 struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q)
 {
-	QDF_STATUS status;
-	qdf_list_node_t *node;
+	qdf_llist_node_t *node, *last;
+
+	/*
+	 * Messages put to the front are detached newest first, which is the
+	 * order they have to run in, and go ahead of everything detached
+	 * earlier.
+	 */
+	if (!qdf_llist_empty(&msg_q->mq_front)) {
+		node = qdf_llist_del_all(&msg_q->mq_front);
+		for (last = node; qdf_llist_next(last);
+		     last = qdf_llist_next(last))
+			;
+		qdf_llist_add_batch(node, last, &msg_q->mq_local);
+	}
 
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
-	status = qdf_list_remove_front(&msg_q->mq_list, &node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+	/* refill the local batch from the back list in posting order */
+	if (qdf_llist_empty(&msg_q->mq_local)) {
+		last = qdf_llist_del_all(&msg_q->mq_back);
+		if (!last)
+			return NULL;
+		node = qdf_llist_reverse_order(last);
+		qdf_llist_add_batch(node, last, &msg_q->mq_local);
+	}
 
-	if (QDF_IS_STATUS_ERROR(status))
-		return NULL;
+	node = qdf_llist_del_first(&msg_q->mq_local);
+	qdf_atomic_dec(&msg_q->mq_depth);
 
 	return qdf_container_of(node, struct scheduler_msg, node);
 }
 
+/**
+ * scheduler_mq_next_qidx() - queue to process the next message from
+ * @sch_ctx: scheduler context
+ * @qidx: index of the queue being drained
+ *
+ * Keeps draining @qidx as long as no higher priority serial queue has a
+ * message pending, which only costs an atomic read per higher priority queue.
+ *
+ * Return: index of the highest priority serial queue with pending messages,
+ *	or @qidx if there is none
+ */
+static int scheduler_mq_next_qidx(struct scheduler_ctx *sch_ctx, int qidx)
+{
+	struct scheduler_mq_type *mq;
+	int i;
+
+	for (i = 0; i < qidx; i++) {
+		mq = &sch_ctx->queue_ctx.sch_msg_q[i];
+		if (mq->affinity == SCHEDULER_AFFINITY_SERIAL &&
+		    qdf_atomic_read(&mq->mq_depth))
+			return i;
+	}
+
+	return qidx;
+}
+
 QDF_STATUS scheduler_queues_deinit(struct scheduler_ctx *sched_ctx)
 {
 	return scheduler_all_queues_deinit(sched_ctx);
@@ -347,12 +467,344 @@ void scheduler_core_msg_free(struct scheduler_msg *msg)
 	qdf_atomic_dec(&__sched_queue_depth);
 }
 
+void scheduler_watchdog_arm(struct scheduler_ctx *sch_ctx)
+{
+	/* pairs with the idle check in scheduler_watchdog_timeout() */
+	qdf_mb();
+	if (qdf_atomic_test_bit(SCHEDULER_WATCHDOG_ARMED,
+				&sch_ctx->watchdog_flags))
+		return;
+
+	if (!qdf_atomic_test_and_set_bit(SCHEDULER_WATCHDOG_ARMED,
+					 &sch_ctx->watchdog_flags))
+		qdf_timer_mod(&sch_ctx->watchdog_timer,
+			      SCHEDULER_WATCHDOG_POLL_INTERVAL);
+}
+
+#ifdef WLAN_SCHED_WORKER_POOL
+/**
+ * scheduler_worker_drain_queue() - process a batch of a claimed queue
+ * @worker: worker which claimed the queue
+ * @qidx: index of the queue
+ *
+ * Return: none
+ */
+static void scheduler_worker_drain_queue(struct scheduler_worker *worker,
+					 int qidx)
+{
+	struct scheduler_ctx *sch_ctx = worker->sched_ctx;
+	struct scheduler_mq_type *mq = &sch_ctx->queue_ctx.sch_msg_q[qidx];
+	scheduler_msg_process_fn_t process_fn;
+	struct scheduler_msg *msg;
+	uint32_t hist_idx;
+	QDF_STATUS status;
+	int count;
+
+	for (count = 0; count < SCHEDULER_WORKER_BATCH; count++) {
+		msg = scheduler_mq_get(mq);
+		if (!msg)
+			break;
+
+		process_fn = sch_ctx->queue_ctx.scheduler_msg_process_fn[qidx];
+		if (!process_fn) {
+			scheduler_core_msg_free(msg);
+			continue;
+		}
+
+		worker->watchdog_msg_type = msg->type;
+		worker->watchdog_callback = msg->callback;
+
+		hist_idx = sched_history_start(msg,
+					       SCHEDULER_AFFINITY_PARALLEL);
+		worker->watchdog_msg_start = qdf_system_ticks();
+		scheduler_watchdog_arm(sch_ctx);
+		status = process_fn(msg);
+		worker->watchdog_msg_start = 0;
+		sched_history_stop(hist_idx);
+
+		if (QDF_IS_STATUS_ERROR(status))
+			sched_err("Worker %d failed processing Qid[%d] message",
+				  worker->id, mq->qid);
+
+		scheduler_core_msg_free(msg);
+	}
+}
+
+/**
+ * scheduler_worker_process_queues() - process parallel queues until idle
+ * @worker: worker thread context
+ *
+ * A parallel queue is claimed by one worker at a time, which keeps its
+ * messages in order and makes the worker its single consumer. The worker
+ * rescans from the highest priority queue after every batch and only goes
+ * back to sleep once a full scan finds nothing it can claim.
+ *
+ * Return: none
+ */
+static void scheduler_worker_process_queues(struct scheduler_worker *worker)
+{
+	struct scheduler_ctx *sch_ctx = worker->sched_ctx;
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+	struct scheduler_mq_type *mq;
+	bool processed;
+	int i;
+
+	/* fully ordered, pairs with scheduler_workers_pause() */
+	qdf_atomic_inc_return(&pool->busy);
+	if (qdf_atomic_test_bit(SCHEDULER_WORKER_PAUSE_EVENT, &pool->flags))
+		goto out;
+
+	qdf_atomic_test_and_clear_bit(SCHEDULER_WORKER_POST_EVENT, &pool->flags);
+
+	do {
+		processed = false;
+
+		for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
+			mq = &sch_ctx->queue_ctx.sch_msg_q[i];
+			if (mq->affinity != SCHEDULER_AFFINITY_PARALLEL ||
+			    !qdf_atomic_read(&mq->mq_depth))
+				continue;
+
+			if (qdf_atomic_test_and_set_bit(SCHEDULER_MQ_CLAIMED,
+							&mq->mq_flags))
+				continue;
+
+			scheduler_worker_drain_queue(worker, i);
+			qdf_atomic_clear_bit(SCHEDULER_MQ_CLAIMED,
+					     &mq->mq_flags);
+			processed = true;
+			break;
+		}
+	} while (processed &&
+		 !qdf_atomic_test_bit(SCHEDULER_WORKER_PAUSE_EVENT,
+				      &pool->flags) &&
+		 !qdf_atomic_test_bit(SCHEDULER_WORKER_SHUTDOWN_EVENT,
+				      &pool->flags));
+
+out:
+	/* the last busy worker of a paused pool releases the pauser */
+	if (!qdf_atomic_dec_return(&pool->busy) &&
+	    qdf_atomic_test_bit(SCHEDULER_WORKER_PAUSE_EVENT, &pool->flags))
+		qdf_event_set(&pool->idle_event);
+}
+
+static int scheduler_worker_thread(void *arg)
+{
+	struct scheduler_worker *worker = arg;
+	struct scheduler_worker_pool *pool = &worker->sched_ctx->worker_pool;
+	int retWaitStatus;
+
+	qdf_set_user_nice(current, -2);
+
+	qdf_event_set(&worker->start_event);
+	sched_debug("scheduler worker %d (%s) starting up",
+		    current->pid, current->comm);
+
+	while (!qdf_atomic_test_bit(SCHEDULER_WORKER_SHUTDOWN_EVENT,
+				    &pool->flags)) {
+		retWaitStatus = qdf_wait_queue_interruptible(
+				pool->wait_queue,
+				(qdf_atomic_test_bit(SCHEDULER_WORKER_POST_EVENT,
+						     &pool->flags) &&
+				 !qdf_atomic_test_bit(SCHEDULER_WORKER_PAUSE_EVENT,
+						      &pool->flags)) ||
+				qdf_atomic_test_bit(SCHEDULER_WORKER_SHUTDOWN_EVENT,
+						    &pool->flags));
+
+		if (retWaitStatus == -ERESTARTSYS)
+			QDF_DEBUG_PANIC("Scheduler worker received -ERESTARTSYS");
+
+		scheduler_worker_process_queues(worker);
+	}
+
+	sched_debug("Scheduler worker %d exiting", worker->id);
+	qdf_event_set(&worker->shutdown_event);
+	qdf_exit_thread(QDF_STATUS_SUCCESS);
+
+	return 0;
+}
+
+/**
+ * scheduler_workers_pause() - stop the workers from picking new messages
+ * @sch_ctx: scheduler context
+ *
+ * Waits for the messages being processed by the workers to complete.
+ *
+ * Return: none
+ */
+static void scheduler_workers_pause(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+
+	qdf_event_reset(&pool->idle_event);
+	/* fully ordered, pairs with the busy count of the workers */
+	qdf_atomic_test_and_set_bit(SCHEDULER_WORKER_PAUSE_EVENT, &pool->flags);
+	if (qdf_atomic_read(&pool->busy))
+		qdf_wait_single_event(&pool->idle_event, 0);
+}
+
+/**
+ * scheduler_workers_resume() - let the workers pick messages again
+ * @sch_ctx: scheduler context
+ *
+ * Return: none
+ */
+static void scheduler_workers_resume(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+
+	qdf_atomic_clear_bit(SCHEDULER_WORKER_PAUSE_EVENT, &pool->flags);
+	scheduler_workers_wake(sch_ctx);
+}
+
+void scheduler_workers_wake(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+
+	qdf_atomic_set_bit(SCHEDULER_WORKER_POST_EVENT, &pool->flags);
+	qdf_wake_up_interruptible(&pool->wait_queue);
+}
+
+bool scheduler_workers_busy(struct scheduler_ctx *sch_ctx)
+{
+	int i;
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		if (sch_ctx->worker_pool.workers[i].watchdog_msg_start)
+			return true;
+	}
+
+	return false;
+}
+
+QDF_STATUS scheduler_workers_init(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+	struct scheduler_worker *worker;
+	QDF_STATUS status;
+	int i;
+
+	qdf_mem_zero(pool, sizeof(*pool));
+	qdf_init_waitqueue_head(&pool->wait_queue);
+	qdf_atomic_init(&pool->busy);
+
+	status = qdf_event_create(&pool->idle_event);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		sched_err("Failed to create worker idle event; status:%d",
+			  status);
+		return status;
+	}
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		worker = &pool->workers[i];
+		worker->sched_ctx = sch_ctx;
+		worker->id = i;
+
+		status = qdf_event_create(&worker->start_event);
+		if (QDF_IS_STATUS_ERROR(status))
+			goto fail;
+
+		status = qdf_event_create(&worker->shutdown_event);
+		if (QDF_IS_STATUS_ERROR(status)) {
+			qdf_event_destroy(&worker->start_event);
+			goto fail;
+		}
+	}
+
+	return QDF_STATUS_SUCCESS;
+
+fail:
+	sched_err("Failed to create worker %d events; status:%d", i, status);
+	while (--i >= 0) {
+		worker = &pool->workers[i];
+		qdf_event_destroy(&worker->shutdown_event);
+		qdf_event_destroy(&worker->start_event);
+	}
+	qdf_event_destroy(&pool->idle_event);
+
+	return status;
+}
+
+void scheduler_workers_deinit(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+	int i;
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		qdf_event_destroy(&pool->workers[i].shutdown_event);
+		qdf_event_destroy(&pool->workers[i].start_event);
+	}
+	qdf_event_destroy(&pool->idle_event);
+}
+
+QDF_STATUS scheduler_workers_start(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+	struct scheduler_worker *worker;
+	char name[16];
+	int i;
+
+	pool->flags = 0;
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		worker = &pool->workers[i];
+		worker->watchdog_msg_start = 0;
+		worker->watchdog_last_bite = 0;
+
+		qdf_snprintf(name, sizeof(name), "sched_worker_%d", i);
+		worker->thread = qdf_create_thread(scheduler_worker_thread,
+						   worker, name);
+		if (!worker->thread) {
+			sched_fatal("Failed to create scheduler worker %d", i);
+			scheduler_workers_stop(sch_ctx);
+			return QDF_STATUS_E_RESOURCES;
+		}
+
+		qdf_wake_up_process(worker->thread);
+		qdf_wait_single_event(&worker->start_event, 0);
+	}
+
+	sched_debug("%d scheduler workers started",
+		    SCHEDULER_WORKER_POOL_SIZE);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void scheduler_workers_stop(struct scheduler_ctx *sch_ctx)
+{
+	struct scheduler_worker_pool *pool = &sch_ctx->worker_pool;
+	struct scheduler_worker *worker;
+	int i;
+
+	qdf_atomic_set_bit(SCHEDULER_WORKER_SHUTDOWN_EVENT, &pool->flags);
+	qdf_wake_up_interruptible(&pool->wait_queue);
+
+	for (i = 0; i < SCHEDULER_WORKER_POOL_SIZE; i++) {
+		worker = &pool->workers[i];
+		if (!worker->thread)
+			continue;
+
+		qdf_wait_single_event(&worker->shutdown_event, 0);
+		worker->thread = NULL;
+	}
+}
+#else
+static inline void scheduler_workers_pause(struct scheduler_ctx *sch_ctx)
+{
+}
+
+static inline void scheduler_workers_resume(struct scheduler_ctx *sch_ctx)
+{
+}
+#endif /* WLAN_SCHED_WORKER_POOL */
+
 static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 					    bool *shutdown)
 {
 	int i;
 	QDF_STATUS status;
 	struct scheduler_msg *msg;
+	uint32_t hist_idx;
 
 	if (!sch_ctx) {
 		QDF_DEBUG_PANIC("sch_ctx is null");
@@ -379,6 +831,13 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			break;
 		}
 
+		/* parallel queues are processed by the worker pool */
+		if (sch_ctx->queue_ctx.sch_msg_q[i].affinity !=
+		    SCHEDULER_AFFINITY_SERIAL) {
+			i++;
+			continue;
+		}
+
 		msg = scheduler_mq_get(&sch_ctx->queue_ctx.sch_msg_q[i]);
 		if (!msg) {
 			/* check next queue */
@@ -390,13 +849,14 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			sch_ctx->watchdog_msg_type = msg->type;
 			sch_ctx->watchdog_callback = msg->callback;
 
-			sched_history_start(msg);
-			qdf_timer_start(&sch_ctx->watchdog_timer,
-					SCHEDULER_WATCHDOG_TIMEOUT);
+			hist_idx = sched_history_start(msg,
+						SCHEDULER_AFFINITY_SERIAL);
+			sch_ctx->watchdog_msg_start = qdf_system_ticks();
+			scheduler_watchdog_arm(sch_ctx);
 			status = sch_ctx->queue_ctx.
 					scheduler_msg_process_fn[i](msg);
-			qdf_timer_stop(&sch_ctx->watchdog_timer);
-			sched_history_stop();
+			sch_ctx->watchdog_msg_start = 0;
+			sched_history_stop(hist_idx);
 
 			if (QDF_IS_STATUS_ERROR(status))
 				sched_err("Failed processing Qid[%d] message",
@@ -405,13 +865,15 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			scheduler_core_msg_free(msg);
 		}
 
-		/* start again with highest priority queue at index 0 */
-		i = 0;
+		/* keep draining the batch unless a higher priority msg is due */
+		i = scheduler_mq_next_qidx(sch_ctx, i);
 	}
 
 	/* Check for any Suspend Indication */
 	if (qdf_atomic_test_and_clear_bit(MC_SUSPEND_EVENT_MASK,
 			&sch_ctx->sch_event_flag)) {
+		/* workers must be idle before suspend is acknowledged */
+		scheduler_workers_pause(sch_ctx);
 		qdf_spin_lock(&sch_ctx->sch_thread_lock);
 		qdf_event_reset(&sch_ctx->resume_sch_event);
 		/* controller thread suspend completion callback */
@@ -420,6 +882,7 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 		qdf_spin_unlock(&sch_ctx->sch_thread_lock);
 		/* Wait for resume indication */
 		qdf_wait_single_event(&sch_ctx->resume_sch_event, 0);
+		scheduler_workers_resume(sch_ctx);
 	}
 
 	return;  /* Nothing to process wait on wait queue */
@@ -456,7 +919,12 @@ int scheduler_thread(void *arg)
 		if (retWaitStatus == -ERESTARTSYS)
 			QDF_DEBUG_PANIC("Scheduler received -ERESTARTSYS");
 
-		qdf_atomic_clear_bit(MC_POST_EVENT_MASK, &sch_ctx->sch_event_flag);
+		/*
+		 * Queues are no longer read under a lock, use a fully ordered
+		 * clear so that messages posted before the event are seen.
+		 */
+		qdf_atomic_test_and_clear_bit(MC_POST_EVENT_MASK,
+					      &sch_ctx->sch_event_flag);
 		scheduler_thread_process_queues(sch_ctx, &shutdown);
 	}
 
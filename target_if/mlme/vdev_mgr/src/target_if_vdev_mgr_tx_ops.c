@@ -373,6 +373,37 @@ static QDF_STATUS target_if_vdev_mgr_set_param_send(
 	return status;
 }
 
+static QDF_STATUS target_if_vdev_mgr_set_multiple_param_send(
+					struct wlan_objmgr_vdev *vdev,
+					struct vdev_set_params *params,
+					uint8_t num)
+{
+	struct wmi_unified *wmi_handle;
+	uint8_t i;
+
+	if (!vdev || !params) {
+		mlme_err("Invalid input");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	wmi_handle = target_if_vdev_mgr_wmi_handle_get(vdev);
+	if (!wmi_handle) {
+		mlme_err("Failed to get WMI handle!");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	for (i = 0; i < num; i++) {
+		params[i].param_id =
+			target_if_vdev_mlme_id_2_wmi(params[i].param_id);
+		if (params[i].param_id == wmi_vdev_param_txbf)
+			params[i].param_value =
+				target_if_vdev_mlme_build_txbf_caps(vdev);
+	}
+
+	return wmi_unified_vdev_set_multiple_param_send(wmi_handle, params,
+							num);
+}
+
 static QDF_STATUS target_if_vdev_mgr_create_send(
 					struct wlan_objmgr_vdev *vdev,
 					struct vdev_create_params *param)
@@ -1184,6 +1215,8 @@ target_if_vdev_mgr_register_tx_ops(struct wlan_lmac_if_tx_ops *tx_ops)
 	mlme_tx_ops->beacon_tmpl_send = target_if_vdev_mgr_beacon_tmpl_send;
 	mlme_tx_ops->vdev_set_param_send =
 			target_if_vdev_mgr_set_param_send;
+	mlme_tx_ops->vdev_set_multiple_param_send =
+			target_if_vdev_mgr_set_multiple_param_send;
 	mlme_tx_ops->vdev_set_tx_rx_decap_type =
 			target_if_vdev_set_tx_rx_decap_type;
 	mlme_tx_ops->vdev_sta_ps_param_send =
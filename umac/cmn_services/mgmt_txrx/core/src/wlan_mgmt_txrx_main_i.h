@@ -29,6 +29,10 @@
 #include "wlan_mgmt_txrx_utils_api.h"
 #include "wlan_objmgr_cmn.h"
 #include "qdf_list.h"
+#include "qdf_rcu.h"
+#include "qdf_lock.h"
+#include "qdf_atomic.h"
+#include "qdf_mem.h"
 
 
 #define IEEE80211_FC0_TYPE_MASK             0x0c
@@ -106,14 +110,47 @@ struct mgmt_desc_pool_t {
  * struct mgmt_rx_handler - structure for storing rx cb
  * @comp_id:      component id
  * @rx_cb:        rx callback for the mgmt. frame
- * @next:         pointer to next rx cb structure
+ * @flags:        MGMT_RX_CB_FLAG_* the cb was registered with
  */
 struct mgmt_rx_handler {
 	enum wlan_umac_comp_id comp_id;
 	mgmt_frame_rx_callback rx_cb;
-	struct mgmt_rx_handler *next;
+	uint32_t flags;
 };
 
+/**
+ * struct mgmt_rx_handler_table - rx cbs registered for a mgmt. frame type
+ * @ref:          one reference held while the table is published in the
+ *                psoc context plus one per rx dispatch walking it
+ * @num_handlers: number of entries in @handlers
+ * @handlers:     rx cbs, most recently registered first
+ *
+ * Tables are not resized once published. Registration builds a new table,
+ * publishes it with RCU and drops the reference of the old one after a grace
+ * period, so rx dispatch only needs to take a reference under the RCU read
+ * lock to walk the table. The only in place change is a deregistration which
+ * cannot allocate the new table clearing the rx_cb of its entry, which rx
+ * dispatch then skips and the next registration drops.
+ */
+struct mgmt_rx_handler_table {
+	qdf_atomic_t ref;
+	uint16_t num_handlers;
+	struct mgmt_rx_handler handlers[];
+};
+
+/**
+ * wlan_mgmt_txrx_rx_handler_table_put() - drop a reference on rx cb table
+ * @table: rx cb table
+ *
+ * Return: none
+ */
+static inline void
+wlan_mgmt_txrx_rx_handler_table_put(struct mgmt_rx_handler_table *table)
+{
+	if (qdf_atomic_dec_and_test(&table->ref))
+		qdf_mem_free(table);
+}
+
 /**
  * struct txrx_stats - txrx stats for mgmt frames
  * @pkts_success:       no. of packets successfully txed/rcvd
@@ -171,13 +208,15 @@ struct mgmt_txrx_stats_t {
 /**
  * struct mgmt_txrx_priv_psoc_context - mgmt txrx private psoc context
  * @psoc:                psoc context
- * @mgmt_rx_comp_cb:     array of pointers of mgmt rx cbs
+ * @mgmt_rx_comp_cb:     RCU protected tables of mgmt rx cbs per frame type
  * @mgmt_txrx_psoc_ctx_lock:  mgmt txrx psoc ctx lock
+ * @mgmt_rx_cb_lock:     serializes updates of @mgmt_rx_comp_cb
  */
 struct mgmt_txrx_priv_psoc_context {
 	struct wlan_objmgr_psoc *psoc;
-	struct mgmt_rx_handler *mgmt_rx_comp_cb[MGMT_MAX_FRAME_TYPE];
+	struct mgmt_rx_handler_table *mgmt_rx_comp_cb[MGMT_MAX_FRAME_TYPE];
 	qdf_spinlock_t mgmt_txrx_psoc_ctx_lock;
+	qdf_mutex_t mgmt_rx_cb_lock;
 };
 
 /**
@@ -910,6 +910,14 @@ QDF_STATUS wlan_mgmt_txrx_fd_action_frame_tx(struct wlan_objmgr_vdev *vdev,
 					     enum wlan_umac_comp_id comp_id);
 #endif /* WLAN_SUPPORT_FILS */
 
+/*
+ * MGMT_RX_CB_FLAG_READ_ONLY: the rx cb neither modifies the frame nor the
+ * nbuf (data pointer, length, headroom), so the frame may be shared with
+ * other rx cbs. The cb still owns a reference on the nbuf which it releases
+ * with qdf_nbuf_free() as usual.
+ */
+#define MGMT_RX_CB_FLAG_READ_ONLY	(1 << 0)
+
 /**
  * wlan_mgmt_txrx_register_rx_cb() - registers the rx cb for mgmt. frames
  * @psoc: psoc context
@@ -928,6 +936,26 @@ QDF_STATUS wlan_mgmt_txrx_register_rx_cb(
 			struct mgmt_txrx_mgmt_frame_cb_info *frm_cb_info,
 			uint8_t num_entries);
 
+/**
+ * wlan_mgmt_txrx_register_rx_cb_flags() - registers the rx cb for mgmt. frames
+ * @psoc: psoc context
+ * @comp_id: umac component id
+ * @frm_cb_info: pointer to array of structure containing frm type and callback
+ * @num_entries: num of frames for which cb to be registered
+ * @flags: MGMT_RX_CB_FLAG_* applying to all the callbacks
+ *
+ * Same as wlan_mgmt_txrx_register_rx_cb(). Callbacks registered with
+ * MGMT_RX_CB_FLAG_READ_ONLY are handed a reference on the received nbuf
+ * instead of a clone of it.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+QDF_STATUS wlan_mgmt_txrx_register_rx_cb_flags(
+			struct wlan_objmgr_psoc *psoc,
+			enum wlan_umac_comp_id comp_id,
+			struct mgmt_txrx_mgmt_frame_cb_info *frm_cb_info,
+			uint8_t num_entries, uint32_t flags);
+
 /**
  * wlan_mgmt_txrx_vdev_drain() - Function to drain all mgmt packets
  * specific to a vdev
@@ -909,46 +909,30 @@ mgmt_txrx_get_frm_type(uint8_t mgmt_subtype, uint8_t *mpdu_data_ptr)
 }
 
 /**
- * wlan_mgmt_txrx_rx_handler_list_copy() - copies rx handler list
- * @rx_handler: pointer to rx handler list
- * @rx_handler_head: pointer to head of the copies list
- * @rx_handler_tail: pointer to tail of the copies list
+ * wlan_mgmt_txrx_rx_handler_table_get() - get the rx cb table of a frm type
+ * @mgmt_txrx_psoc_ctx: mgmt txrx context
+ * @frm_type: mgmt. frame type
  *
- * This function copies the rx handler linked list into a local
- * linked list.
+ * The table stays valid until wlan_mgmt_txrx_rx_handler_table_put(), even
+ * if the cbs are deregistered meanwhile.
  *
- * Return: QDF_STATUS_SUCCESS in case of success
+ * Return: referenced rx cb table or NULL if no cb is registered
  */
-static QDF_STATUS wlan_mgmt_txrx_rx_handler_list_copy(
-			struct mgmt_rx_handler *rx_handler,
-			struct mgmt_rx_handler **rx_handler_head,
-			struct mgmt_rx_handler **rx_handler_tail)
+static struct mgmt_rx_handler_table *wlan_mgmt_txrx_rx_handler_table_get(
+		struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx,
+		enum mgmt_frame_type frm_type)
 {
-	struct mgmt_rx_handler *rx_handler_node;
-
-	while (rx_handler) {
-		rx_handler_node =
-				qdf_mem_malloc_atomic(sizeof(*rx_handler_node));
-		if (!rx_handler_node) {
-			mgmt_txrx_err_rl("Couldn't allocate memory for rx handler node");
-			return QDF_STATUS_E_NOMEM;
-		}
-
-		rx_handler_node->comp_id = rx_handler->comp_id;
-		rx_handler_node->rx_cb = rx_handler->rx_cb;
-		rx_handler_node->next = NULL;
+	struct mgmt_rx_handler_table *table;
 
-		if (!(*rx_handler_head)) {
-			*rx_handler_head = rx_handler_node;
-			*rx_handler_tail = *rx_handler_head;
-		} else {
-			(*rx_handler_tail)->next = rx_handler_node;
-			*rx_handler_tail = (*rx_handler_tail)->next;
-		}
-		rx_handler = rx_handler->next;
-	}
+	qdf_rcu_read_lock();
+	table = qdf_rcu_dereference(
+			mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type]);
+	/* the psoc context reference is only dropped after a grace period */
+	if (table)
+		qdf_atomic_inc(&table->ref);
+	qdf_rcu_read_unlock();
 
-	return QDF_STATUS_SUCCESS;
+	return table;
 }
 
 static bool
@@ -974,7 +958,12 @@ QDF_STATUS tgt_mgmt_txrx_rx_frame_handler(
 	uint8_t *mac_addr, *mpdu_data_ptr;
 	enum mgmt_frame_type frm_type;
 	struct mgmt_rx_handler *rx_handler;
-	struct mgmt_rx_handler *rx_handler_head = NULL, *rx_handler_tail = NULL;
+	mgmt_frame_rx_callback rx_cb;
+	struct mgmt_rx_handler_table *tables[2];
+	uint32_t num_handlers = 0, num_shared = 0, num_cloned = 0;
+	uint8_t t;
+	uint16_t i;
+	bool buf_given = false;
 	u_int8_t *data, *ivp = NULL;
 	uint16_t buflen;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
@@ -1088,37 +1077,34 @@ QDF_STATUS tgt_mgmt_txrx_rx_frame_handler(
 			wlan_objmgr_psoc_get_comp_private_obj(psoc,
 				WLAN_UMAC_COMP_MGMT_TXRX);
 
-	qdf_spin_lock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
-	rx_handler = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
-	if (rx_handler) {
-		status = wlan_mgmt_txrx_rx_handler_list_copy(rx_handler,
-				&rx_handler_head, &rx_handler_tail);
-		if (status != QDF_STATUS_SUCCESS) {
-			qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
-			qdf_nbuf_free(buf);
-			goto rx_handler_mem_free;
-		}
-	}
+	tables[0] = wlan_mgmt_txrx_rx_handler_table_get(mgmt_txrx_psoc_ctx,
+							frm_type);
+	tables[1] = wlan_mgmt_txrx_rx_handler_table_get(mgmt_txrx_psoc_ctx,
+							MGMT_FRAME_TYPE_ALL);
+
+	for (t = 0; t < QDF_ARRAY_SIZE(tables); t++) {
+		if (!tables[t])
+			continue;
+
+		for (i = 0; i < tables[t]->num_handlers; i++) {
+			rx_handler = &tables[t]->handlers[i];
+			/* tombstoned by a deregistration */
+			if (!rx_handler->rx_cb)
+				continue;
 
-	rx_handler = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[MGMT_FRAME_TYPE_ALL];
-	if (rx_handler) {
-		status = wlan_mgmt_txrx_rx_handler_list_copy(rx_handler,
-				&rx_handler_head, &rx_handler_tail);
-		if (status != QDF_STATUS_SUCCESS) {
-			qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
-			qdf_nbuf_free(buf);
-			goto rx_handler_mem_free;
+			if (rx_handler->flags & MGMT_RX_CB_FLAG_READ_ONLY)
+				num_shared++;
+			num_handlers++;
 		}
 	}
 
-	if (!rx_handler_head) {
-		qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
+	if (!num_handlers) {
 		mgmt_txrx_debug("No rx callback registered for frm_type: %d",
 				frm_type);
 		qdf_nbuf_free(buf);
-		return QDF_STATUS_E_FAILURE;
+		status = QDF_STATUS_E_FAILURE;
+		goto rx_handler_table_put;
 	}
-	qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
 
 	mac_addr = (uint8_t *)wh->i_addr2;
 	/*
@@ -1141,30 +1127,55 @@ QDF_STATUS tgt_mgmt_txrx_rx_frame_handler(
 					    mac_addr, WLAN_MGMT_SB_ID);
 	}
 
-	rx_handler = rx_handler_head;
-	while (rx_handler->next) {
-		copy_buf = qdf_nbuf_clone(buf);
-
-		if (!copy_buf) {
-			rx_handler = rx_handler->next;
+	/*
+	 * Read only cbs share buf, each one with its own reference. The other
+	 * cbs get a clone, except the last one which gets buf itself when no
+	 * cb shares it. A cb tombstoned since it was counted is skipped, buf
+	 * is then freed below.
+	 */
+	for (t = 0; t < QDF_ARRAY_SIZE(tables); t++) {
+		if (!tables[t])
 			continue;
-		}
 
-		rx_handler->rx_cb(psoc, peer, copy_buf,
-					mgmt_rx_params, frm_type);
-		rx_handler = rx_handler->next;
+		for (i = 0; i < tables[t]->num_handlers; i++) {
+			rx_handler = &tables[t]->handlers[i];
+			rx_cb = qdf_rcu_dereference(rx_handler->rx_cb);
+			if (!rx_cb)
+				continue;
+
+			if (rx_handler->flags & MGMT_RX_CB_FLAG_READ_ONLY) {
+				qdf_nbuf_ref(buf);
+				rx_cb(psoc, peer, buf, mgmt_rx_params,
+				      frm_type);
+				continue;
+			}
+
+			num_cloned++;
+			if (!num_shared && num_cloned == num_handlers) {
+				buf_given = true;
+				rx_cb(psoc, peer, buf, mgmt_rx_params,
+				      frm_type);
+				continue;
+			}
+
+			copy_buf = qdf_nbuf_clone(buf);
+			if (!copy_buf)
+				continue;
+
+			rx_cb(psoc, peer, copy_buf, mgmt_rx_params, frm_type);
+		}
 	}
-	rx_handler->rx_cb(psoc, peer, buf,
-				mgmt_rx_params, frm_type);
+
+	if (!buf_given)
+		qdf_nbuf_free(buf);
 
 	if (peer)
 		wlan_objmgr_peer_release_ref(peer, WLAN_MGMT_SB_ID);
 
-rx_handler_mem_free:
-	while (rx_handler_head) {
-		rx_handler = rx_handler_head;
-		rx_handler_head = rx_handler_head->next;
-		qdf_mem_free(rx_handler);
+rx_handler_table_put:
+	for (t = 0; t < QDF_ARRAY_SIZE(tables); t++) {
+		if (tables[t])
+			wlan_mgmt_txrx_rx_handler_table_put(tables[t]);
 	}
 
 	return status;
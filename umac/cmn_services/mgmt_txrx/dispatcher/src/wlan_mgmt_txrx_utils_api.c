@@ -65,6 +65,7 @@ static QDF_STATUS wlan_mgmt_txrx_psoc_obj_create_notification(
 	mgmt_txrx_psoc_ctx->psoc = psoc;
 
 	qdf_spinlock_create(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
+	qdf_mutex_create(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 
 	if (wlan_objmgr_psoc_component_obj_attach(psoc,
 				WLAN_UMAC_COMP_MGMT_TXRX,
@@ -81,6 +82,7 @@ static QDF_STATUS wlan_mgmt_txrx_psoc_obj_create_notification(
 	return QDF_STATUS_SUCCESS;
 
 err_psoc_attach:
+	qdf_mutex_destroy(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 	qdf_spinlock_destroy(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
 	qdf_mem_free(mgmt_txrx_psoc_ctx);
 err_return:
@@ -103,6 +105,8 @@ static QDF_STATUS wlan_mgmt_txrx_psoc_obj_destroy_notification(
 			void *arg)
 {
 	struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx;
+	struct mgmt_rx_handler_table *table;
+	uint8_t i;
 
 	if (!psoc) {
 		mgmt_txrx_err("psoc context passed is NULL");
@@ -125,6 +129,14 @@ static QDF_STATUS wlan_mgmt_txrx_psoc_obj_destroy_notification(
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	/* no rx dispatch can be walking the tables once detached */
+	for (i = 0; i < MGMT_MAX_FRAME_TYPE; i++) {
+		table = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[i];
+		if (table)
+			wlan_mgmt_txrx_rx_handler_table_put(table);
+	}
+
+	qdf_mutex_destroy(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 	qdf_spinlock_destroy(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
 	qdf_mem_free(mgmt_txrx_psoc_ctx);
 
@@ -553,15 +565,77 @@ wlan_mgmt_txrx_fd_action_frame_tx(struct wlan_objmgr_vdev *vdev,
 }
 #endif /* WLAN_SUPPORT_FILS */
 
+/**
+ * wlan_mgmt_txrx_rx_handler_table_publish() - replace rx cb table of frm type
+ * @mgmt_txrx_psoc_ctx: mgmt txrx context
+ * @frm_type: mgmt. frame type of the table
+ * @table: new table, NULL if no cb is left for @frm_type
+ *
+ * Must be called with mgmt_rx_cb_lock held. The old table may still be
+ * looked up by rx dispatches until a grace period elapsed, so it is handed
+ * back to be released by wlan_mgmt_txrx_rx_handler_tables_release().
+ *
+ * Return: old table of @frm_type, NULL if there was none
+ */
+static struct mgmt_rx_handler_table *wlan_mgmt_txrx_rx_handler_table_publish(
+		struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx,
+		enum mgmt_frame_type frm_type,
+		struct mgmt_rx_handler_table *table)
+{
+	struct mgmt_rx_handler_table *old_table;
+
+	old_table = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
+	qdf_rcu_assign_pointer(mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type],
+			       table);
+
+	return old_table;
+}
+
+/**
+ * wlan_mgmt_txrx_rx_handler_tables_release() - release replaced rx cb tables
+ * @tables: tables replaced by wlan_mgmt_txrx_rx_handler_table_publish()
+ * @num_tables: number of entries in @tables, NULL entries are skipped
+ *
+ * Waits once for the rx dispatches which may have looked up any of the
+ * tables to take their own reference, then drops the reference of the psoc
+ * context on each of them.
+ *
+ * Return: none
+ */
+static void wlan_mgmt_txrx_rx_handler_tables_release(
+		struct mgmt_rx_handler_table **tables,
+		uint8_t num_tables)
+{
+	bool synced = false;
+	uint8_t i;
+
+	for (i = 0; i < num_tables; i++) {
+		if (!tables[i])
+			continue;
+
+		if (!synced) {
+			qdf_synchronize_rcu();
+			synced = true;
+		}
+
+		wlan_mgmt_txrx_rx_handler_table_put(tables[i]);
+		tables[i] = NULL;
+	}
+}
+
 /**
  * wlan_mgmt_txrx_create_rx_handler() - creates rx handler node for umac comp.
  * @mgmt_txrx_psoc_ctx: mgmt txrx context
  * @mgmt_rx_cb: mgmt rx callback to be registered
  * @comp_id: umac component id
  * @frm_type: mgmt. frame for which cb to be registered.
+ * @flags: MGMT_RX_CB_FLAG_* of the callback
+ * @replaced: set to the table replaced for @frm_type, to be released with
+ *	      wlan_mgmt_txrx_rx_handler_tables_release()
  *
  * This function creates rx handler node for frame type and
- * umac component passed in the func.
+ * umac component passed in the func. Entries tombstoned by
+ * wlan_mgmt_txrx_delete_rx_handler() are dropped from the new table.
  *
  * Return: QDF_STATUS_SUCCESS - in case of success
  */
@@ -569,21 +643,49 @@ static QDF_STATUS wlan_mgmt_txrx_create_rx_handler(
 				struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx,
 				mgmt_frame_rx_callback mgmt_rx_cb,
 				enum wlan_umac_comp_id comp_id,
-				enum mgmt_frame_type frm_type)
+				enum mgmt_frame_type frm_type,
+				uint32_t flags,
+				struct mgmt_rx_handler_table **replaced)
 {
+	struct mgmt_rx_handler_table *table, *old_table;
 	struct mgmt_rx_handler *rx_handler;
+	uint16_t i, num_handlers = 0;
+
+	qdf_mutex_acquire(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
+	old_table = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
+	if (old_table) {
+		for (i = 0; i < old_table->num_handlers; i++) {
+			if (old_table->handlers[i].rx_cb)
+				num_handlers++;
+		}
+	}
 
-	rx_handler = qdf_mem_malloc(sizeof(*rx_handler));
-	if (!rx_handler)
+	table = qdf_mem_malloc(sizeof(*table) +
+			       (num_handlers + 1) * sizeof(*rx_handler));
+	if (!table) {
+		qdf_mutex_release(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 		return QDF_STATUS_E_NOMEM;
+	}
 
+	qdf_atomic_init(&table->ref);
+	qdf_atomic_inc(&table->ref);
+	table->num_handlers = num_handlers + 1;
+
+	rx_handler = &table->handlers[0];
 	rx_handler->comp_id = comp_id;
 	rx_handler->rx_cb = mgmt_rx_cb;
+	rx_handler->flags = flags;
 
-	qdf_spin_lock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
-	rx_handler->next = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
-	mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type] = rx_handler;
-	qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
+	for (i = 0; num_handlers && i < old_table->num_handlers; i++) {
+		if (!old_table->handlers[i].rx_cb)
+			continue;
+
+		*(++rx_handler) = old_table->handlers[i];
+	}
+
+	*replaced = wlan_mgmt_txrx_rx_handler_table_publish(mgmt_txrx_psoc_ctx,
+							    frm_type, table);
+	qdf_mutex_release(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 
 	mgmt_txrx_debug("Callback registered for comp_id: %d, frm_type: %d",
 			comp_id, frm_type);
@@ -596,9 +698,13 @@ static QDF_STATUS wlan_mgmt_txrx_create_rx_handler(
  * @mgmt_rx_cb: mgmt rx callback to be deregistered
  * @comp_id: umac component id
  * @frm_type: mgmt. frame for which cb to be registered.
+ * @replaced: set to the table replaced for @frm_type, to be released with
+ *	      wlan_mgmt_txrx_rx_handler_tables_release()
  *
  * This function deletes rx handler node for frame type and
- * umac component passed in the func.
+ * umac component passed in the func. Deregistration cannot fail once the
+ * cb is found: if the smaller table cannot be allocated, the entry is
+ * tombstoned in place so that rx dispatch skips it.
  *
  * Return: QDF_STATUS_SUCCESS - in case of success
  */
@@ -606,39 +712,63 @@ static QDF_STATUS wlan_mgmt_txrx_delete_rx_handler(
 		struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx,
 		mgmt_frame_rx_callback mgmt_rx_cb,
 		enum wlan_umac_comp_id comp_id,
-		enum mgmt_frame_type frm_type)
+		enum mgmt_frame_type frm_type,
+		struct mgmt_rx_handler_table **replaced)
 {
-	struct mgmt_rx_handler *rx_handler = NULL, *rx_handler_prev = NULL;
-	bool delete = false;
+	struct mgmt_rx_handler_table *table = NULL, *old_table;
+	struct mgmt_rx_handler *rx_handler;
+	uint16_t i, j, num_handlers = 0, num_left = 0;
 
-	qdf_spin_lock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
-	rx_handler = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
-	while (rx_handler) {
+	qdf_mutex_acquire(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
+	old_table = mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type];
+	if (old_table)
+		num_handlers = old_table->num_handlers;
+
+	for (i = 0; i < num_handlers; i++) {
+		rx_handler = &old_table->handlers[i];
 		if (rx_handler->comp_id == comp_id &&
-				rx_handler->rx_cb == mgmt_rx_cb) {
-			if (rx_handler_prev)
-				rx_handler_prev->next =
-					rx_handler->next;
-			else
-				mgmt_txrx_psoc_ctx->mgmt_rx_comp_cb[frm_type] =
-					rx_handler->next;
-
-			qdf_mem_free(rx_handler);
-			delete = true;
+		    rx_handler->rx_cb == mgmt_rx_cb)
 			break;
-		}
-
-		rx_handler_prev = rx_handler;
-		rx_handler = rx_handler->next;
 	}
-	qdf_spin_unlock_bh(&mgmt_txrx_psoc_ctx->mgmt_txrx_psoc_ctx_lock);
 
-	if (!delete) {
+	if (i == num_handlers) {
+		qdf_mutex_release(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
 		mgmt_txrx_err("No callback registered for comp_id: %d, frm_type: %d",
 				comp_id, frm_type);
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	for (j = 0; j < num_handlers; j++) {
+		if (j != i && old_table->handlers[j].rx_cb)
+			num_left++;
+	}
+
+	if (num_left) {
+		table = qdf_mem_malloc(sizeof(*table) +
+				       num_left * sizeof(*rx_handler));
+		if (!table) {
+			/* pairs with the cb load of the rx dispatch */
+			qdf_rcu_assign_pointer(old_table->handlers[i].rx_cb,
+					       NULL);
+			goto release;
+		}
+
+		qdf_atomic_init(&table->ref);
+		qdf_atomic_inc(&table->ref);
+		table->num_handlers = num_left;
+		rx_handler = table->handlers;
+		for (j = 0; j < num_handlers; j++) {
+			if (j != i && old_table->handlers[j].rx_cb)
+				*rx_handler++ = old_table->handlers[j];
+		}
+	}
+
+	*replaced = wlan_mgmt_txrx_rx_handler_table_publish(mgmt_txrx_psoc_ctx,
+							    frm_type, table);
+
+release:
+	qdf_mutex_release(&mgmt_txrx_psoc_ctx->mgmt_rx_cb_lock);
+
 	mgmt_txrx_debug("Callback deregistered for comp_id: %d, frm_type: %d",
 			comp_id, frm_type);
 	return QDF_STATUS_SUCCESS;
@@ -649,8 +779,19 @@ QDF_STATUS wlan_mgmt_txrx_register_rx_cb(
 			enum wlan_umac_comp_id comp_id,
 			struct mgmt_txrx_mgmt_frame_cb_info *frm_cb_info,
 			uint8_t num_entries)
+{
+	return wlan_mgmt_txrx_register_rx_cb_flags(psoc, comp_id, frm_cb_info,
+						   num_entries, 0);
+}
+
+QDF_STATUS wlan_mgmt_txrx_register_rx_cb_flags(
+			struct wlan_objmgr_psoc *psoc,
+			enum wlan_umac_comp_id comp_id,
+			struct mgmt_txrx_mgmt_frame_cb_info *frm_cb_info,
+			uint8_t num_entries, uint32_t flags)
 {
 	struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx;
+	struct mgmt_rx_handler_table *replaced[MGMT_MAX_FRAME_TYPE] = {NULL};
 	QDF_STATUS status;
 	uint8_t i, j;
 
@@ -686,18 +827,23 @@ QDF_STATUS wlan_mgmt_txrx_register_rx_cb(
 	for (i = 0; i < num_entries; i++) {
 		status = wlan_mgmt_txrx_create_rx_handler(mgmt_txrx_psoc_ctx,
 				frm_cb_info[i].mgmt_rx_cb, comp_id,
-				frm_cb_info[i].frm_type);
+				frm_cb_info[i].frm_type, flags, &replaced[i]);
 		if (status != QDF_STATUS_SUCCESS) {
+			wlan_mgmt_txrx_rx_handler_tables_release(replaced, i);
 			for (j = 0; j < i; j++) {
 				wlan_mgmt_txrx_delete_rx_handler(
 					mgmt_txrx_psoc_ctx,
 					frm_cb_info[j].mgmt_rx_cb,
-					comp_id, frm_cb_info[j].frm_type);
+					comp_id, frm_cb_info[j].frm_type,
+					&replaced[j]);
 			}
+			wlan_mgmt_txrx_rx_handler_tables_release(replaced, i);
 			return status;
 		}
 	}
 
+	wlan_mgmt_txrx_rx_handler_tables_release(replaced, num_entries);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -708,6 +854,7 @@ QDF_STATUS wlan_mgmt_txrx_deregister_rx_cb(
 			uint8_t num_entries)
 {
 	struct mgmt_txrx_priv_psoc_context *mgmt_txrx_psoc_ctx;
+	struct mgmt_rx_handler_table *replaced[MGMT_MAX_FRAME_TYPE] = {NULL};
 	uint8_t i;
 
 	if (!psoc) {
@@ -742,9 +889,11 @@ QDF_STATUS wlan_mgmt_txrx_deregister_rx_cb(
 	for (i = 0; i < num_entries; i++) {
 		wlan_mgmt_txrx_delete_rx_handler(mgmt_txrx_psoc_ctx,
 				frm_cb_info[i].mgmt_rx_cb, comp_id,
-				frm_cb_info[i].frm_type);
+				frm_cb_info[i].frm_type, &replaced[i]);
 	}
 
+	wlan_mgmt_txrx_rx_handler_tables_release(replaced, num_entries);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -240,6 +240,7 @@ enum wlan_mlme_cfg_id;
  * @vdev_stop_send: function to send vdev stop
  * @vdev_down_send: function to send vdev down
  * @vdev_set_param_send: function to send vdev parameter
+ * @vdev_set_multiple_param_send: function to send several vdev parameters
  * @vdev_set_tx_rx_decap_type: function to send vdev tx rx cap/decap type
  * @vdev_set_nac_rssi_send: function to send nac rssi
  * @vdev_set_neighbour_rx_cmd_send: function to send vdev neighbour rx cmd
@@ -279,6 +280,10 @@ struct wlan_lmac_if_mlme_tx_ops {
 				     struct vdev_down_params *param);
 	QDF_STATUS (*vdev_set_param_send)(struct wlan_objmgr_vdev *vdev,
 					  struct vdev_set_params *param);
+	QDF_STATUS (*vdev_set_multiple_param_send)(
+					struct wlan_objmgr_vdev *vdev,
+					struct vdev_set_params *params,
+					uint8_t num);
 	QDF_STATUS (*vdev_set_tx_rx_decap_type)(struct wlan_objmgr_vdev *vdev,
 						enum wlan_mlme_cfg_id param_id,
 						uint32_t value);
@@ -106,10 +106,10 @@ QDF_STATUS tgt_vdev_mgr_create_send(
 QDF_STATUS tgt_vdev_mgr_create_complete(struct vdev_mlme_obj *vdev_mlme)
 {
 	struct wlan_objmgr_vdev *vdev;
-	struct vdev_set_params param = {0};
+	struct vdev_set_params param[3] = {0};
 	struct wlan_lmac_if_mlme_tx_ops *txops;
 	struct vdev_mlme_inactivity_params *inactivity;
-	uint8_t vdev_id;
+	uint8_t vdev_id, i;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
 	vdev = vdev_mlme->vdev;
@@ -122,31 +122,38 @@ QDF_STATUS tgt_vdev_mgr_create_complete(struct vdev_mlme_obj *vdev_mlme)
 
 	inactivity = &vdev_mlme->mgmt.inactivity_params;
 
-	param.vdev_id = vdev_id;
-
-	param.param_value =
+	param[0].param_value =
 		inactivity->keepalive_min_idle_inactive_time_secs;
-	param.param_id = WLAN_MLME_CFG_MIN_IDLE_INACTIVE_TIME;
-	status = txops->vdev_set_param_send(vdev, &param);
-	if (QDF_IS_STATUS_ERROR(status))
-		mlme_err("VDEV_%d: Failed to set min idle inactive time!",
-			 vdev_id);
-
-	param.param_value =
+	param[0].param_id = WLAN_MLME_CFG_MIN_IDLE_INACTIVE_TIME;
+	param[1].param_value =
 		inactivity->keepalive_max_idle_inactive_time_secs;
-	param.param_id = WLAN_MLME_CFG_MAX_IDLE_INACTIVE_TIME;
-	status = txops->vdev_set_param_send(vdev, &param);
-	if (QDF_IS_STATUS_ERROR(status))
-		mlme_err("VDEV_%d: Failed to set max idle inactive time!",
-			 vdev_id);
-
-	param.param_value =
+	param[1].param_id = WLAN_MLME_CFG_MAX_IDLE_INACTIVE_TIME;
+	param[2].param_value =
 		inactivity->keepalive_max_unresponsive_time_secs;
-	param.param_id = WLAN_MLME_CFG_MAX_UNRESPONSIVE_INACTIVE_TIME;
-	status = txops->vdev_set_param_send(vdev, &param);
-	if (QDF_IS_STATUS_ERROR(status))
-		mlme_err("VDEV_%d: Failed to set max unresponse inactive time!",
-			 vdev_id);
+	param[2].param_id = WLAN_MLME_CFG_MAX_UNRESPONSIVE_INACTIVE_TIME;
+	for (i = 0; i < QDF_ARRAY_SIZE(param); i++)
+		param[i].vdev_id = vdev_id;
+
+	/*
+	 * the inactivity params go to the target as one command batch; the
+	 * batch send falls back to per-param commands on failure, so every
+	 * param still gets its own attempt
+	 */
+	if (txops->vdev_set_multiple_param_send) {
+		status = txops->vdev_set_multiple_param_send(
+					vdev, param, QDF_ARRAY_SIZE(param));
+		if (QDF_IS_STATUS_ERROR(status))
+			mlme_err("VDEV_%d: Failed to set inactivity params!",
+				 vdev_id);
+		return status;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(param); i++) {
+		status = txops->vdev_set_param_send(vdev, &param[i]);
+		if (QDF_IS_STATUS_ERROR(status))
+			mlme_err("VDEV_%d: Failed to set inactivity param %d!",
+				 vdev_id, param[i].param_id);
+	}
 
 	return status;
 }
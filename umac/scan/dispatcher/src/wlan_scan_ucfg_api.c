@@ -1466,6 +1466,16 @@ ucfg_scan_get_pdev_status(struct wlan_objmgr_pdev *pdev)
 	return get_scan_status_from_serialization_status(status);
 }
 
+/*
+ * Beacons and probe responses are only parsed into the scan cache, unless
+ * the SSID of hidden APs on DFS channels is filled in the frame itself.
+ */
+#ifdef WLAN_DFS_CHAN_HIDDEN_SSID
+#define SCAN_BCN_PROBE_RX_CB_FLAGS 0
+#else
+#define SCAN_BCN_PROBE_RX_CB_FLAGS MGMT_RX_CB_FLAG_READ_ONLY
+#endif
+
 static void
 ucfg_scan_register_unregister_bcn_cb(struct wlan_objmgr_psoc *psoc,
 	bool enable)
@@ -1479,8 +1489,9 @@ ucfg_scan_register_unregister_bcn_cb(struct wlan_objmgr_psoc *psoc,
 	cb_info[1].mgmt_rx_cb = tgt_scan_bcn_probe_rx_callback;
 
 	if (enable)
-		status = wlan_mgmt_txrx_register_rx_cb(psoc,
-					 WLAN_UMAC_COMP_SCAN, cb_info, 2);
+		status = wlan_mgmt_txrx_register_rx_cb_flags(psoc,
+					 WLAN_UMAC_COMP_SCAN, cb_info, 2,
+					 SCAN_BCN_PROBE_RX_CB_FLAGS);
 	else
 		status = wlan_mgmt_txrx_deregister_rx_cb(psoc,
 					 WLAN_UMAC_COMP_SCAN, cb_info, 2);
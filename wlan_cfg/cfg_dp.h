@@ -346,6 +346,17 @@
 #define WLAN_CFG_PKTLOG_MIN_BUFFER_SIZE 1
 #define WLAN_CFG_PKTLOG_MAX_BUFFER_SIZE 10
 
+#ifndef WLAN_CFG_RX_PREFETCH_DIST
+#define WLAN_CFG_RX_PREFETCH_DIST 4
+#endif
+#define WLAN_CFG_RX_PREFETCH_DIST_MIN 0
+#define WLAN_CFG_RX_PREFETCH_DIST_MAX 16
+
+#define WLAN_CFG_INTR_MOD_TIMER_MIN 8
+#define WLAN_CFG_INTR_MOD_TIMER_MAX 256
+#define WLAN_CFG_INTR_MOD_BATCH_MIN 1
+#define WLAN_CFG_INTR_MOD_BATCH_MAX 64
+
 /* DP INI Declerations */
 #define CFG_DP_HTT_PACKET_TYPE \
 		CFG_INI_UINT("dp_htt_packet_type", \
@@ -807,6 +818,175 @@
 	CFG_INI_BOOL("dp_rx_fisa_enable", false, \
 		     "Enable/Disable DP Rx FISA")
 
+/*
+ * <ini>
+ * dp_rx_prefetch_dist - Rx reap loop prefetch distance
+ * @Min: 0
+ * @Max: 16
+ * @Default: 4
+ *
+ * This ini sets how many REO destination ring entries ahead of the one
+ * being reaped are prefetched. The SW Rx descriptor is prefetched at half
+ * that distance and the nbuf of the next entry is always prefetched.
+ * 0 disables Rx reap prefetching.
+ *
+ * Related: None
+ *
+ * Supported Feature: Rx reap prefetch (QCA_DP_RX_REAP_PREFETCH)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_PREFETCH_DIST \
+		CFG_INI_UINT("dp_rx_prefetch_dist", \
+		WLAN_CFG_RX_PREFETCH_DIST_MIN, \
+		WLAN_CFG_RX_PREFETCH_DIST_MAX, \
+		WLAN_CFG_RX_PREFETCH_DIST, \
+		CFG_VALUE_OR_DEFAULT, "DP Rx reap prefetch distance")
+
+/*
+ * <ini>
+ * dp_rx_partial_inv_enable - Sync only the received bytes of Rx buffers
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * When set, the batched Rx buffer unmap makes only msdu_len plus the Rx
+ * TLVs coherent for the CPU instead of the whole Rx buffer.
+ *
+ * Related: None
+ *
+ * Supported Feature: Rx batched unmap (QCA_DP_RX_BATCH_UNMAP)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_PARTIAL_INV_ENABLE \
+	CFG_INI_BOOL("dp_rx_partial_inv_enable", false, \
+		     "Enable/Disable DP Rx partial buffer invalidation")
+
+/*
+ * <ini>
+ * dp_intr_mod_enable - Enable adaptive DP ring interrupt moderation
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * When set, the interrupt timer and batch thresholds of the REO
+ * destination and Tx completion rings are retuned per interrupt context
+ * from the work done per poll, within the dp_intr_mod_* bounds.
+ *
+ * Related: dp_intr_mod_timer_min, dp_intr_mod_timer_max,
+ *	    dp_intr_mod_batch_min, dp_intr_mod_batch_max
+ *
+ * Supported Feature: DP interrupt moderation (DP_INTR_ADAPTIVE_MODERATION)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_ENABLE \
+	CFG_INI_BOOL("dp_intr_mod_enable", false, \
+		     "Enable/Disable adaptive DP interrupt moderation")
+
+/*
+ * <ini>
+ * dp_intr_mod_timer_min - Lowest interrupt timer threshold in us
+ * @Min: 8
+ * @Max: 500
+ * @Default: 8
+ *
+ * Timer threshold of the lowest latency moderation profile.
+ *
+ * Related: dp_intr_mod_enable
+ *
+ * Supported Feature: DP interrupt moderation (DP_INTR_ADAPTIVE_MODERATION)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_TIMER_MIN \
+		CFG_INI_UINT("dp_intr_mod_timer_min", \
+		WLAN_CFG_INT_TIMER_THRESHOLD_RX_MIN, \
+		WLAN_CFG_INT_TIMER_THRESHOLD_RX_MAX, \
+		WLAN_CFG_INTR_MOD_TIMER_MIN, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation min timer")
+
+/*
+ * <ini>
+ * dp_intr_mod_timer_max - Highest interrupt timer threshold in us
+ * @Min: 8
+ * @Max: 500
+ * @Default: 256
+ *
+ * Timer threshold of the highest throughput moderation profile.
+ *
+ * Related: dp_intr_mod_enable
+ *
+ * Supported Feature: DP interrupt moderation (DP_INTR_ADAPTIVE_MODERATION)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_TIMER_MAX \
+		CFG_INI_UINT("dp_intr_mod_timer_max", \
+		WLAN_CFG_INT_TIMER_THRESHOLD_RX_MIN, \
+		WLAN_CFG_INT_TIMER_THRESHOLD_RX_MAX, \
+		WLAN_CFG_INTR_MOD_TIMER_MAX, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation max timer")
+
+/*
+ * <ini>
+ * dp_intr_mod_batch_min - Lowest interrupt batch threshold in entries
+ * @Min: 1
+ * @Max: 128
+ * @Default: 1
+ *
+ * Batch counter threshold of the lowest latency moderation profile.
+ *
+ * Related: dp_intr_mod_enable
+ *
+ * Supported Feature: DP interrupt moderation (DP_INTR_ADAPTIVE_MODERATION)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_BATCH_MIN \
+		CFG_INI_UINT("dp_intr_mod_batch_min", \
+		WLAN_CFG_INT_BATCH_THRESHOLD_RX_MIN, \
+		WLAN_CFG_INT_BATCH_THRESHOLD_RX_MAX, \
+		WLAN_CFG_INTR_MOD_BATCH_MIN, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation min batch")
+
+/*
+ * <ini>
+ * dp_intr_mod_batch_max - Highest interrupt batch threshold in entries
+ * @Min: 1
+ * @Max: 128
+ * @Default: 64
+ *
+ * Batch counter threshold of the highest throughput moderation profile.
+ *
+ * Related: dp_intr_mod_enable
+ *
+ * Supported Feature: DP interrupt moderation (DP_INTR_ADAPTIVE_MODERATION)
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_BATCH_MAX \
+		CFG_INI_UINT("dp_intr_mod_batch_max", \
+		WLAN_CFG_INT_BATCH_THRESHOLD_RX_MIN, \
+		WLAN_CFG_INT_BATCH_THRESHOLD_RX_MAX, \
+		WLAN_CFG_INTR_MOD_BATCH_MAX, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation max batch")
+
 #define CFG_DP_RXDMA_MONITOR_RX_DROP_THRESHOLD \
 		CFG_INI_UINT("mon_drop_thresh", \
 		WLAN_CFG_RXDMA_MONITOR_RX_DROP_THRESH_SIZE_MIN, \
@@ -899,6 +1079,13 @@
 		CFG(CFG_DP_RXDMA_MONITOR_RX_DROP_THRESHOLD) \
 		CFG(CFG_DP_PKTLOG_BUFFER_SIZE) \
 		CFG(CFG_DP_RX_FISA_ENABLE) \
-		CFG(CFG_DP_FULL_MON_MODE)
+		CFG(CFG_DP_FULL_MON_MODE) \
+		CFG(CFG_DP_RX_PREFETCH_DIST) \
+		CFG(CFG_DP_RX_PARTIAL_INV_ENABLE) \
+		CFG(CFG_DP_INTR_MOD_ENABLE) \
+		CFG(CFG_DP_INTR_MOD_TIMER_MIN) \
+		CFG(CFG_DP_INTR_MOD_TIMER_MAX) \
+		CFG(CFG_DP_INTR_MOD_BATCH_MIN) \
+		CFG(CFG_DP_INTR_MOD_BATCH_MAX)
 
 #endif /* _CFG_DP_H_ */
@@ -605,6 +605,19 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 	wlan_cfg_ctx->mon_drop_thresh =
 		cfg_get(psoc, CFG_DP_RXDMA_MONITOR_RX_DROP_THRESHOLD);
 	wlan_cfg_ctx->is_rx_fisa_enabled = cfg_get(psoc, CFG_DP_RX_FISA_ENABLE);
+	wlan_cfg_ctx->rx_prefetch_dist = cfg_get(psoc, CFG_DP_RX_PREFETCH_DIST);
+	wlan_cfg_ctx->is_rx_partial_inv_enabled =
+			cfg_get(psoc, CFG_DP_RX_PARTIAL_INV_ENABLE);
+	wlan_cfg_ctx->is_intr_mod_enabled =
+			cfg_get(psoc, CFG_DP_INTR_MOD_ENABLE);
+	wlan_cfg_ctx->intr_mod_timer_min =
+			cfg_get(psoc, CFG_DP_INTR_MOD_TIMER_MIN);
+	wlan_cfg_ctx->intr_mod_timer_max =
+			cfg_get(psoc, CFG_DP_INTR_MOD_TIMER_MAX);
+	wlan_cfg_ctx->intr_mod_batch_min =
+			cfg_get(psoc, CFG_DP_INTR_MOD_BATCH_MIN);
+	wlan_cfg_ctx->intr_mod_batch_max =
+			cfg_get(psoc, CFG_DP_INTR_MOD_BATCH_MAX);
 	return wlan_cfg_ctx;
 }
 
@@ -1220,6 +1233,42 @@ wlan_cfg_get_dp_soc_rx_sw_desc_num(struct wlan_cfg_dp_soc_ctxt *cfg)
 	return cfg->rx_sw_desc_num;
 }
 
+uint8_t
+wlan_cfg_get_dp_soc_rx_prefetch_dist(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->rx_prefetch_dist;
+}
+
+bool wlan_cfg_is_rx_partial_inv_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->is_rx_partial_inv_enabled;
+}
+
+bool wlan_cfg_is_intr_mod_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->is_intr_mod_enabled;
+}
+
+uint16_t wlan_cfg_get_intr_mod_timer_min(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_timer_min;
+}
+
+uint16_t wlan_cfg_get_intr_mod_timer_max(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_timer_max;
+}
+
+uint8_t wlan_cfg_get_intr_mod_batch_min(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_batch_min;
+}
+
+uint8_t wlan_cfg_get_intr_mod_batch_max(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_batch_max;
+}
+
 bool
 wlan_cfg_get_dp_caps(struct wlan_cfg_dp_soc_ctxt *cfg,
 		     enum cdp_capabilities dp_caps)
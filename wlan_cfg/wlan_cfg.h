@@ -182,6 +182,13 @@ struct wlan_srng_cfg {
  *                        5 tuple flow entry
  * @pktlog_buffer_size: packet log buffer size
  * @is_rx_fisa_enabled: flag to enable/disable FISA Rx
+ * @rx_prefetch_dist: REO ring entries to prefetch ahead in Rx reap loop
+ * @is_rx_partial_inv_enabled: flag to sync only received bytes on Rx unmap
+ * @is_intr_mod_enabled: flag to enable adaptive interrupt moderation
+ * @intr_mod_timer_min: lowest moderation interrupt timer threshold in us
+ * @intr_mod_timer_max: highest moderation interrupt timer threshold in us
+ * @intr_mod_batch_min: lowest moderation interrupt batch threshold
+ * @intr_mod_batch_max: highest moderation interrupt batch threshold
  */
 struct wlan_cfg_dp_soc_ctxt {
 	int num_int_ctxts;
@@ -282,6 +289,13 @@ struct wlan_cfg_dp_soc_ctxt {
 	uint8_t is_rx_fisa_enabled;
 	bool is_tso_desc_attach_defer;
 	uint32_t delayed_replenish_entries;
+	uint8_t rx_prefetch_dist;
+	bool is_rx_partial_inv_enabled;
+	bool is_intr_mod_enabled;
+	uint16_t intr_mod_timer_min;
+	uint16_t intr_mod_timer_max;
+	uint8_t intr_mod_batch_min;
+	uint8_t intr_mod_batch_max;
 };
 
 /**
@@ -1167,6 +1181,63 @@ wlan_cfg_get_dp_soc_rx_sw_desc_weight(struct wlan_cfg_dp_soc_ctxt *cfg);
 int
 wlan_cfg_get_dp_soc_rx_sw_desc_num(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/*
+ * wlan_cfg_get_dp_soc_rx_prefetch_dist - Get Rx reap prefetch distance
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: rx_prefetch_dist
+ */
+uint8_t
+wlan_cfg_get_dp_soc_rx_prefetch_dist(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_is_rx_partial_inv_enabled - Get Rx partial invalidation flag
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: true if only received bytes are synced on Rx buffer unmap
+ */
+bool wlan_cfg_is_rx_partial_inv_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_is_intr_mod_enabled - Get adaptive interrupt moderation flag
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: true if adaptive interrupt moderation is enabled
+ */
+bool wlan_cfg_is_intr_mod_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_get_intr_mod_timer_min - Get lowest moderation timer threshold
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: intr_mod_timer_min
+ */
+uint16_t wlan_cfg_get_intr_mod_timer_min(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_get_intr_mod_timer_max - Get highest moderation timer threshold
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: intr_mod_timer_max
+ */
+uint16_t wlan_cfg_get_intr_mod_timer_max(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_get_intr_mod_batch_min - Get lowest moderation batch threshold
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: intr_mod_batch_min
+ */
+uint8_t wlan_cfg_get_intr_mod_batch_min(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/*
+ * wlan_cfg_get_intr_mod_batch_max - Get highest moderation batch threshold
+ * @wlan_cfg_soc_ctx
+ *
+ * Return: intr_mod_batch_max
+ */
+uint8_t wlan_cfg_get_intr_mod_batch_max(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 /*
  * wlan_cfg_get_dp_caps - Get dp capablities
  * @wlan_cfg_soc_ctx
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020, The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Scratch arena used to decode WMI event TLVs without a heap allocation
+ * per event. The arena holds the event param tlvs structure together with
+ * any padded TLV copies and is released once the event handler returns.
+ */
+#ifndef _WMI_TLV_ARENA_H_
+#define _WMI_TLV_ARENA_H_
+
+#include <qdf_types.h>
+#include <qdf_atomic.h>
+
+/* Space reserved beyond the largest param tlvs structure for padded TLVs */
+#define WMITLV_ARENA_PAD_SIZE 2048
+#define WMITLV_ARENA_ALIGN 8
+
+/* bit in wmitlv_arena.flags set while an event is decoded in the arena */
+#define WMITLV_ARENA_IN_USE 0
+
+/**
+ * struct wmitlv_arena - per wmi_unified scratch arena for event TLVs
+ * @buf: arena memory, NULL if the arena could not be allocated
+ * @size: size of @buf in bytes
+ * @used: bytes handed out for the event currently being decoded
+ * @flags: WMITLV_ARENA_IN_USE ownership bit
+ * @arena_allocs: allocations served from the arena
+ * @oversize_allocs: allocations that did not fit in the arena
+ * @heap_allocs: allocations served from the heap for any reason
+ * @busy_fallbacks: events decoded on the heap as the arena was in use
+ */
+struct wmitlv_arena {
+	uint8_t *buf;
+	uint32_t size;
+	uint32_t used;
+	unsigned long flags;
+	uint32_t arena_allocs;
+	uint32_t oversize_allocs;
+	qdf_atomic_t heap_allocs;
+	qdf_atomic_t busy_fallbacks;
+};
+
+/**
+ * wmitlv_arena_init() - allocate the scratch arena for event TLVs
+ * @arena: arena to be initialized
+ *
+ * The arena is sized from the largest event TLV table known to the host
+ * plus WMITLV_ARENA_PAD_SIZE for padded copies. A failure to allocate is
+ * not fatal, events are then decoded on the heap.
+ *
+ * Return: 0 if the arena was allocated, < 0 otherwise
+ */
+int wmitlv_arena_init(struct wmitlv_arena *arena);
+
+/**
+ * wmitlv_arena_deinit() - free the scratch arena for event TLVs
+ * @arena: arena to be freed
+ *
+ * Return: none
+ */
+void wmitlv_arena_deinit(struct wmitlv_arena *arena);
+
+/**
+ * wmitlv_arena_stats_clear() - reset the arena allocation counters
+ * @arena: arena
+ *
+ * Return: none
+ */
+void wmitlv_arena_stats_clear(struct wmitlv_arena *arena);
+
+/**
+ * wmitlv_check_and_pad_event_tlvs_arena() - validate and pad event TLVs
+ * @os_handle: os context handle
+ * @arena: scratch arena to decode into, may be NULL
+ * @param_struc_ptr: pointer to tlv structure
+ * @param_buf_len: length of tlv parameter
+ * @wmi_cmd_event_id: event id
+ * @wmi_cmd_struct_ptr: wmi event param tlvs structure
+ *
+ * Same as wmitlv_check_and_pad_event_tlvs() except that the param tlvs
+ * structure and padded TLVs are carved out of @arena when it is free.
+ *
+ * Return: 0 if success. Return < 0 if failure.
+ */
+int wmitlv_check_and_pad_event_tlvs_arena(void *os_handle,
+					  struct wmitlv_arena *arena,
+					  void *param_struc_ptr,
+					  uint32_t param_buf_len,
+					  uint32_t wmi_cmd_event_id,
+					  void **wmi_cmd_struct_ptr);
+
+/**
+ * wmitlv_free_allocated_event_tlvs_arena() - release decoded event TLVs
+ * @arena: scratch arena the event was decoded with, may be NULL
+ * @cmd_event_id: event id
+ * @wmi_cmd_struct_ptr: wmi event param tlvs structure
+ *
+ * Frees the heap backed buffers of the event and hands the arena back.
+ *
+ * Return: none
+ */
+void wmitlv_free_allocated_event_tlvs_arena(struct wmitlv_arena *arena,
+					    uint32_t cmd_event_id,
+					    void **wmi_cmd_struct_ptr);
+#endif /* _WMI_TLV_ARENA_H_ */
@@ -290,6 +290,68 @@ wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 			uint32_t buflen, uint32_t cmd_id,
 			const char *func, uint32_t line);
 
+/* Commands gathered in a batch before it is sent on its own */
+#define WMI_CMD_BATCH_MAX 32
+
+/**
+ * struct wmi_cmd_batch - WMI commands to be handed to HTC in one go
+ * @pkt_queue: HTC packets of the commands added to the batch
+ */
+struct wmi_cmd_batch {
+	HTC_PACKET_QUEUE pkt_queue;
+};
+
+/**
+ * wmi_unified_cmd_batch_begin() - start gathering WMI commands in a batch
+ * @wmi_handle: handle to WMI.
+ * @batch: caller owned batch
+ *
+ * Return: none
+ */
+void wmi_unified_cmd_batch_begin(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch);
+
+/**
+ * wmi_unified_cmd_batch_add() - add a WMI command to a batch
+ * @wmi_handle: handle to WMI.
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ * @buf: wmi command buffer
+ * @buflen: wmi command buffer length
+ * @cmd_id: WMI cmd id
+ *
+ * The command goes through the same checks as wmi_unified_cmd_send() and
+ * is sent when the batch is committed. A batch holding WMI_CMD_BATCH_MAX
+ * commands is committed before the new one is added. Only SDIO and USB
+ * bundle HTC tx; on other buses the command is sent right away.
+ *
+ * Note, on success it is NOT safe to access buf after calling this function!
+ *
+ * Return: QDF_STATUS
+ */
+#define wmi_unified_cmd_batch_add(wmi_handle, batch, buf, buflen, cmd_id) \
+	wmi_unified_cmd_batch_add_fl(wmi_handle, batch, buf, buflen, \
+				     cmd_id, __func__, __LINE__)
+
+QDF_STATUS
+wmi_unified_cmd_batch_add_fl(wmi_unified_t wmi_handle,
+			     struct wmi_cmd_batch *batch,
+			     wmi_buf_t buf, uint32_t buflen, uint32_t cmd_id,
+			     const char *func, uint32_t line);
+
+/**
+ * wmi_unified_cmd_batch_commit() - send the WMI commands of a batch
+ * @wmi_handle: handle to WMI.
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ *
+ * The commands are handed to HTC as one queue so that they can share a
+ * bundled transfer. Commands HTC does not accept are freed here. The
+ * batch is empty on return and can be reused.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS wmi_unified_cmd_batch_commit(wmi_unified_t wmi_handle,
+					struct wmi_cmd_batch *batch);
+
 #ifdef WLAN_FEATURE_WMI_SEND_RECV_QMI
 /**
  * wmi_unified_cmd_send_over_qmi() -  generic function to send unified WMI command
@@ -726,6 +788,22 @@ QDF_STATUS
 wmi_unified_vdev_set_param_send(wmi_unified_t wmi_handle,
 				struct vdev_set_params *param);
 
+/**
+ * wmi_unified_vdev_set_multiple_param_send() - WMI vdev set several params
+ * @wmi_handle: handle to WMI.
+ * @params: vdev parameters to set
+ * @num: number of entries in @params
+ *
+ * The commands are sent as one WMI command batch. Parameters the target
+ * does not support are skipped.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS
+wmi_unified_vdev_set_multiple_param_send(wmi_unified_t wmi_handle,
+					 struct vdev_set_params *params,
+					 uint8_t num);
+
 /**
  * wmi_unified_sifs_trigger_send() - WMI vdev sifs trigger parameter function
  * @wmi_handle: handle to WMI.
@@ -786,6 +864,24 @@ wmi_set_peer_param_send(wmi_unified_t wmi_handle,
 			uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
 			struct peer_set_params *param);
 
+/**
+ * wmi_set_peer_multiple_param_send() - set several peer parameters in fw
+ * @wmi_handle: wmi handle
+ * @peer_addr: peer mac address
+ * @params: peer parameters to set
+ * @num: number of entries in @params
+ *
+ * The commands are sent as one WMI command batch. Parameters the target
+ * does not support are skipped.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS
+wmi_set_peer_multiple_param_send(wmi_unified_t wmi_handle,
+				 uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
+				 struct peer_set_params *params,
+				 uint8_t num);
+
 /**
  * wmi_unified_peer_create_send() - send peer create command to fw
  * @wmi_handle: wmi handle
@@ -28,6 +28,7 @@
 #include "wlan_scan_ucfg_api.h"
 #include "qdf_atomic.h"
 #include <wbuff.h>
+#include "wmi_tlv_arena.h"
 
 #ifdef WLAN_FW_OFFLOAD
 #include "wlan_fwol_public_structs.h"
@@ -83,6 +84,91 @@
 
 #define WMI_UNIFIED_MAX_EVENT 0x100
 
+/*
+ * Event id to handler index hash, open addressed and kept at most half
+ * full so that lookups from the event Rx path stay within a probe or two.
+ */
+#define WMI_EVENT_HASH_BITS 9
+#define WMI_EVENT_HASH_SIZE (1 << WMI_EVENT_HASH_BITS)
+
+/**
+ * struct wmi_event_stats - per registered event dispatch statistics
+ * @count: number of times the event handler was called
+ * @total_time_us: cumulative time spent in the event handler
+ * @max_time_us: longest single run of the event handler
+ *
+ * Updated atomically, as an event can be dispatched from the rx class
+ * workers, the tasklet and the scheduler thread at the same time.
+ */
+struct wmi_event_stats {
+	qdf_atomic_t count;
+	qdf_atomic64_t total_time_us;
+	qdf_atomic_t max_time_us;
+};
+
+/**
+ * enum wmi_rx_evt_class - classes of events processed in rx work context,
+ * each class is queued and drained by its own worker
+ * @WMI_RX_EVT_CLASS_CRITICAL: latency critical events, e.g. roam, kickout
+ * @WMI_RX_EVT_CLASS_MGMT: management events
+ * @WMI_RX_EVT_CLASS_BULK: all other events
+ * @WMI_RX_EVT_CLASS_MAX: number of classes
+ */
+enum wmi_rx_evt_class {
+	WMI_RX_EVT_CLASS_CRITICAL,
+	WMI_RX_EVT_CLASS_MGMT,
+	WMI_RX_EVT_CLASS_BULK,
+	WMI_RX_EVT_CLASS_MAX,
+};
+
+#define WMI_RX_EVT_HIST_MAX 8
+
+/**
+ * struct wmi_rx_evt_lane - per class rx event queue and worker
+ * @wmi_handle: wmi handle the lane belongs to
+ * @eventq_lock: protects @event_queue
+ * @event_queue: events pending for the class, in arrival order
+ * @rx_event_work: work draining @event_queue
+ * @wmi_rx_work_queue: workqueue @rx_event_work runs on
+ * @enqueued: number of events queued to the lane
+ * @max_depth: deepest @event_queue has been
+ * @depth_hist: log2 histogram of the queue depth found by arriving events
+ * @dwell_hist: histogram of the time events waited in @event_queue
+ * @tlv_arena: event TLV scratch arena of the lane, lanes decode in parallel
+ *	       so they do not share the wmi_unified one
+ */
+struct wmi_rx_evt_lane {
+	struct wmi_unified *wmi_handle;
+	qdf_spinlock_t eventq_lock;
+	qdf_nbuf_queue_t event_queue;
+	qdf_work_t rx_event_work;
+	qdf_workqueue_t *wmi_rx_work_queue;
+	uint32_t enqueued;
+	uint32_t max_depth;
+	uint32_t depth_hist[WMI_RX_EVT_HIST_MAX];
+	uint32_t dwell_hist[WMI_RX_EVT_HIST_MAX];
+	struct wmitlv_arena tlv_arena;
+};
+
+/**
+ * struct wmi_htc_pkt_pool - lock-free pool of HTC packets for WMI commands
+ * @pkts: packet storage
+ * @next: free list links, index + 1 of the next free packet, 0 ends a list
+ * @head: index + 1 of the first free packet in the low 16 bits, update tag
+ *	  in the high 16 bits so that a stale head fails the cmpxchg
+ * @size: number of packets in @pkts
+ * @hit: packets served from the pool
+ * @miss: packets allocated from the heap as the pool was empty
+ */
+struct wmi_htc_pkt_pool {
+	HTC_PACKET *pkts;
+	uint16_t *next;
+	qdf_atomic_t head;
+	uint16_t size;
+	qdf_atomic_t hit;
+	qdf_atomic_t miss;
+};
+
 #ifdef WMI_EXT_DBG
 
 #define WMI_EXT_DBG_DIR			"WMI_EXT_DBG"
@@ -371,6 +457,11 @@ QDF_STATUS (*send_peer_param_cmd)(wmi_unified_t wmi,
 				uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
 				struct peer_set_params *param);
 
+QDF_STATUS (*send_multiple_peer_param_cmd)(wmi_unified_t wmi,
+				uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
+				struct peer_set_params *params,
+				uint8_t num);
+
 QDF_STATUS (*send_vdev_up_cmd)(wmi_unified_t wmi,
 			     uint8_t bssid[QDF_MAC_ADDR_SIZE],
 				 struct vdev_up_params *params);
@@ -441,6 +532,10 @@ QDF_STATUS
 QDF_STATUS (*send_vdev_set_param_cmd)(wmi_unified_t wmi_handle,
 				struct vdev_set_params *param);
 
+QDF_STATUS (*send_vdev_set_multiple_param_cmd)(wmi_unified_t wmi_handle,
+				struct vdev_set_params *params,
+				uint8_t num);
+
 QDF_STATUS (*send_vdev_sifs_trigger_cmd)(wmi_unified_t wmi_handle,
 					 struct sifs_trigger_param *param);
 
@@ -2079,9 +2174,11 @@ void (*wmi_pdev_id_conversion_enable)(wmi_unified_t wmi_handle,
 				      uint32_t *pdev_map,
 				      uint8_t size);
 void (*send_time_stamp_sync_cmd)(wmi_unified_t wmi_handle);
-void (*wmi_free_allocated_event)(uint32_t cmd_event_id,
-				void **wmi_cmd_struct_ptr);
-int (*wmi_check_and_pad_event)(void *os_handle, void *param_struc_ptr,
+void (*wmi_free_allocated_event)(struct wmitlv_arena *arena,
+				 uint32_t cmd_event_id,
+				 void **wmi_cmd_struct_ptr);
+int (*wmi_check_and_pad_event)(void *os_handle, struct wmitlv_arena *arena,
+				void *param_struc_ptr,
 				uint32_t param_buf_len,
 				uint32_t wmi_cmd_event_id,
 				void **wmi_cmd_struct_ptr);
@@ -2357,15 +2454,16 @@ struct wmi_host_abi_version {
 /* number of debugfs entries used */
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 /* filtered logging added 4 more entries */
-#define NUM_DEBUG_INFOS 13
+#define NUM_DEBUG_INFOS 17
 #else
-#define NUM_DEBUG_INFOS 9
+#define NUM_DEBUG_INFOS 13
 #endif
 
 struct wmi_unified {
 	void *scn_handle;    /* handle to device */
 	osdev_t  osdev; /* handle to use OS-independent services */
 	struct wbuff_mod_handle *wbuff_handle; /* handle to wbuff */
+	struct wmi_htc_pkt_pool htc_pkt_pool;
 	qdf_atomic_t pending_cmds;
 	HTC_ENDPOINT_ID wmi_endpoint_id;
 	uint16_t max_msg_len;
@@ -2373,10 +2471,7 @@ struct wmi_unified {
 	wmi_unified_event_handler *event_handler;
 	enum wmi_rx_exec_ctx *ctx;
 	HTC_HANDLE htc_handle;
-	qdf_spinlock_t eventq_lock;
-	qdf_nbuf_queue_t event_queue;
-	qdf_work_t rx_event_work;
-	qdf_workqueue_t *wmi_rx_work_queue;
+	struct wmi_rx_evt_lane rx_evt_lane[WMI_RX_EVT_CLASS_MAX];
 	int wmi_stop_in_progress;
 	struct wmi_host_abi_version fw_abi_version;
 	struct wmi_host_abi_version final_abi_vers;
@@ -2420,6 +2515,7 @@ struct wmi_unified {
 	uint32_t *cmd_phy_id_map;
 	uint32_t *evt_phy_id_map;
 	qdf_atomic_t num_stats_over_qmi;
+	struct wmitlv_arena tlv_arena;
 };
 
 #define WMI_MAX_RADIOS 3
@@ -2435,6 +2531,9 @@ struct wmi_soc {
 	uint32_t max_event_idx;
 	enum wmi_rx_exec_ctx ctx[WMI_UNIFIED_MAX_EVENT];
 	qdf_spinlock_t ctx_lock;
+	/* event id hash, each slot holds handler index + 1, 0 if empty */
+	uint16_t event_hash[WMI_EVENT_HASH_SIZE];
+	struct wmi_event_stats event_stats[WMI_UNIFIED_MAX_EVENT];
 	struct wmi_unified *wmi_pdev[WMI_MAX_RADIOS];
 	HTC_ENDPOINT_ID wmi_endpoint_id[WMI_MAX_RADIOS];
 	uint16_t max_msg_len[WMI_MAX_RADIOS];
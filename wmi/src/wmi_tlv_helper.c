@@ -20,6 +20,7 @@
 #include "wmi_tlv_defs.h"
 #include "wmi_version.h"
 #include "qdf_module.h"
+#include "wmi_tlv_arena.h"
 
 #define WMITLV_GET_ATTRIB_NUM_TLVS  0xFFFFFFFF
 
@@ -469,9 +470,159 @@ wmitlv_check_command_tlv_params(void *os_handle, void *param_struc_ptr,
 }
 qdf_export_symbol(wmitlv_check_command_tlv_params);
 
+#ifndef NO_DYNAMIC_MEM_ALLOC
+/**
+ * wmitlv_arena_get() - take ownership of the event TLV scratch arena
+ * @arena: scratch arena, may be NULL
+ *
+ * Return: true if the arena is now owned by the caller
+ */
+static bool wmitlv_arena_get(struct wmitlv_arena *arena)
+{
+	if (!arena || !arena->buf)
+		return false;
+
+	if (qdf_atomic_test_and_set_bit(WMITLV_ARENA_IN_USE, &arena->flags)) {
+		qdf_atomic_inc(&arena->busy_fallbacks);
+		return false;
+	}
+
+	arena->used = 0;
+	return true;
+}
+
+/**
+ * wmitlv_arena_put() - give up ownership of the event TLV scratch arena
+ * @arena: scratch arena owned by the caller
+ *
+ * Return: none
+ */
+static void wmitlv_arena_put(struct wmitlv_arena *arena)
+{
+	arena->used = 0;
+	qdf_atomic_clear_bit(WMITLV_ARENA_IN_USE, &arena->flags);
+}
+
+/**
+ * wmitlv_arena_owns() - check if a buffer was carved out of the arena
+ * @arena: scratch arena, may be NULL
+ * @ptr: buffer
+ *
+ * Return: true if @ptr lies within the arena
+ */
+static inline bool wmitlv_arena_owns(struct wmitlv_arena *arena, void *ptr)
+{
+	return arena && arena->buf && (uint8_t *)ptr >= arena->buf &&
+	       (uint8_t *)ptr < arena->buf + arena->size;
+}
+
+/**
+ * wmitlv_mem_alloc() - allocate a buffer for event/command TLV processing
+ * @arena: scratch arena owned by the caller, NULL to use the heap
+ * @stats: arena accounting the heap allocations, may be NULL
+ * @len: number of bytes
+ *
+ * Return: buffer or NULL on failure
+ */
+static void *wmitlv_mem_alloc(struct wmitlv_arena *arena,
+			      struct wmitlv_arena *stats, uint32_t len)
+{
+	uint32_t alloc_len = qdf_roundup(len, WMITLV_ARENA_ALIGN);
+	void *ptr;
+
+	if (arena) {
+		if (alloc_len <= arena->size - arena->used) {
+			ptr = arena->buf + arena->used;
+			arena->used += alloc_len;
+			arena->arena_allocs++;
+			return ptr;
+		}
+		arena->oversize_allocs++;
+	}
+
+	if (stats)
+		qdf_atomic_inc(&stats->heap_allocs);
+
+	wmi_tlv_os_mem_alloc(NULL, ptr, len);
+	return ptr;
+}
+
+/**
+ * wmitlv_mem_free() - free a buffer used for event/command TLV processing
+ * @arena: scratch arena the buffer may come from, may be NULL
+ * @ptr: buffer
+ *
+ * Buffers carved out of the arena are reclaimed all at once when the arena
+ * is put back, only heap buffers are freed here.
+ *
+ * Return: none
+ */
+static inline void wmitlv_mem_free(struct wmitlv_arena *arena, void *ptr)
+{
+	if (!wmitlv_arena_owns(arena, ptr))
+		wmi_tlv_os_mem_free(ptr);
+}
+
+int wmitlv_arena_init(struct wmitlv_arena *arena)
+{
+	uint32_t i, num_tlvs, max_tlvs = 0;
+
+	/* Walk the event attribute list the way wmitlv_get_attributes does */
+	for (i = 0; i < QDF_ARRAY_SIZE(evt_attr_list); i++) {
+		num_tlvs = WMITLV_GET_NUM_TLVS(evt_attr_list[i]);
+		if (num_tlvs > max_tlvs)
+			max_tlvs = num_tlvs;
+		i += num_tlvs;
+	}
+
+	qdf_mem_zero(arena, sizeof(*arena));
+	arena->size = qdf_roundup(max_tlvs * sizeof(wmitlv_cmd_param_info),
+				  WMITLV_ARENA_ALIGN) + WMITLV_ARENA_PAD_SIZE;
+	arena->buf = qdf_mem_malloc(arena->size);
+	if (!arena->buf) {
+		arena->size = 0;
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+void wmitlv_arena_deinit(struct wmitlv_arena *arena)
+{
+	if (arena->buf)
+		qdf_mem_free(arena->buf);
+	arena->buf = NULL;
+	arena->size = 0;
+}
+#else
+int wmitlv_arena_init(struct wmitlv_arena *arena)
+{
+	qdf_mem_zero(arena, sizeof(*arena));
+	return -EINVAL;
+}
+
+void wmitlv_arena_deinit(struct wmitlv_arena *arena)
+{
+}
+#endif
+
+void wmitlv_arena_stats_clear(struct wmitlv_arena *arena)
+{
+	arena->arena_allocs = 0;
+	arena->oversize_allocs = 0;
+	qdf_atomic_set(&arena->heap_allocs, 0);
+	qdf_atomic_set(&arena->busy_fallbacks, 0);
+}
+
+static void wmitlv_free_allocated_tlvs(struct wmitlv_arena *arena,
+				       uint32_t is_cmd_id,
+				       uint32_t cmd_event_id,
+				       void **wmi_cmd_struct_ptr);
+
 /**
  * wmitlv_check_and_pad_tlvs() - tlv helper function
  * @os_handle: os context handle
+ * @stats_arena: scratch arena to decode into, NULL to use the heap
  * @param_buf_len: length of tlv parameter
  * @param_struc_ptr: pointer to tlv structure
  * @is_cmd_id: boolean for command attribute
@@ -485,10 +636,12 @@ qdf_export_symbol(wmitlv_check_command_tlv_params);
  * Return: 0 if success. Return < 0 if failure.
  */
 static int
-wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
+wmitlv_check_and_pad_tlvs(void *os_handle, struct wmitlv_arena *stats_arena,
+			  void *param_struc_ptr,
 			  uint32_t param_buf_len, uint32_t is_cmd_id,
 			  uint32_t wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
 {
+	struct wmitlv_arena *arena = NULL;
 	wmitlv_attributes_struc attr_struct_ptr;
 	uint32_t buf_idx = 0;
 	uint32_t tlv_index = 0;
@@ -524,8 +677,15 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 		attr_struct_ptr.cmd_num_tlv * sizeof(wmitlv_cmd_param_info);
 #ifndef NO_DYNAMIC_MEM_ALLOC
 	/* Dynamic memory allocation supported */
-	wmi_tlv_os_mem_alloc(os_handle, *wmi_cmd_struct_ptr,
-			     len_wmi_cmd_struct_buf);
+	if (wmitlv_arena_get(stats_arena))
+		arena = stats_arena;
+	*wmi_cmd_struct_ptr = wmitlv_mem_alloc(arena, stats_arena,
+					       len_wmi_cmd_struct_buf);
+	if (arena && !wmitlv_arena_owns(arena, *wmi_cmd_struct_ptr)) {
+		/* Base structure went to the heap, keep the arena free */
+		wmitlv_arena_put(arena);
+		arena = NULL;
+	}
 #else
 	/* Dynamic memory allocation is not supported. Use the buffer
 	 * g_wmi_static_cmd_param_info_buf, which should be set using
@@ -701,9 +861,10 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				WMITLV_GET_TLVLEN(WMITLV_GET_HDR(buf_ptr)) +
 				WMI_TLV_HDR_SIZE;
 #ifndef NO_DYNAMIC_MEM_ALLOC
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (num_of_elems *
-					      attr_struct_ptr.tag_struct_size));
+			new_tlv_buf =
+				wmitlv_mem_alloc(arena, stats_arena,
+						 (num_of_elems *
+						  attr_struct_ptr.tag_struct_size));
 			if (!new_tlv_buf) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -908,8 +1069,9 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				__func__, tlv_size_diff);
 #ifndef NO_DYNAMIC_MEM_ALLOC
 			/* Dynamic memory allocation is supported */
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (curr_tlv_len - tlv_size_diff));
+			new_tlv_buf =
+				wmitlv_mem_alloc(arena, stats_arena,
+						 (curr_tlv_len - tlv_size_diff));
 			if (!new_tlv_buf) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -964,13 +1126,8 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 
 	return 0;
 Error_wmitlv_check_and_pad_tlvs:
-	if (is_cmd_id) {
-		wmitlv_free_allocated_command_tlvs(wmi_cmd_event_id,
-						   wmi_cmd_struct_ptr);
-	} else {
-		wmitlv_free_allocated_event_tlvs(wmi_cmd_event_id,
-						 wmi_cmd_struct_ptr);
-	}
+	wmitlv_free_allocated_tlvs(arena, is_cmd_id, wmi_cmd_event_id,
+				   wmi_cmd_struct_ptr);
 	*wmi_cmd_struct_ptr = NULL;
 	return error;
 }
@@ -996,11 +1153,26 @@ wmitlv_check_and_pad_event_tlvs(void *os_handle, void *param_struc_ptr,
 {
 	uint32_t is_cmd_id = 0;
 	return wmitlv_check_and_pad_tlvs
-			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			(os_handle, NULL, param_struc_ptr, param_buf_len,
+			is_cmd_id, wmi_cmd_event_id, wmi_cmd_struct_ptr);
 }
 qdf_export_symbol(wmitlv_check_and_pad_event_tlvs);
 
+int
+wmitlv_check_and_pad_event_tlvs_arena(void *os_handle,
+				      struct wmitlv_arena *arena,
+				      void *param_struc_ptr,
+				      uint32_t param_buf_len,
+				      uint32_t wmi_cmd_event_id,
+				      void **wmi_cmd_struct_ptr)
+{
+	uint32_t is_cmd_id = 0;
+	return wmitlv_check_and_pad_tlvs
+			(os_handle, arena, param_struc_ptr, param_buf_len,
+			is_cmd_id, wmi_cmd_event_id, wmi_cmd_struct_ptr);
+}
+qdf_export_symbol(wmitlv_check_and_pad_event_tlvs_arena);
+
 /**
  * wmitlv_check_and_pad_command_tlvs() - tlv helper function
  * @os_handle: os context handle
@@ -1022,12 +1194,13 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
 {
 	uint32_t is_cmd_id = 1;
 	return wmitlv_check_and_pad_tlvs
-			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			(os_handle, NULL, param_struc_ptr, param_buf_len,
+			is_cmd_id, wmi_cmd_event_id, wmi_cmd_struct_ptr);
 }
 
 /**
  * wmitlv_free_allocated_tlvs() - tlv helper function
+ * @arena: scratch arena the TLVs may have been decoded into, may be NULL
  * @is_cmd_id: bollean to check if cmd or event tlv
  * @cmd_event_id: command or event id
  * @wmi_cmd_struct_ptr: wmi command structure
@@ -1037,7 +1210,8 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
  *
  * Return: none
  */
-static void wmitlv_free_allocated_tlvs(uint32_t is_cmd_id,
+static void wmitlv_free_allocated_tlvs(struct wmitlv_arena *arena,
+				       uint32_t is_cmd_id,
 				       uint32_t cmd_event_id,
 				       void **wmi_cmd_struct_ptr)
 {
@@ -1055,7 +1229,7 @@ static void wmitlv_free_allocated_tlvs(uint32_t is_cmd_id,
 	if ((((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->WMITLV_FIELD_BUF_IS_ALLOCATED(elem_name)) &&	\
 	    (((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name)) \
 	{ \
-		wmi_tlv_os_mem_free(((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name); \
+		wmitlv_mem_free(arena, ((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name); \
 	}
 
 #define WMITLV_FREE_TLV_ELEMS(id)	     \
@@ -1083,7 +1257,10 @@ break;
 		}
 	}
 
-	wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
+	if (wmitlv_arena_owns(arena, *wmi_cmd_struct_ptr))
+		wmitlv_arena_put(arena);
+	else
+		wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
 	*wmi_cmd_struct_ptr = NULL;
 #endif
 
@@ -1103,7 +1280,7 @@ break;
 void wmitlv_free_allocated_command_tlvs(uint32_t cmd_event_id,
 					void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(NULL, 1, cmd_event_id, wmi_cmd_struct_ptr);
 }
 
 /**
@@ -1119,10 +1296,18 @@ void wmitlv_free_allocated_command_tlvs(uint32_t cmd_event_id,
 void wmitlv_free_allocated_event_tlvs(uint32_t cmd_event_id,
 				      void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(NULL, 0, cmd_event_id, wmi_cmd_struct_ptr);
 }
 qdf_export_symbol(wmitlv_free_allocated_event_tlvs);
 
+void wmitlv_free_allocated_event_tlvs_arena(struct wmitlv_arena *arena,
+					    uint32_t cmd_event_id,
+					    void **wmi_cmd_struct_ptr)
+{
+	wmitlv_free_allocated_tlvs(arena, 0, cmd_event_id, wmi_cmd_struct_ptr);
+}
+qdf_export_symbol(wmitlv_free_allocated_event_tlvs_arena);
+
 /**
  * wmi_versions_are_compatible() - tlv helper function
  * @vers1: host wmi version
@@ -70,6 +70,44 @@ WMI_CMD_HDR to be defined here. */
 #define WMI_EP_LPASS           0x1
 #define WMI_EP_SENSOR          0x2
 
+/* upper bounds of the rx event dwell time histogram buckets, in us */
+static const uint32_t wmi_rx_evt_dwell_us[WMI_RX_EVT_HIST_MAX - 1] = {
+	100, 500, 1000, 5000, 10000, 50000, 100000
+};
+
+static const char *wmi_rx_evt_class_name[WMI_RX_EVT_CLASS_MAX] = {
+	"critical", "mgmt", "bulk"
+};
+
+/**
+ * wmi_event_stats_reset() - clear the dispatch statistics of an event
+ * @stats: event statistics
+ *
+ * Return: none
+ */
+static void wmi_event_stats_reset(struct wmi_event_stats *stats)
+{
+	qdf_atomic_set(&stats->count, 0);
+	qdf_atomic64_set(&stats->total_time_us, 0);
+	qdf_atomic_set(&stats->max_time_us, 0);
+}
+
+/**
+ * wmi_event_stats_copy() - copy the dispatch statistics of an event
+ * @dst: destination event statistics
+ * @src: source event statistics
+ *
+ * Return: none
+ */
+static void wmi_event_stats_copy(struct wmi_event_stats *dst,
+				 struct wmi_event_stats *src)
+{
+	qdf_atomic_set(&dst->count, qdf_atomic_read(&src->count));
+	qdf_atomic64_set(&dst->total_time_us,
+			 qdf_atomic64_read(&src->total_time_us));
+	qdf_atomic_set(&dst->max_time_us, qdf_atomic_read(&src->max_time_us));
+}
+
 /*
  *  * Control Path
  *   */
@@ -101,6 +139,10 @@ typedef PREPACK struct {
 /* Allocation of size 2048 bytes */
 #define WMI_WBUFF_POOL_3_SIZE 8
 
+/* HTC packet pool free list head layout */
+#define WMI_HTC_PKT_POOL_IDX_MASK 0xFFFF
+#define WMI_HTC_PKT_POOL_TAG_INC 0x10000
+
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 3, 0))
 /* TODO Cleanup this backported function */
@@ -1305,6 +1347,305 @@ static ssize_t debug_wmi_enable_write(struct file *file, const char __user *buf,
 	return count;
 }
 
+/**
+ * debug_wmi_event_stats_show() - debugfs functions to display the dispatch
+ * count and handler time of every registered wmi event.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: Length of characters printed
+ */
+static int debug_wmi_event_stats_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t)m->private;
+	struct wmi_soc *soc = wmi_handle->soc;
+	struct wmi_event_stats *stats;
+	uint64_t total_time_us;
+	uint32_t max_time_us;
+	uint32_t count;
+	uint32_t idx;
+
+	wmi_bp_seq_printf(m, "%-10s %10s %14s %10s %10s\n", "event_id",
+			  "count", "total(us)", "avg(us)", "max(us)");
+
+	for (idx = 0; idx < soc->max_event_idx; idx++) {
+		stats = &soc->event_stats[idx];
+		count = qdf_atomic_read(&stats->count);
+		if (!count)
+			continue;
+
+		total_time_us = qdf_atomic64_read(&stats->total_time_us);
+		max_time_us = qdf_atomic_read(&stats->max_time_us);
+		wmi_bp_seq_printf(m, "0x%-8x %10u %14llu %10llu %10u\n",
+				  wmi_handle->event_id[idx], count,
+				  total_time_us,
+				  qdf_do_div(total_time_us, count),
+				  max_time_us);
+	}
+
+	return 0;
+}
+
+/**
+ * debug_wmi_event_stats_write() - debugfs functions to clear the wmi event
+ * dispatch statistics.
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ * @ppos: Not used
+ *
+ * Return: count
+ */
+static ssize_t debug_wmi_event_stats_write(struct file *file,
+					   const char __user *buf,
+					   size_t count, loff_t *ppos)
+{
+	wmi_unified_t wmi_handle =
+		((struct seq_file *)file->private_data)->private;
+	int k, ret;
+	char locbuf[50];
+
+	if ((!buf) || (count > 50))
+		return -EFAULT;
+
+	if (copy_from_user(locbuf, buf, count))
+		return -EFAULT;
+
+	ret = sscanf(locbuf, "%d", &k);
+	if ((ret != 1) || (k != 0))
+		return -EINVAL;
+
+	for (k = 0; k < WMI_UNIFIED_MAX_EVENT; k++)
+		wmi_event_stats_reset(&wmi_handle->soc->event_stats[k]);
+
+	return count;
+}
+
+/**
+ * debug_wmi_tlv_arena_print() - print the allocation counts of one event
+ * TLV scratch arena
+ *
+ * @m: debugfs handler
+ * @name: owner of the arena
+ * @arena: arena
+ *
+ * Return: none
+ */
+static void debug_wmi_tlv_arena_print(struct seq_file *m, const char *name,
+				      struct wmitlv_arena *arena)
+{
+	wmi_bp_seq_printf(m, "%s arena size: %u\n", name, arena->size);
+	wmi_bp_seq_printf(m, "%s arena allocs: %u\n", name,
+			  arena->arena_allocs);
+	wmi_bp_seq_printf(m, "%s oversize allocs: %u\n", name,
+			  arena->oversize_allocs);
+	wmi_bp_seq_printf(m, "%s heap allocs: %u\n", name,
+			  qdf_atomic_read(&arena->heap_allocs));
+	wmi_bp_seq_printf(m, "%s busy fallbacks: %u\n", name,
+			  qdf_atomic_read(&arena->busy_fallbacks));
+}
+
+/**
+ * debug_wmi_tlv_arena_stats_show() - debugfs functions to display the
+ * allocation counts of the event TLV scratch arenas.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: Length of characters printed
+ */
+static int debug_wmi_tlv_arena_stats_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t)m->private;
+	uint32_t i;
+
+	debug_wmi_tlv_arena_print(m, "direct", &wmi_handle->tlv_arena);
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++)
+		debug_wmi_tlv_arena_print(m, wmi_rx_evt_class_name[i],
+					  &wmi_handle->rx_evt_lane[i].tlv_arena);
+
+	return 0;
+}
+
+/**
+ * debug_wmi_tlv_arena_stats_write() - debugfs functions to clear the
+ * allocation counts of the event TLV scratch arena.
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ * @ppos: Not used
+ *
+ * Return: count
+ */
+static ssize_t debug_wmi_tlv_arena_stats_write(struct file *file,
+					       const char __user *buf,
+					       size_t count, loff_t *ppos)
+{
+	wmi_unified_t wmi_handle =
+		((struct seq_file *)file->private_data)->private;
+	int k, ret;
+	char locbuf[50];
+
+	if ((!buf) || (count > 50))
+		return -EFAULT;
+
+	if (copy_from_user(locbuf, buf, count))
+		return -EFAULT;
+
+	ret = sscanf(locbuf, "%d", &k);
+	if ((ret != 1) || (k != 0))
+		return -EINVAL;
+
+	wmitlv_arena_stats_clear(&wmi_handle->tlv_arena);
+	for (k = 0; k < WMI_RX_EVT_CLASS_MAX; k++)
+		wmitlv_arena_stats_clear(&wmi_handle->rx_evt_lane[k].tlv_arena);
+	return count;
+}
+
+/**
+ * debug_wmi_rx_evt_lane_stats_show() - debugfs functions to display the
+ * queue depth and dwell time histograms of every rx event class.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: Length of characters printed
+ */
+static int debug_wmi_rx_evt_lane_stats_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t)m->private;
+	struct wmi_rx_evt_lane *lane;
+	uint32_t i, j;
+
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++) {
+		lane = &wmi_handle->rx_evt_lane[i];
+		wmi_bp_seq_printf(m, "%s: enqueued %u pending %u max depth %u\n",
+				  wmi_rx_evt_class_name[i], lane->enqueued,
+				  qdf_nbuf_queue_len(&lane->event_queue),
+				  lane->max_depth);
+
+		wmi_bp_seq_printf(m, "  depth:");
+		for (j = 0; j < WMI_RX_EVT_HIST_MAX - 1; j++)
+			wmi_bp_seq_printf(m, " <%u:%u", 1 << j,
+					  lane->depth_hist[j]);
+		wmi_bp_seq_printf(m, " >=%u:%u", 1 << (j - 1),
+				  lane->depth_hist[j]);
+		wmi_bp_seq_printf(m, "\n  dwell(us):");
+		for (j = 0; j < WMI_RX_EVT_HIST_MAX - 1; j++)
+			wmi_bp_seq_printf(m, " <%u:%u", wmi_rx_evt_dwell_us[j],
+					  lane->dwell_hist[j]);
+		wmi_bp_seq_printf(m, " >=%u:%u\n", wmi_rx_evt_dwell_us[j - 1],
+				  lane->dwell_hist[j]);
+	}
+
+	return 0;
+}
+
+/**
+ * debug_wmi_rx_evt_lane_stats_write() - debugfs functions to clear the
+ * rx event class histograms.
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ * @ppos: Not used
+ *
+ * Return: count
+ */
+static ssize_t debug_wmi_rx_evt_lane_stats_write(struct file *file,
+						 const char __user *buf,
+						 size_t count, loff_t *ppos)
+{
+	wmi_unified_t wmi_handle =
+		((struct seq_file *)file->private_data)->private;
+	struct wmi_rx_evt_lane *lane;
+	int k, ret;
+	char locbuf[50];
+	uint32_t i;
+
+	if ((!buf) || (count > 50))
+		return -EFAULT;
+
+	if (copy_from_user(locbuf, buf, count))
+		return -EFAULT;
+
+	ret = sscanf(locbuf, "%d", &k);
+	if ((ret != 1) || (k != 0))
+		return -EINVAL;
+
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++) {
+		lane = &wmi_handle->rx_evt_lane[i];
+		qdf_spin_lock_bh(&lane->eventq_lock);
+		lane->enqueued = 0;
+		lane->max_depth = 0;
+		qdf_mem_zero(lane->depth_hist, sizeof(lane->depth_hist));
+		qdf_mem_zero(lane->dwell_hist, sizeof(lane->dwell_hist));
+		qdf_spin_unlock_bh(&lane->eventq_lock);
+	}
+
+	return count;
+}
+
+/**
+ * debug_wmi_htc_pkt_pool_stats_show() - debugfs functions to display the
+ * hit and miss counts of the WMI command HTC packet pool.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: Length of characters printed
+ */
+static int debug_wmi_htc_pkt_pool_stats_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t)m->private;
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
+
+	wmi_bp_seq_printf(m, "pool size: %u\n", pool->size);
+	wmi_bp_seq_printf(m, "pool hit: %u\n", qdf_atomic_read(&pool->hit));
+	wmi_bp_seq_printf(m, "pool miss: %u\n",
+			  qdf_atomic_read(&pool->miss));
+
+	return 0;
+}
+
+/**
+ * debug_wmi_htc_pkt_pool_stats_write() - debugfs functions to clear the
+ * hit and miss counts of the WMI command HTC packet pool.
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ * @ppos: Not used
+ *
+ * Return: count
+ */
+static ssize_t debug_wmi_htc_pkt_pool_stats_write(struct file *file,
+						  const char __user *buf,
+						  size_t count, loff_t *ppos)
+{
+	wmi_unified_t wmi_handle =
+		((struct seq_file *)file->private_data)->private;
+	int k, ret;
+	char locbuf[50];
+
+	if ((!buf) || (count > 50))
+		return -EFAULT;
+
+	if (copy_from_user(locbuf, buf, count))
+		return -EFAULT;
+
+	ret = sscanf(locbuf, "%d", &k);
+	if ((ret != 1) || (k != 0))
+		return -EINVAL;
+
+	qdf_atomic_set(&wmi_handle->htc_pkt_pool.hit, 0);
+	qdf_atomic_set(&wmi_handle->htc_pkt_pool.miss, 0);
+	return count;
+}
+
 /**
  * debug_wmi_log_size_write() - reserved.
  *
@@ -1365,6 +1706,10 @@ GENERATE_DEBUG_STRUCTS(wmi_mgmt_command_tx_cmp_log);
 GENERATE_DEBUG_STRUCTS(wmi_mgmt_event_log);
 GENERATE_DEBUG_STRUCTS(wmi_enable);
 GENERATE_DEBUG_STRUCTS(wmi_log_size);
+GENERATE_DEBUG_STRUCTS(wmi_event_stats);
+GENERATE_DEBUG_STRUCTS(wmi_tlv_arena_stats);
+GENERATE_DEBUG_STRUCTS(wmi_rx_evt_lane_stats);
+GENERATE_DEBUG_STRUCTS(wmi_htc_pkt_pool_stats);
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 GENERATE_DEBUG_STRUCTS(filtered_wmi_cmds);
 GENERATE_DEBUG_STRUCTS(filtered_wmi_evts);
@@ -1382,6 +1727,10 @@ struct wmi_debugfs_info wmi_debugfs_infos[NUM_DEBUG_INFOS] = {
 	DEBUG_FOO(wmi_mgmt_event_log),
 	DEBUG_FOO(wmi_enable),
 	DEBUG_FOO(wmi_log_size),
+	DEBUG_FOO(wmi_event_stats),
+	DEBUG_FOO(wmi_tlv_arena_stats),
+	DEBUG_FOO(wmi_rx_evt_lane_stats),
+	DEBUG_FOO(wmi_htc_pkt_pool_stats),
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 	DEBUG_FOO(filtered_wmi_cmds),
 	DEBUG_FOO(filtered_wmi_evts),
@@ -1704,60 +2053,210 @@ static inline void wmi_unified_debug_dump(wmi_unified_t wmi_handle)
 						"WMI_NON_TLV_TARGET"));
 }
 
-QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
-				   uint32_t len, uint32_t cmd_id,
-				   const char *func, uint32_t line)
+/**
+ * wmi_htc_pkt_pool_init() - allocate the HTC packet pool of a wmi handle
+ * @wmi_handle: handle to wmi
+ *
+ * The pool holds one packet per command that may be pending, so command
+ * send only falls back to the heap if completions are being held back.
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_pool_init(struct wmi_unified *wmi_handle)
 {
-	HTC_PACKET *pkt;
-	QDF_STATUS status;
-	uint16_t htc_tag = 0;
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
+	uint16_t size = wmi_handle->wmi_max_cmds;
+	uint16_t i;
 
-	if (wmi_get_runtime_pm_inprogress(wmi_handle)) {
-		htc_tag = wmi_handle->ops->wmi_set_htc_tx_tag(wmi_handle, buf,
-							      cmd_id);
-	} else if (qdf_atomic_read(&wmi_handle->is_target_suspended) &&
-		   !wmi_is_pm_resume_cmd(cmd_id) &&
-		   !wmi_is_legacy_d0wow_disable_cmd(buf, cmd_id)) {
-			wmi_nofl_err("Target is suspended (via %s:%u)",
-					func, line);
-		return QDF_STATUS_E_BUSY;
-	}
+	if (!size)
+		return;
 
-	if (wmi_handle->wmi_stopinprogress) {
-		wmi_nofl_err("%s:%d, WMI stop in progress, wmi_handle:%pK",
-			     func, line, wmi_handle);
-		return QDF_STATUS_E_INVAL;
+	pool->pkts = qdf_mem_malloc(size * sizeof(*pool->pkts));
+	pool->next = qdf_mem_malloc(size * sizeof(*pool->next));
+	if (!pool->pkts || !pool->next) {
+		qdf_mem_free(pool->pkts);
+		qdf_mem_free(pool->next);
+		pool->pkts = NULL;
+		pool->next = NULL;
+		return;
 	}
 
-#ifndef WMI_NON_TLV_SUPPORT
-	/* Do sanity check on the TLV parameter structure */
-	if (wmi_handle->target_type == WMI_TLV_TARGET) {
-		void *buf_ptr = (void *)qdf_nbuf_data(buf);
+	for (i = 0; i < size; i++)
+		pool->next[i] = (i + 1 < size) ? i + 2 : 0;
 
-		if (wmi_handle->ops->wmi_check_command_params(NULL, buf_ptr, len, cmd_id)
-			!= 0) {
-			wmi_nofl_err("%s:%d, Invalid WMI Param Buffer for Cmd:%d",
-				     func, line, cmd_id);
-			return QDF_STATUS_E_INVAL;
-		}
-	}
-#endif
+	pool->size = size;
+	qdf_atomic_init(&pool->hit);
+	qdf_atomic_init(&pool->miss);
+	qdf_atomic_set(&pool->head, 1);
+}
 
-	if (qdf_nbuf_push_head(buf, sizeof(WMI_CMD_HDR)) == NULL) {
-		wmi_nofl_err("%s:%d, Failed to send cmd %x, no memory",
-			     func, line, cmd_id);
-		return QDF_STATUS_E_NOMEM;
-	}
+/**
+ * wmi_htc_pkt_pool_deinit() - free the HTC packet pool of a wmi handle
+ * @wmi_handle: handle to wmi
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_pool_deinit(struct wmi_unified *wmi_handle)
+{
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
 
-	qdf_mem_zero(qdf_nbuf_data(buf), sizeof(WMI_CMD_HDR));
-	WMI_SET_FIELD(qdf_nbuf_data(buf), WMI_CMD_HDR, COMMANDID, cmd_id);
+	if (!pool->pkts)
+		return;
 
-	qdf_atomic_inc(&wmi_handle->pending_cmds);
-	if (qdf_atomic_read(&wmi_handle->pending_cmds) >=
-			wmi_handle->wmi_max_cmds) {
-		wmi_nofl_err("hostcredits = %d",
-			     wmi_get_host_credits(wmi_handle));
-		htc_dump_counter_info(wmi_handle->htc_handle);
+	qdf_atomic_set(&pool->head, 0);
+	pool->size = 0;
+	qdf_mem_free(pool->next);
+	qdf_mem_free(pool->pkts);
+	pool->next = NULL;
+	pool->pkts = NULL;
+}
+
+/**
+ * wmi_htc_pkt_alloc() - get an HTC packet to send a WMI command
+ * @wmi_handle: handle to wmi
+ * @func: caller function name
+ * @line: caller line number
+ *
+ * Return: zeroed HTC packet or NULL on failure
+ */
+static HTC_PACKET *wmi_htc_pkt_alloc(struct wmi_unified *wmi_handle,
+				     const char *func, uint32_t line)
+{
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
+	HTC_PACKET *pkt;
+	uint32_t old, new;
+	uint16_t idx;
+
+	do {
+		old = qdf_atomic_read(&pool->head);
+		idx = old & WMI_HTC_PKT_POOL_IDX_MASK;
+		if (!idx) {
+			qdf_atomic_inc(&pool->miss);
+			return qdf_mem_malloc_fl(sizeof(*pkt), func, line);
+		}
+		new = ((old + WMI_HTC_PKT_POOL_TAG_INC) &
+		       ~WMI_HTC_PKT_POOL_IDX_MASK) | pool->next[idx - 1];
+	} while (qdf_atomic_cmpxchg(&pool->head, old, new) != old);
+
+	qdf_atomic_inc(&pool->hit);
+	pkt = &pool->pkts[idx - 1];
+	qdf_mem_zero(pkt, sizeof(*pkt));
+
+	return pkt;
+}
+
+/**
+ * wmi_htc_pkt_is_pooled() - check if an HTC packet belongs to the pool
+ * @wmi_handle: handle to wmi
+ * @pkt: HTC packet
+ *
+ * Return: true if @pkt was served from the HTC packet pool
+ */
+static inline bool wmi_htc_pkt_is_pooled(struct wmi_unified *wmi_handle,
+					 HTC_PACKET *pkt)
+{
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
+
+	return pool->pkts && pkt >= pool->pkts &&
+	       pkt < pool->pkts + pool->size;
+}
+
+/**
+ * wmi_htc_pkt_free() - release an HTC packet used to send a WMI command
+ * @wmi_handle: handle to wmi
+ * @pkt: HTC packet from wmi_htc_pkt_alloc()
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_free(struct wmi_unified *wmi_handle, HTC_PACKET *pkt)
+{
+	struct wmi_htc_pkt_pool *pool = &wmi_handle->htc_pkt_pool;
+	uint32_t old, new;
+	uint16_t idx;
+
+	if (!wmi_htc_pkt_is_pooled(wmi_handle, pkt)) {
+		qdf_mem_free(pkt);
+		return;
+	}
+
+	idx = pkt - pool->pkts;
+	do {
+		old = qdf_atomic_read(&pool->head);
+		pool->next[idx] = old & WMI_HTC_PKT_POOL_IDX_MASK;
+		new = ((old + WMI_HTC_PKT_POOL_TAG_INC) &
+		       ~WMI_HTC_PKT_POOL_IDX_MASK) | (idx + 1);
+	} while (qdf_atomic_cmpxchg(&pool->head, old, new) != old);
+}
+
+/**
+ * wmi_unified_cmd_prepare() - validate a WMI command and build its HTC packet
+ * @wmi_handle: handle to wmi
+ * @buf: wmi command buffer
+ * @len: wmi command buffer length
+ * @cmd_id: WMI cmd id
+ * @func: caller function name
+ * @line: caller line number
+ * @pkt_out: HTC packet ready to be handed to HTC
+ *
+ * On success the command is accounted in pending_cmds and recorded in the
+ * command log.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS wmi_unified_cmd_prepare(wmi_unified_t wmi_handle,
+					  wmi_buf_t buf, uint32_t len,
+					  uint32_t cmd_id, const char *func,
+					  uint32_t line, HTC_PACKET **pkt_out)
+{
+	HTC_PACKET *pkt;
+	uint16_t htc_tag = 0;
+
+	if (wmi_get_runtime_pm_inprogress(wmi_handle)) {
+		htc_tag = wmi_handle->ops->wmi_set_htc_tx_tag(wmi_handle, buf,
+							      cmd_id);
+	} else if (qdf_atomic_read(&wmi_handle->is_target_suspended) &&
+		   !wmi_is_pm_resume_cmd(cmd_id) &&
+		   !wmi_is_legacy_d0wow_disable_cmd(buf, cmd_id)) {
+			wmi_nofl_err("Target is suspended (via %s:%u)",
+					func, line);
+		return QDF_STATUS_E_BUSY;
+	}
+
+	if (wmi_handle->wmi_stopinprogress) {
+		wmi_nofl_err("%s:%d, WMI stop in progress, wmi_handle:%pK",
+			     func, line, wmi_handle);
+		return QDF_STATUS_E_INVAL;
+	}
+
+#ifndef WMI_NON_TLV_SUPPORT
+	/* Do sanity check on the TLV parameter structure */
+	if (wmi_handle->target_type == WMI_TLV_TARGET) {
+		void *buf_ptr = (void *)qdf_nbuf_data(buf);
+
+		if (wmi_handle->ops->wmi_check_command_params(NULL, buf_ptr, len, cmd_id)
+			!= 0) {
+			wmi_nofl_err("%s:%d, Invalid WMI Param Buffer for Cmd:%d",
+				     func, line, cmd_id);
+			return QDF_STATUS_E_INVAL;
+		}
+	}
+#endif
+
+	if (qdf_nbuf_push_head(buf, sizeof(WMI_CMD_HDR)) == NULL) {
+		wmi_nofl_err("%s:%d, Failed to send cmd %x, no memory",
+			     func, line, cmd_id);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	qdf_mem_zero(qdf_nbuf_data(buf), sizeof(WMI_CMD_HDR));
+	WMI_SET_FIELD(qdf_nbuf_data(buf), WMI_CMD_HDR, COMMANDID, cmd_id);
+
+	qdf_atomic_inc(&wmi_handle->pending_cmds);
+	if (qdf_atomic_read(&wmi_handle->pending_cmds) >=
+			wmi_handle->wmi_max_cmds) {
+		wmi_nofl_err("hostcredits = %d",
+			     wmi_get_host_credits(wmi_handle));
+		htc_dump_counter_info(wmi_handle->htc_handle);
 		qdf_atomic_dec(&wmi_handle->pending_cmds);
 		wmi_nofl_err("%s:%d, MAX %d WMI Pending cmds reached",
 			     func, line, wmi_handle->wmi_max_cmds);
@@ -1768,7 +2267,7 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 		return QDF_STATUS_E_BUSY;
 	}
 
-	pkt = qdf_mem_malloc_fl(sizeof(*pkt), func, line);
+	pkt = wmi_htc_pkt_alloc(wmi_handle, func, line);
 	if (!pkt) {
 		qdf_atomic_dec(&wmi_handle->pending_cmds);
 		return QDF_STATUS_E_NOMEM;
@@ -1778,6 +2277,12 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 			       NULL,
 			       qdf_nbuf_data(buf), len + sizeof(WMI_CMD_HDR),
 			       wmi_handle->wmi_endpoint_id, htc_tag);
+	/*
+	 * HTC drops the packet on its own when the target is down, pooled
+	 * packets come back through wmi_htc_pkt_release()
+	 */
+	if (wmi_htc_pkt_is_pooled(wmi_handle, pkt))
+		pkt->PktInfo.AsTx.Flags |= HTC_TX_PACKET_FLAG_POOLED;
 
 	SET_HTC_PACKET_NET_BUF_CONTEXT(pkt, buf);
 	wmi_log_cmd_id(cmd_id, htc_tag);
@@ -1803,13 +2308,30 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 	}
 #endif
 
+	*pkt_out = pkt;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				   uint32_t len, uint32_t cmd_id,
+				   const char *func, uint32_t line)
+{
+	HTC_PACKET *pkt;
+	QDF_STATUS status;
+
+	status = wmi_unified_cmd_prepare(wmi_handle, buf, len, cmd_id,
+					 func, line, &pkt);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
 	status = htc_send_pkt(wmi_handle->htc_handle, pkt);
 
 	if (QDF_STATUS_SUCCESS != status) {
 		qdf_atomic_dec(&wmi_handle->pending_cmds);
 		wmi_nofl_err("%s:%d, htc_send_pkt failed, status:%d",
 			     func, line, status);
-		qdf_mem_free(pkt);
+		wmi_htc_pkt_free(wmi_handle, pkt);
 		return status;
 	}
 
@@ -1817,6 +2339,188 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 }
 qdf_export_symbol(wmi_unified_cmd_send_fl);
 
+#if defined(HIF_SDIO) || defined(HIF_USB)
+void wmi_unified_cmd_batch_begin(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch)
+{
+	INIT_HTC_PACKET_QUEUE(&batch->pkt_queue);
+}
+qdf_export_symbol(wmi_unified_cmd_batch_begin);
+
+QDF_STATUS wmi_unified_cmd_batch_add_fl(wmi_unified_t wmi_handle,
+					struct wmi_cmd_batch *batch,
+					wmi_buf_t buf, uint32_t len,
+					uint32_t cmd_id, const char *func,
+					uint32_t line)
+{
+	HTC_PACKET *pkt;
+	QDF_STATUS status;
+
+	if (HTC_PACKET_QUEUE_DEPTH(&batch->pkt_queue) >= WMI_CMD_BATCH_MAX) {
+		status = wmi_unified_cmd_batch_commit(wmi_handle, batch);
+		if (QDF_IS_STATUS_ERROR(status))
+			return status;
+	}
+
+	status = wmi_unified_cmd_prepare(wmi_handle, buf, len, cmd_id,
+					 func, line, &pkt);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	HTC_PACKET_ENQUEUE(&batch->pkt_queue, pkt);
+
+	return QDF_STATUS_SUCCESS;
+}
+qdf_export_symbol(wmi_unified_cmd_batch_add_fl);
+
+QDF_STATUS wmi_unified_cmd_batch_commit(wmi_unified_t wmi_handle,
+					struct wmi_cmd_batch *batch)
+{
+	HTC_PACKET *pkt;
+	QDF_STATUS status;
+
+	if (HTC_QUEUE_EMPTY(&batch->pkt_queue))
+		return QDF_STATUS_SUCCESS;
+
+	status = htc_send_pkts_multiple(wmi_handle->htc_handle,
+					&batch->pkt_queue);
+	if (QDF_STATUS_SUCCESS == status)
+		return status;
+
+	/* the commands HTC did not accept are dropped here */
+	while ((pkt = htc_packet_dequeue(&batch->pkt_queue))) {
+		wmi_err("htc_send_pkts_multiple failed, status:%d cmd:0x%x",
+			status,
+			WMI_GET_FIELD(qdf_nbuf_data(
+				      GET_HTC_PACKET_NET_BUF_CONTEXT(pkt)),
+				      WMI_CMD_HDR, COMMANDID));
+		qdf_atomic_dec(&wmi_handle->pending_cmds);
+		wmi_buf_free(GET_HTC_PACKET_NET_BUF_CONTEXT(pkt));
+		wmi_htc_pkt_free(wmi_handle, pkt);
+	}
+
+	return status;
+}
+qdf_export_symbol(wmi_unified_cmd_batch_commit);
+#else
+/*
+ * CE based buses do not bundle HTC tx, so there is nothing to gain from
+ * holding commands back: a batched command is sent right away.
+ */
+void wmi_unified_cmd_batch_begin(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch)
+{
+	INIT_HTC_PACKET_QUEUE(&batch->pkt_queue);
+}
+qdf_export_symbol(wmi_unified_cmd_batch_begin);
+
+QDF_STATUS wmi_unified_cmd_batch_add_fl(wmi_unified_t wmi_handle,
+					struct wmi_cmd_batch *batch,
+					wmi_buf_t buf, uint32_t len,
+					uint32_t cmd_id, const char *func,
+					uint32_t line)
+{
+	return wmi_unified_cmd_send_fl(wmi_handle, buf, len, cmd_id,
+				       func, line);
+}
+qdf_export_symbol(wmi_unified_cmd_batch_add_fl);
+
+QDF_STATUS wmi_unified_cmd_batch_commit(wmi_unified_t wmi_handle,
+					struct wmi_cmd_batch *batch)
+{
+	return QDF_STATUS_SUCCESS;
+}
+qdf_export_symbol(wmi_unified_cmd_batch_commit);
+#endif /* HIF_SDIO || HIF_USB */
+
+/**
+ * wmi_event_hash_slot() - home slot of an event id in the event hash
+ * @event_id: wmi event id
+ *
+ * Return: slot index in wmi_soc event_hash
+ */
+static inline uint32_t wmi_event_hash_slot(uint32_t event_id)
+{
+	return (event_id * 0x9E3779B1) >> (32 - WMI_EVENT_HASH_BITS);
+}
+
+/**
+ * wmi_event_hash_find() - find the hash slot holding an event id
+ * @wmi_handle: handle to wmi
+ * @event_id: wmi event id
+ *
+ * Return: slot index, -1 if the event id is not in the hash
+ */
+static int wmi_event_hash_find(wmi_unified_t wmi_handle, uint32_t event_id)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t slot = wmi_event_hash_slot(event_id);
+	uint16_t entry;
+
+	while ((entry = soc->event_hash[slot])) {
+		if (wmi_handle->event_id[entry - 1] == event_id)
+			return slot;
+		slot = (slot + 1) & (WMI_EVENT_HASH_SIZE - 1);
+	}
+
+	return -1;
+}
+
+/**
+ * wmi_event_hash_add() - add an event handler index to the event hash
+ * @wmi_handle: handle to wmi
+ * @event_id: wmi event id
+ * @idx: event handler's index
+ *
+ * Return: none
+ */
+static void wmi_event_hash_add(wmi_unified_t wmi_handle, uint32_t event_id,
+			       uint32_t idx)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t slot = wmi_event_hash_slot(event_id);
+
+	while (soc->event_hash[slot])
+		slot = (slot + 1) & (WMI_EVENT_HASH_SIZE - 1);
+
+	soc->event_hash[slot] = idx + 1;
+}
+
+/**
+ * wmi_event_hash_del() - remove an event id from the event hash
+ * @wmi_handle: handle to wmi
+ * @slot: slot holding the event id
+ *
+ * Entries placed after the removed one are shifted back so that every
+ * entry stays reachable from its home slot without tombstones.
+ *
+ * Return: none
+ */
+static void wmi_event_hash_del(wmi_unified_t wmi_handle, uint32_t slot)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t next = slot;
+	uint32_t home;
+	uint16_t entry;
+
+	while (true) {
+		next = (next + 1) & (WMI_EVENT_HASH_SIZE - 1);
+		entry = soc->event_hash[next];
+		if (!entry)
+			break;
+
+		home = wmi_event_hash_slot(wmi_handle->event_id[entry - 1]);
+		/* entry may move back only if its home is not in (slot, next] */
+		if (((next - home) & (WMI_EVENT_HASH_SIZE - 1)) >=
+		    ((next - slot) & (WMI_EVENT_HASH_SIZE - 1))) {
+			soc->event_hash[slot] = entry;
+			slot = next;
+		}
+	}
+
+	soc->event_hash[slot] = 0;
+}
+
 /**
  * wmi_unified_get_event_handler_ix() - gives event handler's index
  * @wmi_handle: handle to wmi
@@ -1827,19 +2531,87 @@ qdf_export_symbol(wmi_unified_cmd_send_fl);
 static int wmi_unified_get_event_handler_ix(wmi_unified_t wmi_handle,
 					    uint32_t event_id)
 {
-	uint32_t idx = 0;
-	int32_t invalid_idx = -1;
+	int slot;
+	uint32_t idx;
+
+	slot = wmi_event_hash_find(wmi_handle, event_id);
+	if (slot < 0)
+		return -1;
+
+	idx = wmi_handle->soc->event_hash[slot] - 1;
+	if (!wmi_handle->event_handler[idx])
+		return -1;
+
+	return idx;
+}
+
+/**
+ * wmi_unified_event_handler_add() - add an event handler at the next index
+ * @wmi_handle: handle to wmi
+ * @evt_id: target wmi event id
+ * @handler_func: wmi event handler function
+ * @rx_ctx: rx execution context for the event
+ *
+ * Return: none
+ */
+static void wmi_unified_event_handler_add(wmi_unified_t wmi_handle,
+					  uint32_t evt_id,
+					  wmi_unified_event_handler handler_func,
+					  uint8_t rx_ctx)
+{
 	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t idx = soc->max_event_idx;
 
-	for (idx = 0; (idx < soc->max_event_idx &&
-		       idx < WMI_UNIFIED_MAX_EVENT); ++idx) {
-		if (wmi_handle->event_id[idx] == event_id &&
-		    wmi_handle->event_handler[idx]) {
-			return idx;
-		}
-	}
+	wmi_handle->event_handler[idx] = handler_func;
+	wmi_handle->event_id[idx] = evt_id;
+	wmi_event_stats_reset(&soc->event_stats[idx]);
+	qdf_spin_lock_bh(&soc->ctx_lock);
+	wmi_handle->ctx[idx] = rx_ctx;
+	qdf_spin_unlock_bh(&soc->ctx_lock);
+	wmi_event_hash_add(wmi_handle, evt_id, idx);
+	soc->max_event_idx++;
+}
 
-	return invalid_idx;
+/**
+ * wmi_unified_event_handler_del() - remove the event handler at an index
+ * @wmi_handle: handle to wmi
+ * @idx: event handler's index
+ *
+ * The last registered handler is moved into the freed index, together
+ * with its rx context and statistics, and its hash entry is updated.
+ *
+ * Return: none
+ */
+static void wmi_unified_event_handler_del(wmi_unified_t wmi_handle,
+					  uint32_t idx)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t last;
+	int slot;
+
+	slot = wmi_event_hash_find(wmi_handle, wmi_handle->event_id[idx]);
+	if (slot >= 0)
+		wmi_event_hash_del(wmi_handle, slot);
+
+	wmi_handle->event_handler[idx] = NULL;
+	wmi_handle->event_id[idx] = 0;
+	last = --soc->max_event_idx;
+	if (last == idx)
+		return;
+
+	wmi_handle->event_handler[idx] = wmi_handle->event_handler[last];
+	wmi_handle->event_id[idx] = wmi_handle->event_id[last];
+	wmi_event_stats_copy(&soc->event_stats[idx], &soc->event_stats[last]);
+	qdf_spin_lock_bh(&soc->ctx_lock);
+	wmi_handle->ctx[idx] = wmi_handle->ctx[last];
+	qdf_spin_unlock_bh(&soc->ctx_lock);
+
+	slot = wmi_event_hash_find(wmi_handle, wmi_handle->event_id[idx]);
+	if (slot >= 0)
+		soc->event_hash[slot] = idx + 1;
+
+	wmi_handle->event_handler[last] = NULL;
+	wmi_handle->event_id[last] = 0;
 }
 
 /**
@@ -1854,7 +2626,6 @@ int wmi_unified_register_event(wmi_unified_t wmi_handle,
 				       uint32_t event_id,
 				       wmi_unified_event_handler handler_func)
 {
-	uint32_t idx = 0;
 	uint32_t evt_id;
 	struct wmi_soc *soc;
 
@@ -1885,13 +2656,8 @@ int wmi_unified_register_event(wmi_unified_t wmi_handle,
 					__func__, evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
-	idx = soc->max_event_idx;
-	wmi_handle->event_handler[idx] = handler_func;
-	wmi_handle->event_id[idx] = evt_id;
-	qdf_spin_lock_bh(&soc->ctx_lock);
-	wmi_handle->ctx[idx] = WMI_RX_UMAC_CTX;
-	qdf_spin_unlock_bh(&soc->ctx_lock);
-	soc->max_event_idx++;
+	wmi_unified_event_handler_add(wmi_handle, evt_id, handler_func,
+				      WMI_RX_UMAC_CTX);
 
 	return 0;
 }
@@ -1911,7 +2677,6 @@ int wmi_unified_register_event_handler(wmi_unified_t wmi_handle,
 				       wmi_unified_event_handler handler_func,
 				       uint8_t rx_ctx)
 {
-	uint32_t idx = 0;
 	uint32_t evt_id;
 	struct wmi_soc *soc;
 
@@ -1942,13 +2707,8 @@ int wmi_unified_register_event_handler(wmi_unified_t wmi_handle,
 	}
 	QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_DEBUG,
 		  "Registered event handler for event 0x%8x", evt_id);
-	idx = soc->max_event_idx;
-	wmi_handle->event_handler[idx] = handler_func;
-	wmi_handle->event_id[idx] = evt_id;
-	qdf_spin_lock_bh(&soc->ctx_lock);
-	wmi_handle->ctx[idx] = rx_ctx;
-	qdf_spin_unlock_bh(&soc->ctx_lock);
-	soc->max_event_idx++;
+	wmi_unified_event_handler_add(wmi_handle, evt_id, handler_func,
+				      rx_ctx);
 
 	return 0;
 }
@@ -1966,7 +2726,6 @@ int wmi_unified_unregister_event(wmi_unified_t wmi_handle,
 {
 	uint32_t idx = 0;
 	uint32_t evt_id;
-	struct wmi_soc *soc = wmi_handle->soc;
 
 	if (event_id >= wmi_events_max ||
 		wmi_handle->wmi_events[event_id] == WMI_EVENT_ID_INVALID) {
@@ -1983,13 +2742,7 @@ int wmi_unified_unregister_event(wmi_unified_t wmi_handle,
 			 evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
-	wmi_handle->event_handler[idx] = NULL;
-	wmi_handle->event_id[idx] = 0;
-	--soc->max_event_idx;
-	wmi_handle->event_handler[idx] =
-		wmi_handle->event_handler[soc->max_event_idx];
-	wmi_handle->event_id[idx] =
-		wmi_handle->event_id[soc->max_event_idx];
+	wmi_unified_event_handler_del(wmi_handle, idx);
 
 	return 0;
 }
@@ -2006,15 +2759,12 @@ int wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle,
 {
 	uint32_t idx = 0;
 	uint32_t evt_id;
-	struct wmi_soc *soc;
 
 	if (!wmi_handle) {
 		WMI_LOGE("WMI handle is NULL");
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	soc = wmi_handle->soc;
-
 	if (event_id >= wmi_events_max ||
 		wmi_handle->wmi_events[event_id] == WMI_EVENT_ID_INVALID) {
 		wmi_err("Event id %d is unavailable", event_id);
@@ -2028,33 +2778,12 @@ int wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle,
 			 evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
-	wmi_handle->event_handler[idx] = NULL;
-	wmi_handle->event_id[idx] = 0;
-	--soc->max_event_idx;
-	wmi_handle->event_handler[idx] =
-		wmi_handle->event_handler[soc->max_event_idx];
-	wmi_handle->event_id[idx] =
-		wmi_handle->event_id[soc->max_event_idx];
+	wmi_unified_event_handler_del(wmi_handle, idx);
 
 	return 0;
 }
 qdf_export_symbol(wmi_unified_unregister_event_handler);
 
-void wmi_process_fw_event_worker_thread_ctx(struct wmi_unified *wmi_handle,
-					    void *evt_buf)
-{
-
-	qdf_spin_lock_bh(&wmi_handle->eventq_lock);
-	qdf_nbuf_queue_add(&wmi_handle->event_queue, evt_buf);
-	qdf_spin_unlock_bh(&wmi_handle->eventq_lock);
-	qdf_queue_work(0, wmi_handle->wmi_rx_work_queue,
-			&wmi_handle->rx_event_work);
-
-	return;
-}
-
-qdf_export_symbol(wmi_process_fw_event_worker_thread_ctx);
-
 uint32_t wmi_critical_events_in_flight(struct wmi_unified *wmi)
 {
 	return qdf_atomic_read(&wmi->critical_events_in_flight);
@@ -2069,6 +2798,92 @@ wmi_is_event_critical(struct wmi_unified *wmi_handle, uint32_t event_id)
 	return false;
 }
 
+/**
+ * wmi_rx_evt_class_get() - classify an event for rx work context processing
+ * @wmi_handle: wmi handle
+ * @event_id: target event id
+ *
+ * Critical events are the ones tracked by wmi_is_event_critical() along
+ * with the peer kickout, CSA and roam events which should not wait behind
+ * a long running stats or scan event handler.
+ *
+ * Return: class of the event
+ */
+static enum wmi_rx_evt_class
+wmi_rx_evt_class_get(struct wmi_unified *wmi_handle, uint32_t event_id)
+{
+	uint32_t *wmi_events = wmi_handle->wmi_events;
+
+	if (wmi_is_event_critical(wmi_handle, event_id) ||
+	    event_id == wmi_events[wmi_peer_sta_kickout_event_id] ||
+	    event_id == wmi_events[wmi_csa_handling_event_id] ||
+	    event_id == wmi_events[wmi_roam_event_id])
+		return WMI_RX_EVT_CLASS_CRITICAL;
+
+	if (wmi_handle->ops->is_management_record(event_id))
+		return WMI_RX_EVT_CLASS_MGMT;
+
+	return WMI_RX_EVT_CLASS_BULK;
+}
+
+/**
+ * wmi_rx_evt_depth_bucket() - log2 bucket of a rx event queue depth
+ * @depth: queue depth
+ *
+ * Return: histogram bucket index
+ */
+static inline uint32_t wmi_rx_evt_depth_bucket(uint32_t depth)
+{
+	return qdf_min((uint32_t)qdf_fls(depth),
+		       (uint32_t)(WMI_RX_EVT_HIST_MAX - 1));
+}
+
+/**
+ * wmi_rx_evt_dwell_bucket() - histogram bucket of a rx event dwell time
+ * @dwell_us: time the event waited in its queue, in us
+ *
+ * Return: histogram bucket index
+ */
+static inline uint32_t wmi_rx_evt_dwell_bucket(uint32_t dwell_us)
+{
+	uint32_t i;
+
+	for (i = 0; i < WMI_RX_EVT_HIST_MAX - 1; i++)
+		if (dwell_us < wmi_rx_evt_dwell_us[i])
+			break;
+
+	return i;
+}
+
+void wmi_process_fw_event_worker_thread_ctx(struct wmi_unified *wmi_handle,
+					    void *evt_buf)
+{
+	struct wmi_rx_evt_lane *lane;
+	enum wmi_rx_evt_class evt_class;
+	uint32_t depth;
+
+	evt_class = wmi_rx_evt_class_get(wmi_handle,
+					 WMI_GET_FIELD(qdf_nbuf_data(evt_buf),
+						       WMI_CMD_HDR,
+						       COMMANDID));
+	lane = &wmi_handle->rx_evt_lane[evt_class];
+
+	qdf_nbuf_set_timestamp(evt_buf);
+	qdf_spin_lock_bh(&lane->eventq_lock);
+	depth = qdf_nbuf_queue_len(&lane->event_queue);
+	qdf_nbuf_queue_add(&lane->event_queue, evt_buf);
+	lane->enqueued++;
+	if (depth >= lane->max_depth)
+		lane->max_depth = depth + 1;
+	lane->depth_hist[wmi_rx_evt_depth_bucket(depth)]++;
+	qdf_spin_unlock_bh(&lane->eventq_lock);
+	qdf_queue_work(0, lane->wmi_rx_work_queue, &lane->rx_event_work);
+
+	return;
+}
+
+qdf_export_symbol(wmi_process_fw_event_worker_thread_ctx);
+
 static QDF_STATUS wmi_discard_fw_event(struct scheduler_msg *msg)
 {
 	struct wmi_process_fw_event_params *event_param;
@@ -2377,13 +3192,46 @@ void wmi_process_fw_event(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 }
 
 /**
- * __wmi_control_rx() - process serialize wmi event callback
+ * wmi_event_stats_update() - account one run of an event handler
  * @wmi_handle: wmi handle
+ * @idx: event handler's index
+ * @start_ts: qdf_log_timestamp taken before calling the handler
+ *
+ * Return: none
+ */
+static inline void wmi_event_stats_update(struct wmi_unified *wmi_handle,
+					  uint32_t idx, uint64_t start_ts)
+{
+	struct wmi_event_stats *stats = &wmi_handle->soc->event_stats[idx];
+	uint32_t time_us;
+	uint32_t max;
+	uint32_t old;
+
+	time_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() -
+					     start_ts);
+	qdf_atomic_inc(&stats->count);
+	qdf_atomic64_add(time_us, &stats->total_time_us);
+
+	max = qdf_atomic_read(&stats->max_time_us);
+	while (time_us > max) {
+		old = qdf_atomic_cmpxchg(&stats->max_time_us, max, time_us);
+		if (old == max)
+			break;
+		max = old;
+	}
+}
+
+/**
+ * wmi_control_rx_arena() - process serialize wmi event callback
+ * @wmi_handle: wmi handle
+ * @arena: event TLV scratch arena owned by the calling context
  * @evt_buf: fw event buffer
  *
  * Return: none
  */
-void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
+static void wmi_control_rx_arena(struct wmi_unified *wmi_handle,
+				 struct wmitlv_arena *arena,
+				 wmi_buf_t evt_buf)
 {
 	uint32_t id;
 	uint8_t *data;
@@ -2393,6 +3241,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	int tlv_ok_status = 0;
 #endif
 	uint32_t idx = 0;
+	uint64_t start_ts;
 
 	id = WMI_GET_FIELD(qdf_nbuf_data(evt_buf), WMI_CMD_HDR, COMMANDID);
 
@@ -2410,6 +3259,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 		/* Validate and pad(if necessary) the TLVs */
 		tlv_ok_status =
 			wmi_handle->ops->wmi_check_and_pad_event(wmi_handle->scn_handle,
+							arena,
 							data, len, id,
 							&wmi_cmd_struct_ptr);
 		if (tlv_ok_status != 0) {
@@ -2453,24 +3303,39 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	}
 #endif
 	/* Call the WMI registered event handler */
+	start_ts = qdf_get_log_timestamp();
 	if (wmi_handle->target_type == WMI_TLV_TARGET)
 		wmi_handle->event_handler[idx] (wmi_handle->scn_handle,
 			wmi_cmd_struct_ptr, len);
 	else
 		wmi_handle->event_handler[idx] (wmi_handle->scn_handle,
 			data, len);
+	wmi_event_stats_update(wmi_handle, idx, start_ts);
 
 end:
 	/* Free event buffer and allocated event tlv */
 #ifndef WMI_NON_TLV_SUPPORT
 	if (wmi_handle->target_type == WMI_TLV_TARGET)
-		wmi_handle->ops->wmi_free_allocated_event(id, &wmi_cmd_struct_ptr);
+		wmi_handle->ops->wmi_free_allocated_event(arena, id,
+							  &wmi_cmd_struct_ptr);
 #endif
 
 	qdf_nbuf_free(evt_buf);
 
 }
 
+/**
+ * __wmi_control_rx() - process serialize wmi event callback
+ * @wmi_handle: wmi handle
+ * @evt_buf: fw event buffer
+ *
+ * Return: none
+ */
+void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
+{
+	wmi_control_rx_arena(wmi_handle, &wmi_handle->tlv_arena, evt_buf);
+}
+
 #define WMI_WQ_WD_TIMEOUT (30 * 1000) /* 30s */
 
 static inline void wmi_workqueue_watchdog_warn(uint32_t msg_type_id)
@@ -2503,40 +3368,135 @@ static inline void wmi_workqueue_watchdog_bite(void *arg)
 
 /**
  * wmi_rx_event_work() - process rx event in rx work queue context
- * @arg: opaque pointer to wmi handle
+ * @arg: opaque pointer to the rx event lane
  *
  * This function process any fw event to serialize it through rx worker thread.
+ * Each event class has its own worker so events are serialized per class.
  *
  * Return: none
  */
 static void wmi_rx_event_work(void *arg)
 {
 	wmi_buf_t buf;
-	struct wmi_unified *wmi = arg;
+	struct wmi_rx_evt_lane *lane = arg;
+	struct wmi_unified *wmi = lane->wmi_handle;
 	qdf_timer_t wd_timer;
 	struct wmi_wq_dbg_info info;
 
 	/* initialize WMI workqueue watchdog timer */
 	qdf_timer_init(NULL, &wd_timer, &wmi_workqueue_watchdog_bite,
 			&info, QDF_TIMER_TYPE_SW);
-	qdf_spin_lock_bh(&wmi->eventq_lock);
-	buf = qdf_nbuf_queue_remove(&wmi->event_queue);
-	qdf_spin_unlock_bh(&wmi->eventq_lock);
+	qdf_spin_lock_bh(&lane->eventq_lock);
+	buf = qdf_nbuf_queue_remove(&lane->event_queue);
+	qdf_spin_unlock_bh(&lane->eventq_lock);
 	while (buf) {
+		lane->dwell_hist[wmi_rx_evt_dwell_bucket(
+				 qdf_nbuf_get_timedelta_us(buf))]++;
 		qdf_timer_start(&wd_timer, WMI_WQ_WD_TIMEOUT);
 		info.wd_msg_type_id =
 		   WMI_GET_FIELD(qdf_nbuf_data(buf), WMI_CMD_HDR, COMMANDID);
-		info.wmi_wq = wmi->wmi_rx_work_queue;
+		info.wmi_wq = lane->wmi_rx_work_queue;
 		info.task = qdf_get_current_task();
-		__wmi_control_rx(wmi, buf);
+		wmi_control_rx_arena(wmi, &lane->tlv_arena, buf);
 		qdf_timer_stop(&wd_timer);
-		qdf_spin_lock_bh(&wmi->eventq_lock);
-		buf = qdf_nbuf_queue_remove(&wmi->event_queue);
-		qdf_spin_unlock_bh(&wmi->eventq_lock);
+		qdf_spin_lock_bh(&lane->eventq_lock);
+		buf = qdf_nbuf_queue_remove(&lane->event_queue);
+		qdf_spin_unlock_bh(&lane->eventq_lock);
 	}
 	qdf_timer_free(&wd_timer);
 }
 
+/**
+ * wmi_rx_evt_lane_purge() - free the events pending on a rx event lane
+ * @lane: rx event lane
+ *
+ * Return: none
+ */
+static void wmi_rx_evt_lane_purge(struct wmi_rx_evt_lane *lane)
+{
+	wmi_buf_t buf;
+
+	qdf_spin_lock_bh(&lane->eventq_lock);
+	buf = qdf_nbuf_queue_remove(&lane->event_queue);
+	while (buf) {
+		qdf_nbuf_free(buf);
+		buf = qdf_nbuf_queue_remove(&lane->event_queue);
+	}
+	qdf_spin_unlock_bh(&lane->eventq_lock);
+}
+
+/**
+ * wmi_rx_evt_lanes_deinit() - destroy the per class rx event workers
+ * @wmi_handle: wmi handle
+ *
+ * Return: none
+ */
+static void wmi_rx_evt_lanes_deinit(struct wmi_unified *wmi_handle)
+{
+	struct wmi_rx_evt_lane *lane;
+	uint8_t i;
+
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++) {
+		lane = &wmi_handle->rx_evt_lane[i];
+		if (!lane->wmi_rx_work_queue)
+			continue;
+
+		qdf_flush_workqueue(0, lane->wmi_rx_work_queue);
+		qdf_destroy_workqueue(0, lane->wmi_rx_work_queue);
+		lane->wmi_rx_work_queue = NULL;
+		wmi_rx_evt_lane_purge(lane);
+		qdf_spinlock_destroy(&lane->eventq_lock);
+		wmitlv_arena_deinit(&lane->tlv_arena);
+	}
+}
+
+/**
+ * wmi_rx_evt_lanes_init() - create the per class rx event workers
+ * @wmi_handle: wmi handle
+ *
+ * Critical events get a high priority ordered workqueue, the other classes
+ * an unbound one. A single work item per class keeps the events of a class
+ * in arrival order while letting the classes run in parallel. Each class
+ * decodes into its own TLV arena so that the workers do not push each
+ * other onto the heap.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS wmi_rx_evt_lanes_init(struct wmi_unified *wmi_handle)
+{
+	struct wmi_rx_evt_lane *lane;
+	uint8_t i;
+
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++) {
+		lane = &wmi_handle->rx_evt_lane[i];
+		lane->wmi_handle = wmi_handle;
+		qdf_spinlock_create(&lane->eventq_lock);
+		qdf_nbuf_queue_init(&lane->event_queue);
+		qdf_create_work(0, &lane->rx_event_work,
+				wmi_rx_event_work, lane);
+		if (i == WMI_RX_EVT_CLASS_CRITICAL)
+			lane->wmi_rx_work_queue =
+				qdf_alloc_high_prior_ordered_workqueue(
+						"wmi_rx_crit_event_work_queue");
+		else
+			lane->wmi_rx_work_queue =
+				qdf_alloc_unbound_workqueue(
+						"wmi_rx_event_work_queue");
+		if (!lane->wmi_rx_work_queue) {
+			WMI_LOGE("failed to create %s wmi_rx_event_work_queue",
+				 wmi_rx_evt_class_name[i]);
+			qdf_spinlock_destroy(&lane->eventq_lock);
+			wmi_rx_evt_lanes_deinit(wmi_handle);
+			return QDF_STATUS_E_NOMEM;
+		}
+		if (wmitlv_arena_init(&lane->tlv_arena))
+			WMI_LOGD("%s wmi tlv arena unavailable, using heap",
+				 wmi_rx_evt_class_name[i]);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
 #ifdef FEATURE_RUNTIME_PM
 /**
  * wmi_runtime_pm_init() - initialize runtime pm wmi variables
@@ -2630,17 +3590,8 @@ void *wmi_unified_get_pdev_handle(struct wmi_soc *soc, uint32_t pdev_idx)
 		wmi_handle->event_handler = soc->event_handler;
 		wmi_handle->ctx = soc->ctx;
 		wmi_handle->ops = soc->ops;
-		qdf_spinlock_create(&wmi_handle->eventq_lock);
-		qdf_nbuf_queue_init(&wmi_handle->event_queue);
-
-		qdf_create_work(0, &wmi_handle->rx_event_work,
-				wmi_rx_event_work, wmi_handle);
-		wmi_handle->wmi_rx_work_queue =
-			qdf_alloc_unbound_workqueue("wmi_rx_event_work_queue");
-		if (!wmi_handle->wmi_rx_work_queue) {
-			WMI_LOGE("failed to create wmi_rx_event_work_queue");
+		if (QDF_IS_STATUS_ERROR(wmi_rx_evt_lanes_init(wmi_handle)))
 			goto error;
-		}
 		wmi_handle->wmi_events = soc->wmi_events;
 		wmi_handle->services = soc->services;
 		wmi_handle->soc = soc;
@@ -2653,6 +3604,9 @@ void *wmi_unified_get_pdev_handle(struct wmi_soc *soc, uint32_t pdev_idx)
 		qdf_atomic_init(&wmi_handle->is_target_suspended);
 		wmi_handle->target_type = soc->target_type;
 		wmi_handle->wmi_max_cmds = soc->wmi_max_cmds;
+		if (wmitlv_arena_init(&wmi_handle->tlv_arena))
+			WMI_LOGD("wmi tlv arena unavailable, using heap");
+		wmi_htc_pkt_pool_init(wmi_handle);
 
 		soc->wmi_pdev[pdev_idx] = wmi_handle;
 	} else
@@ -2689,6 +3643,9 @@ qdf_export_symbol(wmi_unified_register_module);
  * wmi_wbuff_register() - register wmi with wbuff
  * @wmi_handle: handle to wmi
  *
+ * Along with the command nbuf pools, set up the HTC packet pool used to
+ * send the commands.
+ *
  * @Return: void
  */
 static void wmi_wbuff_register(struct wmi_unified *wmi_handle)
@@ -2706,6 +3663,7 @@ static void wmi_wbuff_register(struct wmi_unified *wmi_handle)
 
 	wmi_handle->wbuff_handle = wbuff_module_register(wbuff_alloc, 4,
 							 WMI_MIN_HEAD_ROOM, 4);
+	wmi_htc_pkt_pool_init(wmi_handle);
 }
 
 /**
@@ -2718,6 +3676,7 @@ static inline void wmi_wbuff_deregister(struct wmi_unified *wmi_handle)
 {
 	wbuff_module_deregister(wmi_handle->wbuff_handle);
 	wmi_handle->wbuff_handle = NULL;
+	wmi_htc_pkt_pool_deinit(wmi_handle);
 }
 
 /**
@@ -2766,16 +3725,8 @@ void *wmi_unified_attach(void *scn_handle,
 	qdf_atomic_init(&wmi_handle->is_target_suspended);
 	qdf_atomic_init(&wmi_handle->num_stats_over_qmi);
 	wmi_runtime_pm_init(wmi_handle);
-	qdf_spinlock_create(&wmi_handle->eventq_lock);
-	qdf_nbuf_queue_init(&wmi_handle->event_queue);
-	qdf_create_work(0, &wmi_handle->rx_event_work,
-			wmi_rx_event_work, wmi_handle);
-	wmi_handle->wmi_rx_work_queue =
-		qdf_alloc_unbound_workqueue("wmi_rx_event_work_queue");
-	if (!wmi_handle->wmi_rx_work_queue) {
-		WMI_LOGE("failed to create wmi_rx_event_work_queue");
+	if (QDF_IS_STATUS_ERROR(wmi_rx_evt_lanes_init(wmi_handle)))
 		goto error;
-	}
 	wmi_interface_logging_init(wmi_handle, WMI_HOST_PDEV_ID_0);
 	wmi_handle->target_type = param->target_type;
 	soc->target_type = param->target_type;
@@ -2795,6 +3746,8 @@ void *wmi_unified_attach(void *scn_handle,
 	wmi_handle->wmi_stopinprogress = 0;
 	wmi_handle->wmi_max_cmds = param->max_commands;
 	soc->wmi_max_cmds = param->max_commands;
+	if (wmitlv_arena_init(&wmi_handle->tlv_arena))
+		WMI_LOGD("wmi tlv arena unavailable, using heap");
 	/* Increase the ref count once refcount infra is present */
 	soc->wmi_psoc = param->psoc;
 	qdf_spinlock_create(&soc->ctx_lock);
@@ -2811,6 +3764,7 @@ void *wmi_unified_attach(void *scn_handle,
 	return wmi_handle;
 
 error:
+	wmi_rx_evt_lanes_deinit(wmi_handle);
 	qdf_mem_free(soc);
 	qdf_mem_free(wmi_handle);
 
@@ -2826,7 +3780,6 @@ error:
  */
 void wmi_unified_detach(struct wmi_unified *wmi_handle)
 {
-	wmi_buf_t buf;
 	struct wmi_soc *soc;
 	uint8_t i;
 
@@ -2839,18 +3792,8 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 	soc = wmi_handle->soc;
 	for (i = 0; i < WMI_MAX_RADIOS; i++) {
 		if (soc->wmi_pdev[i]) {
-			qdf_flush_workqueue(0,
-				soc->wmi_pdev[i]->wmi_rx_work_queue);
-			qdf_destroy_workqueue(0,
-				soc->wmi_pdev[i]->wmi_rx_work_queue);
+			wmi_rx_evt_lanes_deinit(soc->wmi_pdev[i]);
 			wmi_debugfs_remove(soc->wmi_pdev[i]);
-			buf = qdf_nbuf_queue_remove(
-					&soc->wmi_pdev[i]->event_queue);
-			while (buf) {
-				qdf_nbuf_free(buf);
-				buf = qdf_nbuf_queue_remove(
-						&soc->wmi_pdev[i]->event_queue);
-			}
 
 			wmi_log_buffer_free(soc->wmi_pdev[i]);
 
@@ -2859,7 +3802,8 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 				qdf_mem_free(
 					soc->wmi_pdev[i]->events_logs_list);
 
-			qdf_spinlock_destroy(&soc->wmi_pdev[i]->eventq_lock);
+			wmitlv_arena_deinit(&soc->wmi_pdev[i]->tlv_arena);
+			wmi_htc_pkt_pool_deinit(soc->wmi_pdev[i]);
 			qdf_mem_free(soc->wmi_pdev[i]);
 		}
 	}
@@ -2894,16 +3838,14 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 void
 wmi_unified_remove_work(struct wmi_unified *wmi_handle)
 {
-	wmi_buf_t buf;
+	struct wmi_rx_evt_lane *lane;
+	uint8_t i;
 
-	qdf_flush_workqueue(0, wmi_handle->wmi_rx_work_queue);
-	qdf_spin_lock_bh(&wmi_handle->eventq_lock);
-	buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
-	while (buf) {
-		qdf_nbuf_free(buf);
-		buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
+	for (i = 0; i < WMI_RX_EVT_CLASS_MAX; i++) {
+		lane = &wmi_handle->rx_evt_lane[i];
+		qdf_flush_workqueue(0, lane->wmi_rx_work_queue);
+		wmi_rx_evt_lane_purge(lane);
 	}
-	qdf_spin_unlock_bh(&wmi_handle->eventq_lock);
 }
 
 /**
@@ -2957,7 +3899,7 @@ static void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 	len = qdf_nbuf_len(wmi_cmd_buf);
 	qdf_mem_zero(buf_ptr, len);
 	wmi_buf_free(wmi_cmd_buf);
-	qdf_mem_free(htc_pkt);
+	wmi_htc_pkt_free(wmi_handle, htc_pkt);
 	qdf_atomic_dec(&wmi_handle->pending_cmds);
 }
 
@@ -2988,6 +3930,31 @@ static void wmi_htc_log_pkt(void *ctx, HTC_PACKET *htc_pkt)
 }
 #endif
 
+/**
+ * wmi_htc_pkt_release() - return a pooled HTC packet dropped by HTC
+ * @ctx: handle to wmi soc
+ * @htc_pkt: pointer to htc packet
+ *
+ * HTC calls this instead of the send completion when the target is down,
+ * after it has freed the command buffer itself.
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_release(void *ctx, HTC_PACKET *htc_pkt)
+{
+	struct wmi_soc *soc = (struct wmi_soc *)ctx;
+	struct wmi_unified *wmi_handle;
+
+	wmi_handle = wmi_get_pdev_ep(soc, htc_pkt->Endpoint);
+	if (!wmi_handle) {
+		WMI_LOGE("%s: Unable to get wmi handle\n", __func__);
+		QDF_ASSERT(0);
+		return;
+	}
+
+	wmi_htc_pkt_free(wmi_handle, htc_pkt);
+}
+
 /**
  * wmi_connect_pdev_htc_service() -  WMI API to get connect to HTC service
  *
@@ -3019,6 +3986,7 @@ static QDF_STATUS wmi_connect_pdev_htc_service(struct wmi_soc *soc,
 	connect.EpCallbacks.EpTxComplete =
 		wmi_htc_tx_complete /* ar6000_tx_queue_full */;
 	connect.EpCallbacks.ep_log_pkt = wmi_htc_log_pkt;
+	connect.EpCallbacks.ep_pkt_release = wmi_htc_pkt_release;
 
 	/* connect to control service */
 	connect.service_id = soc->svc_ids[pdev_idx];
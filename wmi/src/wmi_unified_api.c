@@ -182,6 +182,29 @@ QDF_STATUS wmi_set_peer_param_send(wmi_unified_t wmi_handle,
 	return QDF_STATUS_E_FAILURE;
 }
 
+QDF_STATUS
+wmi_set_peer_multiple_param_send(wmi_unified_t wmi_handle,
+				 uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
+				 struct peer_set_params *params,
+				 uint8_t num)
+{
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint8_t i;
+
+	if (wmi_handle->ops->send_multiple_peer_param_cmd)
+		return wmi_handle->ops->send_multiple_peer_param_cmd(wmi_handle,
+				peer_addr, params, num);
+
+	for (i = 0; i < num; i++) {
+		if (QDF_IS_STATUS_ERROR(wmi_set_peer_param_send(wmi_handle,
+								peer_addr,
+								&params[i])))
+			status = QDF_STATUS_E_FAILURE;
+	}
+
+	return status;
+}
+
 QDF_STATUS wmi_unified_vdev_up_send(wmi_unified_t wmi_handle,
 				    uint8_t bssid[QDF_MAC_ADDR_SIZE],
 				    struct vdev_up_params *params)
@@ -401,6 +424,27 @@ wmi_unified_vdev_set_param_send(wmi_unified_t wmi_handle,
 	return QDF_STATUS_E_FAILURE;
 }
 
+QDF_STATUS
+wmi_unified_vdev_set_multiple_param_send(wmi_unified_t wmi_handle,
+					 struct vdev_set_params *params,
+					 uint8_t num)
+{
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint8_t i;
+
+	if (wmi_handle->ops->send_vdev_set_multiple_param_cmd)
+		return wmi_handle->ops->send_vdev_set_multiple_param_cmd(
+				wmi_handle, params, num);
+
+	for (i = 0; i < num; i++) {
+		if (QDF_IS_STATUS_ERROR(wmi_unified_vdev_set_param_send(
+						wmi_handle, &params[i])))
+			status = QDF_STATUS_E_FAILURE;
+	}
+
+	return status;
+}
+
 QDF_STATUS wmi_unified_sifs_trigger_send(wmi_unified_t wmi_handle,
 					 struct sifs_trigger_param *param)
 {
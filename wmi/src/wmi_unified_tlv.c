@@ -1243,20 +1243,20 @@ static inline uint32_t convert_host_peer_param_id_to_target_id_tlv(
 #endif
 
 /**
- * send_peer_param_cmd_tlv() - set peer parameter in fw
+ * peer_param_cmd_buf_tlv() - build a peer set parameter command
  * @wmi: wmi handle
  * @peer_addr: peer mac address
  * @param    : pointer to hold peer set parameter
+ * @buf: filled with the command buffer on success
  *
  * Return: QDF_STATUS_SUCCESS for success or error code
  */
-static QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
+static QDF_STATUS peer_param_cmd_buf_tlv(wmi_unified_t wmi,
 				uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
-				struct peer_set_params *param)
+				struct peer_set_params *param,
+				wmi_buf_t *buf)
 {
 	wmi_peer_set_param_cmd_fixed_param *cmd;
-	wmi_buf_t buf;
-	int32_t err;
 	uint32_t param_id;
 
 	param_id = convert_host_peer_param_id_to_target_id_tlv(param->param_id);
@@ -1265,11 +1265,11 @@ static QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
 		return QDF_STATUS_E_NOSUPPORT;
 	}
 
-	buf = wmi_buf_alloc(wmi, sizeof(*cmd));
-	if (!buf)
+	*buf = wmi_buf_alloc(wmi, sizeof(*cmd));
+	if (!*buf)
 		return QDF_STATUS_E_NOMEM;
 
-	cmd = (wmi_peer_set_param_cmd_fixed_param *) wmi_buf_data(buf);
+	cmd = (wmi_peer_set_param_cmd_fixed_param *) wmi_buf_data(*buf);
 	WMITLV_SET_HDR(&cmd->tlv_header,
 		       WMITLV_TAG_STRUC_wmi_peer_set_param_cmd_fixed_param,
 		       WMITLV_GET_STRUCT_TLVLEN
@@ -1279,6 +1279,30 @@ static QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
 	cmd->param_id = param_id;
 	cmd->param_value = param->param_value;
 	wmi_mtrace(WMI_PEER_SET_PARAM_CMDID, cmd->vdev_id, 0);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * send_peer_param_cmd_tlv() - set peer parameter in fw
+ * @wmi: wmi handle
+ * @peer_addr: peer mac address
+ * @param    : pointer to hold peer set parameter
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
+				uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
+				struct peer_set_params *param)
+{
+	wmi_buf_t buf;
+	QDF_STATUS status;
+	int32_t err;
+
+	status = peer_param_cmd_buf_tlv(wmi, peer_addr, param, &buf);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
 	err = wmi_unified_cmd_send(wmi, buf,
 				   sizeof(wmi_peer_set_param_cmd_fixed_param),
 				   WMI_PEER_SET_PARAM_CMDID);
@@ -1291,6 +1315,54 @@ static QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
 	return 0;
 }
 
+/**
+ * send_multiple_peer_param_cmd_tlv() - set several peer parameters in fw
+ * @wmi: wmi handle
+ * @peer_addr: peer mac address
+ * @params: peer set parameters
+ * @num: number of entries in @params
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS send_multiple_peer_param_cmd_tlv(wmi_unified_t wmi,
+				uint8_t peer_addr[QDF_MAC_ADDR_SIZE],
+				struct peer_set_params *params,
+				uint8_t num)
+{
+	struct wmi_cmd_batch batch;
+	wmi_buf_t buf;
+	QDF_STATUS status, ret = QDF_STATUS_SUCCESS;
+	uint8_t i;
+
+	wmi_unified_cmd_batch_begin(wmi, &batch);
+	for (i = 0; i < num; i++) {
+		status = peer_param_cmd_buf_tlv(wmi, peer_addr, &params[i],
+						&buf);
+		if (status == QDF_STATUS_E_NOSUPPORT)
+			continue;
+		if (QDF_IS_STATUS_ERROR(status)) {
+			ret = status;
+			break;
+		}
+
+		status = wmi_unified_cmd_batch_add(wmi, &batch, buf,
+				sizeof(wmi_peer_set_param_cmd_fixed_param),
+				WMI_PEER_SET_PARAM_CMDID);
+		if (QDF_IS_STATUS_ERROR(status)) {
+			WMI_LOGE("Failed to send set_param cmd");
+			wmi_buf_free(buf);
+			ret = QDF_STATUS_E_FAILURE;
+			break;
+		}
+	}
+
+	status = wmi_unified_cmd_batch_commit(wmi, &batch);
+	if (QDF_IS_STATUS_ERROR(status))
+		ret = status;
+
+	return ret;
+}
+
 /**
  * send_vdev_up_cmd_tlv() - send vdev up command in fw
  * @wmi: wmi handle
@@ -2058,20 +2130,18 @@ static inline uint32_t convert_host_vdev_param_tlv(uint32_t host_param)
 #endif
 
 /**
- *  send_vdev_set_param_cmd_tlv() - WMI vdev set parameter function
+ *  vdev_set_param_cmd_buf_tlv() - build a WMI vdev set parameter command
  *  @param wmi_handle      : handle to WMI.
- *  @param macaddr	: MAC address
  *  @param param    : pointer to hold vdev set parameter
+ *  @param buf	: filled with the command buffer on success
  *
- *  Return: 0  on success and -ve on failure.
+ *  Return: QDF_STATUS_SUCCESS for success or error code
  */
-static QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
-				struct vdev_set_params *param)
+static QDF_STATUS vdev_set_param_cmd_buf_tlv(wmi_unified_t wmi_handle,
+				struct vdev_set_params *param,
+				wmi_buf_t *buf)
 {
-	QDF_STATUS ret;
 	wmi_vdev_set_param_cmd_fixed_param *cmd;
-	wmi_buf_t buf;
-	uint16_t len = sizeof(*cmd);
 	uint32_t vdev_param;
 
 	vdev_param = convert_host_vdev_param_tlv(param->param_id);
@@ -2082,11 +2152,11 @@ static QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
 
 	}
 
-	buf = wmi_buf_alloc(wmi_handle, len);
-	if (!buf)
+	*buf = wmi_buf_alloc(wmi_handle, sizeof(*cmd));
+	if (!*buf)
 		return QDF_STATUS_E_NOMEM;
 
-	cmd = (wmi_vdev_set_param_cmd_fixed_param *) wmi_buf_data(buf);
+	cmd = (wmi_vdev_set_param_cmd_fixed_param *) wmi_buf_data(*buf);
 	WMITLV_SET_HDR(&cmd->tlv_header,
 		       WMITLV_TAG_STRUC_wmi_vdev_set_param_cmd_fixed_param,
 		       WMITLV_GET_STRUCT_TLVLEN
@@ -2097,7 +2167,30 @@ static QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("Setting vdev %d param = %x, value = %u",
 		 cmd->vdev_id, cmd->param_id, cmd->param_value);
 	wmi_mtrace(WMI_VDEV_SET_PARAM_CMDID, cmd->vdev_id, 0);
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ *  send_vdev_set_param_cmd_tlv() - WMI vdev set parameter function
+ *  @param wmi_handle      : handle to WMI.
+ *  @param macaddr	: MAC address
+ *  @param param    : pointer to hold vdev set parameter
+ *
+ *  Return: 0  on success and -ve on failure.
+ */
+static QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
+				struct vdev_set_params *param)
+{
+	QDF_STATUS ret;
+	wmi_buf_t buf;
+
+	ret = vdev_set_param_cmd_buf_tlv(wmi_handle, param, &buf);
+	if (QDF_IS_STATUS_ERROR(ret))
+		return ret;
+
+	ret = wmi_unified_cmd_send(wmi_handle, buf,
+				   sizeof(wmi_vdev_set_param_cmd_fixed_param),
 				   WMI_VDEV_SET_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set param command ret = %d", ret);
@@ -2107,6 +2200,68 @@ static QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
 	return ret;
 }
 
+/**
+ *  send_vdev_set_multiple_param_cmd_tlv() - WMI vdev set several parameters
+ *  @param wmi_handle      : handle to WMI.
+ *  @param params   : vdev set parameters
+ *  @param num	: number of entries in params
+ *
+ *  The params are independent of each other, so a failure to build or
+ *  queue one of them does not abort the rest: the batch queued so far is
+ *  committed and the remaining params are sent one command at a time.
+ *
+ *  Return: 0  on success and -ve on failure of any param.
+ */
+static QDF_STATUS
+send_vdev_set_multiple_param_cmd_tlv(wmi_unified_t wmi_handle,
+				     struct vdev_set_params *params,
+				     uint8_t num)
+{
+	struct wmi_cmd_batch batch;
+	wmi_buf_t buf;
+	QDF_STATUS status, ret = QDF_STATUS_SUCCESS;
+	uint8_t i;
+
+	wmi_unified_cmd_batch_begin(wmi_handle, &batch);
+	for (i = 0; i < num; i++) {
+		status = vdev_set_param_cmd_buf_tlv(wmi_handle, &params[i],
+						    &buf);
+		if (status == QDF_STATUS_E_INVAL)
+			continue;
+		if (QDF_IS_STATUS_ERROR(status))
+			break;
+
+		status = wmi_unified_cmd_batch_add(wmi_handle, &batch, buf,
+				sizeof(wmi_vdev_set_param_cmd_fixed_param),
+				WMI_VDEV_SET_PARAM_CMDID);
+		if (QDF_IS_STATUS_ERROR(status)) {
+			WMI_LOGE("Failed to batch set param command ret = %d",
+				 status);
+			wmi_buf_free(buf);
+			break;
+		}
+	}
+
+	status = wmi_unified_cmd_batch_commit(wmi_handle, &batch);
+	if (QDF_IS_STATUS_ERROR(status))
+		ret = status;
+
+	/* best effort: send what could not be batched param by param */
+	for (; i < num; i++) {
+		status = send_vdev_set_param_cmd_tlv(wmi_handle, &params[i]);
+		if (status == QDF_STATUS_E_INVAL)
+			continue;
+		if (QDF_IS_STATUS_ERROR(status)) {
+			WMI_LOGE("Failed to set vdev %d param %x ret = %d",
+				 params[i].vdev_id, params[i].param_id,
+				 status);
+			ret = status;
+		}
+	}
+
+	return ret;
+}
+
 /**
  *  send_stats_request_cmd_tlv() - WMI request stats function
  *  @param wmi_handle      : handle to WMI.
@@ -14182,6 +14337,7 @@ struct wmi_ops tlv_ops =  {
 	.send_vdev_start_cmd = send_vdev_start_cmd_tlv,
 	.send_peer_flush_tids_cmd = send_peer_flush_tids_cmd_tlv,
 	.send_peer_param_cmd = send_peer_param_cmd_tlv,
+	.send_multiple_peer_param_cmd = send_multiple_peer_param_cmd_tlv,
 	.send_vdev_up_cmd = send_vdev_up_cmd_tlv,
 	.send_vdev_stop_cmd = send_vdev_stop_cmd_tlv,
 	.send_peer_create_cmd = send_peer_create_cmd_tlv,
@@ -14204,6 +14360,8 @@ struct wmi_ops tlv_ops =  {
 	.send_dbglog_cmd = send_dbglog_cmd_tlv,
 #endif
 	.send_vdev_set_param_cmd = send_vdev_set_param_cmd_tlv,
+	.send_vdev_set_multiple_param_cmd =
+				send_vdev_set_multiple_param_cmd_tlv,
 	.send_stats_request_cmd = send_stats_request_cmd_tlv,
 	.send_packet_log_enable_cmd = send_packet_log_enable_cmd_tlv,
 	.send_peer_based_pktlog_cmd = send_peer_based_pktlog_cmd,
@@ -14468,8 +14626,8 @@ struct wmi_ops tlv_ops =  {
 	.send_obss_detection_cfg_cmd = send_obss_detection_cfg_cmd_tlv,
 	.extract_obss_detection_info = extract_obss_detection_info_tlv,
 	.wmi_pdev_id_conversion_enable = wmi_tlv_pdev_id_conversion_enable,
-	.wmi_free_allocated_event = wmitlv_free_allocated_event_tlvs,
-	.wmi_check_and_pad_event = wmitlv_check_and_pad_event_tlvs,
+	.wmi_free_allocated_event = wmitlv_free_allocated_event_tlvs_arena,
+	.wmi_check_and_pad_event = wmitlv_check_and_pad_event_tlvs_arena,
 	.wmi_check_command_params = wmitlv_check_command_tlv_params,
 	.extract_comb_phyerr = extract_comb_phyerr_tlv,
 	.extract_single_phyerr = extract_single_phyerr_tlv,